@@ -22,9 +22,16 @@
     You should have received a copy of the GNU General Public License
     along with this program; if not, visit http://www.fsf.org/
 */
+#define _GNU_SOURCE
 #include <glib.h>
 #include <glib/gi18n.h>
 #include <glib/gstdio.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef G_OS_WIN32
+#include <unistd.h>
+#endif
 #ifdef HAVE_CONFIG_H
 #include <build-config.h>
 #endif
@@ -428,18 +435,146 @@ static void first_time_check_step_04(guint * error)
     g_free(dir);
 }
 
-/* create .sat files from a satellites.dat file */
-static void create_sat_files(guint * error)
+/* number of threads used to write the satellite data files */
+#define FTC_WRITE_THREADS 4
+
+/* keys copied from satellites.dat to the .sat files, in this order */
+static const gchar *sat_keys[] = {
+    "VERSION", "NAME", "NICKNAME", "WEBSITE", "TLE1", "TLE2"
+};
+
+#define SAT_KEY_NUM G_N_ELEMENTS(sat_keys)
+
+/* a file to be written by the writer threads */
+typedef struct {
+    gchar          *filename;
+    gchar          *data;
+    gsize           length;
+} ftc_write_job_t;
+
+/*
+ * Flush the file system holding a directory to disk.
+ *
+ * With full is FALSE only the directory entries are flushed, otherwise the
+ * data of all files written to the file system is flushed too. This is not
+ * possible on windows.
+ */
+static void sync_dir(const gchar * dirname, gboolean full)
+{
+#ifndef G_OS_WIN32
+    int             fd;
+    int             status;
+
+    fd = g_open(dirname, O_RDONLY, 0);
+    if (fd < 0)
+        return;
+
+    if (!full)
+        status = fsync(fd);
+    else
+    {
+#ifdef __linux__
+        status = syncfs(fd);
+#else
+        sync();
+        status = 0;
+#endif
+    }
+
+    if (status != 0)
+        sat_log_log(SAT_LOG_LEVEL_WARN, _("%s: Failed to sync %s"),
+                    __func__, dirname);
+    close(fd);
+#else
+    (void)dirname;
+    (void)full;
+#endif
+}
+
+/* thread pool function writing one file; data is a ftc_write_job_t */
+static void write_file_job(gpointer data, gpointer errors)
+{
+    ftc_write_job_t *job = (ftc_write_job_t *) data;
+    FILE           *file;
+    gboolean        ok = FALSE;
+
+    file = g_fopen(job->filename, "wb");
+    if (file != NULL)
+    {
+        ok = (fwrite(job->data, 1, job->length, file) == job->length);
+        ok = (fclose(file) == 0) && ok;
+    }
+
+    if (!ok)
+        g_atomic_int_inc((gint *) errors);
+
+    g_free(job->filename);
+    g_free(job->data);
+    g_free(job);
+}
+
+/* queue file for writing; takes ownership of filename and data */
+static void queue_write(GThreadPool * pool, gint * errors, gchar * filename,
+                        gchar * data, gsize length)
+{
+    ftc_write_job_t *job = g_new(ftc_write_job_t, 1);
+
+    job->filename = filename;
+    job->data = data;
+    job->length = length;
+
+    if (pool != NULL)
+        g_thread_pool_push(pool, job, NULL);
+    else
+        write_file_job(job, errors);
+}
+
+/* queue .sat file for one satellite of satellites.dat */
+static void queue_sat_file(GThreadPool * pool, gint * errors,
+                           const gchar * staging, const gchar * catnum,
+                           gchar ** values)
+{
+    GString        *data;
+    guint           i;
+
+    data = g_string_sized_new(256);
+    g_string_append(data, "[Satellite]\n");
+    for (i = 0; i < SAT_KEY_NUM; i++)
+        if (values[i] != NULL)
+            g_string_append_printf(data, "%s=%s\n", sat_keys[i], values[i]);
+
+    queue_write(pool, errors,
+                g_strconcat(staging, G_DIR_SEPARATOR_S, catnum, ".sat", NULL),
+                data->str, data->len);
+    g_string_free(data, FALSE);
+}
+
+/**
+ * Create .sat files from a satellites.dat file.
+ *
+ * @param staging The directory where the files are created.
+ * @param pool Thread pool writing the files. May be NULL.
+ * @param errors Counter of failed writes.
+ * @param error Error flags of the first time check.
+ * @return The number of satellites queued for writing.
+ *
+ * satellites.dat is a key file with one group per satellite. Rather than
+ * loading it into a GKeyFile and creating a new GKeyFile for each satellite,
+ * the file is read once and each group is converted directly to the text of
+ * the corresponding .sat file.
+ */
+static guint create_sat_files(const gchar * staging, GThreadPool * pool,
+                              gint * errors, guint * error)
 {
-    gchar          *satfilename, *targetfilename;
+    gchar          *satfilename;
     gchar          *datadir;
-    gchar         **satellites;
-    GKeyFile       *satfile, *target;
-    gsize           num;
+    gchar          *contents;
+    gchar          *line, *next, *value;
+    gchar          *catnum = NULL;
+    gchar          *values[SAT_KEY_NUM];
     GError         *err = NULL;
     guint           i;
     guint           newsats = 0;
-    gchar          *name, *nickname, *website, *tle1, *tle2, *cfgver;
 
     sat_log_log(SAT_LOG_LEVEL_INFO,
                 _("Copying satellite data to user config"));
@@ -448,10 +583,9 @@ static void create_sat_files(guint * error)
     datadir = get_data_dir();
     satfilename = g_strconcat(datadir, G_DIR_SEPARATOR_S, "satdata",
                               G_DIR_SEPARATOR_S, "satellites.dat", NULL);
+    g_free(datadir);
 
-    satfile = g_key_file_new();
-    if (!g_key_file_load_from_file
-        (satfile, satfilename, G_KEY_FILE_KEEP_COMMENTS, &err))
+    if (!g_file_get_contents(satfilename, &contents, NULL, &err))
     {
         /* an error occurred */
         sat_log_log(SAT_LOG_LEVEL_ERROR,
@@ -459,104 +593,99 @@ static void create_sat_files(guint * error)
                     __func__, satfilename, err->message);
 
         g_clear_error(&err);
+        g_free(satfilename);
         *error |= FTC_ERROR_STEP_05;
+
+        return 0;
     }
-    else
+
+    memset(values, 0, sizeof(values));
+
+    /* values point into contents, which is modified in place */
+    for (line = contents; line != NULL; line = next)
     {
-        satellites = g_key_file_get_groups(satfile, &num);
-        sat_log_log(SAT_LOG_LEVEL_INFO,
-                    _("%s: Found %d satellites in %s"),
-                    __func__, num, satfilename);
+        next = strchr(line, '\n');
+        if (next != NULL)
+            *next++ = '\0';
+
+        g_strstrip(line);
+        if (*line == '\0' || *line == '#')
+            continue;
 
-        for (i = 0; i < num; i++)
+        if (*line == '[')
         {
-            /* first, check if this satellite already has a .sat file */
-            targetfilename = sat_file_name_from_catnum_s(satellites[i]);
-            if (g_file_test(targetfilename, G_FILE_TEST_EXISTS))
+            /* new satellite; write the previous one */
+            if (catnum != NULL)
             {
-                sat_log_log(SAT_LOG_LEVEL_DEBUG,
-                            _("%s: %s.sat already exists. Skipped."),
-                            __func__, satellites[i]);
+                queue_sat_file(pool, errors, staging, catnum, values);
+                newsats++;
             }
-            else
-            {
-                /* read data for this satellite */
-                cfgver =
-                    g_key_file_get_string(satfile, satellites[i], "VERSION",
-                                          NULL);
-                name =
-                    g_key_file_get_string(satfile, satellites[i], "NAME",
-                                          NULL);
-                nickname =
-                    g_key_file_get_string(satfile, satellites[i], "NICKNAME",
-                                          NULL);
-                website =
-                    g_key_file_get_string(satfile, satellites[i], "WEBSITE",
-                                          NULL);
-                tle1 =
-                    g_key_file_get_string(satfile, satellites[i], "TLE1",
-                                          NULL);
-                tle2 =
-                    g_key_file_get_string(satfile, satellites[i], "TLE2",
-                                          NULL);
-
-                /* create output .sat file */
-                target = g_key_file_new();
-                g_key_file_set_string(target, "Satellite", "VERSION", cfgver);
-                g_key_file_set_string(target, "Satellite", "NAME", name);
-                g_key_file_set_string(target, "Satellite", "NICKNAME",
-                                      nickname);
-                if (website != NULL)
-                {
-                    g_key_file_set_string(target, "Satellite", "WEBSITE",
-                                          website);
-                    g_free(website);
-                }
-                g_key_file_set_string(target, "Satellite", "TLE1", tle1);
-                g_key_file_set_string(target, "Satellite", "TLE2", tle2);
 
-                if (gpredict_save_key_file(target, targetfilename))
-                {
-                    *error |= FTC_ERROR_STEP_05;
-                }
-                else
-                {
-                    newsats++;
-                }
+            catnum = line + 1;
+            value = strchr(catnum, ']');
+            if (value != NULL)
+                *value = '\0';
+            memset(values, 0, sizeof(values));
+            continue;
+        }
 
-                g_key_file_free(target);
+        value = strchr(line, '=');
+        if (catnum == NULL || value == NULL)
+            continue;
 
-                g_free(cfgver);
-                g_free(name);
-                g_free(nickname);
-                g_free(tle1);
-                g_free(tle2);
+        *value++ = '\0';
+        g_strchomp(line);
+        for (i = 0; i < SAT_KEY_NUM; i++)
+        {
+            if (!strcmp(line, sat_keys[i]))
+            {
+                values[i] = g_strchug(value);
+                break;
             }
-            g_free(targetfilename);
         }
-        g_strfreev(satellites);
-        sat_log_log(SAT_LOG_LEVEL_INFO,
-                    _("%s: Written %d new satellite to user config"),
-                    __func__, newsats);
     }
-    g_key_file_free(satfile);
+
+    if (catnum != NULL)
+    {
+        queue_sat_file(pool, errors, staging, catnum, values);
+        newsats++;
+    }
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Found %d satellites in %s"),
+                __func__, newsats, satfilename);
+
+    g_free(contents);
     g_free(satfilename);
-    g_free(datadir);
+
+    return newsats;
 }
 
-/* create .cat files in user conf directory */
-static void create_cat_files(guint * error)
+/**
+ * Create .cat files.
+ *
+ * @param staging The directory where the files are created.
+ * @param pool Thread pool writing the files. May be NULL.
+ * @param errors Counter of failed writes.
+ * @param error Error flags of the first time check.
+ * @return The number of categories queued for writing.
+ */
+static guint create_cat_files(const gchar * staging, GThreadPool * pool,
+                              gint * errors, guint * error)
 {
     gchar          *datadir;
     GError         *err = NULL;
     GDir           *srcdir;
     gchar          *srcdirname;
+    gchar          *source;
+    gchar          *contents;
+    gsize           length;
     const gchar    *filename;
+    guint           newcats = 0;
 
     sat_log_log(SAT_LOG_LEVEL_INFO,
                 _("Copying satellite categories to user config"));
 
-    /* .cat files: if .cat file does not exist, copy it, otherwise skip */
     datadir = get_data_dir();
     srcdirname = g_strconcat(datadir, G_DIR_SEPARATOR_S, "satdata", NULL);
     srcdir = g_dir_open(srcdirname, 0, &err);
@@ -574,46 +703,103 @@ static void create_cat_files(guint * error)
     }
     else
     {
-        /* get each .cat file and check if they already exist in user conf */
-        /* read files one by one, if any; count number of .tle files */
         while ((filename = g_dir_read_name(srcdir)))
         {
             /* note: filename is not a newly allocated gchar *,
                so we must not free it
              */
-            if (g_str_has_suffix(filename, ".cat"))
-            {
-
-                /* check whether .cat file exisits in user conf */
-                gchar          *catfilename = sat_file_name(filename);
+            if (!g_str_has_suffix(filename, ".cat"))
+                continue;
 
-                if (!g_file_test(catfilename, G_FILE_TEST_EXISTS))
-                {
-                    /* copy file to target dir */
-                    gchar          *source =
-                        g_strconcat(srcdirname, G_DIR_SEPARATOR_S, filename,
-                                    NULL);
-                    if (gpredict_file_copy(source, catfilename))
-                    {
-                        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                                    _("%s: Failed to copy %s"),
-                                    __func__, filename);
-                    }
-                    else
-                    {
-                        sat_log_log(SAT_LOG_LEVEL_DEBUG,
-                                    _("%s: Successfully copied %s"),
-                                    __func__, filename);
-                    }
-                    g_free(source);
-                }
-                g_free(catfilename);
+            source = g_strconcat(srcdirname, G_DIR_SEPARATOR_S, filename,
+                                 NULL);
+            if (g_file_get_contents(source, &contents, &length, &err))
+            {
+                queue_write(pool, errors,
+                            g_strconcat(staging, G_DIR_SEPARATOR_S, filename,
+                                        NULL), contents, length);
+                newcats++;
+            }
+            else
+            {
+                sat_log_log(SAT_LOG_LEVEL_ERROR,
+                            _("%s: Failed to copy %s (%s)"),
+                            __func__, filename, err->message);
+                g_clear_error(&err);
             }
+            g_free(source);
         }
         g_dir_close(srcdir);
     }
     g_free(srcdirname);
     g_free(datadir);
+
+    return newcats;
+}
+
+/* remove the files in a directory and the directory if it is empty */
+static void remove_dir(const gchar * dirname)
+{
+    GDir           *dir;
+    const gchar    *filename;
+    gchar          *path;
+
+    dir = g_dir_open(dirname, 0, NULL);
+    if (dir != NULL)
+    {
+        while ((filename = g_dir_read_name(dir)))
+        {
+            path = g_strconcat(dirname, G_DIR_SEPARATOR_S, filename, NULL);
+            if (g_file_test(path, G_FILE_TEST_IS_REGULAR))
+                g_remove(path);
+            g_free(path);
+        }
+        g_dir_close(dir);
+    }
+    g_rmdir(dirname);
+}
+
+/**
+ * Move the entries of a directory which are missing in another directory.
+ *
+ * @param from The source directory.
+ * @param to The destination directory.
+ * @return TRUE if all missing entries have been moved.
+ *
+ * Each entry is moved by a single rename, so it is always present in one of
+ * the two directories. Entries already present in the destination are left
+ * in the source directory; the existing file takes precedence.
+ */
+static gboolean move_missing_entries(const gchar * from, const gchar * to)
+{
+    GDir           *dir;
+    const gchar    *filename;
+    gchar          *src, *dst;
+    gboolean        ok = TRUE;
+
+    dir = g_dir_open(from, 0, NULL);
+    if (dir == NULL)
+        return FALSE;
+
+    while ((filename = g_dir_read_name(dir)))
+    {
+        src = g_strconcat(from, G_DIR_SEPARATOR_S, filename, NULL);
+        dst = g_strconcat(to, G_DIR_SEPARATOR_S, filename, NULL);
+
+        if (!g_file_test(dst, G_FILE_TEST_EXISTS) && g_rename(src, dst))
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Failed to move %s to %s"), __func__, src, to);
+            ok = FALSE;
+        }
+        g_free(src);
+        g_free(dst);
+    }
+    g_dir_close(dir);
+
+    sync_dir(to, FALSE);
+
+    return ok;
 }
 
 /**
@@ -623,34 +809,124 @@ static void create_cat_files(guint * error)
  *    PACKAGE_DATA_DIR/data/satdata/satellites.dat to .sat files.
  *    Do the same with .cat files.
  *
+ * The files are written by a pool of threads into a staging directory next
+ * to satdata, which is synced to disk once all files have been written.
+ * Then the files missing in satdata are renamed into it one by one, so
+ * satdata never holds a partially written file. Existing files in satdata
+ * are never replaced.
+ *
+ * A staging directory left behind by an interrupted run may hold truncated
+ * files. It is discarded and the data is staged again; since the previous
+ * run may have moved only some of the files, this is done even if satdata
+ * already has .sat and .cat files.
  */
 static void first_time_check_step_05(guint * error)
 {
     gchar          *datadir_str;
+    gchar          *staging;
     GDir           *datadir;
+    GThreadPool    *pool;
+    GTimer         *timer;
     const gchar    *filename;
     gboolean        have_sat = FALSE;
     gboolean        have_cat = FALSE;
+    guint           newsats = 0;
+    guint           newcats = 0;
+    gint            errors = 0;
 
-    /* check if there already is a .sat and .cat in ~/.config/... */
     datadir_str = get_satdata_dir();
-    datadir = g_dir_open(datadir_str, 0, NULL);
-    while ((filename = g_dir_read_name(datadir)))
+    staging = g_strconcat(datadir_str, ".new", NULL);
+
+    if (g_file_test(staging, G_FILE_TEST_IS_DIR))
     {
-        /* note: filename is not newly allocated */
-        if (g_str_has_suffix(filename, ".sat"))
-            have_sat = TRUE;
-        if (g_str_has_suffix(filename, ".cat"))
-            have_cat = TRUE;
+        /* interrupted run; discard and stage everything again */
+        sat_log_log(SAT_LOG_LEVEL_WARN,
+                    _("%s: Discarding %s left by an interrupted run"),
+                    __func__, staging);
+        remove_dir(staging);
     }
-    g_free(datadir_str);
-    g_dir_close(datadir);
+    else
+    {
+        /* check if there already is a .sat and .cat in ~/.config/... */
+        datadir = g_dir_open(datadir_str, 0, NULL);
+        while ((filename = g_dir_read_name(datadir)))
+        {
+            /* note: filename is not newly allocated */
+            if (g_str_has_suffix(filename, ".sat"))
+                have_sat = TRUE;
+            if (g_str_has_suffix(filename, ".cat"))
+                have_cat = TRUE;
+        }
+        g_dir_close(datadir);
+    }
+
+    if (have_sat && have_cat)
+    {
+        g_free(staging);
+        g_free(datadir_str);
+        return;
+    }
+
+    timer = g_timer_new();
+
+    if (g_file_test(staging, G_FILE_TEST_EXISTS) ||
+        g_mkdir_with_parents(staging, 0755))
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Failed to create %s"),
+                    __func__, staging);
+        *error |= FTC_ERROR_STEP_05;
+        g_free(staging);
+        g_free(datadir_str);
+        g_timer_destroy(timer);
+        return;
+    }
+
+    /* files are written synchronously if the pool can not be created */
+    pool = g_thread_pool_new(write_file_job, &errors, FTC_WRITE_THREADS,
+                             FALSE, NULL);
 
     if (!have_sat)
-        create_sat_files(error);
+        newsats = create_sat_files(staging, pool, &errors, error);
 
     if (!have_cat)
-        create_cat_files(error);
+        newcats = create_cat_files(staging, pool, &errors, error);
+
+    /* wait for all files to be written */
+    if (pool != NULL)
+        g_thread_pool_free(pool, FALSE, TRUE);
+
+    if (errors > 0)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Failed to write %d files to %s"),
+                    __func__, errors, staging);
+        *error |= FTC_ERROR_STEP_05;
+        remove_dir(staging);
+    }
+    else
+    {
+        /* one sync for all files before any of them is renamed */
+        sync_dir(staging, TRUE);
+
+        if (move_missing_entries(staging, datadir_str))
+        {
+            remove_dir(staging);
+            sat_log_log(SAT_LOG_LEVEL_INFO,
+                        _("%s: Written %d satellites and %d categories "
+                          "to user config in %.3f s"),
+                        __func__, newsats, newcats,
+                        g_timer_elapsed(timer, NULL));
+        }
+        else
+        {
+            /* keep the staging directory so the next run stages again */
+            *error |= FTC_ERROR_STEP_05;
+        }
+    }
+
+    g_timer_destroy(timer);
+    g_free(staging);
+    g_free(datadir_str);
 }
 
 /**
@@ -55,6 +55,19 @@ static GtkBoxClass *parent_class = NULL;
 
 static void gtk_azel_plot_destroy(GtkWidget * widget)
 {
+    GtkAzelPlot    *azel = GTK_AZEL_PLOT(widget);
+
+    if (azel->azpts != NULL)
+    {
+        goo_canvas_points_unref(azel->azpts);
+        azel->azpts = NULL;
+    }
+    if (azel->elpts != NULL)
+    {
+        goo_canvas_points_unref(azel->elpts);
+        azel->elpts = NULL;
+    }
+
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
 
@@ -109,34 +122,42 @@ GType gtk_azel_plot_get_type()
     return gtk_azel_plot_type;
 }
 
-static void az_to_xy(GtkAzelPlot * p, gdouble t, gdouble az, gdouble * x,
-                     gdouble * y)
+/* Map normalized graph points to canvas coordinates */
+static void map_graph(GooCanvasItemModel * graph, GooCanvasPoints * norm,
+                      const cairo_matrix_t * matrix)
 {
-    gdouble         tpp;        /* time per pixel */
-    gdouble         dpp;        /* degrees per pixel */
-
-    /* time */
-    tpp = (p->pass->los - p->pass->aos) / (p->xmax - p->x0);
-    *x = p->x0 + (t - p->pass->aos) / tpp;
+    GooCanvasPoints *pts;
+    gint            i;
 
-    /* Az */
-    dpp = (gdouble) (p->maxaz / (p->y0 - p->ymax));
-    *y = (gdouble) (p->y0 - az / dpp);
+    pts = goo_canvas_points_new(norm->num_points);
+    for (i = 0; i < 2 * norm->num_points; i += 2)
+    {
+        pts->coords[i] = norm->coords[i];
+        pts->coords[i + 1] = norm->coords[i + 1];
+        cairo_matrix_transform_point(matrix, &pts->coords[i],
+                                     &pts->coords[i + 1]);
+    }
+    g_object_set(graph, "points", pts, NULL);
+    goo_canvas_points_unref(pts);
 }
 
-static void el_to_xy(GtkAzelPlot * p, gdouble t, gdouble el, gdouble * x,
-                     gdouble * y)
+/*
+ * Map the Az and El graphs to the plot area.
+ *
+ * The graphs are kept with time and angle normalized to [0;1], so only the
+ * mapping to the plot area needs to be redone when the plot is resized. The
+ * points are mapped here rather than by an item transform because the
+ * canvas would stroke the lines under the non-uniform scale too.
+ */
+static void update_graphs(GtkAzelPlot * p)
 {
-    gdouble         tpp;        /* time per pixel */
-    gdouble         dpp;        /* degrees per pixel */
+    cairo_matrix_t  matrix;
 
-    /* time */
-    tpp = (p->pass->los - p->pass->aos) / (p->xmax - p->x0);
-    *x = p->x0 + (t - p->pass->aos) / tpp;
+    cairo_matrix_init(&matrix, (gdouble) p->xmax - p->x0, 0.0, 0.0,
+                      -((gdouble) p->y0 - p->ymax), p->x0, p->y0);
 
-    /* Az */
-    dpp = (gdouble) (90.0 / (p->y0 - p->ymax));
-    *y = (gdouble) (p->y0 - el / dpp);
+    map_graph(p->azg, p->azpts, &matrix);
+    map_graph(p->elg, p->elpts, &matrix);
 }
 
 /**
@@ -151,10 +172,8 @@ static void size_allocate_cb(GtkWidget * widget, GtkAllocation * allocation,
 {
     GtkAzelPlot    *azel;
     GooCanvasPoints *pts;
-    gdouble         dx, dy;
     gdouble         xstep, ystep;
-    guint           i, n;
-    pass_detail_t  *detail;
+    guint           i;
 
     if (gtk_widget_get_realized(widget))
     {
@@ -253,37 +272,8 @@ static void size_allocate_cb(GtkWidget * widget, GtkAllocation * allocation,
                      "x", (gfloat) (azel->x0 + (azel->xmax - azel->x0) / 2),
                      "y", (gfloat) (azel->height - 5), NULL);
 
-        /* Az graph */
-        n = g_slist_length(azel->pass->details);
-        pts = goo_canvas_points_new(n);
-
-        for (i = 0; i < n; i++)
-        {
-            detail = PASS_DETAIL(g_slist_nth_data(azel->pass->details, i));
-            az_to_xy(azel, detail->time, detail->az, &dx, &dy);
-            pts->coords[2 * i] = dx;
-            pts->coords[2 * i + 1] = dy;
-        }
-        pts->coords[0] = azel->x0;
-        pts->coords[2 * n - 2] = azel->xmax;
-        g_object_set(azel->azg, "points", pts, NULL);
-        goo_canvas_points_unref(pts);
-
-        /* El graph */
-        n = g_slist_length(azel->pass->details);
-        pts = goo_canvas_points_new(n);
-
-        for (i = 0; i < n; i++)
-        {
-            detail = PASS_DETAIL(g_slist_nth_data(azel->pass->details, i));
-            el_to_xy(azel, detail->time, detail->el, &dx, &dy);
-            pts->coords[2 * i] = dx;
-            pts->coords[2 * i + 1] = dy;
-        }
-        pts->coords[1] = azel->y0;
-        pts->coords[2 * n - 1] = azel->y0;
-        g_object_set(azel->elg, "points", pts, NULL);
-        goo_canvas_points_unref(pts);
+        /* Az and El graphs */
+        update_graphs(azel);
 
         /* cursor track */
         g_object_set(azel->curs,
@@ -405,6 +395,72 @@ static void on_canvas_realized(GtkWidget * canvas, gpointer data)
 
 }
 
+/*
+ * Create the Az and El graphs.
+ *
+ * Time is normalized to the duration of the pass, Az to maxaz and El to 90
+ * degrees. The graphs are mapped to the canvas by update_graphs().
+ */
+static void create_graphs(GtkAzelPlot * azel, GooCanvasItemModel * root)
+{
+    GooCanvasPoints *azpts, *elpts;
+    GSList         *node;
+    pass_detail_t  *detail;
+    gdouble         x, duration;
+    guint           i, n;
+
+    n = g_slist_length(azel->pass->details);
+    azpts = goo_canvas_points_new(n);
+    elpts = goo_canvas_points_new(n);
+    duration = azel->pass->los - azel->pass->aos;
+
+    for (node = azel->pass->details, i = 0; node != NULL;
+         node = node->next, i++)
+    {
+        detail = PASS_DETAIL(node->data);
+        x = (duration > 0.0) ? (detail->time - azel->pass->aos) / duration :
+            0.0;
+
+        azpts->coords[2 * i] = x;
+        azpts->coords[2 * i + 1] = detail->az / azel->maxaz;
+        elpts->coords[2 * i] = x;
+        elpts->coords[2 * i + 1] = detail->el / 90.0;
+    }
+
+    if (n > 0)
+    {
+        /* Az graph spans the whole time axis */
+        azpts->coords[0] = 0.0;
+        azpts->coords[2 * n - 2] = 1.0;
+
+        /* El graph starts and ends at 0 deg */
+        elpts->coords[1] = 0.0;
+        elpts->coords[2 * n - 1] = 0.0;
+    }
+
+    azel->azpts = azpts;
+    azel->elpts = elpts;
+
+    azel->azg = goo_canvas_polyline_model_new(root, FALSE, 0,
+                                              "points", azpts,
+                                              "line-width", 1.0,
+                                              "stroke-color-rgba", 0x0000BFFF,
+                                              "line-cap",
+                                              CAIRO_LINE_CAP_SQUARE,
+                                              "line-join",
+                                              CAIRO_LINE_JOIN_MITER, NULL);
+
+    azel->elg = goo_canvas_polyline_model_new(root, FALSE, 0,
+                                              "points", elpts,
+                                              "line-width", 1.0,
+                                              "stroke-color-rgba", 0xBF0000FF,
+                                              "fill-color-rgba", 0xBF00001A,
+                                              "line-cap",
+                                              CAIRO_LINE_CAP_SQUARE,
+                                              "line-join",
+                                              CAIRO_LINE_JOIN_MITER, NULL);
+}
+
 static GooCanvasItemModel *create_canvas_model(GtkAzelPlot * azel)
 {
     GooCanvasItemModel *root;
@@ -587,20 +643,9 @@ static GooCanvasItemModel *create_canvas_model(GtkAzelPlot * azel)
                          "font", "Sans 9",
                          "fill-color-rgba", 0xBF0000FF, NULL);
 
-    /* Az graph */
-    azel->azg = MKLINE(root, 0, 0, 10, 10,
-                       "stroke-color-rgba", 0x0000BFFF,
-                       "line-cap", CAIRO_LINE_CAP_SQUARE,
-                       "line-join", CAIRO_LINE_JOIN_MITER,
-                       "line-width", 1.0, NULL);
-
-    /* El graph */
-    azel->elg = MKLINE(root, 30, 30, 40, 40,
-                       "stroke-color-rgba", 0xBF0000FF,
-                       "fill-color-rgba", 0xBF00001A,
-                       "line-cap", CAIRO_LINE_CAP_SQUARE,
-                       "line-join", CAIRO_LINE_JOIN_MITER,
-                       "line-width", 1.0, NULL);
+    /* Az and El graphs */
+    create_graphs(azel, root);
+    update_graphs(azel);
 
     return root;
 }
@@ -615,7 +660,7 @@ GtkWidget      *gtk_azel_plot_new(qth_t * qth, pass_t * pass)
 {
     GtkAzelPlot    *azel;
     GooCanvasItemModel *root;
-    guint           i, n;
+    GSList         *node;
     pass_detail_t  *detail;
 
     azel = GTK_AZEL_PLOT(g_object_new(GTK_TYPE_AZEL_PLOT, NULL));
@@ -628,10 +673,9 @@ GtkWidget      *gtk_azel_plot_new(qth_t * qth, pass_t * pass)
     azel->cursinfo = TRUE;
 
     /* check maximum Az */
-    n = g_slist_length(pass->details);
-    for (i = 0; i < n; i++)
+    for (node = pass->details; node != NULL; node = node->next)
     {
-        detail = PASS_DETAIL(g_slist_nth_data(pass->details, i));
+        detail = PASS_DETAIL(node->data);
 
         if (detail->az > azel->maxaz)
         {
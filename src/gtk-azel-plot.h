@@ -63,6 +63,8 @@ struct _GtkAzelPlot {
     GooCanvasItemModel *frame;  /*!< frame */
     GooCanvasItemModel *azg;    /*!< Az graph */
     GooCanvasItemModel *elg;    /*!< El graph */
+    GooCanvasPoints *azpts;     /*!< Az graph normalized to [0;1] */
+    GooCanvasPoints *elpts;     /*!< El graph normalized to [0;1] */
     GooCanvasItemModel *xticksb[AZEL_PLOT_NUM_TICKS];   /*!< x tick marks bottom */
     GooCanvasItemModel *xtickst[AZEL_PLOT_NUM_TICKS];   /*!< x tick marks top */
     GooCanvasItemModel *xlabels[AZEL_PLOT_NUM_TICKS];   /*!< x tick labels */
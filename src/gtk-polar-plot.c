@@ -76,10 +76,19 @@ static void gtk_polar_plot_init(GtkPolarPlot * polview)
     polview->cursinfo = FALSE;
     polview->extratick = FALSE;
     polview->target = NULL;
+    polview->ctrl = NULL;
+    polview->rotor = NULL;
+    polview->markers_idle = 0;
 }
 
 static void gtk_polar_plot_destroy(GtkWidget * widget)
 {
+    if (GTK_POLAR_PLOT(widget)->markers_idle > 0)
+    {
+        g_source_remove(GTK_POLAR_PLOT(widget)->markers_idle);
+        GTK_POLAR_PLOT(widget)->markers_idle = 0;
+    }
+
     if (GTK_POLAR_PLOT(widget)->pass != NULL)
     {
         free_pass(GTK_POLAR_PLOT(widget)->pass);
@@ -123,8 +132,14 @@ GType gtk_polar_plot_get_type()
     return gtk_polar_plot_type;
 }
 
+/*
+ * Create a time tick.
+ *
+ * The tick is placed at (x,y) on a plot with unit radius centered at (0,0).
+ * Its canvas position is set by update_track().
+ */
 static GooCanvasItemModel *create_time_tick(GtkPolarPlot * pv, gdouble time,
-                                            gfloat x, gfloat y)
+                                            gdouble x, gdouble y)
 {
     GooCanvasItemModel *item;
     GooCanvasAnchorType     anchor;
@@ -138,19 +153,13 @@ static GooCanvasItemModel *create_time_tick(GtkPolarPlot * pv, gdouble time,
 
     daynum_to_str(buff, 6, "%H:%M", time);
 
-    if (x > pv->cx)
-    {
+    if (x > 0.0)
         anchor = GOO_CANVAS_ANCHOR_EAST;
-        x -= 5;
-    }
     else
-    {
         anchor = GOO_CANVAS_ANCHOR_WEST;
-        x += 5;
-    }
 
     item = goo_canvas_text_model_new(root, buff,
-                                     (gdouble) x, (gdouble) y,
+                                     pv->cx + pv->r * x, pv->cy + pv->r * y,
                                      -1, anchor,
                                      "font", "Sans 7",
                                      "fill-color-rgba", col, NULL);
@@ -158,27 +167,22 @@ static GooCanvasItemModel *create_time_tick(GtkPolarPlot * pv, gdouble time,
     return item;
 }
 
-/** Convert Az/El to canvas based XY coordinates. */
-static void azel_to_xy(GtkPolarPlot * p, gdouble az, gdouble el,
-                       gfloat * x, gfloat * y)
+/**
+ * Convert Az/El to XY coordinates on a plot with unit radius.
+ *
+ * The plot is centered at (0,0) and y grows downwards like on the canvas.
+ */
+static void azel_to_unit(GtkPolarPlot * p, gdouble az, gdouble el,
+                         gdouble * x, gdouble * y)
 {
     gdouble         rel;
 
-    if (el < 0.0)
-    {
-        /* FIXME: generate bug report */
-        *x = 0.0;
-        *y = 0.0;
-
-        return;
-    }
-
     /* convert angles to radians */
     az = de2ra * az;
     el = de2ra * el;
 
     /* radius @ el */
-    rel = p->r - (2 * p->r * el) / M_PI;
+    rel = 1.0 - (2.0 * el) / M_PI;
 
     switch (p->swap)
     {
@@ -198,8 +202,28 @@ static void azel_to_xy(GtkPolarPlot * p, gdouble az, gdouble el,
         break;
     }
 
-    *x = (gfloat) (p->cx + rel * sin(az));
-    *y = (gfloat) (p->cy - rel * cos(az));
+    *x = rel * sin(az);
+    *y = -rel * cos(az);
+}
+
+/** Convert Az/El to canvas based XY coordinates. */
+static void azel_to_xy(GtkPolarPlot * p, gdouble az, gdouble el,
+                       gfloat * x, gfloat * y)
+{
+    gdouble         ux, uy;
+
+    if (el < 0.0)
+    {
+        /* FIXME: generate bug report */
+        *x = 0.0;
+        *y = 0.0;
+
+        return;
+    }
+
+    azel_to_unit(p, az, el, &ux, &uy);
+    *x = (gfloat) (p->cx + p->r * ux);
+    *y = (gfloat) (p->cy + p->r * uy);
 }
 
 /** Convert canvas based coordinates to Az/El. */
@@ -251,14 +275,24 @@ static void xy_to_azel(GtkPolarPlot * p, gfloat x, gfloat y,
     }
 }
 
+static void     update_track(GtkPolarPlot * pv);
+
+/*
+ * Create the sky track and the time ticks.
+ *
+ * The track is computed once for a plot with unit radius and mapped to the
+ * canvas by the transformation set in update_track(), so resizing the plot
+ * does not depend on the number of points in the pass.
+ */
 static void create_track(GtkPolarPlot * pv)
 {
     guint           i;
     GooCanvasItemModel *root;
     pass_detail_t  *detail;
+    GSList         *node;
     guint           num;
     GooCanvasPoints *points;
-    gfloat          x, y;
+    gdouble         x, y;
     guint32         col;
     guint           tres, ttidx;
 
@@ -270,52 +304,62 @@ static void create_track(GtkPolarPlot * pv)
     /* time resolution for time ticks; we need
        3 additional points to AOS and LOS ticks.
      */
-    tres = (num - 2) / (TRACK_TICK_NUM - 1);
+    tres = MAX(1, (num - 2) / (TRACK_TICK_NUM - 1));
 
     points = goo_canvas_points_new(num);
 
     /* first point should be (aos_az,0.0) */
-    azel_to_xy(pv, pv->pass->aos_az, 0.0, &x, &y);
-    points->coords[0] = (double)x;
-    points->coords[1] = (double)y;
+    azel_to_unit(pv, pv->pass->aos_az, 0.0, &x, &y);
+    points->coords[0] = x;
+    points->coords[1] = y;
+    pv->trtickx[0] = x;
+    pv->trticky[0] = y;
     pv->trtick[0] = create_time_tick(pv, pv->pass->aos, x, y);
 
     ttidx = 1;
 
+    node = pv->pass->details;
     for (i = 1; i < num - 1; i++)
     {
-        detail = PASS_DETAIL(g_slist_nth_data(pv->pass->details, i));
+        node = node->next;
+        detail = PASS_DETAIL(node->data);
         if (detail->el >= 0.0)
-            azel_to_xy(pv, detail->az, detail->el, &x, &y);
-        points->coords[2 * i] = (double)x;
-        points->coords[2 * i + 1] = (double)y;
+            azel_to_unit(pv, detail->az, detail->el, &x, &y);
+        points->coords[2 * i] = x;
+        points->coords[2 * i + 1] = y;
 
         if (!(i % tres))
         {
             if (ttidx < TRACK_TICK_NUM)
+            {
                 /* create a time tick */
+                pv->trtickx[ttidx] = x;
+                pv->trticky[ttidx] = y;
                 pv->trtick[ttidx] = create_time_tick(pv, detail->time, x, y);
+            }
             ttidx++;
         }
     }
 
     /* last point should be (los_az, 0.0)  */
-    azel_to_xy(pv, pv->pass->los_az, 0.0, &x, &y);
-    points->coords[2 * (num - 1)] = (double)x;
-    points->coords[2 * (num - 1) + 1] = (double)y;
+    azel_to_unit(pv, pv->pass->los_az, 0.0, &x, &y);
+    points->coords[2 * (num - 1)] = x;
+    points->coords[2 * (num - 1) + 1] = y;
 
     /* create poly-line */
     col = sat_cfg_get_int(SAT_CFG_INT_POLAR_TRACK_COL);
 
     pv->track = goo_canvas_polyline_model_new(root, FALSE, 0,
                                               "points", points,
-                                              "line-width", 1.0,
                                               "stroke-color-rgba", col,
                                               "line-cap",
                                               CAIRO_LINE_CAP_SQUARE,
                                               "line-join",
                                               CAIRO_LINE_JOIN_MITER, NULL);
     goo_canvas_points_unref(points);
+
+    /* map track to canvas */
+    update_track(pv);
 }
 
 /**
@@ -522,65 +566,31 @@ static GooCanvasItemModel *create_canvas_model(GtkPolarPlot * polv)
 /** Update sky track drawing after size allocate. */
 static void update_track(GtkPolarPlot * pv)
 {
-    guint           num, i;
-    GooCanvasPoints *points;
-    gfloat          x, y;
-    pass_detail_t  *detail;
-    guint           tres, ttidx;
-
-    /* create points */
-    num = g_slist_length(pv->pass->details);
-
-    points = goo_canvas_points_new(num);
-
-    /* first point should be (aos_az,0.0) */
-    azel_to_xy(pv, pv->pass->aos_az, 0.0, &x, &y);
-    points->coords[0] = (double)x;
-    points->coords[1] = (double)y;
+    cairo_matrix_t  matrix;
+    gdouble         r = MAX(pv->r, 1);
+    gdouble         x;
+    guint           i;
 
-    /* time tick 0 */
-    g_object_set(pv->trtick[0], "x", (gdouble) x, "y", (gdouble) y, NULL);
+    /* scale unit circle to the plot; line width is scaled too */
+    cairo_matrix_init(&matrix, r, 0.0, 0.0, r, pv->cx, pv->cy);
+    goo_canvas_item_model_set_transform(pv->track, &matrix);
+    g_object_set(pv->track, "line-width", 1.0 / r, NULL);
 
-    /* time resolution for time ticks; we need
-       3 additional points to AOS and LOS ticks.
-     */
-    tres = (num - 2) / (TRACK_TICK_NUM - 1);
-    ttidx = 1;
-
-    for (i = 1; i < num - 1; i++)
+    for (i = 0; i < TRACK_TICK_NUM; i++)
     {
-        detail = PASS_DETAIL(g_slist_nth_data(pv->pass->details, i));
-        if (detail->el >= 0.0)
-            azel_to_xy(pv, detail->az, detail->el, &x, &y);
-        points->coords[2 * i] = (double)x;
-        points->coords[2 * i + 1] = (double)y;
+        if (pv->trtick[i] == NULL)
+            continue;
 
-        if (!(i % tres))
-        {
-            /* make room between text and track */
-            if (x > pv->cx)
-                x -= 5;
-            else
-                x += 5;
+        /* make room between text and track */
+        x = pv->cx + r * pv->trtickx[i];
+        if (pv->trtickx[i] > 0.0)
+            x -= 5;
+        else
+            x += 5;
 
-            /* update time tick */
-            if (ttidx < TRACK_TICK_NUM)
-            {
-                g_object_set(pv->trtick[ttidx],
-                             "x", (gdouble) x, "y", (gdouble) y, NULL);
-            }
-            ttidx++;
-        }
+        g_object_set(pv->trtick[i], "x", x,
+                     "y", pv->cy + r * pv->trticky[i], NULL);
     }
-
-    /* last point should be (los_az, 0.0)  */
-    azel_to_xy(pv, pv->pass->los_az, 0.0, &x, &y);
-    points->coords[2 * (num - 1)] = (double)x;
-    points->coords[2 * (num - 1) + 1] = (double)y;
-
-    g_object_set(pv->track, "points", points, NULL);
-
-    goo_canvas_points_unref(points);
 }
 
 /**
@@ -833,6 +843,7 @@ void gtk_polar_plot_set_pass(GtkPolarPlot * plot, pass_t * pass)
             idx = goo_canvas_item_model_find_child(root, plot->trtick[i]);
             if (idx != -1)
                 goo_canvas_item_model_remove_child(root, idx);
+            plot->trtick[i] = NULL;
         }
 
         free_pass(plot->pass);
@@ -846,124 +857,210 @@ void gtk_polar_plot_set_pass(GtkPolarPlot * plot, pass_t * pass)
     }
 }
 
-/**
- * Set target object position
+/* Remove a marker from the canvas. */
+static void remove_marker(GtkPolarPlot * plot, GooCanvasItemModel ** item)
+{
+    GooCanvasItemModel *root;
+    gint            idx;
+
+    if (*item == NULL)
+        return;
+
+    root = goo_canvas_get_root_item_model(GOO_CANVAS(plot->canvas));
+    idx = goo_canvas_item_model_find_child(root, *item);
+    if (idx != -1)
+        goo_canvas_item_model_remove_child(root, idx);
+
+    *item = NULL;
+}
+
+/* Create the rotor marker, a cross hair centered at (0,0). */
+static GooCanvasItemModel *create_rotor_marker(GooCanvasItemModel * root,
+                                               guint32 col)
+{
+    GooCanvasItemModel *group;
+    static const gdouble lines[4][4] = {
+        {0, -4, 0, -14},
+        {4, 0, 14, 0},
+        {0, 4, 0, 14},
+        {-4, 0, -14, 0}
+    };
+    guint           i;
+
+    group = goo_canvas_group_model_new(root, NULL);
+
+    for (i = 0; i < 4; i++)
+    {
+        goo_canvas_polyline_model_new_line(group,
+                                           lines[i][0], lines[i][1],
+                                           lines[i][2], lines[i][3],
+                                           "fill-color-rgba", col,
+                                           "stroke-color-rgba", col,
+                                           "line-width", 1.0, NULL);
+    }
+
+    return group;
+}
+
+/*
+ * Apply pending marker changes to the canvas.
  *
- * @param plot Pointer to the GtkPolarPlot widget
- * @param az Azimuth of the target object
- * @param el Elevation of the target object
- * 
- * If either az or el are negative the target object will be hidden
+ * The markers are drawn around (0,0) and moved by setting their transformation,
+ * so moving a marker only changes one canvas item.
  */
-void gtk_polar_plot_set_target_pos(GtkPolarPlot * plot, gdouble az, gdouble el)
+static gboolean update_markers(gpointer data)
 {
+    GtkPolarPlot   *plot = GTK_POLAR_PLOT(data);
     GooCanvasItemModel *root;
-    gint            idx;
-    gfloat          x, y;
     guint32         col;
 
-    if (plot == NULL)
-        return;
+    plot->markers_idle = 0;
 
     root = goo_canvas_get_root_item_model(GOO_CANVAS(plot->canvas));
+    col = sat_cfg_get_int(SAT_CFG_INT_POLAR_SAT_COL);
 
-    if ((az < 0.0) || (el < 0.0))
+    if (plot->mtarget.dirty)
     {
-        if (plot->target != NULL)
+        plot->mtarget.dirty = FALSE;
+        if (!plot->mtarget.show)
         {
-            /* the target object is visible; delete it */
-            idx = goo_canvas_item_model_find_child(root, plot->target);
-            if (idx != -1)
-                goo_canvas_item_model_remove_child(root, idx);
-
-            plot->target = NULL;
+            remove_marker(plot, &plot->target);
+        }
+        else
+        {
+            if (plot->target == NULL)
+                plot->target = goo_canvas_rect_model_new(root,
+                                                         -MARKER_SIZE_HALF,
+                                                         -MARKER_SIZE_HALF,
+                                                         2 * MARKER_SIZE_HALF,
+                                                         2 * MARKER_SIZE_HALF,
+                                                         "fill-color-rgba",
+                                                         col,
+                                                         "stroke-color-rgba",
+                                                         col, NULL);
+            goo_canvas_item_model_set_simple_transform(plot->target,
+                                                       plot->mtarget.x,
+                                                       plot->mtarget.y,
+                                                       1.0, 0.0);
         }
-        /* else the target object is not visible; nothing to do */
     }
-    else
+
+    if (plot->mctrl.dirty)
     {
-        /* we need to either update or create the object */
-        azel_to_xy(plot, az, el, &x, &y);
+        plot->mctrl.dirty = FALSE;
+        if (!plot->mctrl.show)
+        {
+            remove_marker(plot, &plot->ctrl);
+        }
+        else
+        {
+            if (plot->ctrl == NULL)
+                plot->ctrl = goo_canvas_ellipse_model_new(root,
+                                                          0, 0, 7, 7,
+                                                          "fill-color-rgba",
+                                                          0xFF00000F,
+                                                          "stroke-color-rgba",
+                                                          col,
+                                                          "line-width", 0.8,
+                                                          NULL);
+            goo_canvas_item_model_set_simple_transform(plot->ctrl,
+                                                       plot->mctrl.x,
+                                                       plot->mctrl.y,
+                                                       1.0, 0.0);
+        }
+    }
 
-        if (plot->target != NULL)
+    if (plot->mrotor.dirty)
+    {
+        plot->mrotor.dirty = FALSE;
+        if (!plot->mrotor.show)
         {
-            /* the target object already exists; move it */
-            g_object_set(plot->target,
-                         "x", x - MARKER_SIZE_HALF,
-                         "y", y - MARKER_SIZE_HALF, NULL);
+            remove_marker(plot, &plot->rotor);
         }
         else
         {
-            /* the target object does not exist; create it */
-            col = sat_cfg_get_int(SAT_CFG_INT_POLAR_SAT_COL);
-            plot->target = goo_canvas_rect_model_new(root,
-                                                     x - MARKER_SIZE_HALF,
-                                                     y - MARKER_SIZE_HALF,
-                                                     2 * MARKER_SIZE_HALF,
-                                                     2 * MARKER_SIZE_HALF,
-                                                     "fill-color-rgba", col,
-                                                     "stroke-color-rgba", col,
-                                                     NULL);
+            if (plot->rotor == NULL)
+                plot->rotor = create_rotor_marker(root, col);
+            goo_canvas_item_model_set_simple_transform(plot->rotor,
+                                                       plot->mrotor.x,
+                                                       plot->mrotor.y,
+                                                       1.0, 0.0);
         }
     }
+
+    return FALSE;
 }
 
-/**
- * Set controller object position
+/*
+ * Request a new marker position.
  *
- * @param plot Pointer to the GtkPolarPlot widget
- * @param az Azimuth of the controller object
- * @param el Elevation of the controller object
- * 
- * If either az or el are negative the controller object will be hidden
+ * Changes smaller than one pixel are ignored. Accepted changes are applied
+ * together for all markers before the canvas is redrawn.
  */
-void gtk_polar_plot_set_ctrl_pos(GtkPolarPlot * plot, gdouble az, gdouble el)
+static void set_marker(GtkPolarPlot * plot, polar_plot_marker_t * marker,
+                       gdouble az, gdouble el)
 {
-    GooCanvasItemModel *root;
-    gint            idx;
     gfloat          x, y;
-    guint32         col;
-
-    if (plot == NULL)
-        return;
-
-    root = goo_canvas_get_root_item_model(GOO_CANVAS(plot->canvas));
 
     if ((az < 0.0) || (el < 0.0))
     {
-        if (plot->ctrl != NULL)
-        {
-            /* the target object is visible; delete it */
-            idx = goo_canvas_item_model_find_child(root, plot->ctrl);
-            if (idx != -1)
-                goo_canvas_item_model_remove_child(root, idx);
+        /* the marker is not visible; nothing to do */
+        if (!marker->show)
+            return;
 
-            plot->ctrl = NULL;
-        }
-        /* else the target object is not visible; nothing to do */
+        marker->show = FALSE;
     }
     else
     {
-        /* we need to either update or create the object */
         azel_to_xy(plot, az, el, &x, &y);
 
-        if (plot->ctrl != NULL)
-        {
-            /* the target object already exists; move it */
-            g_object_set(plot->ctrl, "center_x", x, "center_y", y, NULL);
-        }
-        else
-        {
-            /* the target object does not exist; create it */
-            col = sat_cfg_get_int(SAT_CFG_INT_POLAR_SAT_COL);
-            plot->ctrl = goo_canvas_ellipse_model_new(root,
-                                                      x, y, 7, 7,
-                                                      "fill-color-rgba",
-                                                      0xFF00000F,
-                                                      "stroke-color-rgba", col,
-                                                      "line-width", 0.8, NULL);
-        }
+        if (marker->show && (fabs(x - marker->x) < 1.0) &&
+            (fabs(y - marker->y) < 1.0))
+            return;
+
+        marker->show = TRUE;
+        marker->x = x;
+        marker->y = y;
     }
+
+    marker->dirty = TRUE;
+    if (plot->markers_idle == 0)
+        plot->markers_idle = g_idle_add_full(G_PRIORITY_HIGH_IDLE,
+                                             update_markers, plot, NULL);
+}
+
+/**
+ * Set target object position
+ *
+ * @param plot Pointer to the GtkPolarPlot widget
+ * @param az Azimuth of the target object
+ * @param el Elevation of the target object
+ * 
+ * If either az or el are negative the target object will be hidden
+ */
+void gtk_polar_plot_set_target_pos(GtkPolarPlot * plot, gdouble az, gdouble el)
+{
+    if (plot == NULL)
+        return;
+
+    set_marker(plot, &plot->mtarget, az, el);
+}
+
+/**
+ * Set controller object position
+ *
+ * @param plot Pointer to the GtkPolarPlot widget
+ * @param az Azimuth of the controller object
+ * @param el Elevation of the controller object
+ * 
+ * If either az or el are negative the controller object will be hidden
+ */
+void gtk_polar_plot_set_ctrl_pos(GtkPolarPlot * plot, gdouble az, gdouble el)
+{
+    if (plot == NULL)
+        return;
+
+    set_marker(plot, &plot->mctrl, az, el);
 }
 
 /**
@@ -977,155 +1074,10 @@ void gtk_polar_plot_set_ctrl_pos(GtkPolarPlot * plot, gdouble az, gdouble el)
  */
 void gtk_polar_plot_set_rotor_pos(GtkPolarPlot * plot, gdouble az, gdouble el)
 {
-    GooCanvasItemModel *root;
-    GooCanvasPoints *prec;
-    gint            idx;
-    gfloat          x, y;
-    guint32         col;
-
     if (plot == NULL)
         return;
 
-    root = goo_canvas_get_root_item_model(GOO_CANVAS(plot->canvas));
-
-    if ((az < 0.0) || (el < 0.0))
-    {
-        if (plot->rot1 != NULL)
-        {
-            /* the target object is visible; delete it */
-            idx = goo_canvas_item_model_find_child(root, plot->rot1);
-            if (idx != -1)
-                goo_canvas_item_model_remove_child(root, idx);
-
-            plot->rot1 = NULL;
-        }
-        if (plot->rot2 != NULL)
-        {
-            /* the target object is visible; delete it */
-            idx = goo_canvas_item_model_find_child(root, plot->rot2);
-            if (idx != -1)
-                goo_canvas_item_model_remove_child(root, idx);
-
-            plot->rot2 = NULL;
-        }
-        if (plot->rot3 != NULL)
-        {
-            /* the target object is visible; delete it */
-            idx = goo_canvas_item_model_find_child(root, plot->rot3);
-            if (idx != -1)
-                goo_canvas_item_model_remove_child(root, idx);
-
-            plot->rot3 = NULL;
-        }
-        if (plot->rot4 != NULL)
-        {
-            /* the target object is visible; delete it */
-            idx = goo_canvas_item_model_find_child(root, plot->rot4);
-            if (idx != -1)
-                goo_canvas_item_model_remove_child(root, idx);
-
-            plot->rot4 = NULL;
-        }
-    }
-    else
-    {
-        /* we need to either update or create the object */
-        azel_to_xy(plot, az, el, &x, &y);
-        col = sat_cfg_get_int(SAT_CFG_INT_POLAR_SAT_COL);
-
-        if (plot->rot1 != NULL)
-        {
-            /* the target object already exists; move it */
-            prec = goo_canvas_points_new(2);
-            prec->coords[0] = x;
-            prec->coords[1] = y - 4;
-            prec->coords[2] = x;
-            prec->coords[3] = y - 14;
-            g_object_set(plot->rot1, "points", prec, NULL);
-            goo_canvas_points_unref(prec);
-        }
-        else
-        {
-            /* the target object does not exist; create it */
-            plot->rot1 = goo_canvas_polyline_model_new_line(root,
-                                                            x, y - 4, x,
-                                                            y - 14,
-                                                            "fill-color-rgba",
-                                                            col,
-                                                            "stroke-color-rgba",
-                                                            col, "line-width",
-                                                            1.0, NULL);
-        }
-        if (plot->rot2 != NULL)
-        {
-            /* the target object already exists; move it */
-            prec = goo_canvas_points_new(2);
-            prec->coords[0] = x + 4;
-            prec->coords[1] = y;
-            prec->coords[2] = x + 14;
-            prec->coords[3] = y;
-            g_object_set(plot->rot2, "points", prec, NULL);
-            goo_canvas_points_unref(prec);
-        }
-        else
-        {
-            /* the target object does not exist; create it */
-            plot->rot2 = goo_canvas_polyline_model_new_line(root,
-                                                            x + 4, y, x + 14,
-                                                            y,
-                                                            "fill-color-rgba",
-                                                            col,
-                                                            "stroke-color-rgba",
-                                                            col, "line-width",
-                                                            1.0, NULL);
-        }
-        if (plot->rot3 != NULL)
-        {
-            /* the target object already exists; move it */
-            prec = goo_canvas_points_new(2);
-            prec->coords[0] = x;
-            prec->coords[1] = y + 4;
-            prec->coords[2] = x;
-            prec->coords[3] = y + 14;
-            g_object_set(plot->rot3, "points", prec, NULL);
-            goo_canvas_points_unref(prec);
-        }
-        else
-        {
-            /* the target object does not exist; create it */
-            plot->rot3 = goo_canvas_polyline_model_new_line(root,
-                                                            x, y + 4, x,
-                                                            y + 14,
-                                                            "fill-color-rgba",
-                                                            col,
-                                                            "stroke-color-rgba",
-                                                            col, "line-width",
-                                                            1.0, NULL);
-        }
-        if (plot->rot4 != NULL)
-        {
-            /* the target object already exists; move it */
-            prec = goo_canvas_points_new(2);
-            prec->coords[0] = x - 4;
-            prec->coords[1] = y;
-            prec->coords[2] = x - 14;
-            prec->coords[3] = y;
-            g_object_set(plot->rot4, "points", prec, NULL);
-            goo_canvas_points_unref(prec);
-        }
-        else
-        {
-            /* the target object does not exist; create it */
-            plot->rot4 = goo_canvas_polyline_model_new_line(root,
-                                                            x - 4, y, x - 14,
-                                                            y,
-                                                            "fill-color-rgba",
-                                                            col,
-                                                            "stroke-color-rgba",
-                                                            col, "line-width",
-                                                            1.0, NULL);
-        }
-    }
+    set_marker(plot, &plot->mrotor, az, el);
 }
 
 /**
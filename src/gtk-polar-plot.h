@@ -61,6 +61,14 @@ typedef enum {
     POLAR_PLOT_SWNE = 3
 } polar_plot_swap_t;
 
+/** Requested state of a position marker. */
+typedef struct {
+    gboolean        show;       /*!< Whether the marker is shown */
+    gfloat          x;          /*!< Canvas x of the marker */
+    gfloat          y;          /*!< Canvas y of the marker */
+    gboolean        dirty;      /*!< The canvas item needs to be updated */
+} polar_plot_marker_t;
+
 /* pole identifier */
 typedef enum {
     POLAR_PLOT_POLE_N = 0,
@@ -85,8 +93,15 @@ struct _GtkPolarPlot {
     GooCanvasItemModel *track;  /*!< Sky track. */
     GooCanvasItemModel *target; /*!< Target object marker */
     GooCanvasItemModel *ctrl;   /*!< Position marker for the controller */
-    GooCanvasItemModel *rot1, *rot2, *rot3, *rot4;      /*!< Position marker for the rotor */
+    GooCanvasItemModel *rotor;  /*!< Position marker for the rotor */
     GooCanvasItemModel *trtick[TRACK_TICK_NUM]; /*!< Time ticks along the sky track */
+    gdouble         trtickx[TRACK_TICK_NUM];    /*!< Time tick x for unit radius */
+    gdouble         trticky[TRACK_TICK_NUM];    /*!< Time tick y for unit radius */
+
+    polar_plot_marker_t mtarget;        /*!< Target object marker state */
+    polar_plot_marker_t mctrl;  /*!< Controller marker state */
+    polar_plot_marker_t mrotor; /*!< Rotor marker state */
+    guint           markers_idle;       /*!< Pending marker update or 0 */
 
     qth_t          *qth;        /*!< Pointer to current location. */
 
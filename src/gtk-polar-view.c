@@ -78,7 +78,15 @@ static void gtk_polar_view_load_showtracks(GtkPolarView * pv)
 
 static void gtk_polar_view_destroy(GtkWidget * widget)
 {
-    gtk_polar_view_store_showtracks(GTK_POLAR_VIEW(widget));
+    GtkPolarView   *polv = GTK_POLAR_VIEW(widget);
+
+    if (polv->tick_id != 0)
+    {
+        gtk_widget_remove_tick_callback(polv->canvas, polv->tick_id);
+        polv->tick_id = 0;
+    }
+
+    gtk_polar_view_store_showtracks(polv);
 
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
@@ -97,6 +105,7 @@ static void gtk_polar_view_init(GtkPolarView * polview)
     polview->sats = NULL;
     polview->qth = NULL;
     polview->obj = NULL;
+    polview->tick_id = 0;
     polview->naos = 0.0;
     polview->ncat = 0;
     polview->size = 0;
@@ -828,6 +837,65 @@ GtkWidget      *gtk_polar_view_new(GKeyFile * cfgdata, GHashTable * sats,
     return GTK_WIDGET(polv);
 }
 
+/* Move the marker and label of a satellite to its screen position */
+static void move_sat_obj(sat_obj_t * obj)
+{
+    g_object_set(obj->marker,
+                 "x", obj->motion.x - MARKER_SIZE_HALF,
+                 "y", obj->motion.y - MARKER_SIZE_HALF, NULL);
+    g_object_set(obj->label,
+                 "x", obj->motion.x, "y", obj->motion.y + 2, NULL);
+}
+
+/* Move a satellite to its last calculated position without motion */
+static void snap_sat_obj(gpointer key, gpointer value, gpointer data)
+{
+    sat_obj_t      *obj = SAT_OBJ(value);
+
+    (void)key;
+    (void)data;
+
+    marker_motion_reset(&obj->motion, obj->motion.x1, obj->motion.y1);
+    move_sat_obj(obj);
+}
+
+/* Move the satellites once per frame while they are in motion */
+static gboolean frame_tick_cb(GtkWidget * widget, GdkFrameClock * clock,
+                              gpointer data)
+{
+    GtkPolarView   *polv = GTK_POLAR_VIEW(data);
+    GHashTableIter  iter;
+    gpointer        value;
+    sat_obj_t      *obj;
+    gint64          frame_time;
+    gboolean        moving;
+    gboolean        active = FALSE;
+
+    if (marker_motion_visible(widget))
+    {
+        frame_time = gdk_frame_clock_get_frame_time(clock);
+
+        g_hash_table_iter_init(&iter, polv->obj);
+        while (g_hash_table_iter_next(&iter, NULL, &value))
+        {
+            obj = SAT_OBJ(value);
+            if (marker_motion_step(&obj->motion, frame_time, &moving))
+                move_sat_obj(obj);
+
+            active = active || moving;
+        }
+    }
+
+    /* restarted by the next data update */
+    if (!active)
+    {
+        polv->tick_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
 static void update_polv_size(GtkPolarView * polv)
 {
     GtkAllocation   allocation;
@@ -930,6 +998,7 @@ static void update_polv_size(GtkPolarView * polv)
                      "y", (gfloat) polv->cy + polv->r + POLV_LINE_EXTRA, NULL);
 
         g_hash_table_foreach(polv->sats, update_sat, polv);
+        g_hash_table_foreach(polv->obj, snap_sat_obj, NULL);
 
         /* sky tracks */
         g_hash_table_foreach(polv->obj, update_track, polv);
@@ -1178,14 +1247,27 @@ static void update_sat(gpointer key, gpointer value, gpointer data)
                                               sat->nickname,
                                               sat->az, sat->el, losstr);
 
-            g_object_set(obj->marker,
-                         "x", x - MARKER_SIZE_HALF,
-                         "y", y - MARKER_SIZE_HALF, "tooltip", tooltip, NULL);
-            g_object_set(obj->label,
-                         "x", x, "y", y + 2, "tooltip", tooltip, NULL);
+            g_object_set(obj->marker, "tooltip", tooltip, NULL);
+            g_object_set(obj->label, "tooltip", tooltip, NULL);
 
             g_free(tooltip);
 
+            /* the marker is moved by the frame clock */
+            if (marker_motion_visible(polv->canvas))
+            {
+                marker_motion_set(&obj->motion, x, y);
+                if (polv->tick_id == 0)
+                    polv->tick_id =
+                        gtk_widget_add_tick_callback(polv->canvas,
+                                                     frame_tick_cb, polv,
+                                                     NULL);
+            }
+            else
+            {
+                marker_motion_reset(&obj->motion, x, y);
+                move_sat_obj(obj);
+            }
+
             /* update selection info if satellite is
                selected
              */
@@ -1278,6 +1360,7 @@ static void update_sat(gpointer key, gpointer value, gpointer data)
                     obj->showtrack = polv->showtrack;
                 }
                 obj->istarget = FALSE;
+                marker_motion_reset(&obj->motion, x, y);
 
                 root =
                     goo_canvas_get_root_item_model(GOO_CANVAS(polv->canvas));
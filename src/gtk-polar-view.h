@@ -8,6 +8,7 @@
 #include <gtk/gtk.h>
 
 #include "gtk-sat-data.h"
+#include "marker-motion.h"
 #include "predict-tools.h"
 
 /* *INDENT-OFF* */
@@ -40,6 +41,7 @@ typedef struct {
     GooCanvasItemModel *label;  /*!< Item showing the satellite name. */
     GooCanvasItemModel *track;  /*!< Sky track. */
     GooCanvasItemModel *trtick[TRACK_TICK_NUM]; /*!< Time ticks along the sky track */
+    marker_motion_t motion;     /*!< Marker position between updates. */
 } sat_obj_t;
 
 #define SAT_OBJ(obj) ((sat_obj_t *)obj)
@@ -99,6 +101,7 @@ struct _GtkPolarView {
 
     guint           refresh;    /*!< Refresh rate. */
     guint           counter;    /*!< cycle counter. */
+    guint           tick_id;    /*!< Frame clock callback moving the markers. */
 
     polar_view_swap_t swap;
 
@@ -76,14 +76,18 @@ static void     exec_duplex_cycle(GtkRigCtrl * ctrl);
 static void     exec_duplex_tx_cycle(GtkRigCtrl * ctrl);
 static void     exec_dual_rig_cycle(GtkRigCtrl * ctrl);
 static gboolean check_aos_los(GtkRigCtrl * ctrl);
-static gboolean set_freq_simplex(GtkRigCtrl * ctrl, gint sock, gdouble freq);
-static gboolean get_freq_simplex(GtkRigCtrl * ctrl, gint sock, gdouble * freq);
-static gboolean set_freq_toggle(GtkRigCtrl * ctrl, gint sock, gdouble freq);
-static gboolean set_toggle(GtkRigCtrl * ctrl, gint sock);
-static gboolean unset_toggle(GtkRigCtrl * ctrl, gint sock);
-static gboolean get_freq_toggle(GtkRigCtrl * ctrl, gint sock, gdouble * freq);
-static gboolean get_ptt(GtkRigCtrl * ctrl, gint sock);
-static gboolean set_ptt(GtkRigCtrl * ctrl, gint sock, gboolean ptt);
+static gboolean set_freq_simplex(GtkRigCtrl * ctrl, rig_link_t * link,
+                                 gdouble freq);
+static gboolean get_freq_simplex(GtkRigCtrl * ctrl, rig_link_t * link,
+                                 gdouble * freq);
+static gboolean set_freq_toggle(GtkRigCtrl * ctrl, rig_link_t * link,
+                                gdouble freq);
+static gboolean set_toggle(GtkRigCtrl * ctrl, rig_link_t * link);
+static gboolean unset_toggle(GtkRigCtrl * ctrl, rig_link_t * link);
+static gboolean get_freq_toggle(GtkRigCtrl * ctrl, rig_link_t * link,
+                                gdouble * freq);
+static gboolean get_ptt(GtkRigCtrl * ctrl, rig_link_t * link);
+static gboolean set_ptt(GtkRigCtrl * ctrl, rig_link_t * link, gboolean ptt);
 
 /*  add thread for hamlib communication */
 gpointer        rigctl_run(gpointer data);
@@ -117,6 +121,7 @@ static void gtk_rig_ctrl_destroy(GtkWidget * widget)
     {
         g_free(ctrl->conf->name);
         g_free(ctrl->conf->host);
+        g_free(ctrl->conf->device);
         g_free(ctrl->conf);
         ctrl->conf = NULL;
     }
@@ -124,6 +129,7 @@ static void gtk_rig_ctrl_destroy(GtkWidget * widget)
     {
         g_free(ctrl->conf2->name);
         g_free(ctrl->conf2->host);
+        g_free(ctrl->conf2->device);
         g_free(ctrl->conf2);
         ctrl->conf2 = NULL;
     }
@@ -134,6 +140,18 @@ static void gtk_rig_ctrl_destroy(GtkWidget * widget)
         ctrl->trsplist = NULL;
     }
 
+    if (ctrl->pass != NULL)
+    {
+        free_pass(ctrl->pass);
+        ctrl->pass = NULL;
+    }
+
+    if (ctrl->pcache != NULL)
+    {
+        pass_cache_free(ctrl->pcache);
+        ctrl->pcache = NULL;
+    }
+
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
 
@@ -151,6 +169,7 @@ static void gtk_rig_ctrl_init(GtkRigCtrl * ctrl)
     ctrl->sats = NULL;
     ctrl->target = NULL;
     ctrl->pass = NULL;
+    ctrl->pcache = pass_cache_new();
     ctrl->qth = NULL;
     ctrl->conf = NULL;
     ctrl->conf2 = NULL;
@@ -159,8 +178,10 @@ static void gtk_rig_ctrl_init(GtkRigCtrl * ctrl)
     ctrl->trsplock = FALSE;
     ctrl->tracking = FALSE;
     ctrl->prev_ele = 0.0;
-    ctrl->sock = 0;
-    ctrl->sock2 = 0;
+    ctrl->link.sock = 0;
+    ctrl->link.hamlib = NULL;
+    ctrl->link2.sock = 0;
+    ctrl->link2.hamlib = NULL;
     g_mutex_init(&(ctrl->busy));
     ctrl->engaged = FALSE;
     ctrl->delay = 1000;
@@ -313,19 +334,21 @@ void gtk_rig_ctrl_update(GtkRigCtrl * ctrl, gdouble t)
         gtk_label_set_text(GTK_LABEL(ctrl->SatDopUp), buff);
         g_free(buff);
 
-        /* update next pass if necessary */
-        if (ctrl->pass != NULL)
+        /* update next pass if necessary; the pass is stale if it has
+           ended or if the target will not rise before it ends */
+        if ((ctrl->pass != NULL) &&
+            ((ctrl->pass->los < t) ||
+             ((ctrl->pass->aos > t) && (ctrl->target->aos > ctrl->pass->los))))
         {
-            if (ctrl->target->aos > ctrl->pass->aos)
-            {
-                free_pass(ctrl->pass);
-                ctrl->pass = get_next_pass(ctrl->target, ctrl->qth, 3.0);
-            }
+            free_pass(ctrl->pass);
+            ctrl->pass = NULL;
         }
-        else
+
+        if (ctrl->pass == NULL)
         {
-            /* we don't have any current pass; store the current one */
-            ctrl->pass = get_next_pass(ctrl->target, ctrl->qth, 3.0);
+            /* returns NULL until the pass cache has found the pass */
+            ctrl->pass = pass_cache_get(ctrl->pcache, ctrl->target,
+                                        ctrl->qth, t);
         }
     }
 
@@ -660,10 +683,12 @@ static void sat_selected_cb(GtkComboBox * satsel, gpointer data)
 
         ctrl->prev_ele = ctrl->target->el;
 
-        /* update next pass */
+        /* next pass is picked up from the pass cache on the next update */
         if (ctrl->pass != NULL)
+        {
             free_pass(ctrl->pass);
-        ctrl->pass = get_next_pass(ctrl->target, ctrl->qth, 3.0);
+            ctrl->pass = NULL;
+        }
 
         /* read transponders for new target */
         load_trsp_list(ctrl);
@@ -816,6 +841,7 @@ static void primary_rig_selected_cb(GtkComboBox * box, gpointer data)
     {
         g_free(ctrl->conf->name);
         g_free(ctrl->conf->host);
+        g_free(ctrl->conf->device);
         g_free(ctrl->conf);
     }
 
@@ -876,6 +902,7 @@ static void secondary_rig_selected_cb(GtkComboBox * box, gpointer data)
     {
         g_free(ctrl->conf2->name);
         g_free(ctrl->conf2->host);
+        g_free(ctrl->conf2->device);
         g_free(ctrl->conf2);
         ctrl->conf2 = NULL;
     }
@@ -1146,6 +1173,7 @@ static gboolean is_rig_tx_capable(const gchar * confname)
     if (radio_conf_read(conf))
     {
         cantx = (conf->type == RIG_TYPE_RX) ? FALSE : TRUE;
+        g_free(conf->device);
     }
     else
     {
@@ -1478,39 +1506,50 @@ static inline gboolean check_get_response(gchar * buffback, gboolean retcode,
     return retcode;
 }
 
-/* Setup VFOs for split operation (simplex or duplex) */
-static gboolean setup_split(GtkRigCtrl * ctrl)
+/* VFO name as used by rigctld and Hamlib, NULL if no VFO is selected */
+static const gchar *vfo_name(vfo_t vfo)
 {
-    gchar          *buff;
-    gchar           buffback[256];
-    gboolean        retcode;
-
-    switch (ctrl->conf->vfoUp)
+    switch (vfo)
     {
     case VFO_A:
-        buff = g_strdup("S 1 VFOA\x0a");
-        break;
+        return "VFOA";
 
     case VFO_B:
-        buff = g_strdup("S 1 VFOB\x0a");
-        break;
+        return "VFOB";
 
     case VFO_MAIN:
-        buff = g_strdup("S 1 Main\x0a");
-        break;
+        return "Main";
 
     case VFO_SUB:
-        buff = g_strdup("S 1 Sub\x0a");
-        break;
+        return "Sub";
 
     default:
+        return NULL;
+    }
+}
+
+/* Setup VFOs for split operation (simplex or duplex) */
+static gboolean setup_split(GtkRigCtrl * ctrl)
+{
+    gchar          *buff;
+    gchar           buffback[256];
+    gboolean        retcode;
+    const gchar    *txvfo;
+
+    txvfo = vfo_name(ctrl->conf->vfoUp);
+    if (txvfo == NULL)
+    {
         sat_log_log(SAT_LOG_LEVEL_ERROR,
                     _("%s called but TX VFO is %d."), __func__,
                     ctrl->conf->vfoUp);
         return FALSE;
     }
 
-    retcode = send_rigctld_command(ctrl, ctrl->sock, buff, buffback, 128);
+    if (ctrl->link.hamlib != NULL)
+        return hamlib_rig_set_split(ctrl->link.hamlib, TRUE, txvfo);
+
+    buff = g_strdup_printf("S 1 %s\x0a", txvfo);
+    retcode = send_rigctld_command(ctrl, ctrl->link.sock, buff, buffback, 128);
     g_free(buff);
 
     return (check_set_response(buffback, retcode, __func__));
@@ -1548,7 +1587,7 @@ static void exec_rx_cycle(GtkRigCtrl * ctrl)
 
     /* get PTT status */
     if (ctrl->engaged && ctrl->conf->ptt)
-        ptt = get_ptt(ctrl, ctrl->sock);
+        ptt = get_ptt(ctrl, &ctrl->link);
 
     /* Dial feedback:
        If radio device is engaged read frequency from radio and compare it to the
@@ -1560,7 +1599,7 @@ static void exec_rx_cycle(GtkRigCtrl * ctrl)
      */
     if ((ctrl->engaged) && (ctrl->lastrxf > 0.0) && (ptt == FALSE))
     {
-        if (!get_freq_simplex(ctrl, ctrl->sock, &readfreq))
+        if (!get_freq_simplex(ctrl, &ctrl->link, &readfreq))
         {
             /* error => use a passive value */
             ctrl->errcnt++;
@@ -1625,7 +1664,7 @@ static void exec_rx_cycle(GtkRigCtrl * ctrl)
     if ((ctrl->engaged) && (ptt == FALSE) &&
         (fabs(ctrl->lastrxf - tmpfreq) >= 1.0))
     {
-        if (set_freq_simplex(ctrl, ctrl->sock, tmpfreq))
+        if (set_freq_simplex(ctrl, &ctrl->link, tmpfreq))
         {
             /* reset error counter */
             ctrl->errcnt = 0;
@@ -1637,7 +1676,7 @@ static void exec_rx_cycle(GtkRigCtrl * ctrl)
                the tuning step is larger than what we work with (e.g. FT-817 has a
                smallest tuning step of 10 Hz). Therefore we read back the actual
                frequency from the rig. */
-            get_freq_simplex(ctrl, ctrl->sock, &tmpfreq);
+            get_freq_simplex(ctrl, &ctrl->link, &tmpfreq);
             ctrl->lastrxf = tmpfreq;
 
             /* This is only effective in RIG_TYPE_TRX mode.
@@ -1672,7 +1711,7 @@ static void exec_tx_cycle(GtkRigCtrl * ctrl)
     /* get PTT status */
     if (ctrl->engaged && ctrl->conf->ptt)
     {
-        ptt = get_ptt(ctrl, ctrl->sock);
+        ptt = get_ptt(ctrl, &ctrl->link);
     }
 
     /* Dial feedback:
@@ -1685,7 +1724,7 @@ static void exec_tx_cycle(GtkRigCtrl * ctrl)
      */
     if ((ctrl->engaged) && (ctrl->lasttxf > 0.0) && (ptt == TRUE))
     {
-        if (!get_freq_simplex(ctrl, ctrl->sock, &readfreq))
+        if (!get_freq_simplex(ctrl, &ctrl->link, &readfreq))
         {
             /* error => use a passive value */
             ctrl->errcnt++;
@@ -1748,7 +1787,7 @@ static void exec_tx_cycle(GtkRigCtrl * ctrl)
     if ((ctrl->engaged) && (ptt == TRUE) &&
         (fabs(ctrl->lasttxf - tmpfreq) >= 1.0))
     {
-        if (set_freq_simplex(ctrl, ctrl->sock, tmpfreq))
+        if (set_freq_simplex(ctrl, &ctrl->link, tmpfreq))
         {
             /* reset error counter */
             ctrl->errcnt = 0;
@@ -1760,7 +1799,7 @@ static void exec_tx_cycle(GtkRigCtrl * ctrl)
                the tuning step is larger than what we work with (e.g. FT-817 has a
                smallest tuning step of 10 Hz). Therefore we read back the actual
                frequency from the rig. */
-            get_freq_simplex(ctrl, ctrl->sock, &tmpfreq);
+            get_freq_simplex(ctrl, &ctrl->link, &tmpfreq);
             ctrl->lasttxf = tmpfreq;
 
             /* This is only effective in RIG_TYPE_TRX mode.
@@ -1845,7 +1884,7 @@ static void exec_toggle_tx_cycle(GtkRigCtrl * ctrl)
 
     if (ctrl->engaged && ctrl->conf->ptt)
     {
-        ptt = get_ptt(ctrl, ctrl->sock);
+        ptt = get_ptt(ctrl, &ctrl->link);
     }
 
     /* if we are in TX mode do nothing */
@@ -1860,7 +1899,7 @@ static void exec_toggle_tx_cycle(GtkRigCtrl * ctrl)
     /* if device is engaged, send freq command to radio */
     if ((ctrl->engaged) && (fabs(ctrl->lasttxf - tmpfreq) >= 10.0))
     {
-        if (set_freq_toggle(ctrl, ctrl->sock, tmpfreq))
+        if (set_freq_toggle(ctrl, &ctrl->link, tmpfreq))
         {
             /* reset error counter */
             ctrl->errcnt = 0;
@@ -1891,7 +1930,7 @@ static void exec_duplex_tx_cycle(GtkRigCtrl * ctrl)
      */
     if ((ctrl->engaged) && (ctrl->lasttxf > 0.0))
     {
-        if (!get_freq_toggle(ctrl, ctrl->sock, &readfreq))
+        if (!get_freq_toggle(ctrl, &ctrl->link, &readfreq))
         {
             /* error => use a passive value */
             readfreq = ctrl->lasttxf;
@@ -1959,7 +1998,7 @@ static void exec_duplex_tx_cycle(GtkRigCtrl * ctrl)
     /* if device is engaged, send freq command to radio */
     if ((ctrl->engaged) && (fabs(ctrl->lasttxf - tmpfreq) >= 1.0))
     {
-        if (set_freq_toggle(ctrl, ctrl->sock, tmpfreq))
+        if (set_freq_toggle(ctrl, &ctrl->link, tmpfreq))
         {
             /* reset error counter */
             ctrl->errcnt = 0;
@@ -1971,7 +2010,7 @@ static void exec_duplex_tx_cycle(GtkRigCtrl * ctrl)
                the tuning step is larger than what we work with (e.g. FT-817 has a
                smallest tuning step of 10 Hz). Therefore we read back the actual
                frequency from the rig. */
-            get_freq_toggle(ctrl, ctrl->sock, &tmpfreq);
+            get_freq_toggle(ctrl, &ctrl->link, &tmpfreq);
             ctrl->lasttxf = tmpfreq;
         }
         else
@@ -1996,7 +2035,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
     if (ctrl->engaged && (ctrl->lastrxf > 0.0))
     {
         /* get frequency from receiver */
-        if (!get_freq_simplex(ctrl, ctrl->sock, &readfreq))
+        if (!get_freq_simplex(ctrl, &ctrl->link, &readfreq))
         {
             /* error => use a passive value */
             readfreq = ctrl->lastrxf;
@@ -2052,7 +2091,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
         /* if device is engaged, send freq command to radio */
         if ((ctrl->engaged) && (fabs(ctrl->lasttxf - tmpfreq) >= 1.0))
         {
-            if (set_freq_simplex(ctrl, ctrl->sock2, tmpfreq))
+            if (set_freq_simplex(ctrl, &ctrl->link2, tmpfreq))
             {
                 /* reset error counter */
                 ctrl->errcnt = 0;
@@ -2061,7 +2100,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
                 g_usleep(WR_DEL);
 
                 /* The actual frequency migh be different from what we have set */
-                get_freq_simplex(ctrl, ctrl->sock2, &tmpfreq);
+                get_freq_simplex(ctrl, &ctrl->link2, &tmpfreq);
                 ctrl->lasttxf = tmpfreq;
             }
             else
@@ -2092,7 +2131,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
         /* if device is engaged, send freq command to radio */
         if ((ctrl->engaged) && (fabs(ctrl->lastrxf - tmpfreq) >= 1.0))
         {
-            if (set_freq_simplex(ctrl, ctrl->sock, tmpfreq))
+            if (set_freq_simplex(ctrl, &ctrl->link, tmpfreq))
             {
                 /* reset error counter */
                 ctrl->errcnt = 0;
@@ -2101,7 +2140,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
                 g_usleep(WR_DEL);
 
                 /* The actual frequency migh be different from what we have set */
-                get_freq_simplex(ctrl, ctrl->sock, &tmpfreq);
+                get_freq_simplex(ctrl, &ctrl->link, &tmpfreq);
                 ctrl->lastrxf = tmpfreq;
             }
             else
@@ -2115,7 +2154,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
         /* check if uplink dial has changed */
         if ((ctrl->engaged) && (ctrl->lasttxf > 0.0))
         {
-            if (!get_freq_simplex(ctrl, ctrl->sock2, &readfreq))
+            if (!get_freq_simplex(ctrl, &ctrl->link2, &readfreq))
             {
                 /* error => use a passive value */
                 readfreq = ctrl->lasttxf;
@@ -2172,7 +2211,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
             /* if device is engaged, send freq command to radio */
             if ((ctrl->engaged) && (fabs(ctrl->lastrxf - tmpfreq) >= 1.0))
             {
-                if (set_freq_simplex(ctrl, ctrl->sock, tmpfreq))
+                if (set_freq_simplex(ctrl, &ctrl->link, tmpfreq))
                 {
                     /* reset error counter */
                     ctrl->errcnt = 0;
@@ -2181,7 +2220,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
                     g_usleep(WR_DEL);
 
                     /* The actual frequency migh be different from what we have set */
-                    get_freq_simplex(ctrl, ctrl->sock, &tmpfreq);
+                    get_freq_simplex(ctrl, &ctrl->link, &tmpfreq);
                     ctrl->lastrxf = tmpfreq;
                 }
                 else
@@ -2211,7 +2250,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
             /* if device is engaged, send freq command to radio */
             if ((ctrl->engaged) && (fabs(ctrl->lasttxf - tmpfreq) >= 1.0))
             {
-                if (set_freq_simplex(ctrl, ctrl->sock2, tmpfreq))
+                if (set_freq_simplex(ctrl, &ctrl->link2, tmpfreq))
                 {
                     /* reset error counter */
                     ctrl->errcnt = 0;
@@ -2220,7 +2259,7 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
                     g_usleep(WR_DEL);
 
                     /* The actual frequency might be different from what we have set. */
-                    get_freq_simplex(ctrl, ctrl->sock2, &tmpfreq);
+                    get_freq_simplex(ctrl, &ctrl->link2, &tmpfreq);
                     ctrl->lasttxf = tmpfreq;
                 }
                 else
@@ -2232,12 +2271,23 @@ static void exec_dual_rig_cycle(GtkRigCtrl * ctrl)
     }                           /* else dialchange on downlink */
 }
 
-static gboolean get_ptt(GtkRigCtrl * ctrl, gint sock)
+static gboolean get_ptt(GtkRigCtrl * ctrl, rig_link_t * link)
 {
     gchar          *buff, **vbuff;
     gchar           buffback[128];
     gboolean        retcode;
     guint64         pttstat = 0;
+    gboolean        ptt = FALSE;
+
+    if (link->hamlib != NULL)
+    {
+        if (ctrl->conf->ptt == PTT_TYPE_CAT)
+            hamlib_rig_get_ptt(link->hamlib, &ptt);
+        else
+            hamlib_rig_get_dcd(link->hamlib, &ptt);
+
+        return ptt;
+    }
 
     if (ctrl->conf->ptt == PTT_TYPE_CAT)
     {
@@ -2250,7 +2300,7 @@ static gboolean get_ptt(GtkRigCtrl * ctrl, gint sock)
         buff = g_strdup_printf("%c\x0a", 0x8b);
     }
 
-    retcode = send_rigctld_command(ctrl, sock, buff, buffback, 128);
+    retcode = send_rigctld_command(ctrl, link->sock, buff, buffback, 128);
     if (retcode)
     {
         vbuff = g_strsplit(buffback, "\n", 3);
@@ -2264,19 +2314,22 @@ static gboolean get_ptt(GtkRigCtrl * ctrl, gint sock)
     return (pttstat == 1) ? TRUE : FALSE;
 }
 
-static gboolean set_ptt(GtkRigCtrl * ctrl, gint sock, gboolean ptt)
+static gboolean set_ptt(GtkRigCtrl * ctrl, rig_link_t * link, gboolean ptt)
 {
     gchar          *buff;
     gchar           buffback[128];
     gboolean        retcode;
 
+    if (link->hamlib != NULL)
+        return hamlib_rig_set_ptt(link->hamlib, ptt);
+
     /* send command */
     if (ptt == TRUE)
         buff = g_strdup_printf("T 1\x0aq\x0a");
     else
         buff = g_strdup_printf("T 0\x0aq\x0a");
 
-    retcode = send_rigctld_command(ctrl, sock, buff, buffback, 128);
+    retcode = send_rigctld_command(ctrl, link->sock, buff, buffback, 128);
     g_free(buff);
 
     return (check_set_response(buffback, retcode, __func__));
@@ -2291,7 +2344,8 @@ static gboolean set_ptt(GtkRigCtrl * ctrl, gint sock, gboolean ptt)
  *         occurred.
  *
  * This function checks whether AOS or LOS just happened and sends the
- * apropriate signal to the RIG if this signalling is enabled.
+ * apropriate signal to the RIG if this signalling is enabled. The signals
+ * have no Hamlib equivalent and are only sent to rigctld.
  */
 static gboolean check_aos_los(GtkRigCtrl * ctrl)
 {
@@ -2303,34 +2357,34 @@ static gboolean check_aos_los(GtkRigCtrl * ctrl)
         if (ctrl->prev_ele < 0.0 && ctrl->target->el >= 0.0)
         {
             /* AOS has occurred */
-            if (ctrl->conf->signal_aos)
+            if (ctrl->conf->signal_aos && ctrl->link.sock > 0)
             {
-                retcode &= send_rigctld_command(ctrl, ctrl->sock, "AOS\n",
+                retcode &= send_rigctld_command(ctrl, ctrl->link.sock, "AOS\n",
                                                 retbuf, 10);
             }
             if (ctrl->conf2 != NULL)
             {
-                if (ctrl->conf2->signal_aos)
+                if (ctrl->conf2->signal_aos && ctrl->link2.sock > 0)
                 {
-                    retcode &= send_rigctld_command(ctrl, ctrl->sock2, "AOS\n",
-                                                    retbuf, 10);
+                    retcode &= send_rigctld_command(ctrl, ctrl->link2.sock,
+                                                    "AOS\n", retbuf, 10);
                 }
             }
         }
         else if (ctrl->prev_ele >= 0.0 && ctrl->target->el < 0.0)
         {
             /* LOS has occurred */
-            if (ctrl->conf->signal_los)
+            if (ctrl->conf->signal_los && ctrl->link.sock > 0)
             {
-                retcode &= send_rigctld_command(ctrl, ctrl->sock, "LOS\n",
+                retcode &= send_rigctld_command(ctrl, ctrl->link.sock, "LOS\n",
                                                 retbuf, 10);
             }
             if (ctrl->conf2 != NULL)
             {
-                if (ctrl->conf2->signal_los)
+                if (ctrl->conf2->signal_los && ctrl->link2.sock > 0)
                 {
-                    retcode &= send_rigctld_command(ctrl, ctrl->sock2, "LOS\n",
-                                                    retbuf, 10);
+                    retcode &= send_rigctld_command(ctrl, ctrl->link2.sock,
+                                                    "LOS\n", retbuf, 10);
                 }
             }
         }
@@ -2346,14 +2400,18 @@ static gboolean check_aos_los(GtkRigCtrl * ctrl)
  *
  * Returns TRUE if the operation was successful, FALSE otherwise
  */
-static gboolean set_freq_simplex(GtkRigCtrl * ctrl, gint sock, gdouble freq)
+static gboolean set_freq_simplex(GtkRigCtrl * ctrl, rig_link_t * link,
+                                 gdouble freq)
 {
     gchar          *buff;
     gchar           buffback[128];
     gboolean        retcode;
 
+    if (link->hamlib != NULL)
+        return hamlib_rig_set_freq(link->hamlib, freq);
+
     buff = g_strdup_printf("F %10.0f\x0a", freq);
-    retcode = send_rigctld_command(ctrl, sock, buff, buffback, 128);
+    retcode = send_rigctld_command(ctrl, link->sock, buff, buffback, 128);
     g_free(buff);
 
     return (check_set_response(buffback, retcode, __func__));
@@ -2365,15 +2423,19 @@ static gboolean set_freq_simplex(GtkRigCtrl * ctrl, gint sock, gdouble freq)
  *
  * Returns TRUE if the operation was successful, FALSE otherwise
  */
-static gboolean set_freq_toggle(GtkRigCtrl * ctrl, gint sock, gdouble freq)
+static gboolean set_freq_toggle(GtkRigCtrl * ctrl, rig_link_t * link,
+                                gdouble freq)
 {
     gchar          *buff;
     gchar           buffback[128];
     gboolean        retcode;
 
+    if (link->hamlib != NULL)
+        return hamlib_rig_set_split_freq(link->hamlib, freq);
+
     /* send command */
     buff = g_strdup_printf("I %10.0f\x0a", freq);
-    retcode = send_rigctld_command(ctrl, sock, buff, buffback, 128);
+    retcode = send_rigctld_command(ctrl, link->sock, buff, buffback, 128);
     g_free(buff);
 
     return (check_set_response(buffback, retcode, __func__));
@@ -2385,14 +2447,18 @@ static gboolean set_freq_toggle(GtkRigCtrl * ctrl, gint sock, gdouble freq)
  *
  * Returns TRUE if the operation was successful
  */
-static gboolean set_toggle(GtkRigCtrl * ctrl, gint sock)
+static gboolean set_toggle(GtkRigCtrl * ctrl, rig_link_t * link)
 {
     gchar          *buff;
     gchar           buffback[128];
     gboolean        retcode;
 
+    if (link->hamlib != NULL)
+        return hamlib_rig_set_split(link->hamlib, TRUE,
+                                    vfo_name(ctrl->conf->vfoDown));
+
     buff = g_strdup_printf("S 1 %d\x0a", ctrl->conf->vfoDown);
-    retcode = send_rigctld_command(ctrl, sock, buff, buffback, 128);
+    retcode = send_rigctld_command(ctrl, link->sock, buff, buffback, 128);
     g_free(buff);
 
     return (check_set_response(buffback, retcode, __func__));
@@ -2403,15 +2469,19 @@ static gboolean set_toggle(GtkRigCtrl * ctrl, gint sock)
  *
  * Returns TRUE if the operation was successful
  */
-static gboolean unset_toggle(GtkRigCtrl * ctrl, gint sock)
+static gboolean unset_toggle(GtkRigCtrl * ctrl, rig_link_t * link)
 {
     gchar          *buff;
     gchar           buffback[128];
     gboolean        retcode;
 
+    if (link->hamlib != NULL)
+        return hamlib_rig_set_split(link->hamlib, FALSE,
+                                    vfo_name(ctrl->conf->vfoDown));
+
     /* send command */
     buff = g_strdup_printf("S 0 %d\x0a", ctrl->conf->vfoDown);
-    retcode = send_rigctld_command(ctrl, sock, buff, buffback, 128);
+    retcode = send_rigctld_command(ctrl, link->sock, buff, buffback, 128);
     g_free(buff);
 
     return (check_set_response(buffback, retcode, __func__));
@@ -2422,15 +2492,19 @@ static gboolean unset_toggle(GtkRigCtrl * ctrl, gint sock)
  *
  * Returns TRUE if the operation was successful, FALSE otherwise
  */
-static gboolean get_freq_simplex(GtkRigCtrl * ctrl, gint sock, gdouble * freq)
+static gboolean get_freq_simplex(GtkRigCtrl * ctrl, rig_link_t * link,
+                                 gdouble * freq)
 {
     gchar          *buff, **vbuff;
     gchar           buffback[128];
     gboolean        retcode;
     gboolean        retval = TRUE;
 
+    if (link->hamlib != NULL)
+        return hamlib_rig_get_freq(link->hamlib, freq);
+
     buff = g_strdup_printf("f\x0a");
-    retcode = send_rigctld_command(ctrl, sock, buff, buffback, 128);
+    retcode = send_rigctld_command(ctrl, link->sock, buff, buffback, 128);
     retcode = check_get_response(buffback, retcode, __func__);
     if (retcode)
     {
@@ -2455,7 +2529,8 @@ static gboolean get_freq_simplex(GtkRigCtrl * ctrl, gint sock, gdouble * freq)
  *
  * Returns TRUE if the operation was successful, FALSE otherwise
  */
-static gboolean get_freq_toggle(GtkRigCtrl * ctrl, gint sock, gdouble * freq)
+static gboolean get_freq_toggle(GtkRigCtrl * ctrl, rig_link_t * link,
+                                gdouble * freq)
 {
     gchar          *buff, **vbuff;
     gchar           buffback[128];
@@ -2469,9 +2544,12 @@ static gboolean get_freq_toggle(GtkRigCtrl * ctrl, gint sock, gdouble * freq)
         return FALSE;
     }
 
+    if (link->hamlib != NULL)
+        return hamlib_rig_get_split_freq(link->hamlib, freq);
+
     /* send command */
     buff = g_strdup_printf("i\x0a");
-    retcode = send_rigctld_command(ctrl, sock, buff, buffback, 128);
+    retcode = send_rigctld_command(ctrl, link->sock, buff, buffback, 128);
     retcode = check_get_response(buffback, retcode, __func__);
     if (retcode)
     {
@@ -2540,7 +2618,7 @@ static void manage_ptt_event(GtkRigCtrl * ctrl)
         }
         else
         {
-            ptt = get_ptt(ctrl, ctrl->sock);
+            ptt = get_ptt(ctrl, &ctrl->link);
 
             if (ptt == FALSE)
             {
@@ -2550,7 +2628,7 @@ static void manage_ptt_event(GtkRigCtrl * ctrl)
                             __func__);
 
                 exec_toggle_tx_cycle(ctrl);
-                set_ptt(ctrl, ctrl->sock, TRUE);
+                set_ptt(ctrl, &ctrl->link, TRUE);
             }
             else
             {
@@ -2558,7 +2636,7 @@ static void manage_ptt_event(GtkRigCtrl * ctrl)
                 sat_log_log(SAT_LOG_LEVEL_DEBUG,
                             _("%s: PTT is ON = Set PTT=OFF"), __func__);
 
-                set_ptt(ctrl, ctrl->sock, FALSE);
+                set_ptt(ctrl, &ctrl->link, FALSE);
             }
         }
 
@@ -2685,6 +2763,40 @@ static gboolean close_rigctld_socket(gint * sock)
     return TRUE;
 }
 
+/*
+ * Open the link to a radio.
+ *
+ * The radio is controlled in-process through Hamlib if the configuration has
+ * a Hamlib model, otherwise through rigctld at conf->host:conf->port.
+ */
+static gboolean open_rig_link(radio_conf_t * conf, rig_link_t * link)
+{
+    if (conf->model > 0)
+    {
+        link->hamlib = hamlib_rig_open(conf->model, conf->device, conf->speed);
+        return (link->hamlib != NULL);
+    }
+
+    return open_rigctld_socket(conf, &link->sock);
+}
+
+static void close_rig_link(rig_link_t * link)
+{
+    if (link->hamlib != NULL)
+    {
+        hamlib_rig_close(link->hamlib);
+        link->hamlib = NULL;
+    }
+
+    if (link->sock > 0)
+        close_rigctld_socket(&link->sock);
+}
+
+static inline gboolean rig_link_is_open(rig_link_t * link)
+{
+    return (link->sock > 0) || (link->hamlib != NULL);
+}
+
 static void rigctrl_close(GtkRigCtrl * data)
 {
     GtkRigCtrl     *ctrl = GTK_RIG_CTRL(data);
@@ -2699,14 +2811,14 @@ static void rigctrl_close(GtkRigCtrl * data)
     if ((ctrl->conf->type == RIG_TYPE_TOGGLE_AUTO) ||
         (ctrl->conf->type == RIG_TYPE_TOGGLE_MAN))
     {
-        unset_toggle(ctrl, ctrl->sock);
+        unset_toggle(ctrl, &ctrl->link);
     }
 
     if (ctrl->conf2 != NULL)
     {
-        close_rigctld_socket(&(ctrl->sock2));
+        close_rig_link(&ctrl->link2);
     }
-    close_rigctld_socket(&(ctrl->sock));
+    close_rig_link(&ctrl->link);
 }
 
 static void rigctrl_open(GtkRigCtrl * data)
@@ -2717,12 +2829,12 @@ static void rigctrl_open(GtkRigCtrl * data)
 
     start_timer(ctrl);
 
-    open_rigctld_socket(ctrl->conf, &(ctrl->sock));
+    open_rig_link(ctrl->conf, &ctrl->link);
 
     /* set initial frequency */
     if (ctrl->conf2 != NULL)
     {
-        open_rigctld_socket(ctrl->conf2, &(ctrl->sock2));
+        open_rig_link(ctrl->conf2, &ctrl->link2);
         /* set initial dual mode */
         exec_dual_rig_cycle(ctrl);
     }
@@ -2751,7 +2863,7 @@ static void rigctrl_open(GtkRigCtrl * data)
 
         case RIG_TYPE_TOGGLE_AUTO:
         case RIG_TYPE_TOGGLE_MAN:
-            set_toggle(ctrl, ctrl->sock);
+            set_toggle(ctrl, &ctrl->link);
             ctrl->last_toggle_tx = -1;
             exec_toggle_cycle(ctrl);
             break;
@@ -2787,7 +2899,7 @@ gpointer rigctl_run(gpointer data)
 
         if (t_ctrl->engaged)
         {
-            if (!t_ctrl->sock)
+            if (!rig_link_is_open(&t_ctrl->link))
                 rigctrl_open(t_ctrl);
 
             if (!t_ctrl->timerid)
@@ -2797,7 +2909,7 @@ gpointer rigctl_run(gpointer data)
         {
             g_mutex_lock(&t_ctrl->widgetsync);
 
-            if (t_ctrl->sock > 0)
+            if (rig_link_is_open(&t_ctrl->link))
                 rigctrl_close(t_ctrl);
 
             if (t_ctrl->timerid)
@@ -2870,7 +2982,7 @@ gpointer rigctl_run(gpointer data)
         //g_print ("       WROPS = %d\n", ctrl->wrops);
     }
 
-    if (t_ctrl->sock > 0)
+    if (rig_link_is_open(&t_ctrl->link))
         rigctrl_close(t_ctrl);
 
     if (t_ctrl->timerid)
@@ -2933,13 +3045,6 @@ GtkWidget      *gtk_rig_ctrl_new(GtkSatModule * module)
 
     rigctrl->qth = module->qth;
 
-    if (rigctrl->target != NULL)
-    {
-        /* get next pass for target satellite */
-        GTK_RIG_CTRL(widget)->pass = get_next_pass(rigctrl->target,
-                                                   rigctrl->qth, 3.0);
-    }
-
     /* create contents */
     table = gtk_grid_new();
     gtk_grid_set_row_spacing(GTK_GRID(table), 5);
@@ -6,6 +6,8 @@
 #include <gtk/gtk.h>
 
 #include "gtk-sat-module.h"
+#include "hamlib-backend.h"
+#include "pass-cache.h"
 #include "predict-tools.h"
 #include "radio-conf.h"
 #include "sgpsdp/sgp4sdp4.h"
@@ -26,6 +28,12 @@
 typedef struct _gtk_rig_ctrl GtkRigCtrl;
 typedef struct _GtkRigCtrlClass GtkRigCtrlClass;
 
+/** Connection to a radio, either through rigctld or in-process Hamlib. */
+typedef struct {
+    gint            sock;       /*!< Socket to rigctld, 0 if closed. */
+    hamlib_rig_t   *hamlib;     /*!< In-process Hamlib rig, NULL if not used. */
+} rig_link_t;
+
 struct _gtk_rig_ctrl {
     GtkBox          box;
 
@@ -58,6 +66,7 @@ struct _gtk_rig_ctrl {
     GSList         *sats;       /*!< List of sats in parent module */
     sat_t          *target;     /*!< Target satellite */
     pass_t         *pass;       /*!< Next pass of target satellite */
+    pass_cache_t   *pcache;     /*!< Upcoming passes of target satellite */
     qth_t          *qth;        /*!< The QTH for this module */
 
     double          prev_ele;   /*!< Previous elevation (used for AOS/LOS signalling) */
@@ -80,7 +89,7 @@ struct _gtk_rig_ctrl {
     glong           last_toggle_tx;     /*!< Last time when exec_toggle_tx_cycle() was executed (seconds)
                                            -1 indicates that an update should be performed ASAP */
 
-    gint            sock, sock2;        /*!< Sockets for controlling the radio(s). */
+    rig_link_t      link, link2;        /*!< Links to the radio(s). */
 
     /* debug related */
     guint           wrops;
@@ -61,6 +61,13 @@
 #define FMTSTR "%7.2f\302\260"
 #define MAX_ERROR_COUNT 5
 
+/* Slew rate assumed until it has been measured (deg/s) */
+#define DEFAULT_SLEW_RATE 2.0
+
+/* Smallest move and distance from target for a slew rate sample (deg) */
+#define SLEW_MIN_MOVE 0.5
+#define SLEW_MIN_DIST 1.0
+
 static GtkVBoxClass *parent_class = NULL;
 
 
@@ -206,83 +213,44 @@ static gint rot_name_compare(const gchar * a, const gchar * b)
     return (gpredict_strcmp(a, b));
 }
 
-static gboolean is_flipped_pass(pass_t * pass, rot_az_type_t type,
-                                gdouble azstoppos)
+/* Plan the rotator path for the current pass. */
+static void set_path(GtkRotCtrl * ctrl)
 {
-    gdouble         max_az = 0, min_az = 0, offset = 0;
-    gdouble         caz, last_az = pass->aos_az;
-    guint           num, i;
-    pass_detail_t  *detail;
-    gboolean        retval = FALSE;
-
-    num = g_slist_length(pass->details);
-    if (type == ROT_AZ_TYPE_360)
-    {
-        min_az = 0;
-        max_az = 360;
-    }
-    else if (type == ROT_AZ_TYPE_180)
-    {
-        min_az = -180;
-        max_az = 180;
-    }
-
-    /* Offset by (azstoppos-min_az) to handle
-     * rotators with non-default positions.
-     * Note that the default positions of the rotator stops
-     * (eg. -180 for ROT_AZ_TYPE_180, and 0 for 
-     * ROT_AZ_TYPE_360) will create an offset of 0, which
-     * seems like a pretty sane default. */
-    offset = azstoppos - min_az;
-    min_az += offset;
-    max_az += offset;
-
-    /* Assume that min_az and max_az are atleat 360 degrees apart
-       get the azimuth that is in a settable range */
-    while (last_az > max_az)
-        last_az -= 360;
-
-    while (last_az < min_az)
-        last_az += 360;
-
-    if (num > 1)
-    {
-        for (i = 1; i < num - 1; i++)
-        {
-            detail = PASS_DETAIL(g_slist_nth_data(pass->details, i));
-            caz = detail->az;
-
-            while (caz > max_az)
-                caz -= 360;
-
-            while (caz < min_az)
-                caz += 360;
+    gdouble         azrate, elrate;
 
+    rotor_path_free(ctrl->path);
+    ctrl->path = NULL;
 
-            if (fabs(caz - last_az) > 180)
-                retval = TRUE;
-
-            last_az = caz;
-        }
-    }
-    caz = pass->los_az;
-    while (caz > max_az)
-        caz -= 360;
-
-    while (caz < min_az)
-        caz += 360;
-
-    if (fabs(caz - last_az) > 180)
-        retval = TRUE;
+    if ((ctrl->conf == NULL) || (ctrl->pass == NULL))
+        return;
 
-    return retval;
+    g_mutex_lock(&ctrl->client.mutex);
+    azrate = ctrl->client.azi_rate;
+    elrate = ctrl->client.ele_rate;
+    g_mutex_unlock(&ctrl->client.mutex);
+
+    /* start from the last commanded position */
+    ctrl->path = rotor_path_new(ctrl->pass, ctrl->conf,
+                                gtk_rot_knob_get_value(GTK_ROT_KNOB
+                                                       (ctrl->AzSet)),
+                                gtk_rot_knob_get_value(GTK_ROT_KNOB
+                                                       (ctrl->ElSet)),
+                                azrate > 0.0 ? azrate : DEFAULT_SLEW_RATE,
+                                elrate > 0.0 ? elrate : DEFAULT_SLEW_RATE,
+                                ctrl->t);
 }
 
-static inline void set_flipped_pass(GtkRotCtrl * ctrl)
+/* Replace the current pass and update the polar plot. */
+static void set_pass(GtkRotCtrl * ctrl, pass_t * pass)
 {
-    if (ctrl->conf && ctrl->pass)
-        ctrl->flipped = is_flipped_pass(ctrl->pass, ctrl->conf->aztype,
-                                        ctrl->conf->azstoppos);
+    if (ctrl->pass != NULL)
+        free_pass(ctrl->pass);
+
+    ctrl->pass = pass;
+    set_path(ctrl);
+
+    if (ctrl->plot != NULL)
+        gtk_polar_plot_set_pass(GTK_POLAR_PLOT(ctrl->plot), ctrl->pass);
 }
 
 /**
@@ -307,6 +275,9 @@ static gboolean get_pos(GtkRotCtrl * ctrl, gdouble * az, gdouble * el)
         return FALSE;
     }
 
+    if (ctrl->client.hamlib != NULL)
+        return hamlib_rot_get_position(ctrl->client.hamlib, az, el);
+
     /* send command */
     buff = g_strdup_printf("p\x0a");
     retcode = rotctld_socket_rw(ctrl->client.socket, buff, buffback, 128);
@@ -367,6 +338,9 @@ static gboolean set_pos(GtkRotCtrl * ctrl, gdouble az, gdouble el)
     gboolean        retcode;
     gint            retval;
 
+    if (ctrl->client.hamlib != NULL)
+        return hamlib_rot_set_position(ctrl->client.hamlib, az, el);
+
     /* send command */
     buff = g_strdup_printf("P %.2f %.2f\x0a", az, el);
     retcode = rotctld_socket_rw(ctrl->client.socket, buff, buffback, 128);
@@ -390,22 +364,108 @@ static gboolean set_pos(GtkRotCtrl * ctrl, gdouble az, gdouble el)
     return (retcode);
 }
 
+/**
+ * Stop the rotator
+ *
+ * \param ctrl Pointer to the GtkRotCtrl widget
+ *
+ * Errors are only logged since the controller is being disengaged anyway.
+ */
+static void stop_rot(GtkRotCtrl * ctrl)
+{
+    gchar          *buff;
+    gchar           buffback[128];
+    gboolean        retcode;
+    gint            retval;
+
+    if (ctrl->client.hamlib != NULL)
+    {
+        hamlib_rot_stop(ctrl->client.hamlib);
+        return;
+    }
+
+    buff = g_strdup_printf("S\x0a");
+    retcode = rotctld_socket_rw(ctrl->client.socket, buff, buffback, 128);
+    g_free(buff);
+    if (retcode == TRUE)
+    {
+        /* treat errors as soft errors */
+        retval = (gint) g_strtod(buffback + 4, NULL);
+        if (retval != 0)
+        {
+            g_strstrip(buffback);
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _
+                        ("%s:%d: rotctld returned error %d with stop-cmd (%s)"),
+                        __FILE__, __LINE__, retval, buffback);
+        }
+    }
+}
+
+/**
+ * Update a slew rate estimate from two position readbacks.
+ *
+ * \param rate The slew rate estimate in deg/s; 0.0 if not known yet.
+ * \param from The previous position.
+ * \param to The current position.
+ * \param trg The position the rotator has been commanded to.
+ * \param dt The time between the two readbacks in seconds.
+ *
+ * Only intervals where the rotator has been moving towards a target that it
+ * has not yet reached are used, otherwise the rotator may have been standing
+ * still for part of the interval.
+ */
+static void update_slew_rate(gdouble * rate, gdouble from, gdouble to,
+                             gdouble trg, gdouble dt)
+{
+    gdouble         sample;
+
+    if ((dt <= 0.0) || (fabs(to - from) < SLEW_MIN_MOVE) ||
+        (fabs(trg - to) < SLEW_MIN_DIST) ||
+        (fabs(trg - to) > fabs(trg - from)))
+        return;
+
+    sample = fabs(to - from) / dt;
+    if (*rate > 0.0)
+        *rate = 0.7 * (*rate) + 0.3 * sample;
+    else
+        *rate = sample;
+}
+
 /* Rotctl client thread */
 static gpointer rotctld_client_thread(gpointer data)
 {
     gdouble         elapsed_time;
     gdouble         azi = 0.0;
     gdouble         ele = 0.0;
+    gdouble         azi_trg = 0.0;
+    gdouble         ele_trg = 0.0;
+    gdouble         azi_prev = 0.0;
+    gdouble         ele_prev = 0.0;
+    gdouble         azi_rate, ele_rate;
+    gint64          read_time, prev_time = 0;
+    gboolean        have_trg = FALSE;
     gboolean        new_trg = FALSE;
     gboolean        io_error = FALSE;
     GtkRotCtrl     *ctrl = GTK_ROT_CTRL(data);
 
     g_print("Starting rotctld client thread\n");
 
-    ctrl->client.socket = rotctld_socket_open(ctrl->conf->host,
-                                              ctrl->conf->port);
-    if (ctrl->client.socket == -1)
-        return GINT_TO_POINTER(-1);
+    if (ctrl->conf->model > 0)
+    {
+        ctrl->client.hamlib = hamlib_rot_open(ctrl->conf->model,
+                                              ctrl->conf->device,
+                                              ctrl->conf->speed);
+        if (ctrl->client.hamlib == NULL)
+            return GINT_TO_POINTER(-1);
+    }
+    else
+    {
+        ctrl->client.socket = rotctld_socket_open(ctrl->conf->host,
+                                                  ctrl->conf->port);
+        if (ctrl->client.socket == -1)
+            return GINT_TO_POINTER(-1);
+    }
 
     ctrl->client.timer = g_timer_new();
 
@@ -429,7 +489,12 @@ static gpointer rotctld_client_thread(gpointer data)
         if (new_trg && !ctrl->monitor)
         {
             if (set_pos(ctrl, azi, ele))
+            {
                 new_trg = FALSE;
+                have_trg = TRUE;
+                azi_trg = azi;
+                ele_trg = ele;
+            }
             else
                 io_error = TRUE;
         }
@@ -437,9 +502,31 @@ static gpointer rotctld_client_thread(gpointer data)
         /* wait 100 ms before sending new command */
         g_usleep(100000);
         if (!get_pos(ctrl, &azi, &ele))
+        {
             io_error = TRUE;
+            prev_time = 0;
+        }
 
         g_mutex_lock(&ctrl->client.mutex);
+        if (!io_error)
+        {
+            /* measure the slew rate while the rotator is moving */
+            read_time = g_get_monotonic_time();
+            if (have_trg && (prev_time > 0))
+            {
+                azi_rate = ctrl->client.azi_rate;
+                ele_rate = ctrl->client.ele_rate;
+                update_slew_rate(&azi_rate, azi_prev, azi, azi_trg,
+                                 (read_time - prev_time) / 1.0e6);
+                update_slew_rate(&ele_rate, ele_prev, ele, ele_trg,
+                                 (read_time - prev_time) / 1.0e6);
+                ctrl->client.azi_rate = azi_rate;
+                ctrl->client.ele_rate = ele_rate;
+            }
+            prev_time = read_time;
+            azi_prev = azi;
+            ele_prev = ele;
+        }
         ctrl->client.azi_in = azi;
         ctrl->client.ele_in = ele;
         ctrl->client.new_trg = new_trg;
@@ -453,7 +540,15 @@ static gpointer rotctld_client_thread(gpointer data)
 
     g_print("Stopping rotctld client thread\n");
     g_timer_destroy(ctrl->client.timer);
-    rotctld_socket_close(&ctrl->client.socket);
+    if (ctrl->client.hamlib != NULL)
+    {
+        hamlib_rot_close(ctrl->client.hamlib);
+        ctrl->client.hamlib = NULL;
+    }
+    else
+    {
+        rotctld_socket_close(&ctrl->client.socket);
+    }
 
     return GINT_TO_POINTER(0);
 }
@@ -513,6 +608,7 @@ static void update_count_down(GtkRotCtrl * ctrl, gdouble t)
 void gtk_rot_ctrl_update(GtkRotCtrl * ctrl, gdouble t)
 {
     gchar          *buff;
+    pass_t         *pass;
 
     ctrl->t = t;
 
@@ -528,21 +624,13 @@ void gtk_rot_ctrl_update(GtkRotCtrl * ctrl, gdouble t)
 
         update_count_down(ctrl, t);
 
-        /*if the current pass is too far away */
-        if ((ctrl->pass != NULL))
-            if (qth_small_dist(ctrl->qth, ctrl->pass->qth_comp) > 1.0)
-            {
-                free_pass(ctrl->pass);
-                ctrl->pass = NULL;
-                ctrl->pass = get_pass(ctrl->target, ctrl->qth, t, 3.0);
-                if (ctrl->pass)
-                {
-                    set_flipped_pass(ctrl);
-                    /* update polar plot */
-                    gtk_polar_plot_set_pass(GTK_POLAR_PLOT(ctrl->plot),
-                                            ctrl->pass);
-                }
-            }
+        /* the pass cache starts over if the QTH has moved */
+        if ((ctrl->pass != NULL) &&
+            (qth_small_dist(ctrl->qth, ctrl->pass->qth_comp) > 1.0))
+        {
+            set_pass(ctrl, pass_cache_get(ctrl->pcache, ctrl->target,
+                                          ctrl->qth, t));
+        }
 
         /* update next pass if necessary */
         if (ctrl->pass != NULL)
@@ -555,30 +643,23 @@ void gtk_rot_ctrl_update(GtkRotCtrl * ctrl, gdouble t)
                 if (ctrl->target->el >= 0.0)
                 {
                     /* inside an unexpected/unpredicted pass */
-                    free_pass(ctrl->pass);
-                    ctrl->pass = NULL;
-                    ctrl->pass = get_current_pass(ctrl->target, ctrl->qth, t);
-                    set_flipped_pass(ctrl);
-                    gtk_polar_plot_set_pass(GTK_POLAR_PLOT(ctrl->plot),
-                                            ctrl->pass);
+                    set_pass(ctrl, get_current_pass(ctrl->target,
+                                                    ctrl->qth, t));
                 }
-                else if ((ctrl->target->aos - ctrl->pass->aos) >
-                         (ctrl->delay / secday / 1000 / 4.0))
+                else if ((ctrl->pass->los < t) ||
+                         ((ctrl->target->aos - ctrl->pass->aos) >
+                          (ctrl->delay / secday / 1000 / 4.0)))
                 {
-                    /* the target is expected to appear in a new pass 
-                       sufficiently later after the current pass says */
+                    /* the pass is over or the target is expected to
+                       appear in a new pass sufficiently later after the
+                       current pass says */
 
                     /* converted milliseconds to gpredict time and took a 
                        fraction of it as a threshold for deciding a new pass */
 
                     /* if the next pass is not the one for the target */
-                    free_pass(ctrl->pass);
-                    ctrl->pass = NULL;
-                    ctrl->pass = get_pass(ctrl->target, ctrl->qth, t, 3.0);
-                    set_flipped_pass(ctrl);
-                    /* update polar plot */
-                    gtk_polar_plot_set_pass(GTK_POLAR_PLOT(ctrl->plot),
-                                            ctrl->pass);
+                    set_pass(ctrl, pass_cache_get(ctrl->pcache, ctrl->target,
+                                                  ctrl->qth, t));
                 }
             }
             else
@@ -587,27 +668,23 @@ void gtk_rot_ctrl_update(GtkRotCtrl * ctrl, gdouble t)
                    horizon so look for a new pass */
                 if (ctrl->target->el < 0.0)
                 {
-                    free_pass(ctrl->pass);
-                    ctrl->pass = NULL;
-                    ctrl->pass = get_pass(ctrl->target, ctrl->qth, t, 3.0);
-                    set_flipped_pass(ctrl);
-                    /* update polar plot */
-                    gtk_polar_plot_set_pass(GTK_POLAR_PLOT(ctrl->plot),
-                                            ctrl->pass);
+                    /* the cache returns the current pass until its LOS */
+                    pass = pass_cache_get(ctrl->pcache, ctrl->target,
+                                          ctrl->qth, t);
+                    if ((pass != NULL) && (pass->aos > ctrl->pass->aos))
+                        set_pass(ctrl, pass);
+                    else if (pass != NULL)
+                        free_pass(pass);
                 }
             }
         }
         else
         {
-            /* we don't have any current pass; store the current one */
-            if (ctrl->target->el > 0.0)
-                ctrl->pass = get_current_pass(ctrl->target, ctrl->qth, t);
-            else
-                ctrl->pass = get_pass(ctrl->target, ctrl->qth, t, 3.0);
-
-            set_flipped_pass(ctrl);
-            /* update polar plot */
-            gtk_polar_plot_set_pass(GTK_POLAR_PLOT(ctrl->plot), ctrl->pass);
+            /* we don't have any current pass; the pass cache returns
+               NULL until the search running in the background is done */
+            pass = pass_cache_get(ctrl->pcache, ctrl->target, ctrl->qth, t);
+            if (pass != NULL)
+                set_pass(ctrl, pass);
         }
     }
 }
@@ -721,6 +798,42 @@ static void track_toggle_cb(GtkToggleButton * button, gpointer data)
     gtk_widget_set_sensitive(ctrl->ElSet, !ctrl->tracking);
 }
 
+/**
+ * Check whether it is time to head for the AOS position.
+ *
+ * \param ctrl Pointer to the GtkRotCtrl widget.
+ * \param az The AOS azimuth in rotator coordinates.
+ * \param el The AOS elevation in rotator coordinates.
+ * \return TRUE if the rotator should start moving to the AOS position.
+ *
+ * The rotator is given the time it needs to slew from the last commanded
+ * position to the AOS position at the measured slew rate plus the lead
+ * time configured for the rotator. Until both slew rates have been
+ * measured, the rotator heads for the AOS position right away, since a
+ * guessed rate could make it arrive late for the first pass.
+ */
+static gboolean aos_lead_reached(GtkRotCtrl * ctrl, gdouble az, gdouble el)
+{
+    gdouble         azrate, elrate;
+    gdouble         slew;
+
+    g_mutex_lock(&ctrl->client.mutex);
+    azrate = ctrl->client.azi_rate;
+    elrate = ctrl->client.ele_rate;
+    g_mutex_unlock(&ctrl->client.mutex);
+
+    if ((azrate <= 0.0) || (elrate <= 0.0))
+        return TRUE;
+
+    /* the rotator can not move across its stops */
+    slew = MAX(fabs(az - gtk_rot_knob_get_value(GTK_ROT_KNOB(ctrl->AzSet))) /
+               azrate,
+               fabs(el - gtk_rot_knob_get_value(GTK_ROT_KNOB(ctrl->ElSet))) /
+               elrate);
+
+    return ((ctrl->pass->aos - ctrl->t) * secday <= slew + ctrl->lead);
+}
+
 /**
  * Rotator controller timeout function
  *
@@ -757,40 +870,42 @@ static gboolean rot_ctrl_timeout_cb(gpointer data)
             {
                 if (ctrl->t < ctrl->pass->aos)
                 {
-                    setaz = SAFE_AZI(ctrl->pass->aos_az);
-                    setel = SAFE_ELE(0.0);
+                    setaz = ctrl->pass->aos_az;
+                    setel = 0.0;
                 }
                 else if (ctrl->t > ctrl->pass->los)
                 {
-                    setaz = SAFE_AZI(ctrl->pass->los_az);
-                    setel = SAFE_ELE(0.0);
+                    setaz = ctrl->pass->los_az;
+                    setel = 0.0;
                 }
             }
         }
         else
         {
-            setaz = SAFE_AZI(ctrl->target->az);
-            setel = SAFE_ELE(ctrl->target->el);
+            setaz = ctrl->target->az;
+            setel = ctrl->target->el;
         }
-        /* if this is a flipped pass and the rotor supports it */
-        if ((ctrl->flipped) && (ctrl->conf->maxel >= 180.0))
-        {
-            setel = 180 - setel;
-            if (setaz > 180)
-                setaz -= 180;
-            else
-                setaz += 180;
 
-            while (setaz > ctrl->conf->maxaz)
-                setaz -= 360;
+        /* use the azimuth wrap and flip mode planned for the pass */
+        if (ctrl->path != NULL)
+            rotor_path_map(ctrl->path, ctrl->t, setaz, setel, &setaz, &setel);
 
-            while (setaz < ctrl->conf->minaz)
-                setaz += 360;
-        }
+        setaz = SAFE_AZI(setaz);
+        setel = SAFE_ELE(setel);
 
         if ((ctrl->conf->aztype == ROT_AZ_TYPE_180) && (setaz > 180.0))
             setaz = setaz - 360.0;
 
+        /* stay where the last pass left the rotator until it is
+           time to move to the AOS position of the next pass */
+        if ((ctrl->target->el < 0.0) && (ctrl->pass != NULL) &&
+            (ctrl->t < ctrl->pass->aos) &&
+            !aos_lead_reached(ctrl, setaz, setel))
+        {
+            setaz = gtk_rot_knob_get_value(GTK_ROT_KNOB(ctrl->AzSet));
+            setel = gtk_rot_knob_get_value(GTK_ROT_KNOB(ctrl->ElSet));
+        }
+
         if (!(ctrl->engaged))
         {
             gtk_rot_knob_set_value(GTK_ROT_KNOB(ctrl->AzSet), setaz);
@@ -901,14 +1016,10 @@ static gboolean rot_ctrl_timeout_cb(gpointer data)
                     {
                         predict_calc(sat, ctrl->qth, ctrl->t + time_delta);
                         /*update sat->az and sat->el to account for flips and az range */
-                        if ((ctrl->flipped) && (ctrl->conf->maxel >= 180.0))
-                        {
-                            sat->el = 180.0 - sat->el;
-                            if (sat->az > 180.0)
-                                sat->az -= 180.0;
-                            else
-                                sat->az += 180.0;
-                        }
+                        if (ctrl->path != NULL)
+                            rotor_path_map(ctrl->path, ctrl->t + time_delta,
+                                           sat->az, sat->el,
+                                           &sat->az, &sat->el);
                         if ((ctrl->conf->aztype == ROT_AZ_TYPE_180) &&
                             (sat->az > 180.0))
                         {
@@ -1049,6 +1160,44 @@ static void toler_changed_cb(GtkSpinButton * spin, gpointer data)
     ctrl->tolerance = gtk_spin_button_get_value(spin);
 }
 
+/**
+ * Manage AOS lead time changes.
+ *
+ * \param spin Pointer to the spin button.
+ * \param data Pointer to the GtkRotCtrl widget.
+ *
+ * The lead time is stored in the configuration of the current rotator.
+ */
+static void lead_changed_cb(GtkSpinButton * spin, gpointer data)
+{
+    GtkRotCtrl     *ctrl = GTK_ROT_CTRL(data);
+
+    ctrl->lead = gtk_spin_button_get_value(spin);
+
+    /* saved by save_lead() when the rotator is changed or closed */
+    if ((ctrl->conf != NULL) && (ctrl->conf->aoslead != ctrl->lead))
+    {
+        ctrl->conf->aoslead = ctrl->lead;
+        ctrl->leadchanged = TRUE;
+    }
+}
+
+/**
+ * Save the AOS lead time to the rotator configuration.
+ *
+ * \param ctrl Pointer to the GtkRotCtrl widget.
+ *
+ * The configuration file is only written if the lead time has been changed
+ * since the rotator was selected.
+ */
+static void save_lead(GtkRotCtrl * ctrl)
+{
+    if ((ctrl->conf != NULL) && ctrl->leadchanged)
+        rotor_conf_save(ctrl->conf);
+
+    ctrl->leadchanged = FALSE;
+}
+
 /**
  * New rotor device selected.
  *
@@ -1062,11 +1211,14 @@ static void rot_selected_cb(GtkComboBox * box, gpointer data)
 {
     GtkRotCtrl     *ctrl = GTK_ROT_CTRL(data);
 
+    save_lead(ctrl);
+
     /* free previous configuration */
     if (ctrl->conf != NULL)
     {
         g_free(ctrl->conf->name);
         g_free(ctrl->conf->host);
+        g_free(ctrl->conf->device);
         g_free(ctrl->conf);
     }
 
@@ -1094,8 +1246,18 @@ static void rot_selected_cb(GtkComboBox * box, gpointer data)
         gtk_rot_knob_set_range(GTK_ROT_KNOB(ctrl->ElSet), ctrl->conf->minel,
                                ctrl->conf->maxel);
 
-        /* Update flipped when changing rotor if there is a plot */
-        set_flipped_pass(ctrl);
+        /* AOS lead time of the new rotator */
+        ctrl->lead = ctrl->conf->aoslead;
+        gtk_spin_button_set_value(GTK_SPIN_BUTTON(ctrl->LeadSpin), ctrl->lead);
+
+        /* plan the path of the current pass for the new rotator */
+        set_path(ctrl);
+
+        /* the slew rate of the new rotator is not known yet */
+        g_mutex_lock(&ctrl->client.mutex);
+        ctrl->client.azi_rate = 0.0;
+        ctrl->client.ele_rate = 0.0;
+        g_mutex_unlock(&ctrl->client.mutex);
     }
     else
     {
@@ -1137,10 +1299,6 @@ static void rot_monitor_cb(GtkCheckButton * button, gpointer data)
 static void rot_locked_cb(GtkToggleButton * button, gpointer data)
 {
     GtkRotCtrl     *ctrl = GTK_ROT_CTRL(data);
-    gchar          *buff;
-    gchar           buffback[128];
-    gboolean        retcode;
-    gint            retval;
 
     if (!gtk_toggle_button_get_active(button))
     {
@@ -1154,23 +1312,7 @@ static void rot_locked_cb(GtkToggleButton * button, gpointer data)
             return;
 
         /* stop moving rotor */
-        /** FIXME: should use high level func */
-        buff = g_strdup_printf("S\x0a");
-        retcode = rotctld_socket_rw(ctrl->client.socket, buff, buffback, 128);
-        g_free(buff);
-        if (retcode == TRUE)
-        {
-            /* treat errors as soft errors */
-            retval = (gint) g_strtod(buffback + 4, NULL);
-            if (retval != 0)
-            {
-                g_strstrip(buffback);
-                sat_log_log(SAT_LOG_LEVEL_ERROR,
-                            _
-                            ("%s:%d: rotctld returned error %d with stop-cmd (%s)"),
-                            __FILE__, __LINE__, retval, buffback);
-            }
-        }
+        stop_rot(ctrl);
 
         ctrl->client.running = FALSE;
         g_thread_join(ctrl->client.thread);
@@ -1214,16 +1356,15 @@ static void sat_selected_cb(GtkComboBox * satsel, gpointer data)
     {
         ctrl->target = SAT(g_slist_nth_data(ctrl->sats, i));
 
-        /* update next pass */
+        /* update next pass; the pass cache will search the passes of
+           the new target in the background */
         if (ctrl->pass != NULL)
             free_pass(ctrl->pass);
 
-        if (ctrl->target->el > 0.0)
-            ctrl->pass = get_current_pass(ctrl->target, ctrl->qth, ctrl->t);
-        else
-            ctrl->pass = get_pass(ctrl->target, ctrl->qth, ctrl->t, 3.0);
+        ctrl->pass = pass_cache_get(ctrl->pcache, ctrl->target, ctrl->qth,
+                                    ctrl->t);
 
-        set_flipped_pass(ctrl);
+        set_path(ctrl);
     }
     else
     {
@@ -1237,6 +1378,7 @@ static void sat_selected_cb(GtkComboBox * satsel, gpointer data)
             free_pass(ctrl->pass);
             ctrl->pass = NULL;
         }
+        set_path(ctrl);
     }
 
     /* in either case, we set the new pass (even if NULL) on the polar plot */
@@ -1453,6 +1595,34 @@ static GtkWidget *create_conf_widgets(GtkRotCtrl * ctrl)
     g_object_set(label, "xalign", 0.0f, "yalign", 0.5f, NULL);
     gtk_grid_attach(GTK_GRID(table), label, 2, 3, 1, 1);
 
+    /* AOS lead time */
+    label = gtk_label_new(_("AOS lead:"));
+    g_object_set(label, "xalign", 1.0f, "yalign", 0.5f, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 0, 4, 1, 1);
+
+    ctrl->LeadSpin = gtk_spin_button_new_with_range(0, 3600, 10);
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(ctrl->LeadSpin), 0);
+    gtk_widget_set_tooltip_text(ctrl->LeadSpin,
+                                _("This parameter controls when the rotator "
+                                  "moves to the AOS position of the next "
+                                  "pass.\n"
+                                  "Between passes the rotator stays where it "
+                                  "is until the time it needs to reach the "
+                                  "AOS position plus this lead time is left "
+                                  "before AOS. Until the slew rate has been "
+                                  "measured, the rotator moves to the AOS "
+                                  "position right away.\n"
+                                  "The lead time is saved with the rotator "
+                                  "configuration."));
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(ctrl->LeadSpin), ctrl->lead);
+    g_signal_connect(ctrl->LeadSpin, "value-changed",
+                     G_CALLBACK(lead_changed_cb), ctrl);
+    gtk_grid_attach(GTK_GRID(table), ctrl->LeadSpin, 1, 4, 1, 1);
+
+    label = gtk_label_new(_("sec"));
+    g_object_set(label, "xalign", 0.0f, "yalign", 0.5f, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 2, 4, 1, 1);
+
     /* load initial rotator configuration */
     rot_selected_cb(GTK_COMBO_BOX(ctrl->DevSel), ctrl);
 
@@ -1532,6 +1702,8 @@ static void gtk_rot_ctrl_init(GtkRotCtrl * ctrl)
     ctrl->sats = NULL;
     ctrl->target = NULL;
     ctrl->pass = NULL;
+    ctrl->pcache = pass_cache_new();
+    ctrl->path = NULL;
     ctrl->qth = NULL;
     ctrl->plot = NULL;
 
@@ -1540,12 +1712,17 @@ static void gtk_rot_ctrl_init(GtkRotCtrl * ctrl)
     ctrl->delay = 1000;
     ctrl->timerid = 0;
     ctrl->tolerance = 5.0;
+    ctrl->lead = ROT_DEFAULT_AOS_LEAD;
+    ctrl->leadchanged = FALSE;
     ctrl->errcnt = 0;
 
     g_mutex_init(&ctrl->client.mutex);
     ctrl->client.thread = NULL;
     ctrl->client.socket = -1;
+    ctrl->client.hamlib = NULL;
     ctrl->client.running = FALSE;
+    ctrl->client.azi_rate = 0.0;
+    ctrl->client.ele_rate = 0.0;
 }
 
 static void gtk_rot_ctrl_destroy(GtkWidget * widget)
@@ -1557,10 +1734,12 @@ static void gtk_rot_ctrl_destroy(GtkWidget * widget)
         g_source_remove(ctrl->timerid);
 
     /* free configuration */
+    save_lead(ctrl);
     if (ctrl->conf != NULL)
     {
         g_free(ctrl->conf->name);
         g_free(ctrl->conf->host);
+        g_free(ctrl->conf->device);
         g_free(ctrl->conf);
         ctrl->conf = NULL;
     }
@@ -1574,6 +1753,21 @@ static void gtk_rot_ctrl_destroy(GtkWidget * widget)
 
     g_mutex_clear(&ctrl->client.mutex);
 
+    if (ctrl->pass != NULL)
+    {
+        free_pass(ctrl->pass);
+        ctrl->pass = NULL;
+    }
+
+    if (ctrl->pcache != NULL)
+    {
+        pass_cache_free(ctrl->pcache);
+        ctrl->pcache = NULL;
+    }
+
+    rotor_path_free(ctrl->path);
+    ctrl->path = NULL;
+
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
 
@@ -1634,19 +1828,11 @@ GtkWidget      *gtk_rot_ctrl_new(GtkSatModule * module)
     /* store QTH */
     rot_ctrl->qth = module->qth;
 
-    /* get next pass for target satellite */
+    /* start searching the passes of the target satellite */
     if (rot_ctrl->target)
     {
-        if (rot_ctrl->target->el > 0.0)
-        {
-            rot_ctrl->pass = get_current_pass(rot_ctrl->target,
-                                              rot_ctrl->qth, 0.0);
-        }
-        else
-        {
-            rot_ctrl->pass = get_next_pass(rot_ctrl->target,
-                                           rot_ctrl->qth, 3.0);
-        }
+        rot_ctrl->pass = pass_cache_get(rot_ctrl->pcache, rot_ctrl->target,
+                                        rot_ctrl->qth, rot_ctrl->t);
     }
 
     /* create contents */
@@ -6,8 +6,11 @@
 #include <gtk/gtk.h>
 
 #include "gtk-sat-module.h"
+#include "hamlib-backend.h"
+#include "pass-cache.h"
 #include "predict-tools.h"
 #include "rotor-conf.h"
+#include "rotor-path.h"
 #include "sgpsdp/sgp4sdp4.h"
 
 #ifdef __cplusplus
@@ -45,6 +48,7 @@ struct _gtk_rot_ctrl {
     GtkWidget      *LockBut;
     GtkWidget      *MonitorCheckBox;
     GtkWidget      *track;
+    GtkWidget      *LeadSpin;   /*!< AOS lead time */
 
     rotor_conf_t   *conf;
     gdouble         t;          /*!< Time when sat data last has been updated. */
@@ -53,12 +57,15 @@ struct _gtk_rot_ctrl {
     GSList         *sats;       /*!< List of sats in parent module */
     sat_t          *target;     /*!< Target satellite */
     pass_t         *pass;       /*!< Next pass of target satellite */
+    pass_cache_t   *pcache;     /*!< Upcoming passes of target satellite */
     qth_t          *qth;        /*!< The QTH for this module */
-    gboolean        flipped;    /*!< Whether the current pass loaded is a flip pass or not */
+    rotor_path_t   *path;       /*!< Planned rotator path for the pass */
 
     guint           delay;      /*!< Timeout delay. */
     guint           timerid;    /*!< Timer ID */
     gdouble         tolerance;  /*!< Error tolerance */
+    gdouble         lead;       /*!< Extra time in sec to reach AOS position */
+    gboolean        leadchanged;        /*!< Lead time not saved to conf yet */
 
     gboolean        tracking;   /*!< Flag set when we are tracking a target. */
     gboolean        monitor;    /*!< Flag indicating that rig is in monitor mode. */
@@ -66,16 +73,19 @@ struct _gtk_rot_ctrl {
 
     gint            errcnt;     /*!< Error counter. */
 
-    /* TCP client to rotctld */
+    /* Client to rotctld or to an in-process Hamlib rotator */
     struct {
         GThread    *thread;
         GTimer     *timer;
         GMutex      mutex;
         gint        socket;     /* network socket to rotctld */
+        hamlib_rot_t *hamlib;   /* in-process Hamlib rotator or NULL */
         gfloat      azi_in;     /* last AZI angle read from rotctld */
         gfloat      ele_in;     /* last ELE angle read from rotctld */
         gfloat      azi_out;    /* AZI target */
         gfloat      ele_out;    /* ELE target */
+        gdouble     azi_rate;   /* measured AZI slew rate in deg/s */
+        gdouble     ele_rate;   /* measured ELE slew rate in deg/s */
         gboolean    new_trg;    /* new target position set */
         gboolean    running;
         gboolean    io_error;
@@ -47,6 +47,9 @@
  * @return 0 if successfull, 1 if an I/O error occurred,
  *         2 if the TLE data appears to be bad.
  *
+ * Only the TLE data and the epoch are available after this call. Use
+ * gtk_sat_data_init_sat() or gtk_sat_data_init_sats() before using the
+ * satellite for predictions.
  */
 gint gtk_sat_data_read_sat(gint catnum, sat_t * sat)
 {
@@ -162,6 +165,8 @@ gint gtk_sat_data_read_sat(gint catnum, sat_t * sat)
         sat->range_rate = 0.0;
         sat->ra = 0.0;
         sat->dec = 0.0;
+        sat->radec_utc = -1.0;
+        sat->anchor.jul_utc = 0.0;
         sat->ssplat = 0.0;
         sat->ssplon = 0.0;
         sat->alt = 0.0;
@@ -172,8 +177,9 @@ gint gtk_sat_data_read_sat(gint catnum, sat_t * sat)
         sat->aos = 0.0;
         sat->los = 0.0;
 
-        /* calculate satellite data at epoch */
-        gtk_sat_data_init_sat(sat, NULL);
+        /* the rest is calculated by gtk_sat_data_init_sat() */
+        sat->jul_epoch = Julian_Date_of_Epoch(sat->tle.epoch);
+        sat->otype = ORBIT_TYPE_UNKNOWN;
     }
 
     g_free(filename);
@@ -190,7 +196,7 @@ gint gtk_sat_data_read_sat(gint catnum, sat_t * sat)
  * @param qth Optional QTH info, use (0,0) if NULL.
  *
  * This function calculates the satellite data at t = 0, ie. epoch time
- * The function is called automatically by gtk_sat_data_read_sat.
+ * The function must be called after gtk_sat_data_read_sat.
  */
 void gtk_sat_data_init_sat(sat_t * sat, qth_t * qth)
 {
@@ -261,6 +267,75 @@ void gtk_sat_data_init_sat(sat_t * sat, qth_t * qth)
     sat->otype = get_orbit_type(sat);
 }
 
+/* Satellites initialised per job of gtk_sat_data_init_sats() */
+#define INIT_SATS_CHUNK 32
+
+typedef struct {
+    GPtrArray      *sats;
+    guint           first;
+    qth_t          *qth;
+} init_sats_job_t;
+
+static void init_sats_job(gpointer data, gpointer user_data)
+{
+    init_sats_job_t *job = (init_sats_job_t *) data;
+    guint           i;
+    guint           last = MIN(job->first + INIT_SATS_CHUNK, job->sats->len);
+
+    (void)user_data;
+
+    for (i = job->first; i < last; i++)
+        gtk_sat_data_init_sat(SAT(g_ptr_array_index(job->sats, i)), job->qth);
+
+    g_free(job);
+}
+
+/**
+ * Initialise many satellites.
+ *
+ * @param sats The satellites to initialise.
+ * @param qth Optional QTH info, use (0,0) if NULL.
+ *
+ * The satellites are initialised in parallel using one thread per processor.
+ * The function returns when all satellites have been initialised.
+ */
+void gtk_sat_data_init_sats(GPtrArray * sats, qth_t * qth)
+{
+    GThreadPool    *pool;
+    init_sats_job_t *job;
+    gint            nthreads;
+    guint           i;
+
+    g_return_if_fail(sats != NULL);
+
+#if GLIB_CHECK_VERSION(2, 36, 0)
+    nthreads = (gint) g_get_num_processors();
+#else
+    nthreads = 4;
+#endif
+
+    pool = NULL;
+    if (nthreads > 1 && sats->len > INIT_SATS_CHUNK)
+        pool = g_thread_pool_new(init_sats_job, NULL, nthreads, FALSE, NULL);
+
+    for (i = 0; i < sats->len; i += INIT_SATS_CHUNK)
+    {
+        job = g_new(init_sats_job_t, 1);
+        job->sats = sats;
+        job->first = i;
+        job->qth = qth;
+
+        if (pool != NULL)
+            g_thread_pool_push(pool, job, NULL);
+        else
+            init_sats_job(job, NULL);
+    }
+
+    /* wait for the jobs to complete */
+    if (pool != NULL)
+        g_thread_pool_free(pool, FALSE, TRUE);
+}
+
 /**
  * Copy satellite data.
  *
@@ -320,6 +395,8 @@ void gtk_sat_data_copy_sat(const sat_t * source, sat_t * dest, qth_t * qth)
     dest->range_rate = 0.0;
     dest->ra = 0.0;
     dest->dec = 0.0;
+    dest->radec_utc = -1.0;
+    dest->anchor.jul_utc = 0.0;
     dest->ssplat = 0.0;
     dest->ssplon = 0.0;
     dest->alt = 0.0;
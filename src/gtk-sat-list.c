@@ -38,6 +38,7 @@
 #include "locator.h"
 #include "mod-cfg-get-param.h"
 #include "orbit-tools.h"
+#include "predict-tools.h"
 #include "sat-cfg.h"
 #include "sat-info.h"
 #include "sat-log.h"
@@ -213,8 +214,6 @@ static void     row_activated_cb(GtkTreeView * tree_view, GtkTreePath * path,
 
 static void     view_popup_menu(GtkWidget * treeview, GdkEventButton * event,
                                 gpointer list);
-static void     Calculate_RADec(sat_t * sat, qth_t * qth,
-                                obs_astro_t * obs_set);
 
 static GtkVBoxClass *parent_class = NULL;
 
@@ -708,12 +707,7 @@ static gboolean sat_list_update_sats(GtkTreeModel * model, GtkTreePath * path,
         /* Ra and Dec */
         if (satlist->flags & (SAT_LIST_FLAG_RA | SAT_LIST_FLAG_DEC))
         {
-            obs_astro_t     astro;
-
-            Calculate_RADec(sat, satlist->qth, &astro);
-
-            sat->ra = Degrees(astro.ra);
-            sat->dec = Degrees(astro.dec);
+            predict_calc_radec(sat, satlist->qth);
 
             gtk_list_store_set(GTK_LIST_STORE(model), iter,
                                SAT_LIST_COL_RA, sat->ra, SAT_LIST_COL_DEC,
@@ -1353,53 +1347,6 @@ static void view_popup_menu(GtkWidget * treeview, GdkEventButton * event,
     g_free(catnum);
 }
 
-/*** FIXME: formalise with other copies, only need az,el and jul_utc */
-static void Calculate_RADec(sat_t * sat, qth_t * qth, obs_astro_t * obs_set)
-{
-    /* Reference:  Methods of Orbit Determination by  */
-    /*                Pedro Ramon Escobal, pp. 401-402 */
-
-    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
-        az, el, Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Ez, Zz,
-        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
-    geodetic_t      geodetic;
-
-    geodetic.lon = qth->lon * de2ra;
-    geodetic.lat = qth->lat * de2ra;
-    geodetic.alt = qth->alt / 1000.0;
-    geodetic.theta = 0;
-
-    az = sat->az * de2ra;
-    el = sat->el * de2ra;
-    phi = geodetic.lat;
-    theta = FMod2p(ThetaG_JD(sat->jul_utc) + geodetic.lon);
-    sin_theta = sin(theta);
-    cos_theta = cos(theta);
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
-    Lxh = -cos(az) * cos(el);
-    Lyh = sin(az) * cos(el);
-    Lzh = sin(el);
-    Sx = sin_phi * cos_theta;
-    Ex = -sin_theta;
-    Zx = cos_theta * cos_phi;
-    Sy = sin_phi * sin_theta;
-    Ey = cos_theta;
-    Zy = sin_theta * cos_phi;
-    Sz = -cos_phi;
-    Ez = 0;
-    Zz = sin_phi;
-    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
-    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
-    Lz = Sz * Lxh + Ez * Lyh + Zz * Lzh;
-    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
-    cos_delta = sqrt(1 - Sqr(Lz));
-    sin_alpha = Ly / cos_delta;
-    cos_alpha = Lx / cos_delta;
-    obs_set->ra = AcTan(sin_alpha, cos_alpha);  /* Right Ascension (radians) */
-    obs_set->ra = FMod2p(obs_set->ra);
-}
-
 /** Reload reference to satellites (e.g. after TLE update). */
 void gtk_sat_list_reload_sats(GtkWidget * satlist, GHashTable * sats)
 {
@@ -36,7 +36,7 @@
 #include "gtk-sat-map-ground-track.h"
 #include "gtk-sat-map.h"
 #include "locator.h"
-#include "map-tools.h"
+#include "map-cache.h"
 #include "mod-cfg-get-param.h"
 #include "orbit-tools.h"
 #include "predict-tools.h"
@@ -57,6 +57,7 @@ static void     gtk_sat_map_destroy(GtkWidget * widget);
 static void     size_allocate_cb(GtkWidget * widget,
                                  GtkAllocation * allocation, gpointer data);
 static void     update_map_size(GtkSatMap * satmap);
+static void     rescale_map(GtkSatMap * satmap);
 static void     update_sat(gpointer key, gpointer value, gpointer data);
 static void     plot_sat(gpointer key, gpointer value, gpointer data);
 static void     lonlat_to_xy(GtkSatMap * m, gdouble lon, gdouble lat,
@@ -172,12 +173,35 @@ static void gtk_sat_map_init(GtkSatMap * satmap)
     satmap->showgrid = FALSE;
     satmap->keepratio = FALSE;
     satmap->resize = FALSE;
+    satmap->origmap = NULL;
+    satmap->scale_gen = 0;
+    satmap->scaling = FALSE;
+    satmap->rescale = FALSE;
+    satmap->tick_id = 0;
 }
 
 static void gtk_sat_map_destroy(GtkWidget * widget)
 {
-    gtk_sat_map_store_showtracks(GTK_SAT_MAP(widget));
-    gtk_sat_map_store_hidecovs(GTK_SAT_MAP(widget));
+    GtkSatMap      *satmap = GTK_SAT_MAP(widget);
+
+    if (satmap->tick_id != 0)
+    {
+        gtk_widget_remove_tick_callback(satmap->canvas, satmap->tick_id);
+        satmap->tick_id = 0;
+    }
+
+    gtk_sat_map_store_showtracks(satmap);
+    gtk_sat_map_store_hidecovs(satmap);
+
+    /* discard the result of a running scaling job */
+    satmap->scale_gen++;
+
+    if (satmap->origmap != NULL)
+    {
+        map_cache_release(satmap->origmap);
+        satmap->origmap = NULL;
+    }
+
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
 
@@ -403,10 +427,114 @@ static void size_allocate_cb(GtkWidget * widget, GtkAllocation * allocation,
     GTK_SAT_MAP(data)->resize = TRUE;
 }
 
+/* Move the marker and label of a satellite to its screen position */
+static void move_sat_obj(GtkSatMap * satmap, sat_map_obj_t * obj)
+{
+    gdouble         x = obj->motion.x;
+    gdouble         y = obj->motion.y;
+
+    g_object_set(obj->marker,
+                 "x", (gdouble) (x - MARKER_SIZE_HALF),
+                 "y", (gdouble) (y - MARKER_SIZE_HALF), NULL);
+    g_object_set(obj->shadowm,
+                 "x", (gdouble) (x - MARKER_SIZE_HALF + 1),
+                 "y", (gdouble) (y - MARKER_SIZE_HALF + 1), NULL);
+
+    if (x < 50)
+    {
+        g_object_set(obj->label,
+                     "x", (gdouble) (x + 3),
+                     "y", (gdouble) (y), "anchor", GOO_CANVAS_ANCHOR_WEST,
+                     NULL);
+        g_object_set(obj->shadowl, "x", (gdouble) (x + 3 + 1), "y",
+                     (gdouble) (y + 1), "anchor", GOO_CANVAS_ANCHOR_WEST,
+                     NULL);
+    }
+    else if ((satmap->width - x) < 50)
+    {
+        g_object_set(obj->label,
+                     "x", (gdouble) (x - 3),
+                     "y", (gdouble) (y), "anchor", GOO_CANVAS_ANCHOR_EAST,
+                     NULL);
+        g_object_set(obj->shadowl, "x", (gdouble) (x - 3 + 1), "y",
+                     (gdouble) (y + 1), "anchor", GOO_CANVAS_ANCHOR_EAST,
+                     NULL);
+    }
+    else if ((satmap->height - y) < 25)
+    {
+        g_object_set(obj->label,
+                     "x", (gdouble) (x),
+                     "y", (gdouble) (y - 2),
+                     "anchor", GOO_CANVAS_ANCHOR_SOUTH, NULL);
+        g_object_set(obj->shadowl,
+                     "x", (gdouble) (x + 1),
+                     "y", (gdouble) (y - 2 + 1),
+                     "anchor", GOO_CANVAS_ANCHOR_SOUTH, NULL);
+    }
+    else
+    {
+        g_object_set(obj->label,
+                     "x", (gdouble) (x),
+                     "y", (gdouble) (y + 2),
+                     "anchor", GOO_CANVAS_ANCHOR_NORTH, NULL);
+        g_object_set(obj->shadowl,
+                     "x", (gdouble) (x + 1),
+                     "y", (gdouble) (y + 2 + 1),
+                     "anchor", GOO_CANVAS_ANCHOR_NORTH, NULL);
+    }
+}
+
+/* Move a satellite to its last calculated position without motion */
+static void snap_sat_obj(gpointer key, gpointer value, gpointer data)
+{
+    sat_map_obj_t  *obj = SAT_MAP_OBJ(value);
+
+    (void)key;
+
+    marker_motion_reset(&obj->motion, obj->motion.x1, obj->motion.y1);
+    move_sat_obj(GTK_SAT_MAP(data), obj);
+}
+
+/* Move the satellites once per frame while they are in motion */
+static gboolean frame_tick_cb(GtkWidget * widget, GdkFrameClock * clock,
+                              gpointer data)
+{
+    GtkSatMap      *satmap = GTK_SAT_MAP(data);
+    GHashTableIter  iter;
+    gpointer        value;
+    sat_map_obj_t  *obj;
+    gint64          frame_time;
+    gboolean        moving;
+    gboolean        active = FALSE;
+
+    if (marker_motion_visible(widget))
+    {
+        frame_time = gdk_frame_clock_get_frame_time(clock);
+
+        g_hash_table_iter_init(&iter, satmap->obj);
+        while (g_hash_table_iter_next(&iter, NULL, &value))
+        {
+            obj = SAT_MAP_OBJ(value);
+            if (marker_motion_step(&obj->motion, frame_time, &moving))
+                move_sat_obj(satmap, obj);
+
+            active = active || moving;
+        }
+    }
+
+    /* restarted by the next data update */
+    if (!active)
+    {
+        satmap->tick_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
 static void update_map_size(GtkSatMap * satmap)
 {
     GtkAllocation   allocation;
-    GdkPixbuf      *pbuf;
     gfloat          x, y;
     gfloat          ratio;      /* ratio between map width and height */
     gfloat          size;       /* size = min (alloc.w, ratio*alloc.h) */
@@ -431,12 +559,6 @@ static void update_map_size(GtkSatMap * satmap)
 
             satmap->x0 = (allocation.width - satmap->width) / 2;
             satmap->y0 = (allocation.height - satmap->height) / 2;
-
-            /* rescale pixbuf */
-            pbuf = gdk_pixbuf_scale_simple(satmap->origmap,
-                                           satmap->width,
-                                           satmap->height,
-                                           GDK_INTERP_BILINEAR);
         }
         else
         {
@@ -444,12 +566,6 @@ static void update_map_size(GtkSatMap * satmap)
             satmap->y0 = 0;
             satmap->width = allocation.width;
             satmap->height = allocation.height;
-
-            /* rescale pixbuf */
-            pbuf = gdk_pixbuf_scale_simple(satmap->origmap,
-                                           satmap->width,
-                                           satmap->height,
-                                           GDK_INTERP_BILINEAR);
         }
 
         /* set canvas bounds to match new size */
@@ -457,12 +573,16 @@ static void update_map_size(GtkSatMap * satmap)
                               satmap->width, satmap->height);
 
 
-        /* redraw static elements */
+        /* stretch the current map until the rescaled one is ready */
         g_object_set(satmap->map,
-                     "pixbuf", pbuf,
                      "x", (gdouble) satmap->x0,
-                     "y", (gdouble) satmap->y0, NULL);
-        g_object_unref(pbuf);
+                     "y", (gdouble) satmap->y0,
+                     "width", (gdouble) satmap->width,
+                     "height", (gdouble) satmap->height,
+                     "scale-to-fit", TRUE, NULL);
+        rescale_map(satmap);
+
+        /* redraw static elements */
 
         redraw_grid_lines(satmap);
 
@@ -492,10 +612,69 @@ static void update_map_size(GtkSatMap * satmap)
                      "y", (gdouble) satmap->y0 + satmap->height - 1, NULL);
 
         g_hash_table_foreach(satmap->sats, update_sat, satmap);
+        g_hash_table_foreach(satmap->obj, snap_sat_obj, satmap);
         satmap->resize = FALSE;
     }
 }
 
+typedef struct {
+    GtkSatMap      *satmap;
+    guint           gen;
+} map_scale_data_t;
+
+static void map_scaled_cb(GdkPixbuf * pbuf, gpointer data)
+{
+    map_scale_data_t *msd = (map_scale_data_t *) data;
+    GtkSatMap      *satmap = msd->satmap;
+
+    if (msd->gen == satmap->scale_gen)
+    {
+        satmap->scaling = FALSE;
+
+        /* even if the size has changed meanwhile, this is closer
+           to the final map than what is shown now */
+        if (pbuf != NULL)
+            g_object_set(satmap->map, "pixbuf", pbuf, NULL);
+
+        if (satmap->rescale)
+            rescale_map(satmap);
+    }
+
+    if (pbuf != NULL)
+        g_object_unref(pbuf);
+    g_object_unref(satmap);
+    g_free(msd);
+}
+
+/*
+ * Scale the original map to the current map size in a worker thread.
+ *
+ * Only one job runs at a time; if the map is resized while a job is running,
+ * a new job is started when it completes.
+ */
+static void rescale_map(GtkSatMap * satmap)
+{
+    map_scale_data_t *msd;
+
+    if (satmap->scaling)
+    {
+        satmap->rescale = TRUE;
+        return;
+    }
+
+    if (satmap->width == 0 || satmap->height == 0)
+        return;
+
+    msd = g_new(map_scale_data_t, 1);
+    msd->satmap = g_object_ref(satmap);
+    msd->gen = ++satmap->scale_gen;
+
+    satmap->scaling = TRUE;
+    satmap->rescale = FALSE;
+    map_scale_async(satmap->origmap, satmap->width, satmap->height,
+                    map_scaled_cb, msd);
+}
+
 static void on_canvas_realized(GtkWidget * canvas, gpointer data)
 {
     GtkSatMap      *satmap = GTK_SAT_MAP(data);
@@ -984,6 +1163,9 @@ void gtk_sat_map_reconf(GtkWidget * widget, GKeyFile * cfgdat)
  *   - If loading of default map does not succeed, create a dummy GdkPixbuf
  *     (and raise all possible alarms)
  *
+ * The decoded map is shared with other map views using the same file and
+ * center longitude and must be released with map_cache_release().
+ *
  * @note satmap->cfgdata should contain a valid GKeyFile.
  *
  */
@@ -992,7 +1174,6 @@ static void load_map_file(GtkSatMap * satmap, float clon)
     gchar          *buff;
     gchar          *mapfile;
     GError         *error = NULL;
-    GdkPixbuf      *tmpbuf;
 
     /* get local, global or default map file */
     buff = mod_cfg_get_str(satmap->cfgdata,
@@ -1035,8 +1216,8 @@ static void load_map_file(GtkSatMap * satmap, float clon)
                     __FILE__, __LINE__, mapfile);
     }
 
-    /* try to load the map file */
-    tmpbuf = gdk_pixbuf_new_from_file(mapfile, &error);
+    /* get the decoded map from the cache or load it */
+    satmap->origmap = map_cache_get(mapfile, clon, &error);
 
     if (error != NULL)
     {
@@ -1046,19 +1227,11 @@ static void load_map_file(GtkSatMap * satmap, float clon)
         g_clear_error(&error);
 
         /* create a dummy GdkPixbuf to avoid crash */
-        tmpbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, 400, 200);
-        gdk_pixbuf_fill(tmpbuf, 0x0F0F0F0F);
+        satmap->origmap = gdk_pixbuf_new(GDK_COLORSPACE_RGB, FALSE, 8, 400,
+                                         200);
+        gdk_pixbuf_fill(satmap->origmap, 0x0F0F0F0F);
     }
 
-    /* create a blank map with same parameters as tmpbuf */
-    satmap->origmap = gdk_pixbuf_new(GDK_COLORSPACE_RGB,
-                                     FALSE,
-                                     gdk_pixbuf_get_bits_per_sample(tmpbuf),
-                                     gdk_pixbuf_get_width(tmpbuf),
-                                     gdk_pixbuf_get_height(tmpbuf));
-
-    map_tools_shift_center(tmpbuf, satmap->origmap, clon);
-    g_object_unref(tmpbuf);
     g_free(mapfile);
 
     /* Calculate longitude at the left side (-180 deg if center is at 0 deg longitude) */
@@ -1728,6 +1901,7 @@ static void plot_sat(gpointer key, gpointer value, gpointer data)
     obj->track_data.latlon = NULL;
     obj->track_data.lines = NULL;
     obj->track_orbit = 0;
+    marker_motion_reset(&obj->motion, x, y);
 
     root = goo_canvas_get_root_item_model(GOO_CANVAS(satmap->canvas));
 
@@ -1874,7 +2048,6 @@ static void update_sat(gpointer key, gpointer value, gpointer data)
     sat_map_obj_t  *obj = NULL;
     sat_t          *sat = SAT(value);
     gfloat          x, y;
-    gdouble         oldx, oldy;
     gdouble         now;        // = get_current_daynum ();
     GooCanvasItemModel *root;
     gint            idx;
@@ -1975,61 +2148,24 @@ static void update_sat(gpointer key, gpointer value, gpointer data)
     lonlat_to_xy(satmap, sat->ssplon, sat->ssplat, &x, &y);
 
     /* update only if satellite has moved at least
-       2 * MARKER_SIZE_HALF (no need to drain CPU all the time)
+       2 * MARKER_SIZE_HALF (no need to drain CPU all the time);
+       the marker itself is moved by the frame clock
      */
-    g_object_get(obj->marker, "x", &oldx, "y", &oldy, NULL);
-
-    if ((fabs(oldx - x) >= 2 * MARKER_SIZE_HALF) ||
-        (fabs(oldy - y) >= 2 * MARKER_SIZE_HALF))
+    if ((fabs(obj->motion.x1 - x) >= 2 * MARKER_SIZE_HALF) ||
+        (fabs(obj->motion.y1 - y) >= 2 * MARKER_SIZE_HALF))
     {
-        g_object_set(obj->marker,
-                     "x", (gdouble) (x - MARKER_SIZE_HALF),
-                     "y", (gdouble) (y - MARKER_SIZE_HALF), NULL);
-        g_object_set(obj->shadowm,
-                     "x", (gdouble) (x - MARKER_SIZE_HALF + 1),
-                     "y", (gdouble) (y - MARKER_SIZE_HALF + 1), NULL);
-
-        if (x < 50)
-        {
-            g_object_set(obj->label,
-                         "x", (gdouble) (x + 3),
-                         "y", (gdouble) (y), "anchor", GOO_CANVAS_ANCHOR_WEST,
-                         NULL);
-            g_object_set(obj->shadowl, "x", (gdouble) (x + 3 + 1), "y",
-                         (gdouble) (y + 1), "anchor", GOO_CANVAS_ANCHOR_WEST,
-                         NULL);
-        }
-        else if ((satmap->width - x) < 50)
-        {
-            g_object_set(obj->label,
-                         "x", (gdouble) (x - 3),
-                         "y", (gdouble) (y), "anchor", GOO_CANVAS_ANCHOR_EAST,
-                         NULL);
-            g_object_set(obj->shadowl, "x", (gdouble) (x - 3 + 1), "y",
-                         (gdouble) (y + 1), "anchor", GOO_CANVAS_ANCHOR_EAST,
-                         NULL);
-        }
-        else if ((satmap->height - y) < 25)
+        if (marker_motion_visible(satmap->canvas))
         {
-            g_object_set(obj->label,
-                         "x", (gdouble) (x),
-                         "y", (gdouble) (y - 2),
-                         "anchor", GOO_CANVAS_ANCHOR_SOUTH, NULL);
-            g_object_set(obj->shadowl,
-                         "x", (gdouble) (x + 1),
-                         "y", (gdouble) (y - 2 + 1),
-                         "anchor", GOO_CANVAS_ANCHOR_SOUTH, NULL);
+            marker_motion_set(&obj->motion, x, y);
+            if (satmap->tick_id == 0)
+                satmap->tick_id =
+                    gtk_widget_add_tick_callback(satmap->canvas,
+                                                 frame_tick_cb, satmap, NULL);
         }
         else
         {
-            g_object_set(obj->label,
-                         "x", (gdouble) (x),
-                         "y", (gdouble) (y + 2),
-                         "anchor", GOO_CANVAS_ANCHOR_NORTH, NULL);
-            g_object_set(obj->shadowl,
-                         "x", (gdouble) (x + 1),
-                         "y", (gdouble) (y + 2 + 1),
-                         "anchor", GOO_CANVAS_ANCHOR_NORTH, NULL);
+            marker_motion_reset(&obj->motion, x, y);
+            move_sat_obj(satmap, obj);
         }
 
         /* initialize points for footprint */
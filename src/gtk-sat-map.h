@@ -8,6 +8,7 @@
 #include <gtk/gtk.h>
 
 #include "gtk-sat-data.h"
+#include "marker-motion.h"
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -68,6 +69,7 @@ typedef struct {
 
     ground_track_t  track_data; /*!< Ground track data. */
     long            track_orbit;        /*!< Orbit when the ground track has been updated. */
+    marker_motion_t motion;     /*!< Marker position between updates. */
 
 } sat_map_obj_t;
 
@@ -120,6 +122,7 @@ typedef struct {
 
     guint           refresh;    /*!< Refresh rate. */
     guint           counter;    /*!< Cycle counter. */
+    guint           tick_id;    /*!< Frame clock callback moving the markers. */
 
     gboolean        show_terminator;    // show solar terminator
     gboolean        qthinfo;    /*!< Show the QTH info. */
@@ -131,7 +134,10 @@ typedef struct {
 
     gchar          *infobgd;    /*!< Background color of info text. */
 
-    GdkPixbuf      *origmap;    /*!< Original map kept here for high quality scaling. */
+    GdkPixbuf      *origmap;    /*!< Original map kept here for high quality scaling (shared, see map-cache.h). */
+    guint           scale_gen;  /*!< Generation of the latest map scaling job. */
+    gboolean        scaling;    /*!< A map scaling job is running. */
+    gboolean        rescale;    /*!< The map must be scaled again when the running job completes. */
 
 } GtkSatMap;
 
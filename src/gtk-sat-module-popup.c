@@ -35,6 +35,7 @@
 #include "gtk-sat-module-tmg.h"
 #include "gtk-sky-glance.h"
 #include "mod-mgr.h"
+#include "pass-query-dialog.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 #include "sgpsdp/sgp4sdp4.h"
@@ -49,6 +50,7 @@ static void     screen_state_cb(GtkWidget * menuitem, gpointer data);
 static void     sat_selected_cb(GtkWidget * menuitem, gpointer data);
 static void     sky_at_glance_cb(GtkWidget * menuitem, gpointer data);
 static void     tmgr_cb(GtkWidget * menuitem, gpointer data);
+static void     pass_query_cb(GtkWidget * menuitem, gpointer data);
 static void     rigctrl_cb(GtkWidget * menuitem, gpointer data);
 static void     rotctrl_cb(GtkWidget * menuitem, gpointer data);
 static void     delete_cb(GtkWidget * menuitem, gpointer data);
@@ -172,6 +174,11 @@ void gtk_sat_module_popup(GtkSatModule * module)
     gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
     g_signal_connect(menuitem, "activate", G_CALLBACK(tmgr_cb), module);
 
+    /* pass search */
+    menuitem = gtk_menu_item_new_with_label(_("Search passes..."));
+    gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
+    g_signal_connect(menuitem, "activate", G_CALLBACK(pass_query_cb), module);
+
     /* separator */
     menuitem = gtk_separator_menu_item_new();
     gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
@@ -862,6 +869,17 @@ static void tmgr_cb(GtkWidget * menuitem, gpointer data)
     tmg_create(module);
 }
 
+/** Open the pass search dialog. */
+static void pass_query_cb(GtkWidget * menuitem, gpointer data)
+{
+    GtkSatModule   *module = GTK_SAT_MODULE(data);
+
+    (void)menuitem;
+
+    show_pass_query_dialog(module,
+                           gtk_widget_get_toplevel(GTK_WIDGET(module)));
+}
+
 /**
  * Open Radio control window.
  *
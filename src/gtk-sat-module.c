@@ -59,10 +59,12 @@
 #include "mod-mgr.h"
 #include "orbit-tools.h"
 #include "predict-tools.h"
+#include "sat-catalog.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 #include "sgpsdp/sgp4sdp4.h"
 #include "time-tools.h"
+#include "tle-archive.h"
 
 
 static GtkVBoxClass *parent_class = NULL;
@@ -180,6 +182,12 @@ static void gtk_sat_module_destroy(GtkWidget * widget)
         module->satellites = NULL;
     }
 
+    if (module->archives)
+    {
+        g_hash_table_destroy(module->archives);
+        module->archives = NULL;
+    }
+
     if (module->grid)
     {
         g_free(module->grid);
@@ -211,6 +219,9 @@ static void gtk_sat_module_init(GtkSatModule * module)
 
     module->satellites = g_hash_table_new_full(g_int_hash, g_int_equal,
                                                g_free, gtk_sat_module_free_sat);
+    module->archives = g_hash_table_new_full(g_int_hash, g_int_equal, g_free,
+                                             (GDestroyNotify)
+                                             tle_archive_free);
 
     module->rotctrlwin = NULL;
     module->rotctrl = NULL;
@@ -407,6 +418,11 @@ static void gtk_sat_module_load_sats(GtkSatModule * module)
     sat_t          *sat;
     guint          *key = NULL;
     guint           succ = 0;
+    GPtrArray      *newsats;
+    tle_archive_t  *archive;
+    gint64          t0, t1;
+
+    t0 = g_get_monotonic_time();
 
     /* get list of satellites from config file; abort in case of error */
     sats = g_key_file_get_integer_list(module->cfgdata,
@@ -431,6 +447,7 @@ static void gtk_sat_module_load_sats(GtkSatModule * module)
     }
 
     /* read each satellite into hash table */
+    newsats = g_ptr_array_sized_new(length);
     for (i = 0; i < length; i++)
     {
         sat = g_new(sat_t, 1);
@@ -454,7 +471,7 @@ static void gtk_sat_module_load_sats(GtkSatModule * module)
 
             if (g_hash_table_lookup(module->satellites, key) == NULL)
             {
-                gtk_sat_data_init_sat(sat, module->qth);
+                g_ptr_array_add(newsats, sat);
                 g_hash_table_insert(module->satellites, key, sat);
                 succ++;
                 sat_log_log(SAT_LOG_LEVEL_DEBUG,
@@ -473,8 +490,28 @@ static void gtk_sat_module_load_sats(GtkSatModule * module)
         }
     }
 
+    /* initialise the satellites in parallel */
+    t1 = g_get_monotonic_time();
+    gtk_sat_data_init_sats(newsats, module->qth);
+
+    /* load older element sets of the satellites */
+    for (i = 0; i < newsats->len; i++)
+    {
+        sat = SAT(g_ptr_array_index(newsats, i));
+        archive = tle_archive_load(sat);
+        if (archive != NULL)
+        {
+            key = g_new0(guint, 1);
+            *key = sat->tle.catnr;
+            g_hash_table_insert(module->archives, key, archive);
+        }
+    }
+    g_ptr_array_free(newsats, TRUE);
+
     sat_log_log(SAT_LOG_LEVEL_INFO,
-                _("%s: Read %d out of %d satellites"), __func__, succ, length);
+                _("%s: Read %d out of %d satellites "
+                  "(read %.1f ms, init %.1f ms)"), __func__, succ, length,
+                (t1 - t0) / 1000.0, (g_get_monotonic_time() - t1) / 1000.0);
 
     g_free(sats);
 }
@@ -598,6 +635,29 @@ static void update_child(GtkWidget * child, gdouble tstamp)
     }
 }
 
+/**
+ * Check whether a satellite must be calculated with full precision.
+ *
+ * This is the case for the selected satellite and for the targets of the
+ * radio and rotator controllers. All other satellites are only displayed and
+ * use the approximation of predict_calc_approx().
+ */
+static gboolean needs_full_precision(GtkSatModule * module, sat_t * sat)
+{
+    if (sat->tle.catnr == module->target)
+        return TRUE;
+
+    if (module->rigctrl != NULL &&
+        GTK_RIG_CTRL(module->rigctrl)->target == sat)
+        return TRUE;
+
+    if (module->rotctrl != NULL &&
+        GTK_ROT_CTRL(module->rotctrl)->target == sat)
+        return TRUE;
+
+    return FALSE;
+}
+
 /**
  * Update a given satellite.
  *
@@ -613,11 +673,10 @@ static void gtk_sat_module_update_sat(gpointer key, gpointer val,
 {
     sat_t          *sat;
     GtkSatModule   *module;
+    tle_archive_t  *archive;
     gdouble         daynum;
     gdouble         maxdt;
 
-    (void)key;
-
     g_return_if_fail((val != NULL) && (data != NULL));
 
     sat = SAT(val);
@@ -627,6 +686,11 @@ static void gtk_sat_module_update_sat(gpointer key, gpointer val,
     /* get current time (real or simulated */
     daynum = module->tmgCdnum;
 
+    /* use the archived element set closest to the current time */
+    archive = g_hash_table_lookup(module->archives, key);
+    if (archive != NULL)
+        tle_archive_select(archive, sat, module->qth, daynum);
+
     /* update events if the event counter has been reset
        and the other requirements are fulfilled */
     if ((GTK_SAT_MODULE(module)->event_count == 0) &&
@@ -682,7 +746,72 @@ static void gtk_sat_module_update_sat(gpointer key, gpointer val,
     if (sat->los > 0 && sat->los < daynum)
         sat->los = find_los(sat, module->qth, daynum, maxdt);
 
-    predict_calc(sat, module->qth, daynum);
+    if (needs_full_precision(module, sat))
+        predict_calc(sat, module->qth, daynum);
+    else
+        predict_calc_approx(sat, module->qth, daynum,
+                            sat_cfg_get_int(SAT_CFG_INT_PRED_APPROX_ERR) /
+                            1000.0);
+}
+
+/**
+ * Adopt the elements of a new satellite catalog version.
+ *
+ * @param module The module.
+ * @param catalog The current catalog.
+ *
+ * The satellites whose elements have changed are re-initialised in place, so
+ * the views keep their state and pick up the new elements with the next
+ * update.
+ */
+static void adopt_catalog(GtkSatModule * module, sat_catalog_t * catalog)
+{
+    GHashTableIter  iter;
+    gpointer        key, value;
+    sat_t          *sat;
+    const tle_t    *tle;
+    tle_archive_t  *archive;
+    guint          *archkey;
+    guint           num = 0;
+
+    g_hash_table_iter_init(&iter, module->satellites);
+    while (g_hash_table_iter_next(&iter, &key, &value))
+    {
+        sat = SAT(value);
+        tle = sat_catalog_lookup(catalog, sat->tle.catnr);
+        if ((tle == NULL) || ((tle->epoch == sat->tle.epoch) &&
+                              (tle->status == sat->tle.status)))
+            continue;
+
+        /* keep the elements in use available to the time controller */
+        archive = g_hash_table_lookup(module->archives, key);
+        if (archive == NULL)
+        {
+            archive = tle_archive_new();
+            archkey = g_new0(guint, 1);
+            *archkey = sat->tle.catnr;
+            g_hash_table_insert(module->archives, archkey, archive);
+        }
+        tle_archive_insert(archive, sat);
+
+        sat->tle = *tle;
+        sat->flags = 0;
+        select_ephemeris(sat);
+        gtk_sat_data_init_sat(sat, module->qth);
+        tle_archive_insert(archive, sat);
+        num++;
+    }
+
+    module->catalog_version = sat_catalog_version(catalog);
+
+    if (num > 0)
+    {
+        /* recalculate AOS/LOS with the new elements */
+        module->event_count = 0;
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s: Module %s adopted new elements for %d satellites"),
+                    __func__, module->name, num);
+    }
 }
 
 /** Module timeout callback. */
@@ -690,6 +819,7 @@ static gboolean gtk_sat_module_timeout_cb(gpointer module)
 {
     GtkSatModule   *mod = GTK_SAT_MODULE(module);
     GtkWidget      *child;
+    sat_catalog_t  *catalog;
     gboolean        needupdate = FALSE;
     GdkWindowState  state;
     gdouble         delta;
@@ -730,6 +860,12 @@ static gboolean gtk_sat_module_timeout_cb(gpointer module)
             return TRUE;
         }
 
+        /* pick up the results of a background TLE update */
+        catalog = sat_catalog_get();
+        if ((catalog != NULL) &&
+            (sat_catalog_version(catalog) != mod->catalog_version))
+            adopt_catalog(mod, catalog);
+
         mod->rtNow = get_current_daynum();
 
         /* Update time if throttle != 0 */
@@ -1447,6 +1583,7 @@ void gtk_sat_module_reload_sats(GtkSatModule * module)
 
     /* remove each element from the hash table, but keep the hash table */
     g_hash_table_foreach_remove(module->satellites, empty, NULL);
+    g_hash_table_remove_all(module->archives);
 
     /* reset event counter so that next AOS/LOS gets re-calculated */
     module->event_count = 0;
@@ -78,6 +78,8 @@ struct _gtk_sat_module {
     qth_t          *qth;        /*!< QTH information. */
     qth_small_t     qth_event;  /*!< QTH information for last AOS/LOS update. */
     GHashTable     *satellites; /*!< Satellites. */
+    GHashTable     *archives;   /*!< TLE archives of the satellites. */
+    guint           catalog_version;    /*!< Adopted satellite catalog version. */
 
     guint32         timeout;    /*!< Timeout value [msec] */
 
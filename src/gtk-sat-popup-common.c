@@ -25,6 +25,7 @@
 #include "predict-tools.h"
 #include "sat-cfg.h"
 #include "sat-pass-dialogs.h"
+#include "time-tools.h"
 
 
 void add_pass_menu_items(GtkWidget * menu, sat_t * sat, qth_t * qth,
@@ -118,43 +119,20 @@ void show_next_pass_dialog(sat_t * sat, qth_t * qth, gdouble tstamp,
                            GtkWindow * toplevel)
 {
     GtkWidget      *dialog;
-    pass_t         *pass;
+    gdouble         start;
 
     /* check whether sat actually has AOS */
     if (has_aos(sat, qth))
     {
         if (sat_cfg_get_bool(SAT_CFG_BOOL_PRED_USE_REAL_T0))
-        {
-            pass = get_next_pass(sat, qth,
-                                 sat_cfg_get_int(SAT_CFG_INT_PRED_LOOK_AHEAD));
-        }
+            start = get_current_daynum();
         else
-        {
-            pass = get_pass(sat, qth, tstamp,
-                            sat_cfg_get_int(SAT_CFG_INT_PRED_LOOK_AHEAD));
-        }
-
-        if (pass != NULL)
-        {
-            show_pass(sat->nickname, qth, pass, GTK_WIDGET(toplevel));
-        }
-        else
-        {
-            /* show dialog that there are no passes within time frame */
-            dialog = gtk_message_dialog_new(toplevel,
-                                            GTK_DIALOG_MODAL |
-                                            GTK_DIALOG_DESTROY_WITH_PARENT,
-                                            GTK_MESSAGE_INFO,
-                                            GTK_BUTTONS_OK,
-                                            _("Satellite %s has no passes\n"
-                                              "within the next %d days"),
-                                            sat->nickname,
-                                            sat_cfg_get_int
-                                            (SAT_CFG_INT_PRED_LOOK_AHEAD));
-
-            gtk_dialog_run(GTK_DIALOG(dialog));
-            gtk_widget_destroy(dialog);
-        }
+            start = tstamp;
+
+        /* prediction runs in a worker; the dialog handles empty results */
+        show_next_pass_async(sat, qth, start,
+                             sat_cfg_get_int(SAT_CFG_INT_PRED_LOOK_AHEAD),
+                             GTK_WIDGET(toplevel));
     }
     else
     {
@@ -181,52 +159,21 @@ void show_next_pass_dialog(sat_t * sat, qth_t * qth, gdouble tstamp,
 void show_future_passes_dialog(sat_t * sat, qth_t * qth, gdouble tstamp,
                                GtkWindow * toplevel)
 {
-    GSList         *passes = NULL;
-    GtkWidget      *dialog;
+    gdouble         start;
 
     /* check wheather sat actially has AOS */
     if (has_aos(sat, qth))
     {
-
         if (sat_cfg_get_bool(SAT_CFG_BOOL_PRED_USE_REAL_T0))
-        {
-            passes = get_next_passes(sat, qth,
-                                     sat_cfg_get_int
-                                     (SAT_CFG_INT_PRED_LOOK_AHEAD),
-                                     sat_cfg_get_int
-                                     (SAT_CFG_INT_PRED_NUM_PASS));
-        }
-        else
-        {
-            passes = get_passes(sat, qth, tstamp,
-                                sat_cfg_get_int(SAT_CFG_INT_PRED_LOOK_AHEAD),
-                                sat_cfg_get_int(SAT_CFG_INT_PRED_NUM_PASS));
-
-        }
-
-
-        if (passes != NULL)
-        {
-            show_passes(sat->nickname, qth, passes, GTK_WIDGET(toplevel));
-        }
+            start = get_current_daynum();
         else
-        {
-            /* show dialog that there are no passes within time frame */
-            dialog = gtk_message_dialog_new(toplevel,
-                                            GTK_DIALOG_MODAL |
-                                            GTK_DIALOG_DESTROY_WITH_PARENT,
-                                            GTK_MESSAGE_INFO,
-                                            GTK_BUTTONS_OK,
-                                            _("Satellite %s has no passes\n"
-                                              "within the next %d days"),
-                                            sat->nickname,
-                                            sat_cfg_get_int
-                                            (SAT_CFG_INT_PRED_LOOK_AHEAD));
-
-            gtk_dialog_run(GTK_DIALOG(dialog));
-            gtk_widget_destroy(dialog);
-        }
+            start = tstamp;
 
+        /* passes are added to the dialog as they are found */
+        show_passes_async(sat, qth, start,
+                          sat_cfg_get_int(SAT_CFG_INT_PRED_LOOK_AHEAD),
+                          sat_cfg_get_int(SAT_CFG_INT_PRED_NUM_PASS),
+                          GTK_WIDGET(toplevel));
     }
     else
     {
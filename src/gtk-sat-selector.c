@@ -51,7 +51,141 @@ enum {
 static guint    gtksatsel_signals[LAST_SIGNAL] = { 0 };
 
 
+/* number of satellites loaded into the "all" group per idle callback */
+#define SAT_LOAD_BATCH 200
+
 static void     create_and_fill_models(GtkSatSelector * selector);
+static void     load_group(GtkSatSelector * selector, GtkListStore * store);
+static void     load_all_pending(GtkSatSelector * selector);
+
+/** Location of a satellite row in one of the selector models. */
+typedef struct {
+    GtkListStore   *store;
+    GtkTreeIter     iter;
+} sat_row_t;
+
+/** Data of a satellite shown in the selector. */
+typedef struct {
+    gchar          *name;       /*!< Nickname, NULL if the .sat file is bad. */
+    gdouble         epoch;      /*!< Element set epoch. */
+} sat_info_t;
+
+static void free_sat_info(gpointer data)
+{
+    sat_info_t     *info = (sat_info_t *) data;
+
+    g_free(info->name);
+    g_free(info);
+}
+
+/**
+ * Get the name and epoch of a satellite.
+ *
+ * The .sat file is read the first time a satellite is needed, so each file
+ * is parsed at most once no matter how many groups the satellite is in.
+ *
+ * @return The satellite data or NULL if the .sat file could not be read.
+ */
+static const sat_info_t *lookup_sat(GtkSatSelector * selector, gint catnum)
+{
+    sat_info_t     *info;
+    sat_t           sat;
+
+    info = g_hash_table_lookup(selector->sats, GINT_TO_POINTER(catnum));
+    if (info == NULL)
+    {
+        info = g_new0(sat_info_t, 1);
+        if (gtk_sat_data_read_sat(catnum, &sat))
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s:%s: Error reading satellite %d."),
+                        __FILE__, __func__, catnum);
+        }
+        else
+        {
+            info->name = g_strdup(sat.nickname);
+            info->epoch = sat.jul_epoch;
+            g_free(sat.name);
+            g_free(sat.nickname);
+        }
+        g_hash_table_insert(selector->sats, GINT_TO_POINTER(catnum), info);
+    }
+
+    return (info->name != NULL) ? info : NULL;
+}
+
+/** Create an empty satellite list store */
+static GtkListStore *new_sat_store(void)
+{
+    return gtk_list_store_new(GTK_SAT_SELECTOR_COL_NUM, G_TYPE_STRING,  // name
+                              G_TYPE_INT,       // catnum
+                              G_TYPE_DOUBLE,    // epoch
+                              G_TYPE_BOOLEAN    // selected
+        );
+}
+
+/** Free the list of rows stored for a catnum in selector->rows */
+static void free_sat_rows(gpointer data)
+{
+    GSList         *rows = (GSList *) data;
+    GSList         *node;
+    sat_row_t      *row;
+
+    for (node = rows; node != NULL; node = node->next)
+    {
+        row = (sat_row_t *) node->data;
+        g_object_unref(row->store);
+        g_free(row);
+    }
+    g_slist_free(rows);
+}
+
+/**
+ * Add a newly inserted row to the catnum index.
+ *
+ * GtkListStore iters persist as long as the row exists, and rows are never
+ * removed from the selector models, so the iter can be stored directly.
+ */
+static void index_sat_row(GtkSatSelector * selector, GtkListStore * store,
+                          GtkTreeIter * iter, gint catnum)
+{
+    sat_row_t      *row;
+    GSList         *rows;
+
+    row = g_new(sat_row_t, 1);
+    row->store = g_object_ref(store);
+    row->iter = *iter;
+
+    /* steal the list so that it is not freed when replaced */
+    rows = g_hash_table_lookup(selector->rows, GINT_TO_POINTER(catnum));
+    g_hash_table_steal(selector->rows, GINT_TO_POINTER(catnum));
+    rows = g_slist_prepend(rows, row);
+    g_hash_table_insert(selector->rows, GINT_TO_POINTER(catnum), rows);
+}
+
+/** Add a satellite to a selector model; returns FALSE if it can not be read */
+static gboolean append_sat_row(GtkSatSelector * selector, GtkListStore * store,
+                               gint catnum)
+{
+    const sat_info_t *info;
+    GtkTreeIter     node;
+
+    info = lookup_sat(selector, catnum);
+    if (info == NULL)
+        return FALSE;
+
+    gtk_list_store_insert_with_values(store, &node, -1,
+                                      GTK_SAT_SELECTOR_COL_NAME, info->name,
+                                      GTK_SAT_SELECTOR_COL_CATNUM, catnum,
+                                      GTK_SAT_SELECTOR_COL_EPOCH, info->epoch,
+                                      GTK_SAT_SELECTOR_COL_SELECTED,
+                                      g_hash_table_contains(selector->selected,
+                                                            GINT_TO_POINTER
+                                                            (catnum)), -1);
+    index_sat_row(selector, store, &node, catnum);
+
+    return TRUE;
+}
 
 
 /** Clean up memory before destroying satellite selector widget */
@@ -73,6 +207,36 @@ static void gtk_sat_selector_destroy(GtkWidget * widget)
         selector->models = g_slist_remove(selector->models, data);
     }
 
+    if (selector->loader > 0)
+    {
+        g_source_remove(selector->loader);
+        selector->loader = 0;
+    }
+
+    if (selector->rows != NULL)
+    {
+        g_hash_table_destroy(selector->rows);
+        selector->rows = NULL;
+    }
+
+    if (selector->sats != NULL)
+    {
+        g_hash_table_destroy(selector->sats);
+        selector->sats = NULL;
+    }
+
+    if (selector->selected != NULL)
+    {
+        g_hash_table_destroy(selector->selected);
+        selector->selected = NULL;
+    }
+
+    if (selector->pending != NULL)
+    {
+        g_array_free(selector->pending, TRUE);
+        selector->pending = NULL;
+    }
+
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
 
@@ -99,6 +263,13 @@ static void gtk_sat_selector_class_init(GtkSatSelectorClass * class)
 static void gtk_sat_selector_init(GtkSatSelector * selector)
 {
     selector->models = NULL;
+    selector->rows = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+                                           NULL, free_sat_rows);
+    selector->sats = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+                                           NULL, free_sat_info);
+    selector->selected = g_hash_table_new(g_direct_hash, g_direct_equal);
+    selector->pending = g_array_new(FALSE, FALSE, sizeof(gint));
+    selector->loader = 0;
 }
 
 GType gtk_sat_selector_get_type()
@@ -316,6 +487,7 @@ static void epoch_cell_data_function(GtkTreeViewColumn * col,
  * list according to the new selection. This task is very simple because the
  * proper liststore has already been constructed and stored in selector->models[i]
  * where i corresponds to the index of the newly selected group in the combo box.
+ * The satellites of a group are loaded the first time it is selected.
  */
 static void group_selected_cb(GtkComboBox * combobox, gpointer data)
 {
@@ -335,6 +507,7 @@ static void group_selected_cb(GtkComboBox * combobox, gpointer data)
 
     /* now replace oldmodel with newmodel */
     newmodel = GTK_TREE_MODEL(g_slist_nth_data(selector->models, sel));
+    load_group(selector, GTK_LIST_STORE(newmodel));
 
     /* We changed the GtkTreeModel so we need to reset the sort column ID */
     gtk_tree_sortable_set_sort_func(GTK_TREE_SORTABLE(newmodel),
@@ -521,25 +694,23 @@ GtkWidget      *gtk_sat_selector_new(guint flags)
  * Load satellites from a .cat file
  *
  * @param selector Pointer to the GtkSatSelector
+ * @param store The model of the group.
  * @param fname The name of the .cat file (name only, no path)
  *
- * This function is used to encapsulate reading the clear text name and the contents
- * of a .cat file. It is used for building the satellite tree store models
+ * The first line of the file, containing the category name, has already
+ * been read by create_and_fill_models(). The remaining lines are the
+ * catalog numbers of the satellites in the group.
  */
-static void load_cat_file(GtkSatSelector * selector, const gchar * fname)
+static void load_cat_file(GtkSatSelector * selector, GtkListStore * store,
+                          const gchar * fname)
 {
     GIOChannel     *catfile;
     GError         *error = NULL;
-    GtkListStore   *store;      /* the list store data structure */
-    GtkTreeIter     node;       /* new top level node added to the tree store */
     gchar          *path;
     gchar          *buff;
-    sat_t           sat;
     gint            catnum;
     guint           num = 0;
 
-    /* .cat files contains clear text category name in the first line
-       then one satellite catalog number per line */
     path = sat_file_name(fname);
     catfile = g_io_channel_new_file(path, "r", &error);
     if (error != NULL)
@@ -548,75 +719,40 @@ static void load_cat_file(GtkSatSelector * selector, const gchar * fname)
                     _("%s:%s: Failed to open %s: %s"),
                     __FILE__, __func__, fname, error->message);
         g_clear_error(&error);
+        g_free(path);
+        return;
     }
-    else
+
+    /* skip category name */
+    if (g_io_channel_read_line(catfile, &buff, NULL, NULL, NULL) ==
+        G_IO_STATUS_NORMAL)
     {
-        /* read first line => category name */
-        if (g_io_channel_read_line(catfile, &buff, NULL, NULL, NULL) ==
-            G_IO_STATUS_NORMAL)
-        {
-            g_strstrip(buff);   /* removes trailing newline */
-            gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT
-                                           (selector->groups), buff);
-            g_free(buff);
+        g_free(buff);
 
-            /* we can safely create the liststore for this category */
-            store = gtk_list_store_new(GTK_SAT_SELECTOR_COL_NUM, G_TYPE_STRING, // name
-                                       G_TYPE_INT,      // catnum
-                                       G_TYPE_DOUBLE,   // epoch
-                                       G_TYPE_BOOLEAN   // selected
-                );
-            selector->models = g_slist_append(selector->models, store);
-
-            /* Remaining lines are catalog numbers for satellites.
-               Read line by line until the first error, which hopefully is G_IO_STATUS_EOF
-             */
-            while (g_io_channel_read_line(catfile, &buff, NULL, NULL, NULL) ==
-                   G_IO_STATUS_NORMAL)
-            {
-                /* stip trailing EOL */
-                g_strstrip(buff);
-
-                /* catalog number to integer */
-                catnum = (gint) g_ascii_strtoll(buff, NULL, 0);
-
-                /* try to read satellite data */
-                if (gtk_sat_data_read_sat(catnum, &sat))
-                {
-                    /* error */
-                    sat_log_log(SAT_LOG_LEVEL_ERROR,
-                                _("%s:%s: Error reading satellite %d."),
-                                __FILE__, __func__, catnum);
-                }
-                else
-                {
-                    /* insert satellite into liststore */
-                    gtk_list_store_append(store, &node);
-                    gtk_list_store_set(store, &node,
-                                       GTK_SAT_SELECTOR_COL_NAME, sat.nickname,
-                                       GTK_SAT_SELECTOR_COL_CATNUM, catnum,
-                                       GTK_SAT_SELECTOR_COL_EPOCH,
-                                       sat.jul_epoch,
-                                       GTK_SAT_SELECTOR_COL_SELECTED, FALSE,
-                                       -1);
-                    g_free(sat.name);
-                    g_free(sat.nickname);
-                    num++;
-                }
-
-                g_free(buff);
-            }
-            sat_log_log(SAT_LOG_LEVEL_INFO,
-                        _("%s:%s: Read %d satellites from %s"),
-                        __FILE__, __func__, num, fname);
-        }
-        else
+        /* Remaining lines are catalog numbers for satellites.
+           Read line by line until the first error, which hopefully is G_IO_STATUS_EOF
+         */
+        while (g_io_channel_read_line(catfile, &buff, NULL, NULL, NULL) ==
+               G_IO_STATUS_NORMAL)
         {
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s:%s: Failed to read %s"),
-                        __FILE__, __func__, fname);
-        }
+            /* stip trailing EOL */
+            g_strstrip(buff);
+
+            /* catalog number to integer */
+            catnum = (gint) g_ascii_strtoll(buff, NULL, 0);
+            if (append_sat_row(selector, store, catnum))
+                num++;
 
+            g_free(buff);
+        }
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s:%s: Read %d satellites from %s"),
+                    __FILE__, __func__, num, fname);
+    }
+    else
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s:%s: Failed to read %s"), __FILE__, __func__, fname);
     }
 
     g_free(path);
@@ -662,42 +798,110 @@ static gchar   *load_cat_file_cat(const gchar * fname)
         {
             g_strstrip(buff);   /* removes trailing newline */
         }
+        g_io_channel_shutdown(catfile, TRUE, NULL);
     }
 
     g_free(path);
-    g_io_channel_shutdown(catfile, TRUE, NULL);
     return buff;
 }
 
-/* this is a quick function that loads the category name from two cat 
-   files and compares them. 
-*/
-static gint cat_file_compare(const gchar * a, const gchar * b)
+/** A .cat file and its category name */
+typedef struct {
+    gchar          *fname;
+    gchar          *name;
+} cat_entry_t;
+
+/* compare two .cat files by category name */
+static gint cat_entry_compare(gconstpointer a, gconstpointer b)
 {
-    gchar          *cat_a, *cat_b;
-    gint            temp;
+    return gpredict_strcmp(((const cat_entry_t *)a)->name,
+                           ((const cat_entry_t *)b)->name);
+}
 
-    cat_a = load_cat_file_cat(a);
-    cat_b = load_cat_file_cat(b);
-    temp = gpredict_strcmp(cat_a, cat_b);
-    g_free(cat_a);
-    g_free(cat_b);
+/**
+ * Load the satellites of a group if it has not been loaded yet.
+ *
+ * @param selector Pointer to the GtkSatSelector widget
+ * @param store The model of the group.
+ *
+ * The "all" group is loaded in the background by load_pending_cb() and
+ * has no .cat file.
+ */
+static void load_group(GtkSatSelector * selector, GtkListStore * store)
+{
+    const gchar    *fname;
+
+    fname = g_object_get_data(G_OBJECT(store), "catfile");
+    if (fname == NULL || g_object_get_data(G_OBJECT(store), "loaded"))
+        return;
 
-    return (temp);
+    load_cat_file(selector, store, fname);
+    g_object_set_data(G_OBJECT(store), "loaded", GINT_TO_POINTER(TRUE));
+}
+
+/* Load up to max pending satellites into the "all" group */
+static void load_pending(GtkSatSelector * selector, guint max)
+{
+    GtkListStore   *store;
+    guint           i, n;
+
+    store = GTK_LIST_STORE(g_slist_nth_data(selector->models, 0));
+    n = MIN(max, selector->pending->len);
+
+    /* the model is sorted, so the order of insertion does not matter */
+    for (i = 1; i <= n; i++)
+        append_sat_row(selector, store,
+                       g_array_index(selector->pending, gint,
+                                     selector->pending->len - i));
+    g_array_set_size(selector->pending, selector->pending->len - n);
+
+    if (selector->pending->len == 0)
+        sat_log_log(SAT_LOG_LEVEL_INFO,
+                    _("%s:%s: Read %d satellites into MAIN group."),
+                    __FILE__, __func__,
+                    gtk_tree_model_iter_n_children(GTK_TREE_MODEL(store),
+                                                   NULL));
+}
+
+/* idle callback filling the "all" group a batch at a time */
+static gboolean load_pending_cb(gpointer data)
+{
+    GtkSatSelector *selector = GTK_SAT_SELECTOR(data);
+
+    load_pending(selector, SAT_LOAD_BATCH);
+    if (selector->pending->len > 0)
+        return TRUE;
+
+    selector->loader = 0;
+    return FALSE;
+}
+
+/* Finish loading the "all" group; needed before it is queried as a whole */
+static void load_all_pending(GtkSatSelector * selector)
+{
+    if (selector->loader == 0)
+        return;
+
+    g_source_remove(selector->loader);
+    selector->loader = 0;
+    load_pending(selector, G_MAXUINT);
 }
 
 /**
- * Create and fill data store models.
+ * Create data store models.
  *
  * @param selector Pointer to the GtkSatSelector widget
  *
- * this fuinction scan for satellite data and stores them in tree models
- * that can be displayed in a tree view. The scan is performed in two iterations:
+ * This function scans the satellite data directory and creates one model
+ * for all satellites and one model for each .cat file. The satellite data
+ * is not read here:
+ *
+ * (1) The catalog numbers of the .sat files are queued, and the "all" group
+ *     is filled from an idle callback so that the widget is shown at once.
+ * (2) The groups of the .cat files are filled when they are selected for
+ *     the first time.
  *
- * (1) First, all .sat files are scanned, read and added to a pseudo-group called
- *     "all" satellites.
- * (2) After the first scane, the function scans and reads .cat files and creates
- *     the groups accordingly.
+ * Each .sat file is read at most once and shared by all groups.
  *
  * For each group (including the "all" group) and entry is added to the
  * selector->groups GtkComboBox, where the index of the entry corresponds to
@@ -706,25 +910,17 @@ static gint cat_file_compare(const gchar * a, const gchar * b)
 static void create_and_fill_models(GtkSatSelector * selector)
 {
     GtkListStore   *store;      /* the list store data structure */
-    GtkTreeIter     node;       /* new top level node added to the tree store */
     GDir           *dir;
     gchar          *dirname;
-    sat_t           sat;
     gint            catnum;
-    gchar         **buffv;
     const gchar    *fname;
-    gchar          *nfname;
-    guint           num = 0;
-    gint            i, n;
     GSList         *cats = NULL;
+    GSList         *node;
+    cat_entry_t    *cat;
 
 
-    /* load all satellites into selector->models[0] */
-    store = gtk_list_store_new(GTK_SAT_SELECTOR_COL_NUM, G_TYPE_STRING, // name
-                               G_TYPE_INT,      // catnum
-                               G_TYPE_DOUBLE,   // epoch
-                               G_TYPE_BOOLEAN   // selected
-        );
+    /* all satellites go into selector->models[0] */
+    store = new_sat_store();
     selector->models = g_slist_append(selector->models, store);
     gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(selector->groups),
                                    _("All satellites"));
@@ -743,71 +939,49 @@ static void create_and_fill_models(GtkSatSelector * selector)
         return;
     }
 
-    /* Scan data directory for .sat files.
-       For each file scan through the file and
-       add entry to the tree.
+    /* Scan data directory for .sat and .cat files. Only the category names
+       are read here; the catalog numbers come from the file names.
      */
     while ((fname = g_dir_read_name(dir)))
     {
         if (g_str_has_suffix(fname, ".sat"))
         {
-            buffv = g_strsplit(fname, ".", 0);
-            catnum = (gint) g_ascii_strtoll(buffv[0], NULL, 0);
-
-            if (gtk_sat_data_read_sat(catnum, &sat))
-            {
-                /* error */
-            }
-            else
-            {
-                /* read satellite */
-
-                gtk_list_store_append(store, &node);
-                gtk_list_store_set(store, &node,
-                                   GTK_SAT_SELECTOR_COL_NAME, sat.nickname,
-                                   GTK_SAT_SELECTOR_COL_CATNUM, catnum,
-                                   GTK_SAT_SELECTOR_COL_EPOCH, sat.jul_epoch,
-                                   GTK_SAT_SELECTOR_COL_SELECTED, FALSE, -1);
-
-                g_free(sat.name);
-                g_free(sat.nickname);
-                num++;
-            }
-
-            g_strfreev(buffv);
+            catnum = (gint) g_ascii_strtoll(fname, NULL, 10);
+            g_array_append_val(selector->pending, catnum);
         }
-    }
-    sat_log_log(SAT_LOG_LEVEL_INFO,
-                _("%s:%s: Read %d satellites into MAIN group."),
-                __FILE__, __func__, num);
-
-    /* load satellites from each .cat file into selector->models[i] */
-    g_dir_rewind(dir);
-    while ((fname = g_dir_read_name(dir)))
-    {
-        if (g_str_has_suffix(fname, ".cat"))
+        else if (g_str_has_suffix(fname, ".cat"))
         {
-            cats =
-                g_slist_insert_sorted(cats, g_strdup(fname),
-                                      (GCompareFunc) cat_file_compare);
+            cat = g_new(cat_entry_t, 1);
+            cat->fname = g_strdup(fname);
+            cat->name = load_cat_file_cat(fname);
+            if (cat->name == NULL)
+                cat->name = g_strdup(fname);
+            cats = g_slist_prepend(cats, cat);
         }
     }
+    g_dir_close(dir);
+    g_free(dirname);
 
-    /*now load them into the combo box */
-    n = g_slist_length(cats);
-    for (i = 0; i < n; i++)
+    /* now add the groups to the combo box */
+    cats = g_slist_sort(cats, cat_entry_compare);
+    for (node = cats; node != NULL; node = node->next)
     {
-        nfname = g_slist_nth_data(cats, i);
-        if (nfname)
-        {
-            load_cat_file(selector, nfname);
-        }
-        g_free(nfname);
+        cat = (cat_entry_t *) node->data;
+
+        gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(selector->groups),
+                                       cat->name);
+        store = new_sat_store();
+        g_object_set_data_full(G_OBJECT(store), "catfile", cat->fname,
+                               g_free);
+        selector->models = g_slist_append(selector->models, store);
+
+        g_free(cat->name);
+        g_free(cat);
     }
     g_slist_free(cats);
 
-    g_dir_close(dir);
-    g_free(dirname);
+    if (selector->pending->len > 0)
+        selector->loader = g_idle_add(load_pending_cb, selector);
 }
 
 /**
@@ -876,6 +1050,8 @@ gdouble gtk_sat_selector_get_latest_epoch(GtkSatSelector * selector)
 
     g_return_val_if_fail(selector != 0 && IS_GTK_SAT_SELECTOR(selector), 0.0);
 
+    load_all_pending(selector);
+
     /* get the tree model that contains all satellites */
     model = GTK_TREE_MODEL(g_slist_nth_data(selector->models, 0));
     n = gtk_tree_model_iter_n_children(model, NULL);
@@ -903,7 +1079,7 @@ gdouble gtk_sat_selector_get_latest_epoch(GtkSatSelector * selector)
 }
 
 /**
- * Search through all the models for the given satellite and set its selected value.
+ * Set the selected value of the given satellite in all models.
  *
  * @param *selector is the selector that contains the models
  * @param catnr is the catalog numer of satellite.
@@ -912,31 +1088,21 @@ gdouble gtk_sat_selector_get_latest_epoch(GtkSatSelector * selector)
 static void gtk_sat_selector_mark_engine(GtkSatSelector * selector, gint catnr,
                                          gboolean val)
 {
-    gint            n, k;
-    gint            nummodels, numiters;
-    gint            catnumscratch;
-    GtkTreeModel   *model;
-    GtkTreeIter     iter;
+    GSList         *node;
+    sat_row_t      *row;
 
-    nummodels = g_slist_length(selector->models);
+    /* rows added later take their state from the set */
+    if (val)
+        g_hash_table_add(selector->selected, GINT_TO_POINTER(catnr));
+    else
+        g_hash_table_remove(selector->selected, GINT_TO_POINTER(catnr));
 
-    for (n = 0; n < nummodels; n++)
+    node = g_hash_table_lookup(selector->rows, GINT_TO_POINTER(catnr));
+    for (; node != NULL; node = node->next)
     {
-        model = GTK_TREE_MODEL(g_slist_nth_data(selector->models, n));
-        numiters = gtk_tree_model_iter_n_children(model, NULL);
-        for (k = 0; k < numiters; k++)
-        {
-            if (G_LIKELY(gtk_tree_model_iter_nth_child(model, &iter, NULL, k)))
-            {
-                gtk_tree_model_get(model, &iter, GTK_SAT_SELECTOR_COL_CATNUM,
-                                   &catnumscratch, -1);
-                if (catnumscratch == catnr)
-                {
-                    gtk_list_store_set(GTK_LIST_STORE(model), &iter,
-                                       GTK_SAT_SELECTOR_COL_SELECTED, val, -1);
-                }
-            }
-        }
+        row = (sat_row_t *) node->data;
+        gtk_list_store_set(row->store, &row->iter,
+                           GTK_SAT_SELECTOR_COL_SELECTED, val, -1);
     }
 }
 
@@ -962,3 +1128,97 @@ void gtk_sat_selector_mark_unselected(GtkSatSelector * selector, gint catnr)
 {
     gtk_sat_selector_mark_engine(selector, catnr, FALSE);
 }
+
+/**
+ * Mark several satellites as selected in one go.
+ *
+ * @param selector is the selector that contains the models
+ * @param catnums Array of catalog numbers (gint).
+ *
+ * The model is detached from the tree view while the rows are updated so
+ * that the view is refreshed only once.
+ */
+void gtk_sat_selector_mark_selected_array(GtkSatSelector * selector,
+                                          GArray * catnums)
+{
+    GtkTreeModel   *model;
+    guint           i;
+
+    g_return_if_fail(selector != NULL && catnums != NULL);
+
+    model = gtk_tree_view_get_model(GTK_TREE_VIEW(selector->tree));
+    g_object_ref(model);
+    gtk_tree_view_set_model(GTK_TREE_VIEW(selector->tree), NULL);
+
+    for (i = 0; i < catnums->len; i++)
+        gtk_sat_selector_mark_engine(selector, g_array_index(catnums, gint, i),
+                                     TRUE);
+
+    gtk_tree_view_set_model(GTK_TREE_VIEW(selector->tree), model);
+    g_object_unref(model);
+}
+
+/**
+ * Get information about a satellite.
+ *
+ * @param selector Pointer to the GtkSatSelector widget.
+ * @param catnum The catalog number of the satellite.
+ * @param satname Location where the satellite name will be stored. May NOT be NULL. Must be g_freed after use.
+ * @param epoch Location where the satellite Epoch will be stored (may be NULL).
+ * @return TRUE if the satellite data could be read, FALSE otherwise.
+ *
+ * The .sat file is only read if the selector has not loaded the satellite yet.
+ */
+gboolean gtk_sat_selector_get_sat(GtkSatSelector * selector, gint catnum,
+                                  gchar ** satname, gdouble * epoch)
+{
+    const sat_info_t *info;
+
+    g_return_val_if_fail((selector != NULL) && (satname != NULL), FALSE);
+
+    info = lookup_sat(selector, catnum);
+    if (info == NULL)
+        return FALSE;
+
+    *satname = g_strdup(info->name);
+    if (epoch != NULL)
+        *epoch = info->epoch;
+
+    return TRUE;
+}
+
+/**
+ * Get the satellites currently shown in the selector.
+ *
+ * @param selector Pointer to the GtkSatSelector widget.
+ * @return Newly allocated array of catalog numbers (gint) of the satellites
+ *         in the current group matching the search string. Must be freed
+ *         with g_array_free after use.
+ */
+GArray         *gtk_sat_selector_get_visible(GtkSatSelector * selector)
+{
+    GtkTreeModel   *model;
+    GtkTreeIter     iter;
+    GArray         *catnums;
+    gboolean        valid;
+    gint            catnum;
+
+    g_return_val_if_fail(selector != NULL, NULL);
+
+    /* the "all" group may still be loading */
+    load_all_pending(selector);
+
+    catnums = g_array_new(FALSE, FALSE, sizeof(gint));
+    model = gtk_tree_view_get_model(GTK_TREE_VIEW(selector->tree));
+
+    valid = gtk_tree_model_get_iter_first(model, &iter);
+    while (valid)
+    {
+        gtk_tree_model_get(model, &iter,
+                           GTK_SAT_SELECTOR_COL_CATNUM, &catnum, -1);
+        g_array_append_val(catnums, catnum);
+        valid = gtk_tree_model_iter_next(model, &iter);
+    }
+
+    return catnums;
+}
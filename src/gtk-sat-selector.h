@@ -53,6 +53,11 @@ struct _gtk_sat_selector {
     GtkWidget      *groups;     /*!< Combo box for selecting satellite group. */
     GtkWidget      *search;     /*!< Text entry for searching. */
     GSList         *models;     /*!< List of models with index corresponding to groups. */
+    GHashTable     *rows;       /*!< Rows of each catnum in all models (GSList). */
+    GHashTable     *sats;       /*!< Name and epoch of each catnum read so far. */
+    GHashTable     *selected;   /*!< Set of catnums marked as selected. */
+    GArray         *pending;    /*!< Catnums not yet loaded into the "all" group. */
+    guint           loader;     /*!< Idle source loading the pending satellites. */
 };
 
 struct _GtkSatSelectorClass {
@@ -72,6 +77,12 @@ void            gtk_sat_selector_mark_selected(GtkSatSelector * selector,
                                                gint catnum);
 void            gtk_sat_selector_mark_unselected(GtkSatSelector * selector,
                                                  gint catnum);
+void            gtk_sat_selector_mark_selected_array(GtkSatSelector * selector,
+                                                     GArray * catnums);
+gboolean        gtk_sat_selector_get_sat(GtkSatSelector * selector,
+                                         gint catnum, gchar ** satname,
+                                         gdouble * epoch);
+GArray         *gtk_sat_selector_get_visible(GtkSatSelector * selector);
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
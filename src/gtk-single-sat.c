@@ -96,15 +96,20 @@ const gchar    *SINGLE_SAT_FIELD_HINT[SINGLE_SAT_FIELD_NUMBER] = {
 
 static GtkBoxClass *parent_class = NULL;
 
+/* Key of a field that does not show any value yet */
+#define FIELD_KEY_NONE  G_MININT64
+
+/* Number of refreshes averaged in the debug log of the refresh cost */
+#define SINGLE_SAT_TIMED_REFRESHES 100
+
 
 static void gtk_single_sat_destroy(GtkWidget * widget)
 {
     GtkSingleSat   *ssat = GTK_SINGLE_SAT(widget);
-    sat_t          *sat = SAT(g_slist_nth_data(ssat->sats, ssat->selected));
 
-    if (sat != NULL)
+    if (ssat->sat != NULL)
         g_key_file_set_integer(ssat->cfgdata, MOD_CFG_SINGLE_SAT_SECTION,
-                               MOD_CFG_SINGLE_SAT_SELECT, sat->tle.catnr);
+                               MOD_CFG_SINGLE_SAT_SELECT, ssat->catnum);
 
     (*GTK_WIDGET_CLASS(parent_class)->destroy) (widget);
 }
@@ -123,6 +128,96 @@ static void gtk_single_sat_init(GtkSingleSat * list)
     (void)list;
 }
 
+/* Forget the values shown so that all fields are updated next time. */
+static void invalidate_fields(GtkSingleSat * ssat)
+{
+    guint           i;
+
+    for (i = 0; i < SINGLE_SAT_FIELD_NUMBER; i++)
+        ssat->keys[i] = FIELD_KEY_NONE;
+}
+
+/*
+ * Get the value of a field quantized to the displayed precision.
+ *
+ * Two values giving the same key are shown the same way, so the label only
+ * needs to be updated when the key changes. Fields showing text use the key
+ * to pass the text to update_field().
+ */
+static gint64 field_key(GtkSingleSat * ssat, sat_t * sat, guint i)
+{
+    gdouble         number;
+
+    switch (i)
+    {
+    case SINGLE_SAT_FIELD_AZ:
+        return llround(sat->az * 100.0);
+    case SINGLE_SAT_FIELD_EL:
+        return llround(sat->el * 100.0);
+    case SINGLE_SAT_FIELD_DIR:
+        if (sat->otype == ORBIT_TYPE_GEO)
+            return 0;
+        else if (decayed(sat))
+            return 1;
+        else if (sat->range_rate > 0.0)
+            return 2;
+        else if (sat->range_rate < 0.0)
+            return 3;
+        return 4;
+    case SINGLE_SAT_FIELD_RA:
+        return llround(sat->ra * 100.0);
+    case SINGLE_SAT_FIELD_DEC:
+        return llround(sat->dec * 100.0);
+    case SINGLE_SAT_FIELD_RANGE:
+        return llround(sat->range);
+    case SINGLE_SAT_FIELD_RANGE_RATE:
+        return llround(sat->range_rate * 1000.0);
+    case SINGLE_SAT_FIELD_NEXT_EVENT:
+        /* time is shown with 1 second resolution */
+        if (sat->aos > sat->los)
+            number = sat->los;
+        else
+            number = sat->aos;
+        if (number <= 0.0)
+            return -1;
+        return 2 * llround(number * 86400.0) + (sat->aos > sat->los ? 1 : 0);
+    case SINGLE_SAT_FIELD_AOS:
+        return (sat->aos > 0.0) ? llround(sat->aos * 86400.0) : -1;
+    case SINGLE_SAT_FIELD_LOS:
+        return (sat->los > 0.0) ? llround(sat->los * 86400.0) : -1;
+    case SINGLE_SAT_FIELD_LAT:
+        return llround(sat->ssplat * 100.0);
+    case SINGLE_SAT_FIELD_LON:
+        return llround(sat->ssplon * 100.0);
+    case SINGLE_SAT_FIELD_SSP:
+        /* 6 character locator has 5' x 2.5' resolution */
+        return (gint64) floor((sat->ssplon + 180.0) * 12.0) * 10000 +
+            (gint64) floor((sat->ssplat + 90.0) * 24.0);
+    case SINGLE_SAT_FIELD_FOOTPRINT:
+        return llround(sat->footprint);
+    case SINGLE_SAT_FIELD_ALT:
+        return llround(sat->alt);
+    case SINGLE_SAT_FIELD_VEL:
+        return llround(sat->velo * 1000.0);
+    case SINGLE_SAT_FIELD_DOPPLER:
+        return llround(-100.0e06 * (sat->range_rate / 299792.4580));
+    case SINGLE_SAT_FIELD_LOSS:
+        return llround((72.4 + 20.0 * log10(sat->range)) * 100.0);
+    case SINGLE_SAT_FIELD_DELAY:
+        return llround(sat->range / 299.7924580 * 100.0);
+    case SINGLE_SAT_FIELD_MA:
+        return llround(sat->ma * 100.0);
+    case SINGLE_SAT_FIELD_PHASE:
+        return llround(sat->phase * 100.0);
+    case SINGLE_SAT_FIELD_ORBIT:
+        return sat->orbit;
+    case SINGLE_SAT_FIELD_VISIBILITY:
+        return get_sat_vis(sat, ssat->qth, sat->jul_utc);
+    default:
+        return FIELD_KEY_NONE;
+    }
+}
+
 /* Update a field in the GtkSingleSat view. */
 static void update_field(GtkSingleSat * ssat, guint i)
 {
@@ -134,7 +229,7 @@ static void update_field(GtkSingleSat * ssat, guint i)
     gint            retcode;
     gchar          *fmtstr;
     gchar          *alstr;
-    sat_vis_t       vis;
+    gint64          key;
 
     /* make some sanity checks */
     if (ssat->labels[i] == NULL)
@@ -146,7 +241,7 @@ static void update_field(GtkSingleSat * ssat, guint i)
     }
 
     /* get selected satellite */
-    sat = SAT(g_slist_nth_data(ssat->sats, ssat->selected));
+    sat = ssat->sat;
     if (!sat)
     {
         sat_log_log(SAT_LOG_LEVEL_ERROR,
@@ -155,6 +250,14 @@ static void update_field(GtkSingleSat * ssat, guint i)
         return;
     }
 
+    /* nothing to do if the label already shows the value */
+    key = field_key(ssat, sat, i);
+    if ((key == ssat->keys[i]) && (key != FIELD_KEY_NONE))
+        return;
+
+    ssat->keys[i] = key;
+    ssat->refset++;
+
     /* update requested field */
     switch (i)
     {
@@ -165,20 +268,21 @@ static void update_field(GtkSingleSat * ssat, guint i)
         buff = g_strdup_printf("%6.2f\302\260", sat->el);
         break;
     case SINGLE_SAT_FIELD_DIR:
-        if (sat->otype == ORBIT_TYPE_GEO)
+        /* key has been set by field_key() */
+        if (key == 0)
         {
             buff = g_strdup("Geostationary");
         }
-        else if (decayed(sat))
+        else if (key == 1)
         {
             buff = g_strdup("Decayed");
         }
-        else if (sat->range_rate > 0.0)
+        else if (key == 2)
         {
             /* Receeding */
             buff = g_strdup("Receeding");
         }
-        else if (sat->range_rate < 0.0)
+        else if (key == 3)
         {
             /* Approaching */
             buff = g_strdup("Approaching");
@@ -355,8 +459,7 @@ static void update_field(GtkSingleSat * ssat, guint i)
         buff = g_strdup_printf("%ld", sat->orbit);
         break;
     case SINGLE_SAT_FIELD_VISIBILITY:
-        vis = get_sat_vis(sat, ssat->qth, sat->jul_utc);
-        buff = vis_to_str(vis);
+        buff = vis_to_str((sat_vis_t) key);
         break;
     default:
         sat_log_log(SAT_LOG_LEVEL_ERROR,
@@ -389,72 +492,36 @@ static void store_sats(gpointer key, gpointer value, gpointer user_data)
                                              (GCompareFunc) sat_name_compare);
 }
 
-static void Calculate_RADec(sat_t * sat, qth_t * qth, obs_astro_t * obs_set)
+/* Make sat the selected satellite and update the header. */
+static void set_selected_sat(GtkSingleSat * ssat, sat_t * sat)
 {
-    /* Reference:  Methods of Orbit Determination by  */
-    /*                Pedro Ramon Escobal, pp. 401-402 */
-
-    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
-        az, el, Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Ez, Zz,
-        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
-    geodetic_t      geodetic;
-
-    geodetic.lon = qth->lon * de2ra;
-    geodetic.lat = qth->lat * de2ra;
-    geodetic.alt = qth->alt / 1000.0;
-    geodetic.theta = 0;
-
-    az = sat->az * de2ra;
-    el = sat->el * de2ra;
-    phi = geodetic.lat;
-    theta = FMod2p(ThetaG_JD(sat->jul_utc) + geodetic.lon);
-    sin_theta = sin(theta);
-    cos_theta = cos(theta);
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
-    Lxh = -cos(az) * cos(el);
-    Lyh = sin(az) * cos(el);
-    Lzh = sin(el);
-    Sx = sin_phi * cos_theta;
-    Ex = -sin_theta;
-    Zx = cos_theta * cos_phi;
-    Sy = sin_phi * sin_theta;
-    Ey = cos_theta;
-    Zy = sin_theta * cos_phi;
-    Sz = -cos_phi;
-    Ez = 0;
-    Zz = sin_phi;
-    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
-    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
-    Lz = Sz * Lxh + Ez * Lyh + Zz * Lzh;
-    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
-    cos_delta = sqrt(1 - Sqr(Lz));
-    sin_alpha = Ly / cos_delta;
-    cos_alpha = Lx / cos_delta;
-    obs_set->ra = AcTan(sin_alpha, cos_alpha);  /* Right Ascension (radians) */
-    obs_set->ra = FMod2p(obs_set->ra);
+    gchar          *title;
+
+    ssat->sat = sat;
+    ssat->catnum = (sat != NULL) ? sat->tle.catnr : 0;
+    invalidate_fields(ssat);
+
+    if (ssat->header != NULL)
+    {
+        title = g_markup_printf_escaped("<b>%s</b>",
+                                        sat ? sat->nickname : "noname");
+        gtk_label_set_markup(GTK_LABEL(ssat->header), title);
+        g_free(title);
+    }
 }
 
 static void select_satellite(GtkWidget * menuitem, gpointer data)
 {
     GtkSingleSat   *ssat = GTK_SINGLE_SAT(data);
-    guint           i =
-        GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(menuitem), "index"));
-    gchar          *title;
-    sat_t          *sat;
+    sat_t          *sat = SAT(g_object_get_data(G_OBJECT(menuitem), "sat"));
 
     /* there are many "ghost"-trigging of this signal, but we only need to make
        a new selection when the received menuitem is selected
      */
-    if (gtk_check_menu_item_get_active(GTK_CHECK_MENU_ITEM(menuitem)))
+    if (gtk_check_menu_item_get_active(GTK_CHECK_MENU_ITEM(menuitem)) &&
+        (sat != ssat->sat))
     {
-        ssat->selected = i;
-
-        sat = SAT(g_slist_nth_data(ssat->sats, i));
-
-        title = g_markup_printf_escaped("<b>%s</b>", sat->nickname);
-        gtk_label_set_markup(GTK_LABEL(ssat->header), title);
-        g_free(title);
+        set_selected_sat(ssat, sat);
     }
 }
 
@@ -469,14 +536,12 @@ static void gtk_single_sat_popup_cb(GtkWidget * button, gpointer data)
     gchar          *buff;
     sat_t          *sat;
     sat_t          *sati;       /* used to create list of satellites */
-    guint           i, n;
+    GSList         *node;
 
-    sat = SAT(g_slist_nth_data(single_sat->sats, single_sat->selected));
+    sat = single_sat->sat;
     if (sat == NULL)
         return;
 
-    n = g_slist_length(single_sat->sats);
-
     menu = gtk_menu_new();
 
     /* satellite name/info */
@@ -509,19 +574,19 @@ static void gtk_single_sat_popup_cb(GtkWidget * button, gpointer data)
     gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
 
     /* select sat */
-    for (i = 0; i < n; i++)
+    for (node = single_sat->sats; node != NULL; node = node->next)
     {
-        sati = SAT(g_slist_nth_data(single_sat->sats, i));
+        sati = SAT(node->data);
 
         menuitem = gtk_radio_menu_item_new_with_label(group, sati->nickname);
         group = gtk_radio_menu_item_get_group(GTK_RADIO_MENU_ITEM(menuitem));
 
-        if (i == single_sat->selected)
+        if (sati == sat)
             gtk_check_menu_item_set_active(GTK_CHECK_MENU_ITEM(menuitem),
                                            TRUE);
 
-        /* store item index so that it is available in the callback */
-        g_object_set_data(G_OBJECT(menuitem), "index", GUINT_TO_POINTER(i));
+        /* store satellite so that it is available in the callback */
+        g_object_set_data(G_OBJECT(menuitem), "sat", sati);
         g_signal_connect_after(menuitem, "activate",
                                G_CALLBACK(select_satellite), single_sat);
         gtk_menu_shell_append(GTK_MENU_SHELL(menu), menuitem);
@@ -538,12 +603,22 @@ static void gtk_single_sat_popup_cb(GtkWidget * button, gpointer data)
 /* Refresh internal references to the satellites. */
 void gtk_single_sat_reload_sats(GtkWidget * single_sat, GHashTable * sats)
 {
+    GtkSingleSat   *ssat = GTK_SINGLE_SAT(single_sat);
+    sat_t          *sat;
+
     /* free GSlists */
-    g_slist_free(GTK_SINGLE_SAT(single_sat)->sats);
-    GTK_SINGLE_SAT(single_sat)->sats = NULL;
+    g_slist_free(ssat->sats);
+    ssat->sats = NULL;
 
     /* reload satellites */
     g_hash_table_foreach(sats, store_sats, single_sat);
+
+    /* the old satellite data is gone; keep the selection if we can */
+    sat = SAT(g_hash_table_lookup(sats, &ssat->catnum));
+    if (sat == NULL && ssat->sats != NULL)
+        sat = SAT(ssat->sats->data);
+
+    set_selected_sat(ssat, sat);
 }
 
 /*
@@ -580,6 +655,8 @@ void gtk_single_sat_reconf(GtkWidget * widget,
     /* QTH may have changed too since we have a default QTH */
     GTK_SINGLE_SAT(widget)->qth = qth;
 
+    invalidate_fields(GTK_SINGLE_SAT(widget));
+
     /* get refresh rate and cycle counter */
     GTK_SINGLE_SAT(widget)->refresh = mod_cfg_get_int(newcfg,
                                                       MOD_CFG_SINGLE_SAT_SECTION,
@@ -592,44 +669,35 @@ void gtk_single_sat_reconf(GtkWidget * widget,
 void gtk_single_sat_select_sat(GtkWidget * single_sat, gint catnum)
 {
     GtkSingleSat   *ssat = GTK_SINGLE_SAT(single_sat);
-    sat_t          *sat = NULL;
-    gchar          *title;
-    gboolean        foundsat = FALSE;
-    gint            i, n;
+    GSList         *node;
 
     /* find satellite with catnum */
-    n = g_slist_length(ssat->sats);
-    for (i = 0; i < n; i++)
+    for (node = ssat->sats; node != NULL; node = node->next)
     {
-        sat = SAT(g_slist_nth_data(ssat->sats, i));
-        if (sat->tle.catnr == catnum)
-        {
-            /* found satellite */
-            ssat->selected = i;
-            foundsat = TRUE;
-
-            /* exit loop */
-            i = n;
-        }
+        if (SAT(node->data)->tle.catnr == catnum)
+            break;
     }
 
-    if (!foundsat)
+    if (node == NULL)
     {
         sat_log_log(SAT_LOG_LEVEL_ERROR,
                     _("%s: Could not find satellite with catalog number %d"),
                     __func__, catnum);
         return;
     }
-    title = g_markup_printf_escaped("<b>%s</b>", sat->nickname);
-    gtk_label_set_markup(GTK_LABEL(ssat->header), title);
-    g_free(title);
+
+    set_selected_sat(ssat, SAT(node->data));
 }
 
 /* Update satellites */
 void gtk_single_sat_update(GtkWidget * widget)
 {
     GtkSingleSat   *ssat = GTK_SINGLE_SAT(widget);
-    guint           i;
+    sat_t          *sat;
+    gchar          *fmtstr;
+    gint64          t0;
+    guint           cfghash;
+    guint           i, n;
 
     /* first, do some sanity checks */
     if ((ssat == NULL) || !IS_GTK_SINGLE_SAT(ssat))
@@ -646,29 +714,52 @@ void gtk_single_sat_update(GtkWidget * widget)
     {
         ssat->counter++;
     }
-    else
+    else if ((sat = ssat->sat) != NULL)
     {
+        t0 = g_get_monotonic_time();
+
+        /* labels must be redone if the display settings have changed */
+        fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
+        cfghash = g_str_hash(fmtstr) * 8 +
+            sat_cfg_get_bool(SAT_CFG_BOOL_USE_LOCAL_TIME) * 4 +
+            sat_cfg_get_bool(SAT_CFG_BOOL_USE_NSEW) * 2 +
+            sat_cfg_get_bool(SAT_CFG_BOOL_USE_IMPERIAL);
+        g_free(fmtstr);
+
+        if (cfghash != ssat->cfghash)
+        {
+            invalidate_fields(ssat);
+            ssat->cfghash = cfghash;
+        }
+
         /* we calculate here to avoid double calc */
         if ((ssat->flags & SINGLE_SAT_FLAG_RA) ||
             (ssat->flags & SINGLE_SAT_FLAG_DEC))
-        {
-            obs_astro_t     astro;
-            sat_t          *sat =
-                SAT(g_slist_nth_data(ssat->sats, ssat->selected));
-
-            Calculate_RADec(sat, ssat->qth, &astro);
-            sat->ra = Degrees(astro.ra);
-            sat->dec = Degrees(astro.dec);
-        }
+            predict_calc_radec(sat, ssat->qth);
 
         /* update visible fields one by one */
-        for (i = 0; i < SINGLE_SAT_FIELD_NUMBER; i++)
+        for (i = 0, n = 0; i < SINGLE_SAT_FIELD_NUMBER; i++)
         {
             if (ssat->flags & (1 << i))
+            {
                 update_field(ssat, i);
-
+                n++;
+            }
         }
         ssat->counter = 1;
+
+        /* report the average cost of a refresh now and then */
+        ssat->reftime += g_get_monotonic_time() - t0;
+        if (++ssat->refcount == SINGLE_SAT_TIMED_REFRESHES)
+        {
+            sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                        _("%s: %.1f us per refresh, %.1f of %u fields set"),
+                        __func__, (gdouble) ssat->reftime / ssat->refcount,
+                        (gdouble) ssat->refset / ssat->refcount, n);
+            ssat->reftime = 0;
+            ssat->refcount = 0;
+            ssat->refset = 0;
+        }
     }
 }
 
@@ -707,8 +798,6 @@ GtkWidget      *gtk_single_sat_new(GKeyFile * cfgdata, GHashTable * sats,
     GtkWidget      *hbox;       /* horizontal box for header */
     GtkWidget      *label1;
     GtkWidget      *label2;
-    sat_t          *sat;
-    gchar          *title;
     guint           i;
     gint            selectedcatnum;
 
@@ -723,7 +812,10 @@ GtkWidget      *gtk_single_sat_new(GKeyFile * cfgdata, GHashTable * sats,
     /* ... */
 
     g_hash_table_foreach(sats, store_sats, widget);
-    single_sat->selected = 0;
+    single_sat->sat = NULL;
+    single_sat->catnum = 0;
+    single_sat->cfghash = 0;
+    invalidate_fields(single_sat);
     single_sat->qth = qth;
     single_sat->cfgdata = cfgdata;
 
@@ -762,12 +854,9 @@ GtkWidget      *gtk_single_sat_new(GKeyFile * cfgdata, GHashTable * sats,
 
 
     /* create header */
-    sat = SAT(g_slist_nth_data(single_sat->sats, 0));
-    title = g_markup_printf_escaped("<b>%s</b>",
-                                    sat ? sat->nickname : "noname");
     single_sat->header = gtk_label_new(NULL);
-    gtk_label_set_markup(GTK_LABEL(single_sat->header), title);
-    g_free(title);
+    set_selected_sat(single_sat,
+                     single_sat->sats ? SAT(single_sat->sats->data) : NULL);
     g_object_set(single_sat->header, "xalign", 0.0f, "yalign", 0.5f, NULL);
     gtk_box_pack_start(GTK_BOX(hbox), single_sat->header, TRUE, TRUE, 10);
 
@@ -102,7 +102,15 @@ struct _gtk_single_sat {
     guint32         flags;      /*!< Flags indicating which columns are visible. */
     guint           refresh;    /*!< Refresh rate. */
     guint           counter;    /*!< cycle counter. */
-    guint           selected;   /*!< index of selected sat. */
+    sat_t          *sat;        /*!< Selected satellite. */
+    gint            catnum;     /*!< Catalog number of selected satellite. */
+
+    gint64          keys[SINGLE_SAT_FIELD_NUMBER];      /*!< Quantized values shown in the labels. */
+    guint           cfghash;    /*!< Display settings the keys are valid for. */
+
+    gint64          reftime;    /*!< Time spent in the timed refreshes [us]. */
+    guint           refcount;   /*!< Number of timed refreshes. */
+    guint           refset;     /*!< Labels set in the timed refreshes. */
 
     gdouble         tstamp;     /*!< time stamp of calculations; update by GtkSatModule */
 
@@ -0,0 +1,562 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * In-process Hamlib backend for the radio and rotator controllers.
+ *
+ * Instead of sending text commands to rigctld or rotctld over TCP, the
+ * controllers can drive a device through libhamlib directly. A device is
+ * controlled this way when its configuration has a Hamlib model number; the
+ * controllers fall back to the network daemons when the model is 0.
+ *
+ * Hamlib's own type names clash with those in radio-conf.h, so the Hamlib
+ * headers are only included here and the controllers see opaque handles.
+ * Each handle has its own lock because the radio controller may issue PTT
+ * commands from the GUI thread while the control thread is running.
+ *
+ * Hamlib writes its diagnostics to stderr. Their verbosity follows the
+ * gpredict log level once hamlib_backend_set_debug() has been called and is
+ * left at the library default otherwise.
+ *
+ * When gpredict is built without Hamlib the open functions always fail and
+ * the controllers keep using rigctld and rotctld.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+
+#ifdef HAS_HAMLIB
+#include <hamlib/rig.h>
+#include <hamlib/rotator.h>
+#endif
+
+#include "hamlib-backend.h"
+#include "sat-log.h"
+
+
+#ifdef HAS_HAMLIB
+
+struct _hamlib_rig {
+    RIG            *rig;
+    GMutex          lock;
+};
+
+struct _hamlib_rot {
+    ROT            *rot;
+    GMutex          lock;
+};
+
+/* Log a failed Hamlib call; returns TRUE if retcode is RIG_OK */
+static gboolean check_retcode(gint retcode, const gchar * function)
+{
+    if (retcode == RIG_OK)
+        return TRUE;
+
+    sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Hamlib returned error (%s)"),
+                function, rigerror(retcode));
+
+    return FALSE;
+}
+
+/**
+ * Check whether gpredict has been built with the in-process Hamlib backend.
+ *
+ * @return TRUE if devices can be controlled without rigctld and rotctld.
+ */
+gboolean hamlib_backend_available(void)
+{
+    return TRUE;
+}
+
+/**
+ * Set the verbosity of the Hamlib diagnostics.
+ *
+ * @param level The gpredict log level, see sat_log_level_t.
+ */
+void hamlib_backend_set_debug(gint level)
+{
+    switch (level)
+    {
+    case SAT_LOG_LEVEL_NONE:
+        rig_set_debug(RIG_DEBUG_NONE);
+        break;
+
+    case SAT_LOG_LEVEL_ERROR:
+        rig_set_debug(RIG_DEBUG_ERR);
+        break;
+
+    case SAT_LOG_LEVEL_DEBUG:
+        rig_set_debug(RIG_DEBUG_VERBOSE);
+        break;
+
+    default:
+        rig_set_debug(RIG_DEBUG_WARN);
+        break;
+    }
+}
+
+/**
+ * Open a radio.
+ *
+ * @param model The Hamlib rig model number, e.g. 1 for the dummy rig.
+ * @param device The serial port or device path, NULL or empty to use the
+ *               backend default.
+ * @param speed The serial speed in baud, 0 to use the backend default.
+ * @return A new handle or NULL if the radio could not be opened.
+ */
+hamlib_rig_t   *hamlib_rig_open(gint model, const gchar * device, gint speed)
+{
+    hamlib_rig_t   *rig;
+    gchar          *buff;
+    gint            retcode;
+
+    rig = g_try_new0(hamlib_rig_t, 1);
+    if (rig == NULL)
+        return NULL;
+
+    rig->rig = rig_init(model);
+    if (rig->rig == NULL)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Unknown Hamlib rig model %d"), __func__, model);
+        g_free(rig);
+        return NULL;
+    }
+
+    if (device != NULL && device[0] != '\0')
+        rig_set_conf(rig->rig, rig_token_lookup(rig->rig, "rig_pathname"),
+                     device);
+
+    if (speed > 0)
+    {
+        buff = g_strdup_printf("%d", speed);
+        rig_set_conf(rig->rig, rig_token_lookup(rig->rig, "serial_speed"),
+                     buff);
+        g_free(buff);
+    }
+
+    retcode = rig_open(rig->rig);
+    if (retcode != RIG_OK)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Failed to open Hamlib rig model %d (%s)"),
+                    __func__, model, rigerror(retcode));
+        rig_cleanup(rig->rig);
+        g_free(rig);
+        return NULL;
+    }
+
+    g_mutex_init(&rig->lock);
+
+    sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                _("%s: Opened Hamlib rig model %d"), __func__, model);
+
+    return rig;
+}
+
+/** Close a radio and free the handle. */
+void hamlib_rig_close(hamlib_rig_t * rig)
+{
+    if (rig == NULL)
+        return;
+
+    rig_close(rig->rig);
+    rig_cleanup(rig->rig);
+    g_mutex_clear(&rig->lock);
+    g_free(rig);
+}
+
+/** Set the frequency of the current VFO. */
+gboolean hamlib_rig_set_freq(hamlib_rig_t * rig, gdouble freq)
+{
+    gint            retcode;
+
+    g_mutex_lock(&rig->lock);
+    retcode = rig_set_freq(rig->rig, RIG_VFO_CURR, freq);
+    g_mutex_unlock(&rig->lock);
+
+    return check_retcode(retcode, __func__);
+}
+
+/** Read the frequency of the current VFO. */
+gboolean hamlib_rig_get_freq(hamlib_rig_t * rig, gdouble * freq)
+{
+    freq_t          f = 0.0;
+    gint            retcode;
+
+    g_mutex_lock(&rig->lock);
+    retcode = rig_get_freq(rig->rig, RIG_VFO_CURR, &f);
+    g_mutex_unlock(&rig->lock);
+
+    if (!check_retcode(retcode, __func__))
+        return FALSE;
+
+    *freq = f;
+
+    return TRUE;
+}
+
+/** Set the transmit frequency in split mode. */
+gboolean hamlib_rig_set_split_freq(hamlib_rig_t * rig, gdouble freq)
+{
+    gint            retcode;
+
+    g_mutex_lock(&rig->lock);
+    retcode = rig_set_split_freq(rig->rig, RIG_VFO_CURR, freq);
+    g_mutex_unlock(&rig->lock);
+
+    return check_retcode(retcode, __func__);
+}
+
+/** Read the transmit frequency in split mode. */
+gboolean hamlib_rig_get_split_freq(hamlib_rig_t * rig, gdouble * freq)
+{
+    freq_t          f = 0.0;
+    gint            retcode;
+
+    g_mutex_lock(&rig->lock);
+    retcode = rig_get_split_freq(rig->rig, RIG_VFO_CURR, &f);
+    g_mutex_unlock(&rig->lock);
+
+    if (!check_retcode(retcode, __func__))
+        return FALSE;
+
+    *freq = f;
+
+    return TRUE;
+}
+
+/**
+ * Turn split operation on or off.
+ *
+ * @param rig The radio.
+ * @param split Whether split should be on.
+ * @param txvfo Name of the transmit VFO as used by rigctld, e.g. "VFOA" or
+ *              "Sub". NULL selects the current VFO.
+ */
+gboolean hamlib_rig_set_split(hamlib_rig_t * rig, gboolean split,
+                              const gchar * txvfo)
+{
+    gint            retcode;
+
+    g_mutex_lock(&rig->lock);
+    retcode = rig_set_split_vfo(rig->rig, RIG_VFO_CURR,
+                                split ? RIG_SPLIT_ON : RIG_SPLIT_OFF,
+                                txvfo ? rig_parse_vfo(txvfo) : RIG_VFO_CURR);
+    g_mutex_unlock(&rig->lock);
+
+    return check_retcode(retcode, __func__);
+}
+
+/** Key or unkey the transmitter. */
+gboolean hamlib_rig_set_ptt(hamlib_rig_t * rig, gboolean ptt)
+{
+    gint            retcode;
+
+    g_mutex_lock(&rig->lock);
+    retcode = rig_set_ptt(rig->rig, RIG_VFO_CURR,
+                          ptt ? RIG_PTT_ON : RIG_PTT_OFF);
+    g_mutex_unlock(&rig->lock);
+
+    return check_retcode(retcode, __func__);
+}
+
+/** Read the PTT status. */
+gboolean hamlib_rig_get_ptt(hamlib_rig_t * rig, gboolean * ptt)
+{
+    ptt_t           p = RIG_PTT_OFF;
+    gint            retcode;
+
+    g_mutex_lock(&rig->lock);
+    retcode = rig_get_ptt(rig->rig, RIG_VFO_CURR, &p);
+    g_mutex_unlock(&rig->lock);
+
+    if (!check_retcode(retcode, __func__))
+        return FALSE;
+
+    *ptt = (p != RIG_PTT_OFF);
+
+    return TRUE;
+}
+
+/** Read the squelch (DCD) status. */
+gboolean hamlib_rig_get_dcd(hamlib_rig_t * rig, gboolean * dcd)
+{
+    dcd_t           d = RIG_DCD_OFF;
+    gint            retcode;
+
+    g_mutex_lock(&rig->lock);
+    retcode = rig_get_dcd(rig->rig, RIG_VFO_CURR, &d);
+    g_mutex_unlock(&rig->lock);
+
+    if (!check_retcode(retcode, __func__))
+        return FALSE;
+
+    *dcd = (d == RIG_DCD_ON);
+
+    return TRUE;
+}
+
+/**
+ * Open a rotator.
+ *
+ * @param model The Hamlib rotator model number, e.g. 1 for the dummy rotator.
+ * @param device The serial port or device path, NULL or empty to use the
+ *               backend default.
+ * @param speed The serial speed in baud, 0 to use the backend default.
+ * @return A new handle or NULL if the rotator could not be opened.
+ */
+hamlib_rot_t   *hamlib_rot_open(gint model, const gchar * device, gint speed)
+{
+    hamlib_rot_t   *rot;
+    gchar          *buff;
+    gint            retcode;
+
+    rot = g_try_new0(hamlib_rot_t, 1);
+    if (rot == NULL)
+        return NULL;
+
+    rot->rot = rot_init(model);
+    if (rot->rot == NULL)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Unknown Hamlib rotator model %d"), __func__, model);
+        g_free(rot);
+        return NULL;
+    }
+
+    if (device != NULL && device[0] != '\0')
+        rot_set_conf(rot->rot, rot_token_lookup(rot->rot, "rot_pathname"),
+                     device);
+
+    if (speed > 0)
+    {
+        buff = g_strdup_printf("%d", speed);
+        rot_set_conf(rot->rot, rot_token_lookup(rot->rot, "serial_speed"),
+                     buff);
+        g_free(buff);
+    }
+
+    retcode = rot_open(rot->rot);
+    if (retcode != RIG_OK)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Failed to open Hamlib rotator model %d (%s)"),
+                    __func__, model, rigerror(retcode));
+        rot_cleanup(rot->rot);
+        g_free(rot);
+        return NULL;
+    }
+
+    g_mutex_init(&rot->lock);
+
+    sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                _("%s: Opened Hamlib rotator model %d"), __func__, model);
+
+    return rot;
+}
+
+/** Close a rotator and free the handle. */
+void hamlib_rot_close(hamlib_rot_t * rot)
+{
+    if (rot == NULL)
+        return;
+
+    rot_close(rot->rot);
+    rot_cleanup(rot->rot);
+    g_mutex_clear(&rot->lock);
+    g_free(rot);
+}
+
+/** Command the rotator to a new position. */
+gboolean hamlib_rot_set_position(hamlib_rot_t * rot, gdouble az, gdouble el)
+{
+    gint            retcode;
+
+    g_mutex_lock(&rot->lock);
+    retcode = rot_set_position(rot->rot, az, el);
+    g_mutex_unlock(&rot->lock);
+
+    return check_retcode(retcode, __func__);
+}
+
+/** Read the current rotator position. */
+gboolean hamlib_rot_get_position(hamlib_rot_t * rot, gdouble * az,
+                                 gdouble * el)
+{
+    azimuth_t       a = 0.0;
+    elevation_t     e = 0.0;
+    gint            retcode;
+
+    g_mutex_lock(&rot->lock);
+    retcode = rot_get_position(rot->rot, &a, &e);
+    g_mutex_unlock(&rot->lock);
+
+    if (!check_retcode(retcode, __func__))
+        return FALSE;
+
+    *az = a;
+    *el = e;
+
+    return TRUE;
+}
+
+/** Stop the rotator. */
+gboolean hamlib_rot_stop(hamlib_rot_t * rot)
+{
+    gint            retcode;
+
+    g_mutex_lock(&rot->lock);
+    retcode = rot_stop(rot->rot);
+    g_mutex_unlock(&rot->lock);
+
+    return check_retcode(retcode, __func__);
+}
+
+#else
+
+gboolean hamlib_backend_available(void)
+{
+    return FALSE;
+}
+
+void hamlib_backend_set_debug(gint level)
+{
+    (void)level;
+}
+
+hamlib_rig_t   *hamlib_rig_open(gint model, const gchar * device, gint speed)
+{
+    (void)device;
+    (void)speed;
+
+    sat_log_log(SAT_LOG_LEVEL_ERROR,
+                _("%s: Cannot open rig model %d, gpredict was built "
+                  "without Hamlib"), __func__, model);
+
+    return NULL;
+}
+
+void hamlib_rig_close(hamlib_rig_t * rig)
+{
+    (void)rig;
+}
+
+gboolean hamlib_rig_set_freq(hamlib_rig_t * rig, gdouble freq)
+{
+    (void)rig;
+    (void)freq;
+    return FALSE;
+}
+
+gboolean hamlib_rig_get_freq(hamlib_rig_t * rig, gdouble * freq)
+{
+    (void)rig;
+    (void)freq;
+    return FALSE;
+}
+
+gboolean hamlib_rig_set_split_freq(hamlib_rig_t * rig, gdouble freq)
+{
+    (void)rig;
+    (void)freq;
+    return FALSE;
+}
+
+gboolean hamlib_rig_get_split_freq(hamlib_rig_t * rig, gdouble * freq)
+{
+    (void)rig;
+    (void)freq;
+    return FALSE;
+}
+
+gboolean hamlib_rig_set_split(hamlib_rig_t * rig, gboolean split,
+                              const gchar * txvfo)
+{
+    (void)rig;
+    (void)split;
+    (void)txvfo;
+    return FALSE;
+}
+
+gboolean hamlib_rig_set_ptt(hamlib_rig_t * rig, gboolean ptt)
+{
+    (void)rig;
+    (void)ptt;
+    return FALSE;
+}
+
+gboolean hamlib_rig_get_ptt(hamlib_rig_t * rig, gboolean * ptt)
+{
+    (void)rig;
+    (void)ptt;
+    return FALSE;
+}
+
+gboolean hamlib_rig_get_dcd(hamlib_rig_t * rig, gboolean * dcd)
+{
+    (void)rig;
+    (void)dcd;
+    return FALSE;
+}
+
+hamlib_rot_t   *hamlib_rot_open(gint model, const gchar * device, gint speed)
+{
+    (void)device;
+    (void)speed;
+
+    sat_log_log(SAT_LOG_LEVEL_ERROR,
+                _("%s: Cannot open rotator model %d, gpredict was built "
+                  "without Hamlib"), __func__, model);
+
+    return NULL;
+}
+
+void hamlib_rot_close(hamlib_rot_t * rot)
+{
+    (void)rot;
+}
+
+gboolean hamlib_rot_set_position(hamlib_rot_t * rot, gdouble az, gdouble el)
+{
+    (void)rot;
+    (void)az;
+    (void)el;
+    return FALSE;
+}
+
+gboolean hamlib_rot_get_position(hamlib_rot_t * rot, gdouble * az,
+                                 gdouble * el)
+{
+    (void)rot;
+    (void)az;
+    (void)el;
+    return FALSE;
+}
+
+gboolean hamlib_rot_stop(hamlib_rot_t * rot)
+{
+    (void)rot;
+    return FALSE;
+}
+
+#endif
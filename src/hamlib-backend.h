@@ -0,0 +1,35 @@
+#ifndef HAMLIB_BACKEND_H
+#define HAMLIB_BACKEND_H 1
+
+#include <glib.h>
+
+/** Opaque handle of a radio controlled in-process through Hamlib. */
+typedef struct _hamlib_rig hamlib_rig_t;
+
+/** Opaque handle of a rotator controlled in-process through Hamlib. */
+typedef struct _hamlib_rot hamlib_rot_t;
+
+gboolean        hamlib_backend_available(void);
+void            hamlib_backend_set_debug(gint level);
+
+hamlib_rig_t   *hamlib_rig_open(gint model, const gchar * device, gint speed);
+void            hamlib_rig_close(hamlib_rig_t * rig);
+gboolean        hamlib_rig_set_freq(hamlib_rig_t * rig, gdouble freq);
+gboolean        hamlib_rig_get_freq(hamlib_rig_t * rig, gdouble * freq);
+gboolean        hamlib_rig_set_split_freq(hamlib_rig_t * rig, gdouble freq);
+gboolean        hamlib_rig_get_split_freq(hamlib_rig_t * rig, gdouble * freq);
+gboolean        hamlib_rig_set_split(hamlib_rig_t * rig, gboolean split,
+                                     const gchar * txvfo);
+gboolean        hamlib_rig_set_ptt(hamlib_rig_t * rig, gboolean ptt);
+gboolean        hamlib_rig_get_ptt(hamlib_rig_t * rig, gboolean * ptt);
+gboolean        hamlib_rig_get_dcd(hamlib_rig_t * rig, gboolean * dcd);
+
+hamlib_rot_t   *hamlib_rot_open(gint model, const gchar * device, gint speed);
+void            hamlib_rot_close(hamlib_rot_t * rot);
+gboolean        hamlib_rot_set_position(hamlib_rot_t * rot,
+                                        gdouble az, gdouble el);
+gboolean        hamlib_rot_get_position(hamlib_rot_t * rot,
+                                        gdouble * az, gdouble * el);
+gboolean        hamlib_rot_stop(hamlib_rot_t * rot);
+
+#endif
@@ -0,0 +1,367 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Round trip times of the in-process Hamlib backend.
+ *
+ * Opens the Hamlib dummy rig and rotator (model 1) through hamlib-backend.c
+ * and times a set followed by a get. As baseline the same commands are sent
+ * to rigctld and rotctld over a TCP socket the way the radio and rotator
+ * controllers do it in network mode: one send() and one recv() of at most
+ * 128 bytes per command.
+ *
+ *   rigctld -m 1 &
+ *   rotctld -m 1 &
+ *   ./hamlib-bench --count=1000
+ *
+ * The program is not built by default; use "make hamlib-bench".
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#ifndef WIN32
+#include <arpa/inet.h>          /* htons() */
+#include <netdb.h>              /* gethostbyname() */
+#include <netinet/in.h>         /* struct sockaddr_in */
+#include <sys/socket.h>         /* socket(), connect(), send() */
+#include <unistd.h>             /* close() */
+#else
+#include <winsock2.h>
+#endif
+
+#include <glib.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hamlib-backend.h"
+#include "sat-log.h"
+
+
+#define MODEL_DUMMY     1
+
+static gint     count = 100;
+static gchar   *rigctld = NULL;
+static gchar   *rotctld = NULL;
+static gboolean verbose = FALSE;
+
+static GOptionEntry entries[] = {
+    {"count", 'n', 0, G_OPTION_ARG_INT, &count,
+     "Number of set/get round trips", "N"},
+    {"rigctld", 0, 0, G_OPTION_ARG_STRING, &rigctld,
+     "Address of rigctld (default localhost:4532)", "HOST:PORT"},
+    {"rotctld", 0, 0, G_OPTION_ARG_STRING, &rotctld,
+     "Address of rotctld (default localhost:4533)", "HOST:PORT"},
+    {"verbose", 'v', 0, G_OPTION_ARG_NONE, &verbose,
+     "Print debug messages of the backend", NULL},
+    {NULL}
+};
+
+
+/* The backend logs through sat_log_log(); print to stderr instead. */
+void sat_log_log(sat_log_level_t level, const char *fmt, ...)
+{
+    va_list         ap;
+
+    if ((level == SAT_LOG_LEVEL_DEBUG) && !verbose)
+        return;
+
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fputc('\n', stderr);
+}
+
+static void print_result(const gchar * name, gint n, gint64 total,
+                         gint64 max)
+{
+    if (n == 0)
+        printf("%-22s failed\n", name);
+    else
+        printf("%-22s %6d round trips, mean %9.1f us, max %9" G_GINT64_FORMAT
+               " us\n", name, n, (gdouble) total / n, max);
+}
+
+/*
+ * Connect to rigctld or rotctld at HOST:PORT.
+ *
+ * Returns the socket or -1 if the connection failed.
+ */
+static gint socket_open(const gchar * address)
+{
+    struct sockaddr_in ServAddr;
+    struct hostent *h;
+    gchar         **vbuff;
+    gint            sock;
+    gint            status;
+
+    vbuff = g_strsplit(address, ":", 2);
+    if ((vbuff[0] == NULL) || (vbuff[1] == NULL) ||
+        ((h = gethostbyname(vbuff[0])) == NULL))
+    {
+        fprintf(stderr, "Can not resolve %s\n", address);
+        g_strfreev(vbuff);
+        return -1;
+    }
+
+    memset(&ServAddr, 0, sizeof(ServAddr));
+    ServAddr.sin_family = AF_INET;
+    memcpy((char *)&ServAddr.sin_addr.s_addr, h->h_addr_list[0], h->h_length);
+    ServAddr.sin_port = htons(atoi(vbuff[1]));
+    g_strfreev(vbuff);
+
+    sock = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock == -1)
+        return -1;
+
+    status = connect(sock, (struct sockaddr *)&ServAddr, sizeof(ServAddr));
+    if (status == -1)
+    {
+        fprintf(stderr, "Can not connect to %s\n", address);
+#ifdef WIN32
+        closesocket(sock);
+#else
+        close(sock);
+#endif
+        return -1;
+    }
+
+    return sock;
+}
+
+static void socket_close(gint sock)
+{
+    send(sock, "q\x0a", 2, 0);
+#ifndef WIN32
+    shutdown(sock, SHUT_RDWR);
+    close(sock);
+#else
+    shutdown(sock, SD_BOTH);
+    closesocket(sock);
+#endif
+}
+
+/*
+ * Send a command and read the answer like the controllers do.
+ *
+ * Returns FALSE if the socket failed or the daemon returned an error code
+ * other than RPRT 0.
+ */
+static gboolean socket_rw(gint sock, const gchar * buff, gchar * buffout,
+                          gint sizeout)
+{
+    gint            size;
+
+    size = strlen(buff);
+    if (send(sock, buff, size, 0) != size)
+        return FALSE;
+
+    size = recv(sock, buffout, sizeout - 1, 0);
+    if (size <= 0)
+        return FALSE;
+
+    buffout[size] = '\0';
+
+    return ((strncmp(buffout, "RPRT", 4) != 0) ||
+            (strncmp(buffout, "RPRT 0", 6) == 0));
+}
+
+/* Time F/f round trips through rigctld. */
+static void bench_rigctld(const gchar * name, const gchar * address)
+{
+    gchar          *buff;
+    gchar           buffback[128];
+    gdouble         freq;
+    gint64          t, total = 0, max = 0;
+    gint            sock;
+    gint            i;
+
+    sock = socket_open(address);
+    if (sock == -1)
+    {
+        print_result(name, 0, 0, 0);
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        buff = g_strdup_printf("F %10.0f\x0a", 145.8e6 + i * 10.0);
+
+        t = g_get_monotonic_time();
+        if (!socket_rw(sock, buff, buffback, sizeof(buffback)) ||
+            !socket_rw(sock, "f\x0a", buffback, sizeof(buffback)))
+        {
+            g_free(buff);
+            break;
+        }
+        t = g_get_monotonic_time() - t;
+        g_free(buff);
+
+        freq = g_ascii_strtod(buffback, NULL);
+        if (freq != 145.8e6 + i * 10.0)
+            fprintf(stderr, "%s: Read back %.0f Hz, expected %.0f Hz\n",
+                    name, freq, 145.8e6 + i * 10.0);
+
+        total += t;
+        max = MAX(max, t);
+    }
+
+    socket_close(sock);
+    print_result(name, i, total, max);
+}
+
+/* Time P/p round trips through rotctld. */
+static void bench_rotctld(const gchar * name, const gchar * address)
+{
+    gchar          *buff;
+    gchar           buffback[128];
+    gint64          t, total = 0, max = 0;
+    gint            sock;
+    gint            i;
+
+    sock = socket_open(address);
+    if (sock == -1)
+    {
+        print_result(name, 0, 0, 0);
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        buff = g_strdup_printf("P %.2f %.2f\x0a", (gdouble) (i % 360), 45.0);
+
+        t = g_get_monotonic_time();
+        if (!socket_rw(sock, buff, buffback, sizeof(buffback)) ||
+            !socket_rw(sock, "p\x0a", buffback, sizeof(buffback)))
+        {
+            g_free(buff);
+            break;
+        }
+        t = g_get_monotonic_time() - t;
+        g_free(buff);
+
+        total += t;
+        max = MAX(max, t);
+    }
+
+    socket_close(sock);
+    print_result(name, i, total, max);
+}
+
+/* Time set_freq/get_freq round trips of a radio. */
+static void bench_rig(const gchar * name, gint model, const gchar * device)
+{
+    hamlib_rig_t   *rig;
+    gdouble         freq;
+    gint64          t, total = 0, max = 0;
+    gint            i;
+
+    rig = hamlib_rig_open(model, device, 0);
+    if (rig == NULL)
+    {
+        print_result(name, 0, 0, 0);
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        t = g_get_monotonic_time();
+        if (!hamlib_rig_set_freq(rig, 145.8e6 + i * 10.0) ||
+            !hamlib_rig_get_freq(rig, &freq))
+            break;
+        t = g_get_monotonic_time() - t;
+
+        if (freq != 145.8e6 + i * 10.0)
+            fprintf(stderr, "%s: Read back %.0f Hz, expected %.0f Hz\n",
+                    name, freq, 145.8e6 + i * 10.0);
+
+        total += t;
+        max = MAX(max, t);
+    }
+
+    hamlib_rig_close(rig);
+    print_result(name, i, total, max);
+}
+
+/* Time set_position/get_position round trips of a rotator. */
+static void bench_rot(const gchar * name, gint model, const gchar * device)
+{
+    hamlib_rot_t   *rot;
+    gdouble         az, el;
+    gint64          t, total = 0, max = 0;
+    gint            i;
+
+    rot = hamlib_rot_open(model, device, 0);
+    if (rot == NULL)
+    {
+        print_result(name, 0, 0, 0);
+        return;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        t = g_get_monotonic_time();
+        if (!hamlib_rot_set_position(rot, i % 360, 45.0) ||
+            !hamlib_rot_get_position(rot, &az, &el))
+            break;
+        t = g_get_monotonic_time() - t;
+
+        total += t;
+        max = MAX(max, t);
+    }
+
+    hamlib_rot_close(rot);
+    print_result(name, i, total, max);
+}
+
+int main(int argc, char *argv[])
+{
+    GOptionContext *context;
+    GError         *err = NULL;
+
+    context = g_option_context_new("- time Hamlib set/get round trips");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &err))
+    {
+        fprintf(stderr, "%s\n", err->message);
+        g_clear_error(&err);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    if (!hamlib_backend_available())
+    {
+        fprintf(stderr, "gpredict has been built without Hamlib\n");
+        return EXIT_FAILURE;
+    }
+
+    bench_rigctld("rig (rigctld)", rigctld ? rigctld : "localhost:4532");
+    bench_rig("rig (in-process)", MODEL_DUMMY, NULL);
+    bench_rotctld("rotator (rotctld)", rotctld ? rotctld : "localhost:4533");
+    bench_rot("rotator (in-process)", MODEL_DUMMY, NULL);
+
+    g_free(rigctld);
+    g_free(rotctld);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,722 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Indexed location database.
+ *
+ * The text based locations file is converted into a compact binary index
+ * which is stored in the user config directory and memory mapped on later
+ * use. The index is rebuilt whenever the modification time or size of the
+ * locations file changes.
+ *
+ * Index layout (native byte order):
+ *
+ *   header
+ *   records      num_recs x idx_rec_t, in the order of the locations file
+ *   words        num_words x idx_word_t, sorted by casefolded word
+ *   cells        LOC_GRID_CELLS + 1 offsets into cellrecs
+ *   cellrecs     num_recs record numbers ordered by grid cell
+ *   strings      str_size bytes of NUL terminated strings
+ *
+ * Every word of the city name and the weather station name is entered into
+ * the word table, so a binary search finds all locations having a word
+ * starting with the search text. The lat/lon grid is used to find the
+ * locations closest to a given point.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+#include <glib.h>
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <math.h>
+#include <string.h>
+
+#include "compat.h"
+#include "loc-index.h"
+#include "sat-log.h"
+
+
+#define LOC_INDEX_MAGIC     "GPLOCIDX"
+#define LOC_INDEX_VERSION   1
+
+/* lat/lon grid used for nearest location queries */
+#define LOC_GRID_STEP       5
+#define LOC_GRID_ROWS       (180 / LOC_GRID_STEP)
+#define LOC_GRID_COLS       (360 / LOC_GRID_STEP)
+#define LOC_GRID_CELLS      (LOC_GRID_ROWS * LOC_GRID_COLS)
+
+#define EARTH_RADIUS        6371.0      /* mean radius in km */
+#define DEG2RAD(x)          ((x) * G_PI / 180.0)
+
+typedef struct {
+    gchar           magic[8];
+    guint32         version;
+    guint32         num_recs;
+    guint32         num_words;
+    guint32         str_size;
+    gint64          src_mtime;  /* mtime of the locations file */
+    gint64          src_size;   /* size of the locations file */
+} idx_header_t;
+
+typedef struct {
+    guint32         region;     /* string offsets */
+    guint32         country;
+    guint32         city;
+    guint32         wx;
+    gfloat          lat;
+    gfloat          lon;
+    guint32         alt;
+} idx_rec_t;
+
+typedef struct {
+    guint32         key;        /* offset of casefolded word in string pool */
+    guint32         rec;        /* record containing the word */
+} idx_word_t;
+
+struct _loc_index {
+    GMappedFile    *mfile;      /* mapped index file */
+    guint8         *data;       /* index data if it is not mapped */
+    const idx_header_t *hdr;
+    const idx_rec_t *recs;
+    const idx_word_t *words;
+    const guint32  *cells;
+    const guint32  *cellrecs;
+    const gchar    *str;
+};
+
+typedef struct {
+    gdouble         dist;
+    guint           rec;
+} loc_dist_t;
+
+
+static gint loc_grid_row(gdouble lat)
+{
+    gint            row = (gint) floor((lat + 90.0) / LOC_GRID_STEP);
+
+    return CLAMP(row, 0, LOC_GRID_ROWS - 1);
+}
+
+static gint loc_grid_col(gdouble lon)
+{
+    gint            col = (gint) floor((lon + 180.0) / LOC_GRID_STEP);
+
+    col %= LOC_GRID_COLS;
+    if (col < 0)
+        col += LOC_GRID_COLS;
+
+    return col;
+}
+
+/* Number of columns between two grid columns, going the shortest way */
+static gint loc_grid_col_dist(gint c1, gint c2)
+{
+    gint            d = ABS(c1 - c2);
+
+    return MIN(d, LOC_GRID_COLS - d);
+}
+
+/* Name of the index file belonging to a locations file */
+static gchar   *loc_index_file_name(const gchar * fname)
+{
+    gchar          *confdir;
+    gchar          *hash;
+    gchar          *idxname;
+
+    hash = g_compute_checksum_for_string(G_CHECKSUM_MD5, fname, -1);
+    confdir = get_user_conf_dir();
+    idxname = g_strdup_printf("%s%slocations-%s.idx", confdir,
+                              G_DIR_SEPARATOR_S, hash);
+    g_free(confdir);
+    g_free(hash);
+
+    return idxname;
+}
+
+/* Add string to the string pool, reusing identical strings */
+static guint32 pool_add(GString * pool, GHashTable * strings,
+                        const gchar * str)
+{
+    gpointer        offset;
+
+    if (g_hash_table_lookup_extended(strings, str, NULL, &offset))
+        return GPOINTER_TO_UINT(offset);
+
+    offset = GUINT_TO_POINTER(pool->len);
+    g_string_append_len(pool, str, strlen(str) + 1);
+    g_hash_table_insert(strings, g_strdup(str), offset);
+
+    return GPOINTER_TO_UINT(offset);
+}
+
+/* Add each word of str to the word table */
+static void add_words(GArray * words, GString * pool, GHashTable * strings,
+                      const gchar * str, guint32 rec)
+{
+    gchar          *fold;
+    const gchar    *p;
+    guint32         base;
+    gboolean        inword = FALSE;
+    idx_word_t      word;
+
+    if (*str == '\0')
+        return;
+
+    fold = g_utf8_casefold(str, -1);
+    base = pool_add(pool, strings, fold);
+
+    word.rec = rec;
+    for (p = fold; *p != '\0'; p = g_utf8_next_char(p))
+    {
+        if (g_unichar_isalnum(g_utf8_get_char(p)))
+        {
+            if (!inword)
+            {
+                word.key = base + (guint32) (p - fold);
+                g_array_append_val(words, word);
+            }
+            inword = TRUE;
+        }
+        else
+        {
+            inword = FALSE;
+        }
+    }
+
+    g_free(fold);
+}
+
+static gint compare_words(gconstpointer a, gconstpointer b, gpointer pool)
+{
+    const idx_word_t *wa = a;
+    const idx_word_t *wb = b;
+    const gchar    *str = pool;
+    gint            res;
+
+    res = strcmp(str + wa->key, str + wb->key);
+    if (res == 0)
+        res = (wa->rec < wb->rec) ? -1 : (wa->rec > wb->rec);
+
+    return res;
+}
+
+/**
+ * Build location index from locations file.
+ *
+ * @param fname The locations file.
+ * @param mtime Modification time of the locations file.
+ * @param size Size of the locations file.
+ * @return The index data or NULL if the file could not be read.
+ *
+ * Each line of the locations file contains:
+ * region;country;city;weather station;latitude;longitude;altitude
+ */
+static GByteArray *loc_index_build(const gchar * fname, gint64 mtime,
+                                   gint64 size)
+{
+    GByteArray     *data;
+    GArray         *recs;
+    GArray         *words;
+    GString        *pool;
+    GHashTable     *strings;
+    guint32        *cells;
+    guint32        *cellrecs;
+    guint32        *cursor;
+    idx_header_t    hdr;
+    idx_rec_t       rec;
+    gchar          *contents;
+    gchar         **lines;
+    gchar         **buff;
+    GError         *error = NULL;
+    guint           i, cell;
+
+    if (!g_file_get_contents(fname, &contents, NULL, &error))
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Failed to read %s (%s)"),
+                    __func__, fname, error->message);
+        g_clear_error(&error);
+        return NULL;
+    }
+
+    lines = g_strsplit(contents, "\n", -1);
+    g_free(contents);
+
+    recs = g_array_new(FALSE, FALSE, sizeof(idx_rec_t));
+    words = g_array_new(FALSE, FALSE, sizeof(idx_word_t));
+    pool = g_string_new(NULL);
+    strings = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+    /* offset 0 is the empty string */
+    pool_add(pool, strings, "");
+
+    for (i = 0; lines[i] != NULL; i++)
+    {
+        buff = g_strsplit(lines[i], ";", 7);
+
+        if (g_strv_length(buff) < 7)
+        {
+            if (*g_strstrip(lines[i]) != '\0')
+                sat_log_log(SAT_LOG_LEVEL_WARN,
+                            _("%s: Skipping malformed line %d in %s"),
+                            __func__, i + 1, fname);
+            g_strfreev(buff);
+            continue;
+        }
+
+        rec.region = pool_add(pool, strings, g_strstrip(buff[0]));
+        rec.country = pool_add(pool, strings, g_strstrip(buff[1]));
+        rec.city = pool_add(pool, strings, g_strstrip(buff[2]));
+        rec.wx = pool_add(pool, strings, g_strstrip(buff[3]));
+        rec.lat = (gfloat) g_ascii_strtod(buff[4], NULL);
+        rec.lon = (gfloat) g_ascii_strtod(buff[5], NULL);
+        rec.alt = (guint32) g_ascii_strtod(buff[6], NULL);
+
+        add_words(words, pool, strings, buff[2], recs->len);
+        add_words(words, pool, strings, buff[3], recs->len);
+
+        g_array_append_val(recs, rec);
+        g_strfreev(buff);
+    }
+    g_strfreev(lines);
+    g_hash_table_destroy(strings);
+
+    g_array_sort_with_data(words, compare_words, pool->str);
+
+    /* distribute the records over the grid cells */
+    cells = g_new0(guint32, LOC_GRID_CELLS + 1);
+    cellrecs = g_new(guint32, MAX(recs->len, 1));
+    cursor = g_new0(guint32, LOC_GRID_CELLS);
+
+    for (i = 0; i < recs->len; i++)
+    {
+        rec = g_array_index(recs, idx_rec_t, i);
+        cell = loc_grid_row(rec.lat) * LOC_GRID_COLS + loc_grid_col(rec.lon);
+        cells[cell + 1]++;
+    }
+    for (cell = 0; cell < LOC_GRID_CELLS; cell++)
+    {
+        cells[cell + 1] += cells[cell];
+        cursor[cell] = cells[cell];
+    }
+    for (i = 0; i < recs->len; i++)
+    {
+        rec = g_array_index(recs, idx_rec_t, i);
+        cell = loc_grid_row(rec.lat) * LOC_GRID_COLS + loc_grid_col(rec.lon);
+        cellrecs[cursor[cell]++] = i;
+    }
+    g_free(cursor);
+
+    /* assemble index */
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, LOC_INDEX_MAGIC, sizeof(hdr.magic));
+    hdr.version = LOC_INDEX_VERSION;
+    hdr.num_recs = recs->len;
+    hdr.num_words = words->len;
+    hdr.str_size = pool->len;
+    hdr.src_mtime = mtime;
+    hdr.src_size = size;
+
+    data = g_byte_array_new();
+    g_byte_array_append(data, (guint8 *) & hdr, sizeof(hdr));
+    g_byte_array_append(data, (guint8 *) recs->data,
+                        recs->len * sizeof(idx_rec_t));
+    g_byte_array_append(data, (guint8 *) words->data,
+                        words->len * sizeof(idx_word_t));
+    g_byte_array_append(data, (guint8 *) cells,
+                        (LOC_GRID_CELLS + 1) * sizeof(guint32));
+    g_byte_array_append(data, (guint8 *) cellrecs,
+                        recs->len * sizeof(guint32));
+    g_byte_array_append(data, (guint8 *) pool->str, pool->len);
+
+    sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                _("%s: Indexed %d locations (%d words) from %s"),
+                __func__, recs->len, words->len, fname);
+
+    g_array_free(recs, TRUE);
+    g_array_free(words, TRUE);
+    g_string_free(pool, TRUE);
+    g_free(cells);
+    g_free(cellrecs);
+
+    return data;
+}
+
+/* Validate index data and set up the section pointers */
+static gboolean loc_index_attach(loc_index_t * index, const gchar * data,
+                                 gsize length)
+{
+    const idx_header_t *hdr = (const idx_header_t *)data;
+    gsize           expected;
+
+    if (length < sizeof(idx_header_t) ||
+        memcmp(hdr->magic, LOC_INDEX_MAGIC, sizeof(hdr->magic)) ||
+        hdr->version != LOC_INDEX_VERSION || hdr->str_size == 0)
+        return FALSE;
+
+    expected = sizeof(idx_header_t) +
+        (gsize) hdr->num_recs * (sizeof(idx_rec_t) + sizeof(guint32)) +
+        (gsize) hdr->num_words * sizeof(idx_word_t) +
+        (LOC_GRID_CELLS + 1) * sizeof(guint32) + hdr->str_size;
+
+    if (length != expected)
+        return FALSE;
+
+    index->hdr = hdr;
+    index->recs = (const idx_rec_t *)(data + sizeof(idx_header_t));
+    index->words = (const idx_word_t *)(index->recs + hdr->num_recs);
+    index->cells = (const guint32 *)(index->words + hdr->num_words);
+    index->cellrecs = index->cells + LOC_GRID_CELLS + 1;
+    index->str = (const gchar *)(index->cellrecs + hdr->num_recs);
+
+    /* make sure string lookups can not run past the end */
+    return (index->str[hdr->str_size - 1] == '\0');
+}
+
+/**
+ * Open the location index of a locations file.
+ *
+ * @param fname The locations file.
+ * @return A new location index or NULL if the locations file could not be read.
+ *
+ * The index is loaded from the user config directory. If it does not exist or
+ * is out of date, it is rebuilt from the locations file and saved for later use.
+ */
+loc_index_t    *loc_index_open(const gchar * fname)
+{
+    loc_index_t    *index;
+    GByteArray     *data;
+    GStatBuf        st;
+    gsize           length;
+    gchar          *idxname;
+    GError         *error = NULL;
+
+    if (g_stat(fname, &st))
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: %s does not exist!"), __func__, fname);
+        return NULL;
+    }
+
+    index = g_new0(loc_index_t, 1);
+    idxname = loc_index_file_name(fname);
+
+    /* try the existing index first */
+    index->mfile = g_mapped_file_new(idxname, FALSE, NULL);
+    if (index->mfile != NULL)
+    {
+        if (!loc_index_attach(index, g_mapped_file_get_contents(index->mfile),
+                              g_mapped_file_get_length(index->mfile)) ||
+            index->hdr->src_mtime != (gint64) st.st_mtime ||
+            index->hdr->src_size != (gint64) st.st_size)
+        {
+            sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                        _("%s: Location index %s is out of date"),
+                        __func__, idxname);
+            g_mapped_file_unref(index->mfile);
+            index->mfile = NULL;
+        }
+    }
+
+    if (index->mfile == NULL)
+    {
+        data = loc_index_build(fname, st.st_mtime, st.st_size);
+        if (data == NULL)
+        {
+            g_free(idxname);
+            g_free(index);
+            return NULL;
+        }
+
+        if (!g_file_set_contents(idxname, (const gchar *)data->data,
+                                 data->len, &error))
+        {
+            /* not fatal; the index is rebuilt next time */
+            sat_log_log(SAT_LOG_LEVEL_WARN,
+                        _("%s: Could not save location index (%s)"),
+                        __func__, error->message);
+            g_clear_error(&error);
+        }
+
+        length = data->len;
+        index->data = g_byte_array_free(data, FALSE);
+        if (!loc_index_attach(index, (const gchar *)index->data, length))
+        {
+            /* this is a bug */
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Invalid location index built from %s"),
+                        __func__, fname);
+            loc_index_close(index);
+            index = NULL;
+        }
+    }
+
+    g_free(idxname);
+
+    return index;
+}
+
+/** Close location index and free all memory. */
+void loc_index_close(loc_index_t * index)
+{
+    if (index == NULL)
+        return;
+
+    if (index->mfile != NULL)
+        g_mapped_file_unref(index->mfile);
+    g_free(index->data);
+    g_free(index);
+}
+
+/** Get the number of locations in the index. */
+guint loc_index_size(loc_index_t * index)
+{
+    g_return_val_if_fail(index != NULL, 0);
+
+    return index->hdr->num_recs;
+}
+
+/**
+ * Get location from index.
+ *
+ * @param index The location index.
+ * @param n The location number (0 ... loc_index_size() - 1).
+ * @param loc Pointer to where the location data should be stored.
+ * @return TRUE if the location exists, FALSE otherwise.
+ */
+gboolean loc_index_get(loc_index_t * index, guint n, loc_t * loc)
+{
+    const idx_rec_t *rec;
+
+    g_return_val_if_fail((index != NULL) && (loc != NULL), FALSE);
+
+    if (n >= index->hdr->num_recs)
+        return FALSE;
+
+    rec = &index->recs[n];
+    loc->region = index->str + rec->region;
+    loc->country = index->str + rec->country;
+    loc->city = index->str + rec->city;
+    loc->wx = index->str + rec->wx;
+    loc->lat = rec->lat;
+    loc->lon = rec->lon;
+    loc->alt = rec->alt;
+
+    return TRUE;
+}
+
+/**
+ * Search for locations.
+ *
+ * @param index The location index.
+ * @param text The search text.
+ * @param max The maximum number of results.
+ * @return Newly allocated array of location numbers (guint) of the locations
+ *         having a word in the city or weather station name that starts with
+ *         text. Case is ignored. Must be freed with g_array_free after use.
+ */
+GArray         *loc_index_search(loc_index_t * index, const gchar * text,
+                                 guint max)
+{
+    GArray         *result;
+    GHashTable     *seen;
+    gchar          *fold;
+    guint           lo, hi, mid;
+    guint           rec;
+
+    g_return_val_if_fail((index != NULL) && (text != NULL), NULL);
+
+    result = g_array_new(FALSE, FALSE, sizeof(guint));
+
+    fold = g_utf8_casefold(text, -1);
+    g_strstrip(fold);
+    if (*fold == '\0')
+    {
+        g_free(fold);
+        return result;
+    }
+
+    /* find the first word that is not less than the search text */
+    lo = 0;
+    hi = index->hdr->num_words;
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        if (strcmp(index->str + index->words[mid].key, fold) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    /* a location may match with several words */
+    seen = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    for (; lo < index->hdr->num_words && result->len < max; lo++)
+    {
+        if (!g_str_has_prefix(index->str + index->words[lo].key, fold))
+            break;
+
+        rec = index->words[lo].rec;
+        if (!g_hash_table_contains(seen, GUINT_TO_POINTER(rec)))
+        {
+            g_hash_table_add(seen, GUINT_TO_POINTER(rec));
+            g_array_append_val(result, rec);
+        }
+    }
+
+    g_hash_table_destroy(seen);
+    g_free(fold);
+
+    return result;
+}
+
+/* Insert location into the sorted list of the max nearest locations */
+static void nearest_add(GArray * best, guint max, gdouble dist, guint rec)
+{
+    loc_dist_t      item;
+    guint           i;
+
+    if (best->len == max &&
+        dist >= g_array_index(best, loc_dist_t, max - 1).dist)
+        return;
+
+    for (i = best->len; i > 0; i--)
+        if (g_array_index(best, loc_dist_t, i - 1).dist <= dist)
+            break;
+
+    item.dist = dist;
+    item.rec = rec;
+    g_array_insert_val(best, i, item);
+
+    if (best->len > max)
+        g_array_set_size(best, max);
+}
+
+/*
+ * Lower bound for the distance from (lat, lon) to any location outside
+ * the cells within r rings of the cell containing (lat, lon).
+ */
+static gdouble nearest_bound(gdouble lat, gint r)
+{
+    gdouble         dlat, dlon;
+    gdouble         latmax;
+    gdouble         h;
+
+    /* locations in rows further away */
+    dlat = EARTH_RADIUS * DEG2RAD(r * LOC_GRID_STEP);
+
+    /* all columns have been searched */
+    if (2 * r + 1 >= LOC_GRID_COLS)
+        return dlat;
+
+    /* locations in columns further away, within the searched rows */
+    latmax = MIN(fabs(lat) + (r + 1) * LOC_GRID_STEP, 90.0);
+    h = cos(DEG2RAD(lat)) * cos(DEG2RAD(latmax)) *
+        pow(sin(DEG2RAD(r * LOC_GRID_STEP) / 2.0), 2);
+    dlon = 2.0 * EARTH_RADIUS * asin(sqrt(MIN(h, 1.0)));
+
+    return MIN(dlat, dlon);
+}
+
+/**
+ * Find the locations nearest to a point.
+ *
+ * @param index The location index.
+ * @param lat Latitude of the point in dec. deg. north.
+ * @param lon Longitude of the point in dec. deg. east.
+ * @param max The maximum number of results.
+ * @return Newly allocated array of location numbers (guint) sorted by
+ *         increasing distance. Must be freed with g_array_free after use.
+ *
+ * The grid cells are searched in rings around the cell containing the point
+ * until no unsearched location can be closer than the ones found.
+ */
+GArray         *loc_index_nearest(loc_index_t * index, gdouble lat,
+                                  gdouble lon, guint max)
+{
+    GArray         *best;
+    GArray         *result;
+    const idx_rec_t *rec;
+    gint            row0, col0;
+    gint            r, row, col, dr;
+    guint           cell, i;
+
+    g_return_val_if_fail(index != NULL, NULL);
+
+    best = g_array_sized_new(FALSE, FALSE, sizeof(loc_dist_t), max + 1);
+    row0 = loc_grid_row(lat);
+    col0 = loc_grid_col(lon);
+
+    for (r = 0; max > 0 && r <= MAX(LOC_GRID_ROWS - 1, LOC_GRID_COLS / 2);
+         r++)
+    {
+        /* search the cells exactly r rings away */
+        for (row = MAX(row0 - r, 0); row <= MIN(row0 + r, LOC_GRID_ROWS - 1);
+             row++)
+        {
+            dr = ABS(row - row0);
+            for (col = 0; col < LOC_GRID_COLS; col++)
+            {
+                if (MAX(dr, loc_grid_col_dist(col, col0)) != r)
+                    continue;
+
+                cell = row * LOC_GRID_COLS + col;
+                for (i = index->cells[cell]; i < index->cells[cell + 1]; i++)
+                {
+                    rec = &index->recs[index->cellrecs[i]];
+                    nearest_add(best, max,
+                                loc_index_distance(lat, lon, rec->lat,
+                                                   rec->lon),
+                                index->cellrecs[i]);
+                }
+            }
+        }
+
+        if (best->len == max &&
+            g_array_index(best, loc_dist_t, max - 1).dist <=
+            nearest_bound(lat, r))
+            break;
+    }
+
+    result = g_array_sized_new(FALSE, FALSE, sizeof(guint), best->len);
+    for (i = 0; i < best->len; i++)
+        g_array_append_val(result, g_array_index(best, loc_dist_t, i).rec);
+    g_array_free(best, TRUE);
+
+    return result;
+}
+
+/**
+ * Great circle distance between two points.
+ *
+ * @return The distance in km.
+ */
+gdouble loc_index_distance(gdouble lat1, gdouble lon1,
+                           gdouble lat2, gdouble lon2)
+{
+    gdouble         h;
+
+    h = pow(sin(DEG2RAD(lat2 - lat1) / 2.0), 2) +
+        cos(DEG2RAD(lat1)) * cos(DEG2RAD(lat2)) *
+        pow(sin(DEG2RAD(lon2 - lon1) / 2.0), 2);
+
+    return 2.0 * EARTH_RADIUS * asin(sqrt(MIN(h, 1.0)));
+}
@@ -0,0 +1,35 @@
+#ifndef LOC_INDEX_H
+#define LOC_INDEX_H 1
+
+#include <glib.h>
+
+/** Opaque location index handle. */
+typedef struct _loc_index loc_index_t;
+
+/**
+ * Location record.
+ *
+ * The strings point into the index and are valid until the index is closed.
+ */
+typedef struct {
+    const gchar    *region;     /*!< Continent or region. */
+    const gchar    *country;    /*!< Country or state in the US. */
+    const gchar    *city;       /*!< City name. */
+    const gchar    *wx;         /*!< Weather station. */
+    gfloat          lat;        /*!< Latitude in dec. deg. north. */
+    gfloat          lon;        /*!< Longitude in dec. deg. east. */
+    guint           alt;        /*!< Altitude in meters. */
+} loc_t;
+
+loc_index_t    *loc_index_open(const gchar * fname);
+void            loc_index_close(loc_index_t * index);
+guint           loc_index_size(loc_index_t * index);
+gboolean        loc_index_get(loc_index_t * index, guint n, loc_t * loc);
+GArray         *loc_index_search(loc_index_t * index, const gchar * text,
+                                 guint max);
+GArray         *loc_index_nearest(loc_index_t * index, gdouble lat,
+                                  gdouble lon, guint max);
+gdouble         loc_index_distance(gdouble lat1, gdouble lon1,
+                                   gdouble lat2, gdouble lon2);
+
+#endif
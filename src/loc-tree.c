@@ -27,6 +27,8 @@
 #include <gtk/gtk.h>
 #include <math.h>
 #include "compat.h"
+#include "gpredict-utils.h"
+#include "loc-index.h"
 #include "loc-tree.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
@@ -37,8 +39,39 @@
 #define LTMNI  123456
 #define LTEPS  1.0
 
-
-static GtkTreeModel *loc_tree_create_and_fill_model(const gchar * fname);
+/* max number of search results shown */
+#define LOC_SEARCH_MAX   200
+#define LOC_NEAREST_MAX  25
+
+/* Invisible columns private to the location tree. Country rows hold the
+   range [first;end) of their locations in the index until the cities
+   are inserted on the first expansion. */
+#define LOC_COL_FIRST    TREE_COL_NUM
+#define LOC_COL_END      (TREE_COL_NUM + 1)
+#define LOC_COL_NUM      (TREE_COL_NUM + 2)
+
+/* data used by the search callbacks while the dialog is running */
+typedef struct {
+    GtkWidget      *dialog;
+    GtkWidget      *view;
+    GtkWidget      *search;
+    GtkTreeModel   *tree;       /* the full location tree */
+    loc_index_t    *index;
+    gdouble         lat;        /* reference point for nearest search */
+    gdouble         lon;
+} loc_tree_search_t;
+
+
+static GtkTreeModel *loc_tree_create_and_fill_model(loc_index_t * index);
+static GtkTreeStore *loc_tree_create_store(void);
+static void     loc_tree_search_changed_cb(GtkEntry * entry, gpointer data);
+static void     loc_tree_search_icon_cb(GtkEntry * entry,
+                                        GtkEntryIconPosition icon_pos,
+                                        GdkEvent * event, gpointer data);
+static void     loc_tree_nearest_cb(GtkButton * button, gpointer data);
+static gboolean loc_tree_test_expand_cb(GtkTreeView * view,
+                                        GtkTreeIter * iter,
+                                        GtkTreePath * path, gpointer data);
 
 static void     loc_tree_float_cell_data_function(GtkTreeViewColumn * col,
                                                   GtkCellRenderer * renderer,
@@ -68,8 +101,10 @@ static void     loc_tree_get_selection(GtkWidget * view,
  * @param fname The name of the file, which contains locations data. Can be NULL.
  * @param flags Bitise or of flags indicating which columns to display.
  * @param location Newly allocated string containing location (city, country)
- * @param lat Pointer to where the latitude should be stored.
- * @param lon Pointer to where the longitude should be stored.
+ * @param lat Pointer to where the latitude should be stored. On entry it
+ *            contains the latitude used to search for nearby locations.
+ * @param lon Pointer to where the longitude should be stored. On entry it
+ *            contains the longitude used to search for nearby locations.
  * @param alt Pointer to where the altitude should be stored.
  * @param wx Newly allocated string containing the four letter weather station name.
  * @return TRUE if a location has been selected and the returned data is valid,
@@ -91,6 +126,9 @@ gboolean loc_tree_create(const gchar * fname,
     GtkTreeSelection *selection;        /* used to set selection checking func */
     GtkWidget      *swin;       /* scrolled window widget */
     GtkWidget      *dialog;     /* the dialog widget */
+    GtkWidget      *hbox;       /* search entry and nearest button */
+    GtkWidget      *button;
+    loc_tree_search_t search;
     gint            response;   /* response ID returned by gtk_dialog_run */
     gchar          *ffname;
     gboolean        retval;
@@ -201,17 +239,24 @@ gboolean loc_tree_create(const gchar * fname,
     gtk_tree_view_column_set_visible(column, FALSE);
 
     /* create model and finalise treeview */
-    model = loc_tree_create_and_fill_model(ffname);
+    search.index = loc_index_open(ffname);
+    model = loc_tree_create_and_fill_model(search.index);
 
     /* we are done with it */
     g_free(ffname);
 
     gtk_tree_view_set_model(GTK_TREE_VIEW(view), model);
 
-    /* The tree view has acquired its own reference to the
-     *  model, so we can drop ours. That way the model will
-     *  be freed automatically when the tree view is destroyed */
-    g_object_unref(model);
+    /* We keep our reference to the model since the view is switched
+       to the search results and back while the dialog is running */
+    search.tree = model;
+    search.view = view;
+    search.lat = *lat;
+    search.lon = *lon;
+
+    /* cities are inserted when their country is expanded */
+    g_signal_connect(view, "test-expand-row",
+                     G_CALLBACK(loc_tree_test_expand_cb), &search);
 
     /* make sure rows are checked when they are selected */
     /* ... but first create the dialog window .... */
@@ -233,6 +278,57 @@ gboolean loc_tree_create(const gchar * fname,
                                          NULL);
 
     gtk_window_set_default_size(GTK_WINDOW(dialog), 450, 400);
+    search.dialog = dialog;
+
+    /* search entry and nearest location button */
+    search.search = gtk_entry_new();
+    gtk_widget_set_tooltip_text(search.search,
+                                _("Search for a city or weather station"));
+#ifdef G_OS_WIN32
+    gtk_entry_set_icon_from_icon_name(GTK_ENTRY(search.search),
+                                      GTK_ENTRY_ICON_PRIMARY,
+                                      "edit-find-symbolic");
+    gtk_entry_set_icon_from_icon_name(GTK_ENTRY(search.search),
+                                      GTK_ENTRY_ICON_SECONDARY,
+                                      "edit-clear-symbolic");
+#else
+    gtk_entry_set_icon_from_icon_name(GTK_ENTRY(search.search),
+                                      GTK_ENTRY_ICON_PRIMARY, "edit-find");
+    gtk_entry_set_icon_from_icon_name(GTK_ENTRY(search.search),
+                                      GTK_ENTRY_ICON_SECONDARY, "edit-clear");
+#endif
+    gtk_entry_set_icon_tooltip_text(GTK_ENTRY(search.search),
+                                    GTK_ENTRY_ICON_SECONDARY,
+                                    _("Clear the search field"));
+    gtk_entry_set_icon_activatable(GTK_ENTRY(search.search),
+                                   GTK_ENTRY_ICON_PRIMARY, FALSE);
+    gtk_entry_set_icon_activatable(GTK_ENTRY(search.search),
+                                   GTK_ENTRY_ICON_SECONDARY, TRUE);
+    g_signal_connect(search.search, "icon-release",
+                     G_CALLBACK(loc_tree_search_icon_cb), NULL);
+    g_signal_connect(search.search, "changed",
+                     G_CALLBACK(loc_tree_search_changed_cb), &search);
+
+    button = gtk_button_new_with_label(_("Nearest"));
+    gtk_widget_set_tooltip_text(button,
+                                _("Show the locations closest to the "
+                                  "current coordinates"));
+    g_signal_connect(button, "clicked", G_CALLBACK(loc_tree_nearest_cb),
+                     &search);
+
+    if (search.index == NULL)
+    {
+        gtk_widget_set_sensitive(search.search, FALSE);
+        gtk_widget_set_sensitive(button, FALSE);
+    }
+
+    hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+    gtk_box_pack_start(GTK_BOX(hbox), search.search, TRUE, TRUE, 0);
+    gtk_box_pack_start(GTK_BOX(hbox), button, FALSE, FALSE, 0);
+    gtk_widget_show_all(hbox);
+    gtk_box_pack_start(GTK_BOX
+                       (gtk_dialog_get_content_area(GTK_DIALOG(dialog))), hbox,
+                       FALSE, FALSE, 5);
 
     /* OK button disabled by default until a valid selection is made */
     gtk_dialog_set_response_sensitive(GTK_DIALOG(dialog),
@@ -265,152 +361,270 @@ gboolean loc_tree_create(const gchar * fname,
     }
 
     gtk_widget_destroy(dialog);
+    g_object_unref(search.tree);
+    loc_index_close(search.index);
 
     return retval;
 }
 
-static GtkTreeModel *loc_tree_create_and_fill_model(const gchar * fname)
+static GtkTreeStore *loc_tree_create_store(void)
+{
+    return gtk_tree_store_new(LOC_COL_NUM,
+                              G_TYPE_STRING,
+                              G_TYPE_FLOAT,
+                              G_TYPE_FLOAT,
+                              G_TYPE_UINT, G_TYPE_STRING, G_TYPE_UINT,
+                              G_TYPE_STRING, G_TYPE_UINT, G_TYPE_UINT);
+}
+
+/* Add a selectable location row to a tree store */
+static void loc_tree_add_location(GtkTreeStore * store, GtkTreeIter * parent,
+                                  const gchar * name, const loc_t * loc)
+{
+    GtkTreeIter     child;
+    gchar          *locstr;
+
+    locstr = g_strconcat(loc->city, ", ", loc->country, NULL);
+
+    gtk_tree_store_append(store, &child, parent);
+    gtk_tree_store_set(store, &child,
+                       TREE_COL_NAM, name,
+                       TREE_COL_WX, loc->wx,
+                       TREE_COL_LAT, loc->lat,
+                       TREE_COL_LON, loc->lon,
+                       TREE_COL_ALT, loc->alt,
+                       TREE_COL_SELECT, 1, TREE_COL_LOC, locstr, -1);
+
+    g_free(locstr);
+}
+
+/* Add a non-selectable region or country row to a tree store */
+static void loc_tree_add_group(GtkTreeStore * store, GtkTreeIter * row,
+                               GtkTreeIter * parent, const gchar * name)
+{
+    gtk_tree_store_append(store, row, parent);
+    gtk_tree_store_set(store, row,
+                       TREE_COL_NAM, name,
+                       TREE_COL_LAT, LTMN,
+                       TREE_COL_LON, LTMN,
+                       TREE_COL_ALT, LTMNI, TREE_COL_SELECT, 0, -1);
+}
+
+/*
+ * Finish a country row by storing its range of locations and adding an
+ * empty child, which makes the row expandable until the cities are loaded.
+ */
+static void loc_tree_close_country(GtkTreeStore * store, GtkTreeIter * row,
+                                   guint first, guint end)
+{
+    GtkTreeIter     placeholder;
+
+    gtk_tree_store_set(store, row, LOC_COL_FIRST, first, LOC_COL_END, end,
+                       -1);
+    loc_tree_add_group(store, &placeholder, row, "");
+}
+
+/**
+ * Create the tree of locations.
+ *
+ * @param index The location index. May be NULL in which case an empty
+ *              model is returned.
+ *
+ * The locations in the index are in the order of the locations file, so
+ * a new region or country row is started whenever the name changes. Only
+ * the region and country rows are created here; the cities are inserted
+ * by loc_tree_test_expand_cb() when a country is expanded.
+ */
+static GtkTreeModel *loc_tree_create_and_fill_model(loc_index_t * index)
 {
     GtkTreeStore   *treestore;  /* tree store, which is loaded and returned */
     GtkTreeIter     toplevel;   /* highest level rows, continent or region */
     GtkTreeIter     midlevel;   /* mid level rows, country or state in the US */
-    GtkTreeIter     child;      /* lowest level rows, cities */
-    GIOChannel     *locfile;    /* file we read locations from */
-    gchar          *line;       /* line read from file */
-    gchar         **buff;       /* temporary buffer to store line pieces */
-    gsize           length;     /* line length */
-    guint           i = 0;      /* number of lines read */
-    gchar          *continent = g_strdup("DUMMY");      /* current continent */
-    gchar          *country = g_strdup("DUMMY");        /* current country */
-    GError         *error = NULL;       /* error data when reading file */
-
-    treestore = gtk_tree_store_new(TREE_COL_NUM,
-                                   G_TYPE_STRING,
-                                   G_TYPE_FLOAT,
-                                   G_TYPE_FLOAT,
-                                   G_TYPE_UINT, G_TYPE_STRING, G_TYPE_UINT);
-
-    /* if the supplied file does not exist
+    const gchar    *continent = NULL;   /* current continent */
+    const gchar    *country = NULL;     /* current country */
+    loc_t           loc;
+    guint           i, num;
+    guint           first = 0;  /* first location of the current country */
+
+    treestore = loc_tree_create_store();
+
+    /* if the supplied file could not be read
        simply return the empty model
        FIXME: should we fall back to PACKAGE_DATA_DIR/locations.dat ?
      */
-    if (!g_file_test(fname, G_FILE_TEST_EXISTS))
+    if (index == NULL)
+        return GTK_TREE_MODEL(treestore);
+
+    num = loc_index_size(index);
+    for (i = 0; i < num; i++)
     {
+        loc_index_get(index, i, &loc);
 
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s: %s does not exist!"), __func__, fname);
+        /* new region? */
+        if (continent == NULL || g_ascii_strcasecmp(loc.region, continent))
+        {
+            if (country != NULL)
+                loc_tree_close_country(treestore, &midlevel, first, i);
 
-        g_free(continent);
-        g_free(country);
-        return GTK_TREE_MODEL(treestore);
+            continent = loc.region;
+            country = NULL;
+            loc_tree_add_group(treestore, &toplevel, NULL, continent);
+        }
+
+        /* new country? */
+        if (country == NULL || g_ascii_strcasecmp(loc.country, country))
+        {
+            if (country != NULL)
+                loc_tree_close_country(treestore, &midlevel, first, i);
+
+            country = loc.country;
+            first = i;
+            loc_tree_add_group(treestore, &midlevel, &toplevel, country);
+        }
     }
 
-    /* open file and read it line by line */
-    locfile = g_io_channel_new_file(fname, "r", &error);
+    if (country != NULL)
+        loc_tree_close_country(treestore, &midlevel, first, num);
+
+    sat_log_log(SAT_LOG_LEVEL_DEBUG, _("%s: Read %d cities."), __func__, num);
+
+    return GTK_TREE_MODEL(treestore);
+}
+
+/* Show a flat list of locations instead of the location tree */
+static void loc_tree_show_results(loc_tree_search_t * search,
+                                  GArray * result, gboolean distance)
+{
+    GtkTreeStore   *store;
+    loc_t           loc;
+    gchar          *name;
+    gdouble         dist;
+    guint           i;
+
+    store = loc_tree_create_store();
 
-    if (locfile)
+    for (i = 0; i < result->len; i++)
     {
+        if (!loc_index_get(search->index, g_array_index(result, guint, i),
+                           &loc))
+            continue;
 
-        while (g_io_channel_read_line(locfile,
-                                      &line,
-                                      &length, NULL, NULL) != G_IO_STATUS_EOF)
+        if (distance)
         {
+            dist = loc_index_distance(search->lat, search->lon,
+                                      loc.lat, loc.lon);
+            if (sat_cfg_get_bool(SAT_CFG_BOOL_USE_IMPERIAL))
+                name = g_strdup_printf(_("%s, %s (%.0f mi)"), loc.city,
+                                       loc.country, KM_TO_MI(dist));
+            else
+                name = g_strdup_printf(_("%s, %s (%.0f km)"), loc.city,
+                                       loc.country, dist);
+        }
+        else
+        {
+            name = g_strconcat(loc.city, ", ", loc.country, NULL);
+        }
 
-            /* trim line and split it */
-            line = g_strdelimit(line, "\n", '\0');
-
-            buff = g_strsplit(line, ";", 7);
+        loc_tree_add_location(store, NULL, name, &loc);
+        g_free(name);
+    }
 
-            /* buff[0] = continent / region
-               buff[1] = country or state in US
-               buff[2] = city
-               buff[3] = weather station
-               buff[4] = latitude (dec. deg. north)
-               buff[5] = longitude (dec. deg. east)
-               buff[6] = altitude
-             */
+    gtk_tree_view_set_model(GTK_TREE_VIEW(search->view),
+                            GTK_TREE_MODEL(store));
+    g_object_unref(store);
 
-            /* new region? */
-            if (g_ascii_strcasecmp(buff[0], continent))
-            {
+    /* selection is lost when the model changes */
+    gtk_dialog_set_response_sensitive(GTK_DIALOG(search->dialog),
+                                      GTK_RESPONSE_ACCEPT, FALSE);
+}
 
-                g_free(continent);
+/* Search entry changed; show the matching locations or the full tree */
+static void loc_tree_search_changed_cb(GtkEntry * entry, gpointer data)
+{
+    loc_tree_search_t *search = (loc_tree_search_t *) data;
+    const gchar    *text = gtk_entry_get_text(entry);
+    GArray         *result;
 
-                continent = g_strdup(buff[0]);
+    if (*text == '\0')
+    {
+        gtk_tree_view_set_model(GTK_TREE_VIEW(search->view), search->tree);
+        gtk_dialog_set_response_sensitive(GTK_DIALOG(search->dialog),
+                                          GTK_RESPONSE_ACCEPT, FALSE);
+        return;
+    }
 
-                gtk_tree_store_append(treestore, &toplevel, NULL);
-                gtk_tree_store_set(treestore, &toplevel,
-                                   TREE_COL_NAM, continent,
-                                   TREE_COL_LAT, LTMN,
-                                   TREE_COL_LON, LTMN,
-                                   TREE_COL_ALT, LTMNI,
-                                   TREE_COL_SELECT, 0, -1);
+    result = loc_index_search(search->index, text, LOC_SEARCH_MAX);
+    loc_tree_show_results(search, result, FALSE);
+    g_array_free(result, TRUE);
+}
 
-            }
+/* user clicked on "clear icon" in search field */
+static void loc_tree_search_icon_cb(GtkEntry * entry,
+                                    GtkEntryIconPosition icon_pos,
+                                    GdkEvent * event, gpointer data)
+{
+    (void)event;
+    (void)data;
 
-            /* new country? */
-            if (g_ascii_strcasecmp(buff[1], country))
-            {
+    if (icon_pos == GTK_ENTRY_ICON_SECONDARY)
+        gtk_entry_set_text(entry, "");
+}
 
-                g_free(country);
+/* Show the locations closest to the current coordinates */
+static void loc_tree_nearest_cb(GtkButton * button, gpointer data)
+{
+    loc_tree_search_t *search = (loc_tree_search_t *) data;
+    GArray         *result;
+
+    (void)button;
+
+    /* clear search text without showing the tree in between */
+    g_signal_handlers_block_by_func(search->search,
+                                    loc_tree_search_changed_cb, search);
+    gtk_entry_set_text(GTK_ENTRY(search->search), "");
+    g_signal_handlers_unblock_by_func(search->search,
+                                      loc_tree_search_changed_cb, search);
+
+    result = loc_index_nearest(search->index, search->lat, search->lon,
+                               LOC_NEAREST_MAX);
+    loc_tree_show_results(search, result, TRUE);
+    g_array_free(result, TRUE);
+}
 
-                country = g_strdup(buff[1]);
+/* Insert the cities of a country row the first time it is expanded */
+static gboolean loc_tree_test_expand_cb(GtkTreeView * view,
+                                        GtkTreeIter * iter,
+                                        GtkTreePath * path, gpointer data)
+{
+    loc_tree_search_t *search = (loc_tree_search_t *) data;
+    GtkTreeStore   *store;
+    GtkTreeIter     child;
+    loc_t           loc;
+    guint           first, end, i;
 
-                gtk_tree_store_append(treestore, &midlevel, &toplevel);
-                gtk_tree_store_set(treestore, &midlevel,
-                                   TREE_COL_NAM, country,
-                                   TREE_COL_LAT, LTMN,
-                                   TREE_COL_LON, LTMN,
-                                   TREE_COL_ALT, LTMNI,
-                                   TREE_COL_SELECT, 0, -1);
-            }
+    (void)path;
 
-            /* add city */
-            gtk_tree_store_append(treestore, &child, &midlevel);
-            gtk_tree_store_set(treestore, &child,
-                               TREE_COL_NAM, buff[2],
-                               TREE_COL_WX, buff[3],
-                               TREE_COL_LAT, g_ascii_strtod(buff[4], NULL),
-                               TREE_COL_LON, g_ascii_strtod(buff[5], NULL),
-                               /* Crashes here if type is not correctly cast */
-                               TREE_COL_ALT, (guint) g_ascii_strtod(buff[6],
-                                                                    NULL),
-                               TREE_COL_SELECT, 1, -1);
-
-
-            /* finish and clean up */
-            i++;
-
-            /* free allocated memory */
-            g_free(line);
-            g_strfreev(buff);
-        }
+    /* search results are flat and have nothing to expand */
+    if (gtk_tree_view_get_model(view) != search->tree)
+        return FALSE;
 
-        sat_log_log(SAT_LOG_LEVEL_DEBUG,
-                    _("%s: Read %d cities."), __func__, i);
+    gtk_tree_model_get(search->tree, iter,
+                       LOC_COL_FIRST, &first, LOC_COL_END, &end, -1);
+    if (first >= end)
+        return FALSE;
 
-        if (continent)
-            g_free(continent);
+    store = GTK_TREE_STORE(search->tree);
 
-        if (country)
-            g_free(country);
+    /* remove the placeholder and mark the row as loaded */
+    if (gtk_tree_model_iter_children(search->tree, &child, iter))
+        gtk_tree_store_remove(store, &child);
+    gtk_tree_store_set(store, iter, LOC_COL_FIRST, 0, LOC_COL_END, 0, -1);
 
-        /* Close IO chanel; don't care about status.
-           Shutdown will flush the stream and close the channel
-           as soon as the reference count is dropped. Order matters!
-         */
-        g_io_channel_shutdown(locfile, TRUE, NULL);
-        g_io_channel_unref(locfile);
-    }
-    else
-    {
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s: Failed to open locfile (%s)"),
-                    __func__, error->message);
-        g_clear_error(&error);
-    }
+    for (i = first; i < end; i++)
+        if (loc_index_get(search->index, i, &loc))
+            loc_tree_add_location(store, iter, loc.city, &loc);
 
-    return GTK_TREE_MODEL(treestore);
+    return FALSE;
 }
 
 /* render column containg float
@@ -560,42 +774,16 @@ static void loc_tree_get_selection(GtkWidget * view,
     GtkTreeSelection *selection;
     GtkTreeModel   *model;
     GtkTreeIter     iter;
-    GtkTreeIter     parent;
-    gchar          *city;
-    gchar          *country;
 
     selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(view));
     if (gtk_tree_selection_get_selected(selection, &model, &iter))
     {
-        /* get values */
+        /* get values; location string is "City, Country" */
         gtk_tree_model_get(model, &iter,
-                           TREE_COL_NAM, &city,
+                           TREE_COL_LOC, loc,
                            TREE_COL_LAT, lat,
                            TREE_COL_LON, lon,
                            TREE_COL_ALT, alt, TREE_COL_WX, wx, -1);
-
-        /* Location string shall be composed of "City, Country".
-           Currently we have City in _loc1 and so we need to obtain
-           the parent. */
-        if (gtk_tree_model_iter_parent(model, &parent, &iter))
-        {
-            gtk_tree_model_get(model, &parent, TREE_COL_NAM, &country, -1);
-
-            *loc = g_strconcat(city, ", ", country, NULL);
-            g_free(city);
-            g_free(country);
-        }
-        else
-        {
-            /* well no luck; send a warning message and return city
-               only (actually, this is a bug, if it happens).
-             */
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s: Failed to get parent for %s."), __func__, city);
-
-            *loc = g_strdup(city);
-            g_free(city);
-        }
     }
     else
     {
@@ -9,6 +9,7 @@ typedef enum {
     TREE_COL_ALT,               /*!< Location altitude column. */
     TREE_COL_WX,                /*!< Weather station column. */
     TREE_COL_SELECT,            /*!< Invisible colindicating whether row may be selected */
+    TREE_COL_LOC,               /*!< Invisible col with "City, Country" string */
     TREE_COL_NUM                /*!< The total number of columns. */
 } loc_tree_col_t;
 
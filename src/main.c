@@ -33,10 +33,13 @@
 #include "gtk-sat-selector.h"
 #include "gui.h"
 #include "first-time.h"
+#include "hamlib-backend.h"
 #include "tle-update.h"
 #include "mod-mgr.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
+#include "time-tools.h"
+#include "tle-schedule.h"
 
 
 /* Main application widget. */
@@ -68,6 +71,9 @@ static gboolean tle_upd_running = FALSE;
 /* flag indicating whether user has been notified of TLE update */
 static gboolean tle_upd_note_sent = FALSE;
 
+/* TLE source schedule used by the monitoring task */
+static tle_schedule_t *tle_mon_sched = NULL;
+
 
 /* private funtion prototypes */
 static void     gpredict_app_create(void);
@@ -116,6 +122,7 @@ int main(int argc, char *argv[])
     sat_log_init();
     sat_cfg_load();
     sat_log_set_level(sat_cfg_get_int(SAT_CFG_INT_LOG_LEVEL));
+    hamlib_backend_set_debug(sat_cfg_get_int(SAT_CFG_INT_LOG_LEVEL));
 
     if (cleantle)
         clean_tle();
@@ -394,7 +401,8 @@ static gboolean gpredict_app_config(GtkWidget * widget,
  * Monitor TLE age.
  *
  * This function is called periodically in order to check
- * whether it is time to update the TLE elements.
+ * whether it is time to update the TLE elements, i.e. whether
+ * any of the TLE sources is due for a refresh (see tle-schedule.c).
  *
  * If the time to update the TLE has come, it will either notify
  * the user, or fork a separate task which will update the TLE data
@@ -406,8 +414,8 @@ static gboolean gpredict_app_config(GtkWidget * widget,
 static gboolean tle_mon_task(gpointer data)
 {
     /*GtkWidget *selector; */
-    glong           last, now, thrld;
-    GTimeVal        tval;
+    gchar         **due;
+    guint           numdue;
     GtkWidget      *dialog;
     GError         *err = NULL;
 
@@ -419,46 +427,26 @@ static gboolean tle_mon_task(gpointer data)
                     __func__);
     }
 
-    /* get time of last update */
-    last = sat_cfg_get_int(SAT_CFG_INT_TLE_LAST_UPDATE);
+    /* an unattended update may still be fetching the due sources */
+    if (tle_upd_running)
+        return TRUE;
 
-    /* get current time */
-    g_get_current_time(&tval);
-    now = tval.tv_sec;
+    /* sources.cfg is only read again after an update has written it */
+    if (tle_mon_sched == NULL)
+        tle_mon_sched = tle_schedule_load();
+    else
+        tle_schedule_reload(tle_mon_sched);
 
-    /* threshold */
-    switch (sat_cfg_get_int(SAT_CFG_INT_TLE_AUTO_UPD_FREQ))
-    {
-    case TLE_AUTO_UPDATE_MONTHLY:
-        thrld = 2592000;
-        break;
-
-    case TLE_AUTO_UPDATE_WEEKLY:
-        thrld = 604800;
-        break;
-
-    case TLE_AUTO_UPDATE_DAILY:
-        thrld = 86400;
-        break;
-
-        /* set default to "infinite" */
-    default:
-        thrld = G_MAXLONG;
-        break;
-    }
+    due = tle_schedule_get_due(tle_mon_sched, get_current_daynum());
+    numdue = g_strv_length(due);
+    g_strfreev(due);
 
-    if ((now - last) < thrld)
-    {
-        /* too early */
-        /*           sat_log_log (SAT_LOG_LEVEL_DEBUG, */
-        /*                           _("%s: Threshold has not been passed yet."), */
-        /*                           __func__, last, now, thrld); */
-    }
-    else
+    if (numdue > 0)
     {
         /* time to update */
         sat_log_log(SAT_LOG_LEVEL_DEBUG,
-                    _("%s: Time threshold has been passed."), __func__);
+                    _("%s: %d TLE sources are due for a refresh."),
+                    __func__, numdue);
 
         /* find out what to do */
         if (sat_cfg_get_int(SAT_CFG_INT_TLE_AUTO_UPD_ACTION) ==
@@ -526,6 +514,9 @@ static void tle_mon_stop()
     {
         g_usleep(1000);
     }
+
+    tle_schedule_free(tle_mon_sched);
+    tle_mon_sched = NULL;
 }
 
 /* Thread function which invokes TLE update */
@@ -534,7 +525,7 @@ static          gpointer update_tle_thread(gpointer data)
     (void)data;
 
     tle_upd_running = TRUE;
-    tle_update_from_network(TRUE, NULL, NULL, NULL);
+    tle_update_due_from_network();
     tle_upd_running = FALSE;
 
     return NULL;
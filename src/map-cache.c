@@ -0,0 +1,237 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Shared base maps for the map views.
+ *
+ * Decoding a large map image and shifting it to the configured center
+ * longitude is expensive and the result is identical for every map view using
+ * the same file and center. The decoded maps are therefore kept in a process
+ * wide cache keyed by file name and center longitude and shared by reference
+ * counting. A map is freed when the last view using it releases it.
+ *
+ * The cache is only accessed from the main loop. Scaling a map to the size of
+ * a view is done in a worker thread by map_scale_async().
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+
+#include "map-cache.h"
+#include "map-tools.h"
+#include "sat-log.h"
+
+
+typedef struct {
+    gchar          *key;        /*!< Hash key, see map_cache_key() */
+    GdkPixbuf      *map;        /*!< The decoded and shifted map */
+    guint           users;      /*!< Number of map_cache_get() references */
+} map_cache_entry_t;
+
+typedef struct {
+    GdkPixbuf      *map;        /*!< Map to scale */
+    gint            width;      /*!< Target width */
+    gint            height;     /*!< Target height */
+    GdkPixbuf      *result;     /*!< Scaled map */
+    map_scaled_fn   done;       /*!< Completion callback */
+    gpointer        data;       /*!< User data for the callback */
+} map_scale_job_t;
+
+
+/* entries by key and by map */
+static GHashTable *cache_keys = NULL;
+static GHashTable *cache_maps = NULL;
+
+
+static gchar   *map_cache_key(const gchar * mapfile, float clon)
+{
+    return g_strdup_printf("%s|%.3f", mapfile, clon);
+}
+
+static void map_cache_entry_free(map_cache_entry_t * entry)
+{
+    g_object_unref(entry->map);
+    g_free(entry->key);
+    g_free(entry);
+}
+
+/**
+ * Get a decoded map.
+ *
+ * @param mapfile The full path of the map file.
+ * @param clon The longitude that should be the center of the map.
+ * @param error Location to store the error if the file can not be loaded.
+ * @return The map shifted to the center longitude, or NULL on error.
+ *
+ * The returned map is shared with other users and must not be modified.
+ * Release it with map_cache_release() when it is no longer needed.
+ */
+GdkPixbuf      *map_cache_get(const gchar * mapfile, float clon,
+                              GError ** error)
+{
+    map_cache_entry_t *entry;
+    GdkPixbuf      *tmpbuf;
+    gchar          *key;
+
+    if (cache_keys == NULL)
+    {
+        cache_keys = g_hash_table_new(g_str_hash, g_str_equal);
+        cache_maps = g_hash_table_new(g_direct_hash, g_direct_equal);
+    }
+
+    key = map_cache_key(mapfile, clon);
+    entry = g_hash_table_lookup(cache_keys, key);
+    if (entry != NULL)
+    {
+        g_free(key);
+        entry->users++;
+        return entry->map;
+    }
+
+    tmpbuf = gdk_pixbuf_new_from_file(mapfile, error);
+    if (tmpbuf == NULL)
+    {
+        g_free(key);
+        return NULL;
+    }
+
+    entry = g_new(map_cache_entry_t, 1);
+    entry->key = key;
+    entry->users = 1;
+
+    /* create a blank map with same parameters as tmpbuf */
+    entry->map = gdk_pixbuf_new(GDK_COLORSPACE_RGB,
+                                FALSE,
+                                gdk_pixbuf_get_bits_per_sample(tmpbuf),
+                                gdk_pixbuf_get_width(tmpbuf),
+                                gdk_pixbuf_get_height(tmpbuf));
+
+    map_tools_shift_center(tmpbuf, entry->map, clon);
+    g_object_unref(tmpbuf);
+
+    g_hash_table_insert(cache_keys, entry->key, entry);
+    g_hash_table_insert(cache_maps, entry->map, entry);
+
+    sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                _("%s: Cached map %s (%dx%d)"), __func__, entry->key,
+                gdk_pixbuf_get_width(entry->map),
+                gdk_pixbuf_get_height(entry->map));
+
+    return entry->map;
+}
+
+/**
+ * Release a map obtained from map_cache_get().
+ *
+ * Maps that have not been obtained from the cache are simply unreferenced.
+ */
+void map_cache_release(GdkPixbuf * map)
+{
+    map_cache_entry_t *entry = NULL;
+
+    if (map == NULL)
+        return;
+
+    if (cache_maps != NULL)
+        entry = g_hash_table_lookup(cache_maps, map);
+
+    if (entry == NULL)
+    {
+        g_object_unref(map);
+        return;
+    }
+
+    if (--entry->users > 0)
+        return;
+
+    g_hash_table_remove(cache_keys, entry->key);
+    g_hash_table_remove(cache_maps, entry->map);
+    map_cache_entry_free(entry);
+}
+
+static gboolean map_scale_deliver(gpointer data)
+{
+    map_scale_job_t *job = (map_scale_job_t *) data;
+
+    job->done(job->result, job->data);
+    g_object_unref(job->map);
+    g_free(job);
+
+    return FALSE;
+}
+
+static gpointer map_scale_thread(gpointer data)
+{
+    map_scale_job_t *job = (map_scale_job_t *) data;
+
+    job->result = gdk_pixbuf_scale_simple(job->map, job->width, job->height,
+                                          GDK_INTERP_BILINEAR);
+    g_idle_add(map_scale_deliver, job);
+
+    return NULL;
+}
+
+/**
+ * Scale a map in a worker thread.
+ *
+ * @param map The map to scale. It is referenced until the job completes and
+ *            must not be modified meanwhile.
+ * @param width The target width.
+ * @param height The target height.
+ * @param done Function called in the main loop with the scaled map.
+ * @param data User data passed to the callback.
+ *
+ * The callback is always invoked, also if the scaling fails. Jobs are not
+ * cancellable; callers that go away meanwhile must keep data valid and ignore
+ * the result.
+ */
+void map_scale_async(GdkPixbuf * map, gint width, gint height,
+                     map_scaled_fn done, gpointer data)
+{
+    map_scale_job_t *job;
+    GThread        *thread;
+    GError         *err = NULL;
+
+    job = g_new0(map_scale_job_t, 1);
+    job->map = g_object_ref(map);
+    job->width = MAX(width, 1);
+    job->height = MAX(height, 1);
+    job->done = done;
+    job->data = data;
+
+    thread = g_thread_try_new("gpredict_map_scale", map_scale_thread, job,
+                              &err);
+    if (thread == NULL)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Failed to create map scaling thread (%s)"),
+                    __func__, err != NULL ? err->message : "unknown");
+        g_clear_error(&err);
+
+        /* the result is still delivered through the main loop */
+        map_scale_thread(job);
+    }
+    else
+    {
+        g_thread_unref(thread);
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef MAP_CACHE_H
+#define MAP_CACHE_H 1
+
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include <glib.h>
+
+/**
+ * Function called in the main loop when a map has been scaled.
+ *
+ * @param map The scaled map or NULL on error. The callee owns the reference.
+ * @param data User data passed to map_scale_async().
+ */
+typedef void    (*map_scaled_fn) (GdkPixbuf * map, gpointer data);
+
+GdkPixbuf      *map_cache_get(const gchar * mapfile, float clon,
+                              GError ** error);
+void            map_cache_release(GdkPixbuf * map);
+void            map_scale_async(GdkPixbuf * map, gint width, gint height,
+                                map_scaled_fn done, gpointer data);
+
+#endif
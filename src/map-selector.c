@@ -67,147 +67,301 @@ static gchar   *get_map_humanize_size(gint64 size, gchar * buffer,
     return buffer;
 }
 
-static GtkWidget *create_preview_widget(const gchar * selection)
-{
-    GtkWidget      *vbox;
-    GtkWidget      *img;
-    GtkWidget      *label;
-    GdkPixbuf      *obuf, *sbuf;
-    gchar          *buff;
-    gint            w, h;
-    gint64          size;
-    struct stat     sb;
-    gchar          *bf = NULL;
+/* Size of the map preview */
+#define PREVIEW_WIDTH   160
+#define PREVIEW_HEIGHT  80
+
+/* Options used to store the map size in the thumbnails */
+#define THUMB_OPT_WIDTH     "tEXt::Thumb::Image::Width"
+#define THUMB_OPT_HEIGHT    "tEXt::Thumb::Image::Height"
+
+
+/** Map preview widget data, attached to the preview box. */
+typedef struct {
+    GtkWidget      *img;        /*!< The preview image */
+    GtkWidget      *label;      /*!< Label showing the map size */
+    GtkFileChooser *chooser;    /*!< The file chooser */
+    GThreadPool    *pool;       /*!< Thread loading the previews */
+    gint            gen;        /*!< Generation of the latest request (atomic) */
+} map_preview_t;
+
+/** Preview loading job. */
+typedef struct {
+    GtkWidget      *box;        /*!< The preview box, referenced by the job */
+    map_preview_t  *preview;    /*!< Preview data of the box */
+    gint            gen;        /*!< Generation of this request */
+    gchar          *fname;      /*!< The map file */
+    GdkPixbuf      *thumb;      /*!< The thumbnail or NULL on error */
+    gint            width;      /*!< Width of the map */
+    gint            height;     /*!< Height of the map */
+    gint64          size;       /*!< Size of the map file */
+} preview_job_t;
 
 
-    label = gtk_label_new(NULL);
-    img = gtk_image_new();
+/**
+ * Get the thumbnail file of a map.
+ *
+ * The thumbnails are kept in USER_CONF_DIR/thumbnails and the file name is
+ * derived from the path, modification time and size of the map, so a
+ * thumbnail is never used for a map that has changed.
+ */
+static gchar   *thumb_file_name(const gchar * fname, struct stat *sb)
+{
+    gchar          *confdir;
+    gchar          *key;
+    gchar          *hash;
+    gchar          *thumbname;
+
+    key = g_strdup_printf("%s|%" G_GINT64_FORMAT "|%" G_GINT64_FORMAT, fname,
+                          (gint64) sb->st_mtime, (gint64) sb->st_size);
+    hash = g_compute_checksum_for_string(G_CHECKSUM_MD5, key, -1);
+    confdir = get_user_conf_dir();
+    thumbname = g_strdup_printf("%s%sthumbnails%smap-%s.png", confdir,
+                                G_DIR_SEPARATOR_S, G_DIR_SEPARATOR_S, hash);
+    g_free(confdir);
+    g_free(hash);
+    g_free(key);
+
+    return thumbname;
+}
 
-    vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
-    gtk_box_set_homogeneous(GTK_BOX(vbox), FALSE);
-    g_object_set_data(G_OBJECT(vbox), "image", img);
-    g_object_set_data(G_OBJECT(vbox), "label", label);
-    gtk_box_pack_start(GTK_BOX(vbox), img, FALSE, FALSE, 0);
-    gtk_box_pack_start(GTK_BOX(vbox), label, FALSE, FALSE, 0);
-    gtk_widget_show_all(vbox);
+/* Load a cached thumbnail. Returns NULL if there is no valid thumbnail. */
+static GdkPixbuf *load_cached_thumb(const gchar * thumbname, gint * w,
+                                    gint * h)
+{
+    GdkPixbuf      *thumb;
+    const gchar    *optw;
+    const gchar    *opth;
 
-    /* load current map into preview widget */
-    obuf = gdk_pixbuf_new_from_file(selection, NULL);
+    if (!g_file_test(thumbname, G_FILE_TEST_IS_REGULAR))
+        return NULL;
 
-    if (G_LIKELY(obuf != NULL))
-    {
+    thumb = gdk_pixbuf_new_from_file(thumbname, NULL);
+    if (thumb == NULL)
+        return NULL;
 
-        /* store data */
-        w = gdk_pixbuf_get_width(obuf);
-        h = gdk_pixbuf_get_height(obuf);
+    optw = gdk_pixbuf_get_option(thumb, THUMB_OPT_WIDTH);
+    opth = gdk_pixbuf_get_option(thumb, THUMB_OPT_HEIGHT);
+    if (optw == NULL || opth == NULL)
+    {
+        g_object_unref(thumb);
+        return NULL;
+    }
 
-        /* try to stat the file */
-        if (G_UNLIKELY(g_stat(selection, &sb) < 0))
-        {
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s:%d: Could not stat %s"),
-                        __FILE__, __LINE__, selection);
+    *w = (gint) g_ascii_strtoll(optw, NULL, 10);
+    *h = (gint) g_ascii_strtoll(opth, NULL, 10);
 
-            size = 0;
-        }
-        else
-        {
-            size = sb.st_size;
-        }
+    return thumb;
+}
 
-        bf = get_map_humanize_size(size, bf, 0);
+/* Store a thumbnail in the thumbnail cache */
+static void save_cached_thumb(const gchar * thumbname, GdkPixbuf * thumb,
+                              gint w, gint h)
+{
+    gchar          *dir;
+    gchar          *optw;
+    gchar          *opth;
+    GError         *err = NULL;
 
-        buff = g_strdup_printf("%dx%d pixels\n%s", w, h, bf);
-        gtk_label_set_text(GTK_LABEL(label), buff);
-        g_free(buff);
-        g_free(bf);
+    dir = g_path_get_dirname(thumbname);
+    if (g_mkdir_with_parents(dir, 0755) != 0)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Could not create directory %s"), __func__, dir);
+        g_free(dir);
+        return;
+    }
+    g_free(dir);
 
-        /* scale the pixbuf */
-        sbuf = gdk_pixbuf_scale_simple(obuf, 160, 80, GDK_INTERP_HYPER);
-        g_object_unref(obuf);
+    optw = g_strdup_printf("%d", w);
+    opth = g_strdup_printf("%d", h);
 
-        /* update the GtkImage from the pixbuf */
-        gtk_image_set_from_pixbuf(GTK_IMAGE(img), sbuf);
-        g_object_unref(sbuf);
-    }
-    else
+    if (!gdk_pixbuf_save(thumb, thumbname, "png", &err,
+                         THUMB_OPT_WIDTH, optw, THUMB_OPT_HEIGHT, opth, NULL))
     {
-        gtk_image_set_from_icon_name(GTK_IMAGE(img), "image-missing",
-                                     GTK_ICON_SIZE_LARGE_TOOLBAR);
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Could not save thumbnail %s (%s)"),
+                    __func__, thumbname, err->message);
+        g_clear_error(&err);
     }
 
-    return vbox;
+    g_free(optw);
+    g_free(opth);
 }
 
-static void update_preview_widget(GtkFileChooser * chooser, gpointer data)
+/*
+ * Load the preview of a map.
+ *
+ * The preview is taken from the thumbnail cache if possible. Otherwise only
+ * the header of the map is read to get its size and the map is decoded at
+ * the preview size, which the image loaders can do without holding the full
+ * map in memory.
+ *
+ * This function is called from the preview thread.
+ */
+static void load_preview(preview_job_t * job)
 {
-    GtkWidget      *box = GTK_WIDGET(data);
-    GtkImage       *img = GTK_IMAGE(g_object_get_data(G_OBJECT(box), "image"));
-    GtkLabel       *lab = GTK_LABEL(g_object_get_data(G_OBJECT(box), "label"));
-    gchar          *sel = NULL;
-    GdkPixbuf      *obuf, *sbuf;
-    gint            w, h;
-    gint64          size;
     struct stat     sb;
-    gchar          *buff = NULL;
+    gchar          *thumbname = NULL;
 
+    /* try to stat the file */
+    if (g_stat(job->fname, &sb) < 0)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s:%d: Could not stat %s"),
+                    __FILE__, __LINE__, job->fname);
 
-    sel = gtk_file_chooser_get_preview_filename(chooser);
+        job->size = 0;
+    }
+    else
+    {
+        job->size = sb.st_size;
+        thumbname = thumb_file_name(job->fname, &sb);
+        job->thumb = load_cached_thumb(thumbname, &job->width, &job->height);
+    }
 
-    if (sel != NULL)
+    if (job->thumb == NULL &&
+        gdk_pixbuf_get_file_info(job->fname, &job->width,
+                                 &job->height) != NULL)
     {
-        obuf = gdk_pixbuf_new_from_file(sel, NULL);
+        job->thumb = gdk_pixbuf_new_from_file_at_scale(job->fname,
+                                                       PREVIEW_WIDTH,
+                                                       PREVIEW_HEIGHT,
+                                                       FALSE, NULL);
+        if (job->thumb != NULL && thumbname != NULL)
+            save_cached_thumb(thumbname, job->thumb, job->width, job->height);
+    }
 
-        /* try to stat the file */
-        if (g_stat(sel, &sb) < 0)
+    g_free(thumbname);
+}
+
+/* Show the result of a preview job. Called in the main loop. */
+static gboolean preview_job_done(gpointer data)
+{
+    preview_job_t  *job = (preview_job_t *) data;
+    map_preview_t  *preview = job->preview;
+    gchar          *buff;
+    gchar          *bf;
+
+    /* ignore results of old requests and of destroyed previews */
+    if (job->gen == g_atomic_int_get(&preview->gen))
+    {
+        gtk_image_clear(GTK_IMAGE(preview->img));
+
+        if (job->thumb != NULL)
         {
-            sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s:%d: Could not stat %s"),
-                        __FILE__, __LINE__, sel);
+            bf = get_map_humanize_size(job->size, NULL, 0);
+            buff = g_strdup_printf("%dx%d pixels\n%s", job->width,
+                                   job->height, bf);
+            gtk_label_set_text(GTK_LABEL(preview->label), buff);
+            g_free(buff);
+            g_free(bf);
 
-            size = 0;
+            gtk_image_set_from_pixbuf(GTK_IMAGE(preview->img), job->thumb);
+            gtk_file_chooser_set_preview_widget_active(preview->chooser, TRUE);
         }
         else
         {
-            size = sb.st_size;
+            gtk_image_set_from_icon_name(GTK_IMAGE(preview->img),
+                                         "image-missing",
+                                         GTK_ICON_SIZE_LARGE_TOOLBAR);
+            gtk_file_chooser_set_preview_widget_active(preview->chooser,
+                                                       FALSE);
         }
+    }
 
-        g_free(sel);
+    if (job->thumb != NULL)
+        g_object_unref(job->thumb);
+    g_object_unref(job->box);
+    g_free(job->fname);
+    g_free(job);
 
-        if (obuf != NULL)
-        {
+    return FALSE;
+}
 
-            /* store data */
-            w = gdk_pixbuf_get_width(obuf);
-            h = gdk_pixbuf_get_height(obuf);
+static void preview_job_run(gpointer data, gpointer user_data)
+{
+    preview_job_t  *job = (preview_job_t *) data;
 
-            buff = get_map_humanize_size(size, buff, 0);
+    (void)user_data;
 
-            sel = g_strdup_printf("%dx%d pixels\n%s", w, h, buff);
-            gtk_label_set_text(lab, sel);
-            g_free(sel);
-            g_free(buff);
+    /* skip requests that have been superseded while queued */
+    if (job->gen == g_atomic_int_get(&job->preview->gen))
+        load_preview(job);
 
-            /* scale the pixbuf */
-            sbuf = gdk_pixbuf_scale_simple(obuf, 160, 80, GDK_INTERP_HYPER);
-            g_object_unref(obuf);
+    g_idle_add(preview_job_done, job);
+}
 
-            /* update the GtkImage from the pixbuf */
-            gtk_image_clear(img);
-            gtk_image_set_from_pixbuf(img, sbuf);
-            g_object_unref(sbuf);
+/* Request the preview of a map. The preview is shown when it is ready. */
+static void request_preview(GtkWidget * box, const gchar * fname)
+{
+    map_preview_t  *preview = g_object_get_data(G_OBJECT(box), "preview");
+    preview_job_t  *job;
 
-            /* report success */
-            gtk_file_chooser_set_preview_widget_active(chooser, TRUE);
-        }
-        else
-        {
-            gtk_image_clear(img);
-            gtk_image_set_from_icon_name(GTK_IMAGE(img), "image-missing",
-                                         GTK_ICON_SIZE_LARGE_TOOLBAR);
-            /* report failure */
-            gtk_file_chooser_set_preview_widget_active(chooser, FALSE);
-        }
+    job = g_new0(preview_job_t, 1);
+    job->box = g_object_ref(box);
+    job->preview = preview;
+    job->gen = g_atomic_int_add(&preview->gen, 1) + 1;
+    job->fname = g_strdup(fname);
+
+    g_thread_pool_push(preview->pool, job, NULL);
+}
+
+static void preview_destroy_cb(GtkWidget * box, gpointer data)
+{
+    map_preview_t  *preview = (map_preview_t *) data;
+
+    (void)box;
+
+    if (preview->pool == NULL)
+        return;
+
+    /* invalidate pending requests; the queued jobs still run
+       and release their reference to the box */
+    g_atomic_int_inc(&preview->gen);
+    g_thread_pool_free(preview->pool, FALSE, FALSE);
+    preview->pool = NULL;
+}
+
+static GtkWidget *create_preview_widget(GtkFileChooser * chooser,
+                                        const gchar * selection)
+{
+    GtkWidget      *vbox;
+    map_preview_t  *preview;
+
+    preview = g_new0(map_preview_t, 1);
+    preview->label = gtk_label_new(NULL);
+    preview->img = gtk_image_new();
+    preview->chooser = chooser;
+    preview->pool = g_thread_pool_new(preview_job_run, NULL, 1, FALSE, NULL);
+
+    vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
+    gtk_box_set_homogeneous(GTK_BOX(vbox), FALSE);
+    g_object_set_data_full(G_OBJECT(vbox), "preview", preview, g_free);
+    gtk_box_pack_start(GTK_BOX(vbox), preview->img, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(vbox), preview->label, FALSE, FALSE, 0);
+    gtk_widget_show_all(vbox);
+
+    g_signal_connect(vbox, "destroy", G_CALLBACK(preview_destroy_cb),
+                     preview);
+
+    /* load current map into preview widget */
+    request_preview(vbox, selection);
+
+    return vbox;
+}
+
+static void update_preview_widget(GtkFileChooser * chooser, gpointer data)
+{
+    GtkWidget      *box = GTK_WIDGET(data);
+    gchar          *sel;
+
+    sel = gtk_file_chooser_get_preview_filename(chooser);
+
+    if (sel != NULL)
+    {
+        request_preview(box, sel);
+        g_free(sel);
     }
 }
 
@@ -221,7 +375,8 @@ static void update_preview_widget(GtkFileChooser * chooser, gpointer data)
  * This function creates and executes a file chooser dialog
  * and selects the currently selected map curmap. The file chooser dialogue
  * has a custom map preview widget showing the scaled down copty of
- * the selected map as well as the size of the map.
+ * the selected map as well as the size of the map. The previews are loaded
+ * in the background and cached as thumbnails.
  */
 gchar          *select_map(const gchar * curmap)
 {
@@ -274,7 +429,8 @@ gchar          *select_map(const gchar * curmap)
     gtk_file_chooser_select_filename(GTK_FILE_CHOOSER(chooser), selection);
 
     /* preview widget */
-    preview = create_preview_widget(selection);
+    preview = create_preview_widget(GTK_FILE_CHOOSER(chooser),
+                                    selection);
     gtk_file_chooser_set_preview_widget(GTK_FILE_CHOOSER(chooser), preview);
     gtk_file_chooser_set_preview_widget_active(GTK_FILE_CHOOSER(chooser),
                                                TRUE);
@@ -0,0 +1,130 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Frame synchronised marker motion.
+ *
+ * The satellites are propagated on the module timeout while the screen is
+ * refreshed by the frame clock. The views record the marker position of each
+ * data update here and move the markers once per frame from a tick callback,
+ * so that the markers glide at the speed of the last step instead of jumping
+ * from update to update, and several updates between two frames only cause
+ * one redraw.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <math.h>
+
+#include "marker-motion.h"
+
+
+/* Markers are only moved when the position changed by this many pixels */
+#define MOTION_MIN_MOVE     0.5
+
+/* Larger steps are jumps (time controller, date line) and not continued */
+#define MOTION_MAX_STEP     40.0
+
+/* Steps spanning more time than this (us) are not continued either */
+#define MOTION_MAX_DT       30000000
+
+
+/** Place the marker at a position without motion. */
+void marker_motion_reset(marker_motion_t * mm, gdouble x, gdouble y)
+{
+    mm->x0 = mm->x1 = mm->x = x;
+    mm->y0 = mm->y1 = mm->y = y;
+    mm->t0 = mm->t1 = g_get_monotonic_time();
+}
+
+/** Record the position of a new data update. */
+void marker_motion_set(marker_motion_t * mm, gdouble x, gdouble y)
+{
+    mm->x0 = mm->x1;
+    mm->y0 = mm->y1;
+    mm->t0 = mm->t1;
+    mm->x1 = x;
+    mm->y1 = y;
+    mm->t1 = g_get_monotonic_time();
+}
+
+/**
+ * Calculate the screen position for a frame.
+ *
+ * @param mm The marker.
+ * @param frame_time The frame time of the frame clock.
+ * @param active Set to TRUE if the marker is still moving.
+ * @return TRUE if the screen position has changed and the marker needs to be
+ *         moved to mm->x, mm->y.
+ *
+ * The marker continues along the last step for at most the duration of that
+ * step, so it stops where the next update is expected if the update is late.
+ */
+gboolean marker_motion_step(marker_motion_t * mm, gint64 frame_time,
+                            gboolean * active)
+{
+    gdouble         dx = mm->x1 - mm->x0;
+    gdouble         dy = mm->y1 - mm->y0;
+    gint64          dt = mm->t1 - mm->t0;
+    gdouble         f = 0.0;
+    gdouble         x, y;
+
+    *active = FALSE;
+
+    if (dt > 0 && dt <= MOTION_MAX_DT && (dx != 0.0 || dy != 0.0) &&
+        dx * dx + dy * dy <= MOTION_MAX_STEP * MOTION_MAX_STEP)
+    {
+        f = CLAMP((gdouble) (frame_time - mm->t1) / dt, 0.0, 1.0);
+        *active = (f < 1.0);
+    }
+
+    x = mm->x1 + f * dx;
+    y = mm->y1 + f * dy;
+
+    if (fabs(x - mm->x) < MOTION_MIN_MOVE && fabs(y - mm->y) < MOTION_MIN_MOVE)
+        return FALSE;
+
+    mm->x = x;
+    mm->y = y;
+
+    return TRUE;
+}
+
+/**
+ * Check whether a view is on screen.
+ *
+ * Frames are skipped for views that are not mapped, e.g. in a hidden
+ * notebook page, and for views in iconified windows.
+ */
+gboolean marker_motion_visible(GtkWidget * widget)
+{
+    GdkWindow      *window;
+
+    if (!gtk_widget_is_drawable(widget))
+        return FALSE;
+
+    window = gtk_widget_get_window(gtk_widget_get_toplevel(widget));
+    if (window == NULL)
+        return FALSE;
+
+    return !(gdk_window_get_state(window) &
+             (GDK_WINDOW_STATE_ICONIFIED | GDK_WINDOW_STATE_WITHDRAWN));
+}
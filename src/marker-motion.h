@@ -0,0 +1,27 @@
+#ifndef MARKER_MOTION_H
+#define MARKER_MOTION_H 1
+
+#include <gtk/gtk.h>
+
+/**
+ * Screen position of a satellite marker between data updates.
+ *
+ * The views set the position calculated for each data update and move the
+ * marker from the frame clock, continuing along the last step until the next
+ * update arrives.
+ */
+typedef struct {
+    gdouble         x0, y0;     /*!< Position at the previous update. */
+    gdouble         x1, y1;     /*!< Position at the last update. */
+    gint64          t0, t1;     /*!< Monotonic time of the updates [us]. */
+    gdouble         x, y;       /*!< Position on screen. */
+} marker_motion_t;
+
+void            marker_motion_reset(marker_motion_t * mm, gdouble x,
+                                    gdouble y);
+void            marker_motion_set(marker_motion_t * mm, gdouble x, gdouble y);
+gboolean        marker_motion_step(marker_motion_t * mm, gint64 frame_time,
+                                   gboolean * active);
+gboolean        marker_motion_visible(GtkWidget * widget);
+
+#endif
@@ -45,6 +45,7 @@ extern GtkWidget *app;
 static GtkWidget *namew;        /* GtkEntry widget for module name */
 static GtkWidget *locw;         /* GtkComboBox for location selection */
 static GtkWidget *satlist;      /* list of selected satellites */
+static GHashTable *selsats;     /* catnums of the satellites in satlist */
 
 
 static gint qth_name_compare(const gchar * a, const gchar * b)
@@ -85,67 +86,92 @@ static gboolean overwrite_existing_module(void)
 }
 
 
-/* Add a satellite to the list of selected satellites */
-static void add_selected_sat(GtkListStore * store, gint catnum)
+/*
+ * Add a satellite to the list of selected satellites.
+ *
+ * Membership is checked against the selsats set and the satellite name and
+ * epoch are taken from the selector models, so the .sat file only needs to be
+ * read when the selector does not know the satellite.
+ *
+ * Returns TRUE if the satellite has been added to the list.
+ */
+static gboolean add_selected_sat(GtkListStore * store,
+                                 GtkSatSelector * selector, gint catnum)
 {
-    gint            i, sats = 0;
-    GtkTreeIter     iter;
-    GtkTreeIter     node;       /* new top level node added to the tree store */
-    gint            catnr;
-    gboolean        found = FALSE;
+    gchar          *name;
+    gdouble         epoch;
     sat_t           sat;
 
     /* check if the satellite is already in the list */
+    if (g_hash_table_contains(selsats, GINT_TO_POINTER(catnum)))
+        return FALSE;
 
-    /* get number of satellites already in list */
-    sats = gtk_tree_model_iter_n_children(GTK_TREE_MODEL(store), NULL);
-
-    /* loop over list entries and check their catnums */
-    for (i = 0; i < sats; i++)
+    /* Get satellite data */
+    if (!gtk_sat_selector_get_sat(selector, catnum, &name, &epoch))
     {
-        if (gtk_tree_model_iter_nth_child
-            (GTK_TREE_MODEL(store), &iter, NULL, i))
-        {
-            gtk_tree_model_get(GTK_TREE_MODEL(store), &iter,
-                               GTK_SAT_SELECTOR_COL_CATNUM, &catnr, -1);
-            if (catnum == catnr)
-            {
-                found = TRUE;
-            }
-        }
-        else
+        if (gtk_sat_data_read_sat(catnum, &sat))
         {
+            /* error */
             sat_log_log(SAT_LOG_LEVEL_ERROR,
-                        _("%s:%s: Could not fetch entry %d in satellite list"),
-                        __FILE__, __func__, i);
+                        _("%s:%s: Error reading satellite %d."),
+                        __FILE__, __func__, catnum);
+            return FALSE;
         }
 
+        name = g_strdup(sat.nickname);
+        epoch = sat.jul_epoch;
+        g_free(sat.name);
+        g_free(sat.nickname);
     }
 
-    if (found)
-        return;
+    /* insert satellite into liststore */
+    gtk_list_store_insert_with_values(store, NULL, -1,
+                                      GTK_SAT_SELECTOR_COL_NAME, name,
+                                      GTK_SAT_SELECTOR_COL_CATNUM, catnum,
+                                      GTK_SAT_SELECTOR_COL_EPOCH, epoch, -1);
+    g_hash_table_add(selsats, GINT_TO_POINTER(catnum));
+    g_free(name);
 
-    /* if we have made it so far, satellite is not in list */
+    return TRUE;
+}
 
-    /* Get satellite data */
-    if (gtk_sat_data_read_sat(catnum, &sat))
-    {
-        /* error */
-        sat_log_log(SAT_LOG_LEVEL_ERROR,
-                    _("%s:%s: Error reading satellite %d."),
-                    __FILE__, __func__, catnum);
-    }
-    else
+/*
+ * Add several satellites to the list of selected satellites.
+ *
+ * The store is left unsorted while the rows are inserted and sorted once at
+ * the end; the selector is updated in a single batch as well. If the store is
+ * attached to a view it should be detached by the caller.
+ */
+static void add_selected_sats(GtkListStore * store, GtkSatSelector * selector,
+                              const gint * catnums, guint num)
+{
+    GArray         *added;
+    gint            sortcol;
+    GtkSortType     order;
+    guint           i;
+
+    added = g_array_sized_new(FALSE, FALSE, sizeof(gint), num);
+
+    gtk_tree_sortable_get_sort_column_id(GTK_TREE_SORTABLE(store),
+                                         &sortcol, &order);
+    gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(store),
+                                         GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID,
+                                         order);
+
+    for (i = 0; i < num; i++)
     {
-        /* insert satellite into liststore */
-        gtk_list_store_append(store, &node);
-        gtk_list_store_set(store, &node,
-                           GTK_SAT_SELECTOR_COL_NAME, sat.nickname,
-                           GTK_SAT_SELECTOR_COL_CATNUM, catnum,
-                           GTK_SAT_SELECTOR_COL_EPOCH, sat.jul_epoch, -1);
-        g_free(sat.name);
-        g_free(sat.nickname);
+        if (add_selected_sat(store, selector, catnums[i]))
+            g_array_append_val(added, catnums[i]);
     }
+
+    gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(store),
+                                         sortcol, order);
+
+    /* tell the sat_selector to hide the new satellites */
+    if (added->len > 0)
+        gtk_sat_selector_mark_selected_array(selector, added);
+
+    g_array_free(added, TRUE);
 }
 
 /* Signal handler for "->" button signals */
@@ -166,10 +192,42 @@ static void addbut_clicked_cb(GtkButton * button, GtkSatSelector * selector)
         /* Add satellite to selected list */
         store =
             GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(satlist)));
-        add_selected_sat(store, catnum);
-        /*tell the sat_selector to hide that satellite */
-        gtk_sat_selector_mark_selected(selector, catnum);
+        if (add_selected_sat(store, selector, catnum))
+        {
+            /*tell the sat_selector to hide that satellite */
+            gtk_sat_selector_mark_selected(selector, catnum);
+        }
+        g_free(name);
+    }
+}
+
+/* Signal handler for "=>" button signals */
+static void addallbut_clicked_cb(GtkButton * button,
+                                 GtkSatSelector * selector)
+{
+    GtkTreeModel   *model;
+    GArray         *catnums;
+
+    (void)button;
+
+    /* satellites currently shown in the selector */
+    catnums = gtk_sat_selector_get_visible(selector);
+
+    if (catnums->len > 0)
+    {
+        /* detach the store so that the view is only updated once */
+        model = gtk_tree_view_get_model(GTK_TREE_VIEW(satlist));
+        g_object_ref(model);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(satlist), NULL);
+
+        add_selected_sats(GTK_LIST_STORE(model), selector,
+                          (const gint *)catnums->data, catnums->len);
+
+        gtk_tree_view_set_model(GTK_TREE_VIEW(satlist), model);
+        g_object_unref(model);
     }
+
+    g_array_free(catnums, TRUE);
 }
 
 /* Signal handler for "<-" button signals */
@@ -193,6 +251,7 @@ static void delbut_clicked_cb(GtkButton * button, GtkSatSelector * selector)
                            -1);
         /*tell the sat_selector it can show that satellite again */
         gtk_sat_selector_mark_unselected(selector, catnr);
+        g_hash_table_remove(selsats, GINT_TO_POINTER(catnr));
         gtk_list_store_remove(GTK_LIST_STORE(model), &iter);
     }
 }
@@ -206,9 +265,11 @@ static void sat_activated_cb(GtkSatSelector * selector, gint catnr,
 
     /* Add satellite to selected list */
     store = GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(satlist)));
-    add_selected_sat(store, catnr);
-    /*tell the sat_selector it can hide that satellite */
-    gtk_sat_selector_mark_selected(selector, catnr);
+    if (add_selected_sat(store, selector, catnr))
+    {
+        /*tell the sat_selector it can hide that satellite */
+        gtk_sat_selector_mark_selected(selector, catnr);
+    }
 }
 
 
@@ -489,6 +550,7 @@ static void row_activated_cb(GtkTreeView * view, GtkTreePath * path,
                            -1);
         /*tell the sat_selector it can show that satellite again */
         gtk_sat_selector_mark_unselected(selector, catnr);
+        g_hash_table_remove(selsats, GINT_TO_POINTER(catnr));
         gtk_list_store_remove(GTK_LIST_STORE(model), &iter);
     }
 }
@@ -561,7 +623,6 @@ static GtkWidget *create_selected_sats_list(GKeyFile * cfgdata, gboolean new,
         gint           *sats = NULL;
         gsize           length;
         GError         *error = NULL;
-        guint           i;
 
         sats = g_key_file_get_integer_list(cfgdata,
                                            MOD_CFG_GLOBAL_SECTION,
@@ -584,11 +645,7 @@ static GtkWidget *create_selected_sats_list(GKeyFile * cfgdata, gboolean new,
         }
         else
         {
-            for (i = 0; i < length; i++)
-            {
-                add_selected_sat(store, sats[i]);
-                gtk_sat_selector_mark_selected(selector, sats[i]);
-            }
+            add_selected_sats(store, selector, sats, length);
             g_free(sats);
         }
 
@@ -609,7 +666,7 @@ static GtkWidget *mod_cfg_editor_create(const gchar * modname,
     GtkWidget      *grid;
     GtkWidget      *label;
     GtkWidget      *swin;
-    GtkWidget      *addbut, *delbut;
+    GtkWidget      *addbut, *addallbut, *delbut;
     GtkWidget      *vbox;
     gchar          *strbuf;
     GtkWidget      *frame;
@@ -712,6 +769,7 @@ static GtkWidget *mod_cfg_editor_create(const gchar * modname,
                      G_CALLBACK(sat_activated_cb), NULL);
 
     /* list of selected satellites */
+    selsats = g_hash_table_new(g_direct_hash, g_direct_equal);
     satlist = create_selected_sats_list(cfgdata, new,
                                         GTK_SAT_SELECTOR(selector));
     swin = gtk_scrolled_window_new(NULL, NULL);
@@ -725,6 +783,12 @@ static GtkWidget *mod_cfg_editor_create(const gchar * modname,
     g_signal_connect(addbut, "clicked", G_CALLBACK(addbut_clicked_cb),
                      selector);
 
+    addallbut = gtk_button_new_with_label(" ==> ");
+    gtk_widget_set_tooltip_text(addallbut,
+                                _("Add all satellites shown in the group"));
+    g_signal_connect(addallbut, "clicked", G_CALLBACK(addallbut_clicked_cb),
+                     selector);
+
     delbut = gtk_button_new_with_label(" <-- ");
     gtk_widget_set_tooltip_text(delbut, _("Delete satellite from list"));
     g_signal_connect(delbut, "clicked", G_CALLBACK(delbut_clicked_cb),
@@ -744,6 +808,7 @@ static GtkWidget *mod_cfg_editor_create(const gchar * modname,
     gtk_grid_set_column_spacing(GTK_GRID(grid), 10);
     gtk_grid_set_row_homogeneous(GTK_GRID(grid), TRUE);
     gtk_grid_attach(GTK_GRID(grid), selector, 0, 0, 4, 8);
+    gtk_grid_attach(GTK_GRID(grid), addallbut, 4, 3, 1, 1);
     gtk_grid_attach(GTK_GRID(grid), addbut, 4, 4, 1, 1);
     gtk_grid_attach(GTK_GRID(grid), delbut, 4, 5, 1, 1);
     gtk_grid_attach(GTK_GRID(grid), label, 5, 0, 3, 2);
@@ -986,6 +1051,8 @@ gchar          *mod_cfg_new()
     /* clean up */
     g_key_file_free(cfgdata);
     gtk_widget_destroy(dialog);
+    g_hash_table_destroy(selsats);
+    selsats = NULL;
 
     return name;
 }
@@ -1076,6 +1143,8 @@ mod_cfg_status_t mod_cfg_edit(gchar * modname, GKeyFile * cfgdata,
 
     /* clean up */
     gtk_widget_destroy(dialog);
+    g_hash_table_destroy(selsats);
+    selsats = NULL;
 
     return status;
 }
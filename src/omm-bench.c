@@ -0,0 +1,413 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Throughput of the OMM import.
+ *
+ * Serves a large OMM file from a local HTTP server, fetches it with libcurl
+ * the way the TLE update does and imports it with omm_import_file(). The
+ * file is either given with --file, e.g. a full catalog export of CelesTrak,
+ * or generated with --count element sets in JSON, CSV or XML:
+ *
+ *   ./omm-bench --count=60000 --format=xml
+ *
+ * Reports the fetch and import rates and the peak resident memory after
+ * each step.
+ *
+ * The program is not built by default; use "make omm-bench".
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <curl/curl.h>
+#include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "omm-import.h"
+#include "sat-log.h"
+
+
+static gint     count = 30000;
+static gchar   *format = NULL;
+static gchar   *file = NULL;
+static gboolean verbose = FALSE;
+
+static GOptionEntry entries[] = {
+    {"count", 'n', 0, G_OPTION_ARG_INT, &count,
+     "Number of generated element sets (default 30000)", "N"},
+    {"format", 0, 0, G_OPTION_ARG_STRING, &format,
+     "Format of the generated file: json, csv or xml (default json)", "FMT"},
+    {"file", 'f', 0, G_OPTION_ARG_FILENAME, &file,
+     "Serve this OMM file instead of a generated one", "PATH"},
+    {"verbose", 'v', 0, G_OPTION_ARG_NONE, &verbose,
+     "Print debug messages of the importer", NULL},
+    {NULL}
+};
+
+/* State shared with the fetch thread */
+typedef struct {
+    GMainLoop      *loop;
+    gchar          *url;
+    gchar          *dest;
+    gint            status;
+} bench_t;
+
+
+/* Log to stderr instead of the log file of gpredict. */
+void sat_log_log(sat_log_level_t level, const char *fmt, ...)
+{
+    va_list         ap;
+
+    if ((level == SAT_LOG_LEVEL_DEBUG) && !verbose)
+        return;
+
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fputc('\n', stderr);
+}
+
+/* Peak resident memory of the process in KiB. */
+static glong peak_rss(void)
+{
+    struct rusage   usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+
+    return usage.ru_maxrss;
+}
+
+/* Write one generated element set; ISS like orbits with varying planes. */
+static void write_set(FILE * fp, const gchar * fmt, gint i)
+{
+    gchar           name[32];
+    gchar           epoch[32];
+    gint            catnr = 10000 + i;
+    gdouble         raan = (i * 7) % 360;
+    gdouble         ma = (i * 13) % 360;
+
+    g_snprintf(name, sizeof(name), "OBJECT %d", catnr);
+    g_snprintf(epoch, sizeof(epoch), "2024-%02d-%02dT%02d:%02d:%02d.%06d",
+               1 + i % 12, 1 + i % 28, i % 24, i % 60, (i * 7) % 60,
+               (i * 4093) % 1000000);
+
+    if (!strcmp(fmt, "xml"))
+    {
+        fprintf(fp, "<omm id=\"CCSDS_OMM_VERS\" version=\"2.0\"><body>"
+                "<segment><metadata><OBJECT_NAME>%s</OBJECT_NAME>"
+                "<OBJECT_ID>2024-%03dA</OBJECT_ID></metadata><data>"
+                "<meanElements><EPOCH>%s</EPOCH>"
+                "<MEAN_MOTION>15.5</MEAN_MOTION>"
+                "<ECCENTRICITY>.0005</ECCENTRICITY>"
+                "<INCLINATION>51.64</INCLINATION>"
+                "<RA_OF_ASC_NODE>%.4f</RA_OF_ASC_NODE>"
+                "<ARG_OF_PERICENTER>90.0</ARG_OF_PERICENTER>"
+                "<MEAN_ANOMALY>%.4f</MEAN_ANOMALY></meanElements>"
+                "<tleParameters><NORAD_CAT_ID>%d</NORAD_CAT_ID>"
+                "<ELEMENT_SET_NO>999</ELEMENT_SET_NO>"
+                "<REV_AT_EPOCH>1000</REV_AT_EPOCH>"
+                "<BSTAR>.0001</BSTAR><MEAN_MOTION_DOT>.00001</MEAN_MOTION_DOT>"
+                "<MEAN_MOTION_DDOT>0</MEAN_MOTION_DDOT></tleParameters>"
+                "</data></segment></body></omm>\n",
+                name, i % 1000, epoch, raan, ma, catnr);
+    }
+    else if (!strcmp(fmt, "csv"))
+    {
+        fprintf(fp, "%s,2024-%03dA,%s,15.5,.0005,51.64,%.4f,90.0,%.4f,0,U,"
+                "%d,999,1000,.0001,.00001,0\n",
+                name, i % 1000, epoch, raan, ma, catnr);
+    }
+    else
+    {
+        fprintf(fp, "%s{\"OBJECT_NAME\":\"%s\",\"OBJECT_ID\":\"2024-%03dA\","
+                "\"EPOCH\":\"%s\",\"MEAN_MOTION\":15.5,"
+                "\"ECCENTRICITY\":0.0005,\"INCLINATION\":51.64,"
+                "\"RA_OF_ASC_NODE\":%.4f,\"ARG_OF_PERICENTER\":90.0,"
+                "\"MEAN_ANOMALY\":%.4f,\"EPHEMERIS_TYPE\":0,"
+                "\"CLASSIFICATION_TYPE\":\"U\",\"NORAD_CAT_ID\":%d,"
+                "\"ELEMENT_SET_NO\":999,\"REV_AT_EPOCH\":1000,"
+                "\"BSTAR\":0.0001,\"MEAN_MOTION_DOT\":0.00001,"
+                "\"MEAN_MOTION_DDOT\":0}\n",
+                (i > 0) ? "," : "", name, i % 1000, epoch, raan, ma, catnr);
+    }
+}
+
+/* Generate an OMM file with count element sets. */
+static gboolean generate_file(const gchar * path, const gchar * fmt)
+{
+    FILE           *fp;
+    gint            i;
+
+    fp = g_fopen(path, "wb");
+    if (fp == NULL)
+        return FALSE;
+
+    if (!strcmp(fmt, "xml"))
+        fprintf(fp, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<ndm>\n");
+    else if (!strcmp(fmt, "csv"))
+        fprintf(fp, "OBJECT_NAME,OBJECT_ID,EPOCH,MEAN_MOTION,ECCENTRICITY,"
+                "INCLINATION,RA_OF_ASC_NODE,ARG_OF_PERICENTER,MEAN_ANOMALY,"
+                "EPHEMERIS_TYPE,CLASSIFICATION_TYPE,NORAD_CAT_ID,"
+                "ELEMENT_SET_NO,REV_AT_EPOCH,BSTAR,MEAN_MOTION_DOT,"
+                "MEAN_MOTION_DDOT\n");
+    else
+        fprintf(fp, "[\n");
+
+    for (i = 0; i < count; i++)
+        write_set(fp, fmt, i);
+
+    if (!strcmp(fmt, "xml"))
+        fprintf(fp, "</ndm>\n");
+    else if (!strcmp(fmt, "json"))
+        fprintf(fp, "]\n");
+
+    return (fclose(fp) == 0);
+}
+
+/* Serve the file to every request; runs in a thread of the service. */
+static gboolean serve_cb(GThreadedSocketService * service,
+                         GSocketConnection * connection,
+                         GObject * source_object, gpointer path)
+{
+    GInputStream   *in;
+    GOutputStream  *out;
+    GFileInputStream *fin;
+    GFile          *gfile;
+    gchar           buf[4096];
+    gchar          *header;
+    GStatBuf        st;
+
+    (void)service;
+    (void)source_object;
+
+    /* the request itself does not matter */
+    in = g_io_stream_get_input_stream(G_IO_STREAM(connection));
+    out = g_io_stream_get_output_stream(G_IO_STREAM(connection));
+    if (g_input_stream_read(in, buf, sizeof(buf), NULL, NULL) <= 0 ||
+        g_stat((const gchar *)path, &st) != 0)
+        return FALSE;
+
+    header = g_strdup_printf("HTTP/1.0 200 OK\r\n"
+                             "Content-Type: application/octet-stream\r\n"
+                             "Content-Length: %" G_GINT64_FORMAT "\r\n\r\n",
+                             (gint64) st.st_size);
+    g_output_stream_write_all(out, header, strlen(header), NULL, NULL, NULL);
+    g_free(header);
+
+    gfile = g_file_new_for_path((const gchar *)path);
+    fin = g_file_read(gfile, NULL, NULL);
+    if (fin != NULL)
+    {
+        g_output_stream_splice(out, G_INPUT_STREAM(fin),
+                               G_OUTPUT_STREAM_SPLICE_CLOSE_SOURCE, NULL,
+                               NULL);
+        g_object_unref(fin);
+    }
+    g_object_unref(gfile);
+
+    return FALSE;
+}
+
+static size_t write_func(void *ptr, size_t size, size_t nmemb, FILE * stream)
+{
+    return fwrite(ptr, size, nmemb, stream);
+}
+
+static void count_cb(tle_t * tle, gchar lines[3][80], gpointer data)
+{
+    (void)tle;
+    (void)lines;
+
+    (*(gint *) data)++;
+}
+
+/* Fetch and import the file, then stop the main loop. */
+static gpointer bench_thread(gpointer data)
+{
+    bench_t        *bench = (bench_t *) data;
+    CURL           *curl;
+    CURLcode        res;
+    FILE           *fp;
+    GStatBuf        st;
+    GTimer         *timer;
+    gdouble         mbytes, secs;
+    gint            num = 0;
+
+    timer = g_timer_new();
+
+    fp = g_fopen(bench->dest, "wb");
+    curl = curl_easy_init();
+    curl_easy_setopt(curl, CURLOPT_URL, bench->url);
+    curl_easy_setopt(curl, CURLOPT_USERAGENT, "gpredict/curl");
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_func);
+    res = curl_easy_perform(curl);
+    curl_easy_cleanup(curl);
+    fclose(fp);
+
+    if (res != CURLE_OK || g_stat(bench->dest, &st) != 0)
+    {
+        fprintf(stderr, "Error fetching %s (%s)\n", bench->url,
+                curl_easy_strerror(res));
+        bench->status = EXIT_FAILURE;
+        g_main_loop_quit(bench->loop);
+        g_timer_destroy(timer);
+        return NULL;
+    }
+
+    secs = g_timer_elapsed(timer, NULL);
+    mbytes = st.st_size / 1048576.0;
+    printf("fetch   %8.1f MiB in %7.3f s, %8.1f MiB/s, peak RSS %ld KiB\n",
+           mbytes, secs, mbytes / secs, peak_rss());
+
+    g_timer_start(timer);
+    if (omm_import_file(bench->dest, count_cb, &num) < 0)
+    {
+        fprintf(stderr, "%s is not an OMM file\n", bench->dest);
+        bench->status = EXIT_FAILURE;
+    }
+    else
+    {
+        secs = g_timer_elapsed(timer, NULL);
+        printf("import  %8d sets in %7.3f s, %8.0f sets/s, %.1f MiB/s, "
+               "peak RSS %ld KiB\n", num, secs, num / secs, mbytes / secs,
+               peak_rss());
+        bench->status = EXIT_SUCCESS;
+    }
+
+    g_timer_destroy(timer);
+    g_main_loop_quit(bench->loop);
+
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    GOptionContext *context;
+    GError         *err = NULL;
+    GSocketService *service;
+    GInetAddress   *loopback;
+    GSocketAddress *address, *effective = NULL;
+    GThread        *thread;
+    bench_t         bench;
+    gchar          *tmpdir;
+    gchar          *path;
+
+    context = g_option_context_new("- time the OMM import");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &err))
+    {
+        fprintf(stderr, "%s\n", err->message);
+        g_clear_error(&err);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    if (format == NULL)
+        format = g_strdup("json");
+
+    if (strcmp(format, "json") && strcmp(format, "csv") &&
+        strcmp(format, "xml"))
+    {
+        fprintf(stderr, "Unknown format %s\n", format);
+        return EXIT_FAILURE;
+    }
+
+    tmpdir = g_dir_make_tmp("omm-bench-XXXXXX", &err);
+    if (tmpdir == NULL)
+    {
+        fprintf(stderr, "%s\n", err->message);
+        g_clear_error(&err);
+        return EXIT_FAILURE;
+    }
+
+    if (file != NULL)
+    {
+        path = g_strdup(file);
+    }
+    else
+    {
+        path = g_build_filename(tmpdir, "catalog.omm", NULL);
+        if (!generate_file(path, format))
+        {
+            fprintf(stderr, "Could not write %s\n", path);
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* HTTP stand-in on a free port of the loopback interface */
+    service = g_threaded_socket_service_new(2);
+    loopback = g_inet_address_new_loopback(G_SOCKET_FAMILY_IPV4);
+    address = g_inet_socket_address_new(loopback, 0);
+    if (!g_socket_listener_add_address(G_SOCKET_LISTENER(service), address,
+                                       G_SOCKET_TYPE_STREAM,
+                                       G_SOCKET_PROTOCOL_TCP, NULL,
+                                       &effective, &err))
+    {
+        fprintf(stderr, "%s\n", err->message);
+        g_clear_error(&err);
+        return EXIT_FAILURE;
+    }
+    g_signal_connect(service, "run", G_CALLBACK(serve_cb), path);
+    g_socket_service_start(service);
+
+    curl_global_init(CURL_GLOBAL_ALL);
+
+    bench.loop = g_main_loop_new(NULL, FALSE);
+    bench.url = g_strdup_printf("http://127.0.0.1:%u/catalog",
+                                g_inet_socket_address_get_port
+                                (G_INET_SOCKET_ADDRESS(effective)));
+    bench.dest = g_build_filename(tmpdir, "fetched.omm", NULL);
+    bench.status = EXIT_FAILURE;
+
+    thread = g_thread_new("omm-bench", bench_thread, &bench);
+    g_main_loop_run(bench.loop);
+    g_thread_join(thread);
+
+    g_socket_service_stop(service);
+    g_object_unref(service);
+    g_object_unref(effective);
+    g_object_unref(address);
+    g_object_unref(loopback);
+    g_main_loop_unref(bench.loop);
+    curl_global_cleanup();
+
+    g_remove(bench.dest);
+    if (file == NULL)
+        g_remove(path);
+    g_rmdir(tmpdir);
+
+    g_free(bench.url);
+    g_free(bench.dest);
+    g_free(path);
+    g_free(tmpdir);
+    g_free(format);
+    g_free(file);
+
+    return bench.status;
+}
@@ -0,0 +1,895 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Import of CCSDS Orbit Mean-Elements Messages (OMM).
+ *
+ * Element sets published as OMM, e.g. the GP data of CelesTrak, come as JSON,
+ * CSV, KVN or XML. Each message is converted to the equivalent TLE lines and
+ * tle_t, so the TLE update can handle them like any other element set. Files
+ * are read in a single pass: JSON is scanned by a small incremental lexer
+ * and XML is fed to GMarkup in fixed size chunks, while CSV and KVN are read
+ * line by line. Only the message being read is kept in memory, so the memory
+ * use does not depend on the size of the file.
+ *
+ * Catalog numbers from 100000 to 339999 are written using the Alpha-5
+ * scheme, which Decode_Catnr() understands. Messages with larger catalog
+ * numbers can not be represented as TLE and are skipped.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "omm-import.h"
+#include "sat-log.h"
+
+
+/* Size of the chunks read from JSON and XML files */
+#define READ_CHUNK      65536
+
+/* Number of bytes inspected to detect the format */
+#define SNIFF_SIZE      4096
+
+/* Maximum nesting of JSON containers and number of CSV columns */
+#define MAX_DEPTH       32
+#define MAX_COLUMNS     64
+
+/* Largest catalog number that fits in Alpha-5 */
+#define MAX_CATNR       339999
+
+
+/** OMM keywords used for the conversion. */
+typedef enum {
+    F_OBJECT_NAME = 0,
+    F_OBJECT_ID,
+    F_EPOCH,
+    F_CLASSIFICATION_TYPE,
+    F_NORAD_CAT_ID,
+    F_MEAN_MOTION,
+    F_ECCENTRICITY,
+    F_INCLINATION,
+    F_RA_OF_ASC_NODE,
+    F_ARG_OF_PERICENTER,
+    F_MEAN_ANOMALY,
+    F_ELEMENT_SET_NO,
+    F_REV_AT_EPOCH,
+    F_BSTAR,
+    F_MEAN_MOTION_DOT,
+    F_MEAN_MOTION_DDOT,
+    F_NUM
+} omm_field_t;
+
+static const gchar *field_names[F_NUM] = {
+    "OBJECT_NAME",
+    "OBJECT_ID",
+    "EPOCH",
+    "CLASSIFICATION_TYPE",
+    "NORAD_CAT_ID",
+    "MEAN_MOTION",
+    "ECCENTRICITY",
+    "INCLINATION",
+    "RA_OF_ASC_NODE",
+    "ARG_OF_PERICENTER",
+    "MEAN_ANOMALY",
+    "ELEMENT_SET_NO",
+    "REV_AT_EPOCH",
+    "BSTAR",
+    "MEAN_MOTION_DOT",
+    "MEAN_MOTION_DDOT"
+};
+
+/* Fields without which a message is skipped */
+#define REQUIRED_FIELDS ((1 << F_EPOCH) | (1 << F_NORAD_CAT_ID) | \
+                         (1 << F_MEAN_MOTION) | (1 << F_ECCENTRICITY) | \
+                         (1 << F_INCLINATION) | (1 << F_RA_OF_ASC_NODE) | \
+                         (1 << F_ARG_OF_PERICENTER) | (1 << F_MEAN_ANOMALY))
+
+
+/** The message being read. */
+typedef struct {
+    gchar           name[25];   /*!< OBJECT_NAME */
+    gchar           objid[16];  /*!< OBJECT_ID, e.g. 1998-067A */
+    gchar           epoch[32];  /*!< EPOCH, e.g. 2017-01-01T12:00:00.000 */
+    gchar           classif;    /*!< CLASSIFICATION_TYPE */
+    gdouble         values[F_NUM];      /*!< Numeric fields */
+    guint           have;       /*!< Bit mask of the fields read */
+} omm_record_t;
+
+typedef struct {
+    omm_record_t    rec;
+    omm_import_cb   callback;
+    gpointer        data;
+    gint            count;      /*!< Number of imported messages */
+    gint            skipped;    /*!< Number of skipped messages */
+} omm_parser_t;
+
+
+/* Store a field of the current message; unknown keywords are ignored. */
+static void set_field(omm_parser_t * parser, const gchar * name,
+                      const gchar * value)
+{
+    omm_record_t   *rec = &parser->rec;
+    gchar          *end;
+    guint           i;
+
+    for (i = 0; i < F_NUM; i++)
+        if (!strcmp(name, field_names[i]))
+            break;
+
+    if (i == F_NUM)
+        return;
+
+    switch (i)
+    {
+    case F_OBJECT_NAME:
+        g_strlcpy(rec->name, value, sizeof(rec->name));
+        break;
+
+    case F_OBJECT_ID:
+        g_strlcpy(rec->objid, value, sizeof(rec->objid));
+        break;
+
+    case F_EPOCH:
+        g_strlcpy(rec->epoch, value, sizeof(rec->epoch));
+        break;
+
+    case F_CLASSIFICATION_TYPE:
+        rec->classif = value[0];
+        break;
+
+    default:
+        rec->values[i] = g_ascii_strtod(value, &end);
+        if (end == value)
+            return;
+        break;
+    }
+
+    rec->have |= 1 << i;
+}
+
+/* Write the TLE checksum into column 69 and terminate the line. */
+static void set_checksum(gchar * line)
+{
+    gint            i, sum = 0;
+
+    for (i = 0; i < 68; i++)
+    {
+        if (g_ascii_isdigit(line[i]))
+            sum += line[i] - '0';
+        else if (line[i] == '-')
+            sum += 1;
+    }
+
+    line[68] = '0' + sum % 10;
+    line[69] = '\0';
+}
+
+/* Format a catalog number as 5 digit or Alpha-5 TLE field. */
+static gboolean format_catnr(gint catnr, gchar * field)
+{
+    static const gchar letters[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+
+    if ((catnr <= 0) || (catnr > MAX_CATNR))
+        return FALSE;
+
+    if (catnr < 100000)
+        g_snprintf(field, 6, "%05d", catnr);
+    else
+        g_snprintf(field, 6, "%c%04d", letters[catnr / 10000 - 10],
+                   catnr % 10000);
+
+    return TRUE;
+}
+
+/*
+ * Format a value in the TLE exponent notation, e.g. " 12345-3" for
+ * 0.12345e-3.
+ */
+static void format_exp(gdouble value, gchar * field)
+{
+    gint            exp, mant;
+
+    if (fabs(value) < 1.0e-10)
+    {
+        g_strlcpy(field, " 00000-0", 9);
+        return;
+    }
+
+    exp = (gint) floor(log10(fabs(value))) + 1;
+    mant = (gint) lround(fabs(value) / pow(10.0, exp) * 1.0e5);
+    if (mant >= 100000)
+    {
+        mant /= 10;
+        exp++;
+    }
+
+    if (ABS(exp) > 9)
+    {
+        g_strlcpy(field, " 00000-0", 9);
+        return;
+    }
+
+    g_snprintf(field, 9, "%c%05d%c%d", (value < 0.0) ? '-' : ' ', mant,
+               (exp < 0) ? '-' : '+', ABS(exp));
+}
+
+/* Reduce an angle to 0..360 degrees. */
+static gdouble norm_angle(gdouble angle)
+{
+    angle = fmod(angle, 360.0);
+
+    return (angle < 0.0) ? angle + 360.0 : angle;
+}
+
+/*
+ * Convert a message to TLE lines.
+ *
+ * Returns FALSE if the elements can not be represented in the TLE format.
+ */
+static gboolean record_to_tle(omm_record_t * rec, gchar lines[3][80])
+{
+    gdouble        *v = rec->values;
+    GDate           date;
+    gchar           catstr[6], idesg[9], ddot[9], bstar[9];
+    gint            year, month, day, hour, min, n = 0;
+    gdouble         sec, doy;
+    glong           ndot, ecc;
+
+    if (!format_catnr((gint) v[F_NORAD_CAT_ID], catstr))
+        return FALSE;
+
+    /* epoch as year and fractional day of year */
+    if ((sscanf(rec->epoch, "%d-%d-%dT%d:%d:%n", &year, &month, &day,
+                &hour, &min, &n) != 5) || (n == 0) ||
+        !g_date_valid_dmy(day, month, year))
+        return FALSE;
+
+    sec = g_ascii_strtod(rec->epoch + n, NULL);
+    g_date_clear(&date, 1);
+    g_date_set_dmy(&date, day, month, year);
+    doy = g_date_get_day_of_year(&date) +
+        (hour * 3600.0 + min * 60.0 + sec) / 86400.0;
+
+    /* international designator, 1998-067A => 98067A */
+    if ((strlen(rec->objid) > 8) && (rec->objid[4] == '-'))
+        g_snprintf(idesg, sizeof(idesg), "%.2s%.3s%s", rec->objid + 2,
+                   rec->objid + 5, rec->objid + 8);
+    else
+        idesg[0] = '\0';
+
+    ndot = lround(fabs(v[F_MEAN_MOTION_DOT]) * 1.0e8);
+    ecc = lround(v[F_ECCENTRICITY] * 1.0e7);
+    if ((ndot > 99999999) || (ecc < 0) || (ecc > 9999999) ||
+        (v[F_MEAN_MOTION] <= 0.0) || (v[F_MEAN_MOTION] >= 100.0) ||
+        (v[F_INCLINATION] < 0.0) || (v[F_INCLINATION] > 180.0))
+        return FALSE;
+
+    format_exp(v[F_MEAN_MOTION_DDOT], ddot);
+    format_exp(v[F_BSTAR], bstar);
+
+    g_strlcpy(lines[0], rec->name, 80);
+
+    if (g_snprintf(lines[1], 80,
+                   "1 %s%c %-8s %02d%012.8f %c.%08ld %s %s 0 %4d ",
+                   catstr, rec->classif ? rec->classif : 'U', idesg,
+                   year % 100, doy, (v[F_MEAN_MOTION_DOT] < 0.0) ? '-' : ' ',
+                   ndot, ddot, bstar,
+                   (gint) v[F_ELEMENT_SET_NO] % 10000) != 69)
+        return FALSE;
+
+    if (g_snprintf(lines[2], 80,
+                   "2 %s %8.4f %8.4f %07ld %8.4f %8.4f %11.8f%5d ",
+                   catstr, v[F_INCLINATION], norm_angle(v[F_RA_OF_ASC_NODE]),
+                   ecc, norm_angle(v[F_ARG_OF_PERICENTER]),
+                   norm_angle(v[F_MEAN_ANOMALY]), v[F_MEAN_MOTION],
+                   (gint) v[F_REV_AT_EPOCH] % 100000) != 69)
+        return FALSE;
+
+    set_checksum(lines[1]);
+    set_checksum(lines[2]);
+
+    return TRUE;
+}
+
+/* Convert and hand over the current message, then start a new one. */
+static void end_record(omm_parser_t * parser)
+{
+    omm_record_t   *rec = &parser->rec;
+    gchar           lines[3][80];
+    tle_t           tle;
+
+    if (rec->have == 0)
+        return;
+
+    if (((rec->have & REQUIRED_FIELDS) == REQUIRED_FIELDS) &&
+        record_to_tle(rec, lines) && (Get_Next_Tle_Set(lines, &tle) == 1))
+    {
+        parser->callback(&tle, lines, parser->data);
+        parser->count++;
+    }
+    else
+    {
+        sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                    _("%s: Skipping elements of %s (%d)"),
+                    __func__, rec->name, (gint) rec->values[F_NORAD_CAT_ID]);
+        parser->skipped++;
+    }
+
+    memset(rec, 0, sizeof(omm_record_t));
+}
+
+
+/** Lexer state of the JSON reader. */
+typedef enum {
+    JSON_SCAN,                  /*!< Between tokens */
+    JSON_STRING,                /*!< In a string */
+    JSON_ESCAPE,                /*!< After a backslash in a string */
+    JSON_UNICODE,               /*!< In a \uXXXX escape */
+    JSON_LITERAL                /*!< In a number, true, false or null */
+} json_lex_t;
+
+typedef struct {
+    omm_parser_t   *parser;
+    json_lex_t      lex;
+    gchar           stack[MAX_DEPTH];   /*!< Open containers, { or [ */
+    gint            depth;
+    gboolean        expect_key; /*!< Next string is a member name */
+    GString        *key;        /*!< Member name of the next value */
+    GString        *token;      /*!< The string or literal being read */
+    gunichar        uchar;
+    gint            nhex;
+} json_state_t;
+
+/* Handle a complete string or literal token. */
+static void json_token(json_state_t * js, gboolean is_string)
+{
+    if (js->expect_key)
+    {
+        g_string_assign(js->key, js->token->str);
+        js->expect_key = FALSE;
+    }
+    else if (js->key->len > 0)
+    {
+        if (is_string || strcmp(js->token->str, "null"))
+            set_field(js->parser, js->key->str, js->token->str);
+        g_string_truncate(js->key, 0);
+    }
+
+    g_string_truncate(js->token, 0);
+}
+
+/*
+ * Feed a chunk of a JSON document to the lexer.
+ *
+ * Every object with scalar members is taken as one message and ends at its
+ * closing brace. Returns FALSE if the document is not valid JSON.
+ */
+static gboolean json_feed(json_state_t * js, const gchar * buf, gsize len)
+{
+    gchar           c;
+    gsize           i;
+
+    for (i = 0; i < len; i++)
+    {
+        c = buf[i];
+
+        switch (js->lex)
+        {
+        case JSON_STRING:
+            if (c == '"')
+            {
+                js->lex = JSON_SCAN;
+                json_token(js, TRUE);
+            }
+            else if (c == '\\')
+                js->lex = JSON_ESCAPE;
+            else
+                g_string_append_c(js->token, c);
+            continue;
+
+        case JSON_ESCAPE:
+            js->lex = JSON_STRING;
+            switch (c)
+            {
+            case 'b':
+                g_string_append_c(js->token, '\b');
+                break;
+            case 'f':
+                g_string_append_c(js->token, '\f');
+                break;
+            case 'n':
+                g_string_append_c(js->token, '\n');
+                break;
+            case 'r':
+                g_string_append_c(js->token, '\r');
+                break;
+            case 't':
+                g_string_append_c(js->token, '\t');
+                break;
+            case 'u':
+                js->lex = JSON_UNICODE;
+                js->uchar = 0;
+                js->nhex = 0;
+                break;
+            default:
+                g_string_append_c(js->token, c);
+                break;
+            }
+            continue;
+
+        case JSON_UNICODE:
+            if (!g_ascii_isxdigit(c))
+                return FALSE;
+
+            js->uchar = js->uchar * 16 + g_ascii_xdigit_value(c);
+            if (++js->nhex == 4)
+            {
+                g_string_append_unichar(js->token, js->uchar);
+                js->lex = JSON_STRING;
+            }
+            continue;
+
+        case JSON_LITERAL:
+            if (g_ascii_isalnum(c) || (c == '.') || (c == '-') || (c == '+'))
+            {
+                g_string_append_c(js->token, c);
+                continue;
+            }
+
+            /* c is the delimiter after the literal */
+            js->lex = JSON_SCAN;
+            json_token(js, FALSE);
+            break;
+
+        case JSON_SCAN:
+            break;
+        }
+
+        switch (c)
+        {
+        case '{':
+        case '[':
+            if (js->depth == MAX_DEPTH)
+                return FALSE;
+
+            js->stack[js->depth++] = c;
+            js->expect_key = (c == '{');
+            g_string_truncate(js->key, 0);
+            break;
+
+        case '}':
+        case ']':
+            if ((js->depth == 0) ||
+                (js->stack[js->depth - 1] != ((c == '}') ? '{' : '[')))
+                return FALSE;
+
+            js->depth--;
+            js->expect_key = FALSE;
+            if (c == '}')
+                end_record(js->parser);
+            break;
+
+        case ',':
+            js->expect_key = (js->depth > 0) &&
+                (js->stack[js->depth - 1] == '{');
+            break;
+
+        case '"':
+            js->lex = JSON_STRING;
+            break;
+
+        case ':':
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+            break;
+
+        default:
+            js->lex = JSON_LITERAL;
+            g_string_append_c(js->token, c);
+            break;
+        }
+    }
+
+    return TRUE;
+}
+
+static gboolean read_json(FILE * fp, omm_parser_t * parser)
+{
+    json_state_t    js;
+    gchar          *buf;
+    gsize           len;
+    gboolean        ok = TRUE;
+
+    memset(&js, 0, sizeof(js));
+    js.parser = parser;
+    js.lex = JSON_SCAN;
+    js.key = g_string_new(NULL);
+    js.token = g_string_new(NULL);
+
+    buf = g_malloc(READ_CHUNK);
+    while (ok && (len = fread(buf, 1, READ_CHUNK, fp)) > 0)
+        ok = json_feed(&js, buf, len);
+
+    /* a literal at the very end has no delimiter */
+    if (ok && (js.lex == JSON_LITERAL))
+        json_token(&js, FALSE);
+
+    g_free(buf);
+    g_string_free(js.key, TRUE);
+    g_string_free(js.token, TRUE);
+
+    return ok && (js.depth == 0);
+}
+
+
+typedef struct {
+    omm_parser_t   *parser;
+    GString        *text;       /*!< Text of the current element */
+} xml_state_t;
+
+static void xml_start_element(GMarkupParseContext * context,
+                              const gchar * element_name,
+                              const gchar ** attribute_names,
+                              const gchar ** attribute_values,
+                              gpointer user_data, GError ** error)
+{
+    xml_state_t    *xs = (xml_state_t *) user_data;
+
+    (void)context;
+    (void)element_name;
+    (void)attribute_names;
+    (void)attribute_values;
+    (void)error;
+
+    g_string_truncate(xs->text, 0);
+}
+
+static void xml_end_element(GMarkupParseContext * context,
+                            const gchar * element_name,
+                            gpointer user_data, GError ** error)
+{
+    xml_state_t    *xs = (xml_state_t *) user_data;
+
+    (void)context;
+    (void)error;
+
+    if (!g_ascii_strcasecmp(element_name, "omm"))
+        end_record(xs->parser);
+    else if (xs->text->len > 0)
+        set_field(xs->parser, element_name, g_strstrip(xs->text->str));
+
+    g_string_truncate(xs->text, 0);
+}
+
+static void xml_text(GMarkupParseContext * context, const gchar * text,
+                     gsize text_len, gpointer user_data, GError ** error)
+{
+    xml_state_t    *xs = (xml_state_t *) user_data;
+
+    (void)context;
+    (void)error;
+
+    g_string_append_len(xs->text, text, text_len);
+}
+
+static gboolean read_xml(FILE * fp, omm_parser_t * parser)
+{
+    GMarkupParser   markup = {
+        xml_start_element, xml_end_element, xml_text, NULL, NULL
+    };
+    GMarkupParseContext *context;
+    xml_state_t     xs;
+    GError         *err = NULL;
+    gchar          *buf;
+    gsize           len;
+    gboolean        ok = TRUE;
+
+    xs.parser = parser;
+    xs.text = g_string_new(NULL);
+    context = g_markup_parse_context_new(&markup, 0, &xs, NULL);
+
+    buf = g_malloc(READ_CHUNK);
+    while (ok && (len = fread(buf, 1, READ_CHUNK, fp)) > 0)
+        ok = g_markup_parse_context_parse(context, buf, len, &err);
+
+    if (ok)
+        ok = g_markup_parse_context_end_parse(context, &err);
+
+    if (err != NULL)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Error parsing OMM XML (%s)"),
+                    __func__, err->message);
+        g_clear_error(&err);
+    }
+
+    g_free(buf);
+    g_markup_parse_context_free(context);
+    g_string_free(xs.text, TRUE);
+
+    return ok;
+}
+
+
+/*
+ * Split a CSV line in place.
+ *
+ * Quoted fields may contain commas and doubled quotes; fields can not span
+ * lines. Returns the number of fields.
+ */
+static gint split_csv(gchar * line, gchar ** fields, gint max)
+{
+    gchar          *p = line;
+    gchar          *out;
+    gint            n = 0;
+
+    while (n < max)
+    {
+        if (*p == '"')
+        {
+            fields[n] = out = ++p;
+            while (*p != '\0')
+            {
+                if (*p == '"')
+                {
+                    if (p[1] != '"')
+                    {
+                        p++;
+                        break;
+                    }
+                    p++;
+                }
+                *out++ = *p++;
+            }
+            *out = '\0';
+            while ((*p != '\0') && (*p != ','))
+                p++;
+        }
+        else
+        {
+            fields[n] = p;
+            while ((*p != '\0') && (*p != ','))
+                p++;
+        }
+        n++;
+
+        if (*p != ',')
+            break;
+        *p++ = '\0';
+    }
+
+    return n;
+}
+
+static gboolean read_csv(GIOChannel * chan, omm_parser_t * parser)
+{
+    GString        *line;
+    gchar          *fields[MAX_COLUMNS];
+    gchar         **header = NULL;
+    gint            ncols = 0, n, i;
+
+    line = g_string_new(NULL);
+
+    while (g_io_channel_read_line_string(chan, line, NULL, NULL) ==
+           G_IO_STATUS_NORMAL)
+    {
+        g_strchomp(line->str);
+        if (line->str[0] == '\0')
+            continue;
+
+        n = split_csv(line->str, fields, MAX_COLUMNS);
+
+        if (header == NULL)
+        {
+            header = g_new0(gchar *, n + 1);
+            for (i = 0; i < n; i++)
+                header[i] = g_strdup(g_strstrip(fields[i]));
+            ncols = n;
+            continue;
+        }
+
+        for (i = 0; i < MIN(n, ncols); i++)
+            if (fields[i][0] != '\0')
+                set_field(parser, header[i], fields[i]);
+        end_record(parser);
+    }
+
+    g_strfreev(header);
+    g_string_free(line, TRUE);
+
+    return (ncols > 0);
+}
+
+static gboolean read_kvn(GIOChannel * chan, omm_parser_t * parser)
+{
+    GString        *line;
+    gchar          *key, *value, *p;
+
+    line = g_string_new(NULL);
+
+    while (g_io_channel_read_line_string(chan, line, NULL, NULL) ==
+           G_IO_STATUS_NORMAL)
+    {
+        p = strchr(line->str, '=');
+        if (p == NULL)
+            continue;
+
+        *p = '\0';
+        key = g_strstrip(line->str);
+        value = g_strstrip(p + 1);
+
+        /* drop units, e.g. [rev/day] */
+        p = strchr(value, '[');
+        if (p != NULL)
+        {
+            *p = '\0';
+            g_strchomp(value);
+        }
+
+        /* each message starts with its version */
+        if (!strcmp(key, "CCSDS_OMM_VERS"))
+            end_record(parser);
+        else
+            set_field(parser, key, value);
+    }
+    end_record(parser);
+
+    g_string_free(line, TRUE);
+
+    return TRUE;
+}
+
+/**
+ * Detect whether a file holds OMM data.
+ *
+ * @param path The file.
+ * @return The encoding of the OMM data or OMM_FORMAT_NONE if the file is not
+ *         an OMM file or can not be read.
+ *
+ * Only the beginning of the file is inspected.
+ */
+omm_format_t omm_import_sniff(const gchar * path)
+{
+    FILE           *fp;
+    gchar           buf[SNIFF_SIZE + 1];
+    gchar          *p, *eol;
+    gsize           len;
+    omm_format_t    format = OMM_FORMAT_NONE;
+
+    fp = g_fopen(path, "rb");
+    if (fp == NULL)
+        return OMM_FORMAT_NONE;
+
+    len = fread(buf, 1, SNIFF_SIZE, fp);
+    fclose(fp);
+    buf[len] = '\0';
+
+    /* skip UTF-8 byte order mark and white space */
+    p = buf;
+    if (g_str_has_prefix(p, "\xef\xbb\xbf"))
+        p += 3;
+    while (g_ascii_isspace(*p))
+        p++;
+
+    eol = strchr(p, '\n');
+    if (eol == NULL)
+        eol = p + strlen(p);
+
+    if ((*p == '[') || (*p == '{'))
+        format = OMM_FORMAT_JSON;
+    else if ((*p == '<') && (strstr(p, "<omm") || strstr(p, "<OMM")))
+        format = OMM_FORMAT_XML;
+    else if (g_str_has_prefix(p, "CCSDS_OMM_VERS"))
+        format = OMM_FORMAT_KVN;
+    else if (g_strstr_len(p, eol - p, "NORAD_CAT_ID") &&
+             memchr(p, ',', eol - p))
+        format = OMM_FORMAT_CSV;
+
+    return format;
+}
+
+/**
+ * Import the element sets of an OMM file.
+ *
+ * @param path The file.
+ * @param callback Function called for each converted element set.
+ * @param data User data passed to the callback.
+ * @return The number of imported element sets or -1 if the file is not an OMM
+ *         file or could not be read.
+ *
+ * Messages that are incomplete or can not be represented as TLE are skipped.
+ * If a file is broken, the element sets read before the error are kept.
+ */
+gint omm_import_file(const gchar * path, omm_import_cb callback,
+                     gpointer data)
+{
+    omm_parser_t    parser;
+    omm_format_t    format;
+    GIOChannel     *chan;
+    GError         *err = NULL;
+    FILE           *fp;
+    gboolean        ok = FALSE;
+
+    format = omm_import_sniff(path);
+    if (format == OMM_FORMAT_NONE)
+        return -1;
+
+    memset(&parser, 0, sizeof(parser));
+    parser.callback = callback;
+    parser.data = data;
+
+    if ((format == OMM_FORMAT_JSON) || (format == OMM_FORMAT_XML))
+    {
+        fp = g_fopen(path, "rb");
+        if (fp == NULL)
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Failed to open %s"), __func__, path);
+            return -1;
+        }
+
+        if (format == OMM_FORMAT_JSON)
+            ok = read_json(fp, &parser);
+        else
+            ok = read_xml(fp, &parser);
+
+        fclose(fp);
+    }
+    else
+    {
+        chan = g_io_channel_new_file(path, "r", &err);
+        if (chan == NULL)
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Failed to open %s (%s)"),
+                        __func__, path, err->message);
+            g_clear_error(&err);
+            return -1;
+        }
+
+        /* the data is ASCII; skip the UTF-8 validation */
+        g_io_channel_set_encoding(chan, NULL, NULL);
+
+        if (format == OMM_FORMAT_CSV)
+            ok = read_csv(chan, &parser);
+        else
+            ok = read_kvn(chan, &parser);
+
+        g_io_channel_unref(chan);
+    }
+
+    if (!ok)
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: %s is not a valid OMM file"), __func__, path);
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Imported %d and skipped %d element sets from %s"),
+                __func__, parser.count, parser.skipped, path);
+
+    return parser.count;
+}
@@ -0,0 +1,31 @@
+#ifndef OMM_IMPORT_H
+#define OMM_IMPORT_H 1
+
+#include <glib.h>
+
+#include "sgpsdp/sgp4sdp4.h"
+
+/** Encodings of CCSDS Orbit Mean-Elements Messages. */
+typedef enum {
+    OMM_FORMAT_NONE = 0,        /*!< Not an OMM file, e.g. plain TLE. */
+    OMM_FORMAT_JSON,            /*!< JSON array of OMM objects. */
+    OMM_FORMAT_CSV,             /*!< CSV with a header row of OMM keywords. */
+    OMM_FORMAT_KVN,             /*!< Keyword = value notation. */
+    OMM_FORMAT_XML              /*!< OMM/NDM XML. */
+} omm_format_t;
+
+/**
+ * Callback receiving each imported element set.
+ *
+ * @param tle The converted elements.
+ * @param lines The satellite name and the equivalent TLE lines.
+ * @param data User data.
+ */
+typedef void    (*omm_import_cb) (tle_t * tle, gchar lines[3][80],
+                                  gpointer data);
+
+omm_format_t    omm_import_sniff(const gchar * path);
+gint            omm_import_file(const gchar * path, omm_import_cb callback,
+                                gpointer data);
+
+#endif
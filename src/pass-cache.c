@@ -0,0 +1,199 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Pass cache for the radio and rotator controllers.
+ *
+ * The cache holds the upcoming passes of one target satellite for a given
+ * observer. It is keyed on the catalog number and TLE epoch of the satellite,
+ * the observer position and the minimum pass elevation, and it follows the
+ * (possibly simulated) time passed to pass_cache_get(). Passes are predicted
+ * in a worker thread and the next passes are searched in the background while
+ * the last known pass is still ahead, so the caller never waits for a pass
+ * search to complete.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include "pass-cache.h"
+#include "sat-cfg.h"
+
+
+/* Look ahead of each search in days */
+#define PASS_CACHE_MAXDT    3.0
+
+/* Number of passes per search */
+#define PASS_CACHE_NUM      3
+
+/* Start a new search when fewer passes than this are left */
+#define PASS_CACHE_LOW      2
+
+
+struct _pass_cache {
+    gint            catnum;     /*!< Catalog number of the satellite */
+    gdouble         epoch;      /*!< TLE epoch of the satellite */
+    qth_small_t     qth;        /*!< Observer position */
+    gint            min_el;     /*!< Minimum pass elevation */
+    gboolean        valid;      /*!< Whether the key above is set */
+
+    GSList         *passes;     /*!< Known passes ordered by AOS */
+    gdouble         start;      /*!< Start of the time range covered */
+    gdouble         next;       /*!< Start time of the next search */
+    gdouble         horizon;    /*!< All passes before this time are known */
+
+    pass_search_t  *search;     /*!< Running search or NULL */
+    gdouble         search_start;       /*!< Start time of the running search */
+};
+
+
+pass_cache_t   *pass_cache_new(void)
+{
+    return g_new0(pass_cache_t, 1);
+}
+
+void pass_cache_free(pass_cache_t * cache)
+{
+    if (cache == NULL)
+        return;
+
+    pass_cache_clear(cache);
+    g_free(cache);
+}
+
+/** Drop all passes and cancel the running search. */
+void pass_cache_clear(pass_cache_t * cache)
+{
+    if (cache->search != NULL)
+    {
+        pass_search_cancel(cache->search);
+        cache->search = NULL;
+    }
+
+    free_passes(cache->passes);
+    cache->passes = NULL;
+    cache->valid = FALSE;
+}
+
+static void pass_found_cb(pass_t * pass, gpointer data)
+{
+    pass_cache_t   *cache = (pass_cache_t *) data;
+
+    /* passes arrive in chronological order */
+    cache->passes = g_slist_append(cache->passes, pass);
+    cache->next = pass->los + 0.014;    // +20 min, same as get_passes()
+    cache->horizon = cache->next;
+}
+
+static void pass_done_cb(guint count, gpointer data)
+{
+    pass_cache_t   *cache = (pass_cache_t *) data;
+
+    /* the search handle is no longer valid */
+    cache->search = NULL;
+
+    /* if the search ended early there are no more passes
+       within the look ahead time of the search */
+    if (count < PASS_CACHE_NUM)
+    {
+        cache->horizon = MAX(cache->next,
+                             cache->search_start + PASS_CACHE_MAXDT);
+        cache->next = cache->horizon;
+    }
+}
+
+static gboolean key_matches(pass_cache_t * cache, sat_t * sat, qth_t * qth,
+                            gint min_el)
+{
+    return (cache->valid &&
+            cache->catnum == sat->tle.catnr &&
+            cache->epoch == sat->jul_epoch &&
+            cache->qth.lat == qth->lat &&
+            cache->qth.lon == qth->lon &&
+            cache->qth.alt == qth->alt && cache->min_el == min_el);
+}
+
+/**
+ * Get the current or next pass of a satellite.
+ *
+ * @param cache The pass cache of the caller.
+ * @param sat The satellite.
+ * @param qth The observer position.
+ * @param t The current (real or simulated) time.
+ * @return A newly allocated copy of the pass in progress at time t or of the
+ *         next pass after t. NULL is returned if the pass is not yet known or
+ *         there is no pass within the look ahead time.
+ *
+ * The cache is reset when the satellite, its TLE, the observer or the time
+ * range changes, so this function can be called with any of these changing
+ * between calls. Use free_pass() to free the returned pass.
+ */
+pass_t         *pass_cache_get(pass_cache_t * cache, sat_t * sat,
+                               qth_t * qth, gdouble t)
+{
+    gint            min_el = sat_cfg_get_int(SAT_CFG_INT_PRED_MIN_EL);
+
+    if (!key_matches(cache, sat, qth, min_el) ||
+        (t < cache->start) || (t > cache->horizon + PASS_CACHE_MAXDT))
+    {
+        pass_cache_clear(cache);
+
+        cache->catnum = sat->tle.catnr;
+        cache->epoch = sat->jul_epoch;
+        qth_small_save(qth, &cache->qth);
+        cache->min_el = min_el;
+        cache->valid = TRUE;
+        cache->start = t;
+        cache->next = t;
+        cache->horizon = t;
+    }
+
+    /* drop passes that have ended */
+    while (cache->passes != NULL && PASS(cache->passes->data)->los < t)
+    {
+        free_pass(PASS(cache->passes->data));
+        cache->passes = g_slist_delete_link(cache->passes, cache->passes);
+        cache->start = t;
+    }
+
+    /* nothing is known after the horizon; search from now */
+    if (cache->search == NULL && cache->next < t)
+    {
+        cache->next = t;
+        cache->horizon = t;
+        cache->start = t;
+    }
+
+    /* fetch the following passes while the last one is still ahead */
+    if (cache->search == NULL &&
+        g_slist_length(cache->passes) < PASS_CACHE_LOW &&
+        cache->horizon - t < PASS_CACHE_MAXDT)
+    {
+        cache->search_start = cache->next;
+        cache->search = get_passes_async(sat, qth, cache->next,
+                                         PASS_CACHE_MAXDT, PASS_CACHE_NUM,
+                                         pass_found_cb, pass_done_cb, cache);
+    }
+
+    if (cache->passes == NULL)
+        return NULL;
+
+    return copy_pass(PASS(cache->passes->data));
+}
@@ -0,0 +1,19 @@
+#ifndef PASS_CACHE_H
+#define PASS_CACHE_H 1
+
+#include <glib.h>
+
+#include "predict-tools.h"
+#include "qth-data.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/** Opaque pass cache handle. */
+typedef struct _pass_cache pass_cache_t;
+
+pass_cache_t   *pass_cache_new(void);
+void            pass_cache_free(pass_cache_t * cache);
+void            pass_cache_clear(pass_cache_t * cache);
+pass_t         *pass_cache_get(pass_cache_t * cache, sat_t * sat,
+                               qth_t * qth, gdouble t);
+
+#endif
@@ -0,0 +1,594 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Dialog for searching the passes of all satellites in a module, either at
+ * the ground station of the module or along a planned route.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <gtk/gtk.h>
+
+#include "compat.h"
+#include "pass-query.h"
+#include "pass-query-dialog.h"
+#include "sat-cfg.h"
+#include "sat-log.h"
+#include "sat-pass-dialogs.h"
+#include "time-tools.h"
+
+
+#define RESPONSE_SEARCH 1
+
+/** Result list columns. */
+enum {
+    PQ_COL_SAT = 0,
+    PQ_COL_AOS,
+    PQ_COL_LOS,
+    PQ_COL_DURATION,
+    PQ_COL_MAX_EL,
+    PQ_COL_AOS_AZ,
+    PQ_COL_LOS_AZ,
+    PQ_COL_VIS,
+    PQ_COL_PASS,                /* pass_t pointer; not shown */
+    PQ_COL_NUM
+};
+
+static const gchar *PQ_COL_TITLE[PQ_COL_PASS] = {
+    N_("Satellite"), N_("AOS"), N_("LOS"), N_("Duration"), N_("Max El"),
+    N_("AOS Az"), N_("LOS Az"), N_("Vis")
+};
+
+/** Dialog data, attached to the dialog. */
+typedef struct {
+    GtkSatModule   *module;     /*!< The module whose satellites are searched */
+    GtkWidget      *toplevel;   /*!< Parent of the pass details dialogs */
+    GtkWidget      *hours;      /*!< Time window */
+    GtkWidget      *minel;      /*!< Minimum max elevation */
+    GtkWidget      *mindur;     /*!< Minimum duration */
+    GtkWidget      *maxdur;     /*!< Maximum duration */
+    GtkWidget      *aosaz[2];   /*!< AOS azimuth window */
+    GtkWidget      *losaz[2];   /*!< LOS azimuth window */
+    GtkWidget      *sun;        /*!< Sunlight condition */
+    GtkWidget      *routefile;  /*!< Route file chooser */
+    route_t        *route;      /*!< Route of the observer or NULL */
+    GtkWidget      *list;       /*!< Result list */
+    GtkWidget      *spinner;    /*!< Search indicator */
+    GtkWidget      *status;     /*!< Search status */
+    GSList         *passes;     /*!< Passes shown in the list */
+    pass_query_run_t *run;      /*!< Running query or NULL */
+} pass_query_dialog_t;
+
+
+static void time_cell_data_function(GtkTreeViewColumn * col,
+                                    GtkCellRenderer * renderer,
+                                    GtkTreeModel * model,
+                                    GtkTreeIter * iter, gpointer column)
+{
+    gdouble         number;
+    gchar           buff[TIME_FORMAT_MAX_LENGTH];
+    gchar          *fmtstr;
+
+    (void)col;
+
+    gtk_tree_model_get(model, iter, GPOINTER_TO_UINT(column), &number, -1);
+
+    fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
+    daynum_to_str(buff, TIME_FORMAT_MAX_LENGTH, fmtstr, number);
+    g_object_set(renderer, "text", buff, NULL);
+    g_free(fmtstr);
+}
+
+static void duration_cell_data_function(GtkTreeViewColumn * col,
+                                        GtkCellRenderer * renderer,
+                                        GtkTreeModel * model,
+                                        GtkTreeIter * iter, gpointer column)
+{
+    gdouble         number;
+    gchar          *buff;
+    guint           s;
+
+    (void)col;
+
+    gtk_tree_model_get(model, iter, GPOINTER_TO_UINT(column), &number, -1);
+
+    s = (guint) (number * 86400);
+    buff = g_strdup_printf("%02d:%02d:%02d", s / 3600, (s / 60) % 60, s % 60);
+    g_object_set(renderer, "text", buff, NULL);
+    g_free(buff);
+}
+
+static void degree_cell_data_function(GtkTreeViewColumn * col,
+                                      GtkCellRenderer * renderer,
+                                      GtkTreeModel * model,
+                                      GtkTreeIter * iter, gpointer column)
+{
+    gdouble         number;
+    gchar          *buff;
+
+    (void)col;
+
+    gtk_tree_model_get(model, iter, GPOINTER_TO_UINT(column), &number, -1);
+
+    buff = g_strdup_printf("%.2f\302\260", number);
+    g_object_set(renderer, "text", buff, "xalign", 1.0, NULL);
+    g_free(buff);
+}
+
+/* Show the details of a pass when its row is activated */
+static void row_activated_cb(GtkTreeView * treeview, GtkTreePath * path,
+                             GtkTreeViewColumn * column, gpointer data)
+{
+    pass_query_dialog_t *pqd = (pass_query_dialog_t *) data;
+    GtkTreeModel   *model;
+    GtkTreeIter     iter;
+    pass_t         *pass;
+
+    (void)column;
+
+    model = gtk_tree_view_get_model(treeview);
+    if (!gtk_tree_model_get_iter(model, &iter, path))
+        return;
+
+    gtk_tree_model_get(model, &iter, PQ_COL_PASS, &pass, -1);
+    show_pass(pass->satname, pqd->module->qth, copy_pass(pass),
+              pqd->toplevel);
+}
+
+static GtkWidget *create_result_list(pass_query_dialog_t * pqd)
+{
+    GtkWidget      *list;
+    GtkListStore   *store;
+    GtkCellRenderer *renderer;
+    GtkTreeViewColumn *column;
+    guint           i;
+
+    store = gtk_list_store_new(PQ_COL_NUM, G_TYPE_STRING,
+                               G_TYPE_DOUBLE, G_TYPE_DOUBLE, G_TYPE_DOUBLE,
+                               G_TYPE_DOUBLE, G_TYPE_DOUBLE, G_TYPE_DOUBLE,
+                               G_TYPE_STRING, G_TYPE_POINTER);
+
+    list = gtk_tree_view_new_with_model(GTK_TREE_MODEL(store));
+    g_object_unref(store);
+
+    for (i = 0; i < PQ_COL_PASS; i++)
+    {
+        renderer = gtk_cell_renderer_text_new();
+        column = gtk_tree_view_column_new_with_attributes(_(PQ_COL_TITLE[i]),
+                                                          renderer, "text",
+                                                          i, NULL);
+        gtk_tree_view_column_set_alignment(column, 0.5);
+        gtk_tree_view_column_set_sort_column_id(column, i);
+        gtk_tree_view_append_column(GTK_TREE_VIEW(list), column);
+
+        switch (i)
+        {
+        case PQ_COL_AOS:
+        case PQ_COL_LOS:
+            gtk_tree_view_column_set_cell_data_func(column, renderer,
+                                                    time_cell_data_function,
+                                                    GUINT_TO_POINTER(i),
+                                                    NULL);
+            break;
+
+        case PQ_COL_DURATION:
+            gtk_tree_view_column_set_cell_data_func(column, renderer,
+                                                    duration_cell_data_function,
+                                                    GUINT_TO_POINTER(i),
+                                                    NULL);
+            break;
+
+        case PQ_COL_MAX_EL:
+        case PQ_COL_AOS_AZ:
+        case PQ_COL_LOS_AZ:
+            gtk_tree_view_column_set_cell_data_func(column, renderer,
+                                                    degree_cell_data_function,
+                                                    GUINT_TO_POINTER(i),
+                                                    NULL);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    g_signal_connect(list, "row-activated", G_CALLBACK(row_activated_cb),
+                     pqd);
+
+    return list;
+}
+
+/* Read the route selected in the file chooser */
+static void route_set_cb(GtkFileChooserButton * button, gpointer data)
+{
+    pass_query_dialog_t *pqd = (pass_query_dialog_t *) data;
+    GtkWidget      *dialog;
+    gchar          *fname;
+    gchar          *text;
+    gchar           tstart[TIME_FORMAT_MAX_LENGTH];
+    gchar           tend[TIME_FORMAT_MAX_LENGTH];
+    gchar          *fmtstr;
+
+    route_unref(pqd->route);
+    pqd->route = NULL;
+
+    fname = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(button));
+    if (fname != NULL)
+        pqd->route = route_read(fname);
+
+    if (fname != NULL && pqd->route == NULL)
+    {
+        gtk_file_chooser_unselect_all(GTK_FILE_CHOOSER(button));
+        dialog = gtk_message_dialog_new(GTK_WINDOW
+                                        (gtk_widget_get_toplevel
+                                         (GTK_WIDGET(button))),
+                                        GTK_DIALOG_MODAL |
+                                        GTK_DIALOG_DESTROY_WITH_PARENT,
+                                        GTK_MESSAGE_ERROR, GTK_BUTTONS_OK,
+                                        _("Could not read a route from %s.\n"
+                                          "Check the log for details."),
+                                        fname);
+        gtk_dialog_run(GTK_DIALOG(dialog));
+        gtk_widget_destroy(dialog);
+    }
+
+    g_free(fname);
+
+    /* the route determines the time window */
+    gtk_widget_set_sensitive(pqd->hours, pqd->route == NULL);
+
+    if (pqd->route != NULL)
+    {
+        fmtstr = sat_cfg_get_str(SAT_CFG_STR_TIME_FORMAT);
+        daynum_to_str(tstart, TIME_FORMAT_MAX_LENGTH, fmtstr,
+                      route_start(pqd->route));
+        daynum_to_str(tend, TIME_FORMAT_MAX_LENGTH, fmtstr,
+                      route_end(pqd->route));
+        g_free(fmtstr);
+
+        text = g_strdup_printf(_("Route with %d points from %s to %s"),
+                               pqd->route->points->len, tstart, tend);
+        gtk_label_set_text(GTK_LABEL(pqd->status), text);
+        g_free(text);
+    }
+}
+
+static void route_clear_cb(GtkButton * button, gpointer data)
+{
+    pass_query_dialog_t *pqd = (pass_query_dialog_t *) data;
+
+    (void)button;
+
+    gtk_file_chooser_unselect_all(GTK_FILE_CHOOSER(pqd->routefile));
+    route_set_cb(GTK_FILE_CHOOSER_BUTTON(pqd->routefile), pqd);
+    gtk_label_set_text(GTK_LABEL(pqd->status), NULL);
+}
+
+static GtkWidget *create_spin(gdouble min, gdouble max, gdouble step,
+                              gdouble value)
+{
+    GtkWidget      *spin;
+
+    spin = gtk_spin_button_new_with_range(min, max, step);
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(spin), 0);
+    gtk_spin_button_set_numeric(GTK_SPIN_BUTTON(spin), TRUE);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin), value);
+
+    return spin;
+}
+
+/* Add a row with a label, one or two spin buttons and a unit to the grid */
+static void add_filter_row(GtkGrid * grid, gint row, const gchar * text,
+                           GtkWidget * spin1, GtkWidget * spin2,
+                           const gchar * unit)
+{
+    GtkWidget      *label;
+
+    label = gtk_label_new(text);
+    g_object_set(label, "xalign", 0.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(grid, label, 0, row, 1, 1);
+    gtk_grid_attach(grid, spin1, 1, row, 1, 1);
+
+    if (spin2 != NULL)
+    {
+        gtk_grid_attach(grid, gtk_label_new("\342\200\223"), 2, row, 1, 1);
+        gtk_grid_attach(grid, spin2, 3, row, 1, 1);
+    }
+
+    label = gtk_label_new(unit);
+    g_object_set(label, "xalign", 0.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(grid, label, 4, row, 1, 1);
+}
+
+static GtkWidget *create_filters(pass_query_dialog_t * pqd)
+{
+    GtkWidget      *grid;
+    GtkWidget      *label;
+    GtkWidget      *button;
+    GtkFileFilter  *filter;
+
+    grid = gtk_grid_new();
+    gtk_grid_set_row_spacing(GTK_GRID(grid), 5);
+    gtk_grid_set_column_spacing(GTK_GRID(grid), 5);
+
+    pqd->hours = create_spin(1, 336, 1, 48);
+    add_filter_row(GTK_GRID(grid), 0, _("Passes within the next"),
+                   pqd->hours, NULL, _("[hours]"));
+
+    pqd->minel = create_spin(0, 90, 1,
+                             sat_cfg_get_int(SAT_CFG_INT_PRED_MIN_EL));
+    add_filter_row(GTK_GRID(grid), 1, _("Maximum elevation at least"),
+                   pqd->minel, NULL, _("[deg]"));
+
+    pqd->mindur = create_spin(0, 1440, 1, 0);
+    pqd->maxdur = create_spin(0, 1440, 1, 0);
+    gtk_widget_set_tooltip_text(pqd->maxdur, _("Use 0 for no upper limit"));
+    add_filter_row(GTK_GRID(grid), 2, _("Duration"),
+                   pqd->mindur, pqd->maxdur, _("[min]"));
+
+    pqd->aosaz[0] = create_spin(0, 360, 1, 0);
+    pqd->aosaz[1] = create_spin(0, 360, 1, 0);
+    gtk_widget_set_tooltip_text(pqd->aosaz[0],
+                                _("Clockwise azimuth window, e.g. 315 to 45 "
+                                  "for north.\nUse the same value twice for "
+                                  "any azimuth."));
+    add_filter_row(GTK_GRID(grid), 3, _("AOS azimuth"),
+                   pqd->aosaz[0], pqd->aosaz[1], _("[deg]"));
+
+    pqd->losaz[0] = create_spin(0, 360, 1, 0);
+    pqd->losaz[1] = create_spin(0, 360, 1, 0);
+    gtk_widget_set_tooltip_text(pqd->losaz[0],
+                                _("Clockwise azimuth window, e.g. 315 to 45 "
+                                  "for north.\nUse the same value twice for "
+                                  "any azimuth."));
+    add_filter_row(GTK_GRID(grid), 4, _("LOS azimuth"),
+                   pqd->losaz[0], pqd->losaz[1], _("[deg]"));
+
+    label = gtk_label_new(_("Sunlight"));
+    g_object_set(label, "xalign", 0.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(grid), label, 0, 5, 1, 1);
+    pqd->sun = gtk_combo_box_text_new();
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(pqd->sun), _("Any"));
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(pqd->sun),
+                                   _("Satellite in sunlight"));
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(pqd->sun),
+                                   _("Satellite visible"));
+    gtk_combo_box_set_active(GTK_COMBO_BOX(pqd->sun), PASS_QUERY_SUN_ANY);
+    gtk_grid_attach(GTK_GRID(grid), pqd->sun, 1, 5, 3, 1);
+
+    label = gtk_label_new(_("Route"));
+    g_object_set(label, "xalign", 0.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(grid), label, 0, 6, 1, 1);
+    pqd->routefile = gtk_file_chooser_button_new(_("Select route"),
+                                                 GTK_FILE_CHOOSER_ACTION_OPEN);
+    filter = gtk_file_filter_new();
+    gtk_file_filter_set_name(filter, _("Routes (*.gpx, *.csv)"));
+    gtk_file_filter_add_pattern(filter, "*.gpx");
+    gtk_file_filter_add_pattern(filter, "*.GPX");
+    gtk_file_filter_add_pattern(filter, "*.csv");
+    gtk_file_filter_add_pattern(filter, "*.CSV");
+    gtk_file_chooser_add_filter(GTK_FILE_CHOOSER(pqd->routefile), filter);
+    gtk_widget_set_tooltip_text(pqd->routefile,
+                                _("Predict the passes along a planned route "
+                                  "instead of at the ground station.\n"
+                                  "The route is a GPX file or a CSV file "
+                                  "with time, latitude, longitude and "
+                                  "optional altitude on each line."));
+    g_signal_connect(pqd->routefile, "file-set", G_CALLBACK(route_set_cb),
+                     pqd);
+    gtk_grid_attach(GTK_GRID(grid), pqd->routefile, 1, 6, 3, 1);
+
+    button = gtk_button_new_with_label(_("Clear"));
+    g_signal_connect(button, "clicked", G_CALLBACK(route_clear_cb), pqd);
+    gtk_grid_attach(GTK_GRID(grid), button, 4, 6, 1, 1);
+
+    return grid;
+}
+
+static gdouble spin_value(GtkWidget * spin)
+{
+    return gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin));
+}
+
+/* Show the result of a query */
+static void query_done(GSList * passes, gpointer data)
+{
+    pass_query_dialog_t *pqd = (pass_query_dialog_t *) data;
+    GtkListStore   *store;
+    GtkTreeIter     iter;
+    GSList         *node;
+    pass_t         *pass;
+    gchar          *text;
+
+    pqd->run = NULL;
+    pqd->passes = passes;
+
+    store = GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(pqd->list)));
+    for (node = passes; node != NULL; node = node->next)
+    {
+        pass = PASS(node->data);
+        gtk_list_store_append(store, &iter);
+        gtk_list_store_set(store, &iter,
+                           PQ_COL_SAT, pass->satname,
+                           PQ_COL_AOS, pass->aos,
+                           PQ_COL_LOS, pass->los,
+                           PQ_COL_DURATION, pass->los - pass->aos,
+                           PQ_COL_MAX_EL, pass->max_el,
+                           PQ_COL_AOS_AZ, pass->aos_az,
+                           PQ_COL_LOS_AZ, pass->los_az,
+                           PQ_COL_VIS, pass->vis,
+                           PQ_COL_PASS, pass, -1);
+    }
+
+    gtk_spinner_stop(GTK_SPINNER(pqd->spinner));
+    gtk_widget_hide(pqd->spinner);
+
+    text = g_strdup_printf(g_dngettext(NULL, "%d pass found",
+                                       "%d passes found",
+                                       g_slist_length(passes)),
+                           g_slist_length(passes));
+    gtk_label_set_text(GTK_LABEL(pqd->status), text);
+    g_free(text);
+}
+
+static void start_query(pass_query_dialog_t * pqd)
+{
+    pass_query_t    query;
+    gdouble         start;
+
+    if (pqd->run != NULL)
+        pass_query_cancel(pqd->run);
+
+    gtk_list_store_clear(GTK_LIST_STORE
+                         (gtk_tree_view_get_model(GTK_TREE_VIEW(pqd->list))));
+    free_passes(pqd->passes);
+    pqd->passes = NULL;
+
+    if (pqd->route != NULL)
+    {
+        pass_query_init(&query, route_start(pqd->route),
+                        route_end(pqd->route) - route_start(pqd->route));
+        query.route = pqd->route;
+    }
+    else
+    {
+        if (sat_cfg_get_bool(SAT_CFG_BOOL_PRED_USE_REAL_T0))
+            start = get_current_daynum();
+        else
+            start = pqd->module->tmgCdnum;
+
+        pass_query_init(&query, start, spin_value(pqd->hours) / 24.0);
+    }
+
+    query.min_el = spin_value(pqd->minel);
+    query.min_dur = spin_value(pqd->mindur);
+    query.max_dur = spin_value(pqd->maxdur);
+    query.aos_az_min = spin_value(pqd->aosaz[0]);
+    query.aos_az_max = spin_value(pqd->aosaz[1]);
+    query.los_az_min = spin_value(pqd->losaz[0]);
+    query.los_az_max = spin_value(pqd->losaz[1]);
+    query.sun = gtk_combo_box_get_active(GTK_COMBO_BOX(pqd->sun));
+
+    gtk_label_set_text(GTK_LABEL(pqd->status), _("Predicting passes..."));
+    gtk_widget_show(pqd->spinner);
+    gtk_spinner_start(GTK_SPINNER(pqd->spinner));
+
+    pqd->run = pass_query_start(&query, pqd->module->satellites,
+                                pqd->module->qth, query_done, pqd);
+}
+
+static void response_cb(GtkWidget * dialog, gint response, gpointer data)
+{
+    pass_query_dialog_t *pqd = (pass_query_dialog_t *) data;
+
+    if (response == RESPONSE_SEARCH)
+        start_query(pqd);
+    else
+        gtk_widget_destroy(dialog);
+}
+
+static void destroy_cb(GtkWidget * dialog, gpointer data)
+{
+    pass_query_dialog_t *pqd = (pass_query_dialog_t *) data;
+
+    (void)dialog;
+
+    /* the callback will not be invoked */
+    if (pqd->run != NULL)
+        pass_query_cancel(pqd->run);
+    pqd->run = NULL;
+
+    free_passes(pqd->passes);
+    pqd->passes = NULL;
+
+    route_unref(pqd->route);
+    pqd->route = NULL;
+}
+
+/**
+ * Show the pass search dialog of a module.
+ *
+ * @param module The module whose satellites are searched.
+ * @param toplevel The toplevel window or NULL.
+ *
+ * The dialog is destroyed together with the module.
+ */
+void show_pass_query_dialog(GtkSatModule * module, GtkWidget * toplevel)
+{
+    pass_query_dialog_t *pqd;
+    GtkWidget      *dialog;
+    GtkWidget      *content;
+    GtkWidget      *swin;
+    GtkWidget      *hbox;
+    gchar          *buff;
+
+    pqd = g_new0(pass_query_dialog_t, 1);
+    pqd->module = module;
+    pqd->toplevel = toplevel;
+
+    buff = g_strdup_printf(_("Search passes (%s)"), module->name);
+    dialog = gtk_dialog_new_with_buttons(buff,
+                                         GTK_WINDOW(toplevel),
+                                         GTK_DIALOG_DESTROY_WITH_PARENT,
+                                         "_Search", RESPONSE_SEARCH,
+                                         "_Close", GTK_RESPONSE_CLOSE, NULL);
+    g_free(buff);
+    gtk_dialog_set_default_response(GTK_DIALOG(dialog), RESPONSE_SEARCH);
+    gtk_window_set_modal(GTK_WINDOW(dialog), FALSE);
+    gtk_window_set_default_size(GTK_WINDOW(dialog), -1, 500);
+
+    buff = icon_file_name("gpredict-planner.png");
+    gtk_window_set_icon_from_file(GTK_WINDOW(dialog), buff, NULL);
+    g_free(buff);
+
+    g_object_set_data_full(G_OBJECT(dialog), "query", pqd, g_free);
+    g_signal_connect(dialog, "response", G_CALLBACK(response_cb), pqd);
+    g_signal_connect(dialog, "destroy", G_CALLBACK(destroy_cb), pqd);
+
+    /* the dialog uses the satellites and the QTH of the module */
+    g_signal_connect_object(module, "destroy",
+                            G_CALLBACK(gtk_widget_destroy), dialog,
+                            G_CONNECT_SWAPPED);
+
+    content = gtk_dialog_get_content_area(GTK_DIALOG(dialog));
+    gtk_container_set_border_width(GTK_CONTAINER(content), 5);
+    gtk_box_pack_start(GTK_BOX(content), create_filters(pqd), FALSE, FALSE,
+                       5);
+
+    pqd->spinner = gtk_spinner_new();
+    pqd->status = gtk_label_new(NULL);
+    hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+    gtk_box_pack_start(GTK_BOX(hbox), pqd->spinner, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(hbox), pqd->status, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(content), hbox, FALSE, FALSE, 5);
+
+    pqd->list = create_result_list(pqd);
+    swin = gtk_scrolled_window_new(NULL, NULL);
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(swin),
+                                   GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+    gtk_container_add(GTK_CONTAINER(swin), pqd->list);
+    gtk_box_pack_start(GTK_BOX(content), swin, TRUE, TRUE, 0);
+
+    gtk_widget_show_all(dialog);
+    gtk_widget_hide(pqd->spinner);
+}
@@ -0,0 +1,11 @@
+#ifndef PASS_QUERY_DIALOG_H
+#define PASS_QUERY_DIALOG_H 1
+
+#include <gtk/gtk.h>
+
+#include "gtk-sat-module.h"
+
+void            show_pass_query_dialog(GtkSatModule * module,
+                                       GtkWidget * toplevel);
+
+#endif
@@ -0,0 +1,366 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Pass queries across satellites.
+ *
+ * A query selects the passes of a set of satellites within a time window
+ * by maximum elevation, duration, AOS and LOS azimuth and sunlight. Satellites
+ * that can not reach the requested elevation at the observer are skipped
+ * using their inclination and apogee, the remaining satellites are searched
+ * in parallel by a thread pool; queries for visible passes only search the
+ * dark windows of the observer. Queries with a route predict the passes
+ * along the route instead of at the fixed observer. The matching passes are delivered to the
+ * main loop sorted by AOS when all searches have completed.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <string.h>
+
+#include "orbit-tools.h"
+#include "pass-query.h"
+#include "sat-log.h"
+#include "vis-pass.h"
+
+
+struct _pass_query_run {
+    pass_query_t    query;      /*!< Copy of the query */
+    qth_t           qth;        /*!< Observer position */
+    GThreadPool    *pool;       /*!< Pass search threads */
+    gint            pending;    /*!< Number of unfinished jobs (atomic) */
+    gint            cancelled;  /*!< Set when the query is cancelled (atomic) */
+    GMutex          lock;       /*!< Protects passes */
+    GSList         *passes;     /*!< Matching passes */
+    pass_query_done_fn done;    /*!< Completion callback */
+    gpointer        data;       /*!< User data of the callback */
+};
+
+
+/**
+ * Initialise a query that matches all passes in a time window.
+ *
+ * @param query The query.
+ * @param start Start of the time window (Julian Date).
+ * @param maxdt Length of the time window in days.
+ */
+void pass_query_init(pass_query_t * query, gdouble start, gdouble maxdt)
+{
+    query->start = start;
+    query->maxdt = maxdt;
+    query->min_el = 0.0;
+    query->min_dur = 0.0;
+    query->max_dur = 0.0;
+    query->aos_az_min = 0.0;
+    query->aos_az_max = 0.0;
+    query->los_az_min = 0.0;
+    query->los_az_max = 0.0;
+    query->sun = PASS_QUERY_SUN_ANY;
+    query->route = NULL;
+}
+
+/**
+ * Check whether a satellite can have passes matching a query.
+ *
+ * This is a cheap test based on the orbit only. The satellite can not reach
+ * the minimum elevation if the observer is farther from the highest latitude
+ * of the ground track than the radius of the circle around the sub-satellite
+ * point where the satellite is seen above that elevation at apogee.
+ */
+gboolean pass_query_may_match(const pass_query_t * query, sat_t * sat,
+                              qth_t * qth)
+{
+    gdouble         incl, sma, apogee, el, lambda;
+
+    /* also excludes geostationary and decayed satellites */
+    if (!has_aos(sat, qth))
+        return FALSE;
+
+    if (query->min_el <= 0.0)
+        return TRUE;
+
+    /* highest latitude of the ground track; xincl is in rad */
+    incl = sat->tle.xincl;
+    if (incl >= pio2)
+        incl = pi - incl;
+
+    /* same as in has_aos() */
+    sma = 331.25 * exp(log(1440.0 / sat->meanmo) * (2.0 / 3.0));
+    apogee = sma * (1.0 + sat->tle.eo) - xkmper;
+
+    /* Earth central angle of the coverage circle for the min elevation */
+    el = query->min_el * de2ra;
+    lambda = acos(xkmper * cos(el) / (xkmper + apogee)) - el;
+
+    return (fabs(qth->lat * de2ra) - incl <= lambda);
+}
+
+/* Check whether az is in the clockwise window [min;max] */
+static gboolean az_in_window(gdouble az, gdouble min, gdouble max)
+{
+    if (min == max)
+        return TRUE;
+
+    if (min < max)
+        return (az >= min && az <= max);
+
+    /* window through north */
+    return (az >= min || az <= max);
+}
+
+/** Check whether a pass matches a query. */
+gboolean pass_query_match(const pass_query_t * query, pass_t * pass)
+{
+    gdouble         dur = (pass->los - pass->aos) * xmnpda;
+
+    if (pass->max_el < query->min_el)
+        return FALSE;
+
+    if (dur < query->min_dur)
+        return FALSE;
+
+    if (query->max_dur > 0.0 && dur > query->max_dur)
+        return FALSE;
+
+    if (!az_in_window(pass->aos_az, query->aos_az_min, query->aos_az_max))
+        return FALSE;
+
+    if (!az_in_window(pass->los_az, query->los_az_min, query->los_az_max))
+        return FALSE;
+
+    switch (query->sun)
+    {
+    case PASS_QUERY_SUN_LIT:
+        return (pass->vis[0] == 'V' || pass->vis[1] == 'D');
+
+    case PASS_QUERY_SUN_VISIBLE:
+        return (pass->vis[0] == 'V');
+
+    default:
+        return TRUE;
+    }
+}
+
+static gint pass_aos_compare(gconstpointer a, gconstpointer b)
+{
+    gdouble         aos_a = PASS(a)->aos;
+    gdouble         aos_b = PASS(b)->aos;
+
+    return (aos_a < aos_b) ? -1 : ((aos_a > aos_b) ? 1 : 0);
+}
+
+static gboolean pass_query_deliver(gpointer data)
+{
+    pass_query_run_t *run = (pass_query_run_t *) data;
+
+    /* all jobs have completed, so this does not block */
+    if (run->pool != NULL)
+        g_thread_pool_free(run->pool, FALSE, TRUE);
+
+    if (g_atomic_int_get(&run->cancelled))
+    {
+        free_passes(run->passes);
+    }
+    else
+    {
+        run->passes = g_slist_sort(run->passes, pass_aos_compare);
+        run->done(run->passes, run->data);
+    }
+
+    route_unref(run->query.route);
+    g_mutex_clear(&run->lock);
+    g_free(run);
+
+    return FALSE;
+}
+
+/* Search the passes of one satellite; called from the thread pool */
+static void pass_query_job(gpointer data, gpointer user_data)
+{
+    sat_t          *sat = SAT(data);
+    pass_query_run_t *run = (pass_query_run_t *) user_data;
+    pass_query_t   *query = &run->query;
+    GSList         *passes = NULL;
+    GSList         *node, *next;
+    pass_t         *pass;
+    gdouble         end = query->start + query->maxdt;
+    gdouble         t = query->start;
+
+    if (query->route != NULL)
+    {
+        passes = get_route_passes(sat, query->route, query->start,
+                                  query->maxdt, MAX(query->min_el, 0.0),
+                                  &run->cancelled);
+    }
+    /* only search the dark windows for visible passes */
+    else if (query->sun == PASS_QUERY_SUN_VISIBLE)
+    {
+        passes = get_visible_passes(sat, &run->qth, query->start,
+                                    query->maxdt, MAX(query->min_el, 0.0), 0,
+                                    &run->cancelled);
+    }
+    else
+    {
+        while (t < end && !g_atomic_int_get(&run->cancelled))
+        {
+            pass = get_pass_min_el(sat, &run->qth, t, end - t,
+                                   MAX(query->min_el, 0.0));
+            if (pass == NULL)
+                break;
+
+            t = pass->los + 0.014;      // +20 min, same as get_passes()
+
+            passes = g_slist_prepend(passes, pass);
+        }
+    }
+
+    for (node = passes; node != NULL; node = next)
+    {
+        next = node->next;
+        if (!pass_query_match(query, PASS(node->data)))
+        {
+            free_pass(PASS(node->data));
+            passes = g_slist_delete_link(passes, node);
+        }
+    }
+
+    if (passes != NULL)
+    {
+        g_mutex_lock(&run->lock);
+        run->passes = g_slist_concat(passes, run->passes);
+        g_mutex_unlock(&run->lock);
+    }
+
+    g_free(sat->name);
+    g_free(sat->nickname);
+    g_free(sat->website);
+    g_free(sat);
+
+    if (g_atomic_int_dec_and_test(&run->pending))
+        g_idle_add(pass_query_deliver, run);
+}
+
+/**
+ * Run a pass query in the background.
+ *
+ * @param query The query; it is copied.
+ * @param sats The satellites to search (catnum -> sat_t).
+ * @param qth The observer.
+ * @param done Function called in the main loop with the result.
+ * @param data User data passed to the callback.
+ * @return A handle that can be used to cancel the query. It becomes invalid
+ *         when the done callback has been invoked or the query has been
+ *         cancelled.
+ *
+ * Neither sats nor qth are accessed after this function returns. The route
+ * of the query is referenced until the query has completed.
+ */
+pass_query_run_t *pass_query_start(const pass_query_t * query,
+                                   GHashTable * sats, qth_t * qth,
+                                   pass_query_done_fn done, gpointer data)
+{
+    pass_query_run_t *run;
+    GHashTableIter  iter;
+    gpointer        value;
+    GSList         *jobs = NULL;
+    GSList         *node;
+    sat_t          *sat;
+    qth_t          *prune_qth = qth;
+    qth_t           route_qth;
+    guint           total = 0;
+    gint            nthreads;
+
+    g_return_val_if_fail(query != NULL && sats != NULL && qth != NULL &&
+                         done != NULL, NULL);
+
+    run = g_new0(pass_query_run_t, 1);
+    run->query = *query;
+    if (query->route != NULL)
+        route_ref(query->route);
+    run->qth.lat = qth->lat;
+    run->qth.lon = qth->lon;
+    run->qth.alt = qth->alt;
+    run->done = done;
+    run->data = data;
+    g_mutex_init(&run->lock);
+
+    /* along a route, prune for the point closest to the equator */
+    if (query->route != NULL)
+    {
+        memset(&route_qth, 0, sizeof(route_qth));
+        route_qth.lat = route_min_abs_lat(query->route);
+        prune_qth = &route_qth;
+    }
+
+    /* prune and copy the satellites; the copies are owned by the jobs */
+    g_hash_table_iter_init(&iter, sats);
+    while (g_hash_table_iter_next(&iter, NULL, &value))
+    {
+        total++;
+        if (!pass_query_may_match(query, SAT(value), prune_qth))
+            continue;
+
+        sat = g_new(sat_t, 1);
+        *sat = *SAT(value);
+        sat->name = g_strdup(SAT(value)->name);
+        sat->nickname = g_strdup(SAT(value)->nickname);
+        sat->website = g_strdup(SAT(value)->website);
+        jobs = g_slist_prepend(jobs, sat);
+    }
+
+    run->pending = g_slist_length(jobs);
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Searching passes of %d out of %d satellites"),
+                __func__, run->pending, total);
+
+    if (jobs == NULL)
+    {
+        g_idle_add(pass_query_deliver, run);
+        return run;
+    }
+
+#if GLIB_CHECK_VERSION(2, 36, 0)
+    nthreads = (gint) g_get_num_processors();
+#else
+    nthreads = 4;
+#endif
+
+    run->pool = g_thread_pool_new(pass_query_job, run, nthreads, FALSE, NULL);
+    for (node = jobs; node != NULL; node = node->next)
+        g_thread_pool_push(run->pool, node->data, NULL);
+    g_slist_free(jobs);
+
+    return run;
+}
+
+/**
+ * Cancel a pass query.
+ *
+ * Searches in progress are stopped after the current pass and the done
+ * callback is not invoked.
+ */
+void pass_query_cancel(pass_query_run_t * run)
+{
+    if (run != NULL)
+        g_atomic_int_set(&run->cancelled, TRUE);
+}
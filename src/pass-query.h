@@ -0,0 +1,59 @@
+#ifndef PASS_QUERY_H
+#define PASS_QUERY_H 1
+
+#include <glib.h>
+
+#include "predict-tools.h"
+#include "qth-data.h"
+#include "route.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/** Sunlight condition of a pass query. */
+typedef enum {
+    PASS_QUERY_SUN_ANY = 0,     /*!< Any pass. */
+    PASS_QUERY_SUN_LIT,         /*!< Satellite is in sunlight during the pass. */
+    PASS_QUERY_SUN_VISIBLE,     /*!< Satellite is visible during the pass. */
+    PASS_QUERY_SUN_NUM
+} pass_query_sun_t;
+
+/**
+ * Pass query.
+ *
+ * Azimuth windows go clockwise from min to max and may wrap through north.
+ * A window with min equal to max matches any azimuth.
+ */
+typedef struct {
+    gdouble         start;      /*!< Start of the time window (Julian Date). */
+    gdouble         maxdt;      /*!< Length of the time window in days. */
+    gdouble         min_el;     /*!< Minimum of the max elevation [deg]. */
+    gdouble         min_dur;    /*!< Minimum duration [min]. */
+    gdouble         max_dur;    /*!< Maximum duration [min], 0 for no limit. */
+    gdouble         aos_az_min; /*!< Start of the AOS azimuth window [deg]. */
+    gdouble         aos_az_max; /*!< End of the AOS azimuth window [deg]. */
+    gdouble         los_az_min; /*!< Start of the LOS azimuth window [deg]. */
+    gdouble         los_az_max; /*!< End of the LOS azimuth window [deg]. */
+    pass_query_sun_t sun;       /*!< Sunlight condition. */
+    route_t        *route;      /*!< Observer route or NULL for a fixed QTH. */
+} pass_query_t;
+
+/**
+ * Callback invoked in the main loop when a query has completed.
+ *
+ * The callee takes ownership of the passes, which are sorted by AOS.
+ */
+typedef void    (*pass_query_done_fn) (GSList * passes, gpointer data);
+
+/** Opaque handle of a running query. */
+typedef struct _pass_query_run pass_query_run_t;
+
+void            pass_query_init(pass_query_t * query, gdouble start,
+                                gdouble maxdt);
+gboolean        pass_query_may_match(const pass_query_t * query,
+                                     sat_t * sat, qth_t * qth);
+gboolean        pass_query_match(const pass_query_t * query, pass_t * pass);
+pass_query_run_t *pass_query_start(const pass_query_t * query,
+                                   GHashTable * sats, qth_t * qth,
+                                   pass_query_done_fn done, gpointer data);
+void            pass_query_cancel(pass_query_run_t * run);
+
+#endif
@@ -110,9 +110,6 @@ const guint     MCW[] = {
 };
 
 
-static void     Calc_RADec(gdouble jul_utc, gdouble saz, gdouble sel,
-                           qth_t * qth, obs_astro_t * obs_set);
-
 gchar          *pass_to_txt_pgheader(pass_t * pass, qth_t * qth, gint fields)
 {
     gboolean        loc;
@@ -282,10 +279,12 @@ gchar          *pass_to_txt_tblcontents(pass_t * pass, qth_t * qth,
             g_free(buff);
         }
 
+        if (fields & (SINGLE_PASS_FLAG_RA | SINGLE_PASS_FLAG_DEC))
+            calc_radec(detail->time, detail->az, detail->el, qth, &astro);
+
         /* Ra */
         if (fields & SINGLE_PASS_FLAG_RA)
         {
-            Calc_RADec(detail->time, detail->az, detail->el, qth, &astro);
             ra = Degrees(astro.ra);
             buff = g_strdup_printf("%s %6.2f", line, ra);
             g_free(line);
@@ -296,7 +295,6 @@ gchar          *pass_to_txt_tblcontents(pass_t * pass, qth_t * qth,
         /* Dec */
         if (fields & SINGLE_PASS_FLAG_DEC)
         {
-            Calc_RADec(detail->time, detail->az, detail->el, qth, &astro);
             dec = Degrees(astro.dec);
             buff = g_strdup_printf("%s %6.2f", line, dec);
             g_free(line);
@@ -677,47 +675,3 @@ gchar          *passes_to_txt_tblcontents(GSList * passes, qth_t * qth,
     return data;
 }
 
-static void Calc_RADec(gdouble jul_utc, gdouble saz, gdouble sel,
-                       qth_t * qth, obs_astro_t * obs_set)
-{
-    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
-        az, el, Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Ez, Zz,
-        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
-    geodetic_t      geodetic;
-
-
-    geodetic.lon = qth->lon * de2ra;
-    geodetic.lat = qth->lat * de2ra;
-    geodetic.alt = qth->alt / 1000.0;
-    geodetic.theta = 0;
-
-    az = saz * de2ra;
-    el = sel * de2ra;
-    phi = geodetic.lat;
-    theta = FMod2p(ThetaG_JD(jul_utc) + geodetic.lon);
-    sin_theta = sin(theta);
-    cos_theta = cos(theta);
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
-    Lxh = -cos(az) * cos(el);
-    Lyh = sin(az) * cos(el);
-    Lzh = sin(el);
-    Sx = sin_phi * cos_theta;
-    Ex = -sin_theta;
-    Zx = cos_theta * cos_phi;
-    Sy = sin_phi * sin_theta;
-    Ey = cos_theta;
-    Zy = sin_theta * cos_phi;
-    Sz = -cos_phi;
-    Ez = 0;
-    Zz = sin_phi;
-    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
-    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
-    Lz = Sz * Lxh + Ez * Lyh + Zz * Lzh;
-    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
-    cos_delta = sqrt(1 - Sqr(Lz));
-    sin_alpha = Ly / cos_delta;
-    cos_alpha = Lx / cos_delta;
-    obs_set->ra = AcTan(sin_alpha, cos_alpha);  /* Right Ascension (radians) */
-    obs_set->ra = FMod2p(obs_set->ra);
-}
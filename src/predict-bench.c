@@ -0,0 +1,281 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Per tick cost and error of predict_calc_approx().
+ *
+ * Propagates the satellites in USER_CONF_DIR/satdata, or those given on the
+ * command line, over a period of module ticks starting now. The ticks are
+ * first timed with predict_calc() for all satellites and then with
+ * predict_calc_approx(). Finally both are run side by side to find the
+ * largest position error of the approximation:
+ *
+ *   ./predict-bench --duration=3600 --step=1 --max-error=1000 25544 27607
+ *
+ * The program is not built by default; use "make predict-bench".
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "compat.h"
+#include "gtk-sat-data.h"
+#include "predict-tools.h"
+#include "sat-cfg.h"
+#include "sat-log.h"
+#include "sgpsdp/sgp4sdp4.h"
+#include "time-tools.h"
+
+
+static gint     duration = 3600;
+static gint     step = 1;
+static gint     maxerr = 1000;
+static gboolean verbose = FALSE;
+
+static GOptionEntry entries[] = {
+    {"duration", 'd', 0, G_OPTION_ARG_INT, &duration,
+     "Propagated period in seconds (default 3600)", "S"},
+    {"step", 's', 0, G_OPTION_ARG_INT, &step,
+     "Time between ticks in seconds (default 1)", "S"},
+    {"max-error", 'e', 0, G_OPTION_ARG_INT, &maxerr,
+     "Position error bound in meters (default 1000)", "M"},
+    {"verbose", 'v', 0, G_OPTION_ARG_NONE, &verbose,
+     "Print debug messages, e.g. resyncs exceeding the bound", NULL},
+    {NULL}
+};
+
+
+/* Log to stderr instead of the log file of gpredict. */
+void sat_log_log(sat_log_level_t level, const char *fmt, ...)
+{
+    va_list         ap;
+
+    if ((level == SAT_LOG_LEVEL_DEBUG) && !verbose)
+        return;
+
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fputc('\n', stderr);
+}
+
+/* Get the catalog numbers of all .sat files in satdata. */
+static GArray  *get_all_sats(void)
+{
+    GArray         *catnrs;
+    GDir           *dir;
+    gchar          *dirname;
+    const gchar    *filename;
+    gint            catnr;
+
+    catnrs = g_array_new(FALSE, FALSE, sizeof(gint));
+
+    dirname = get_satdata_dir();
+    dir = g_dir_open(dirname, 0, NULL);
+    g_free(dirname);
+    if (dir == NULL)
+        return catnrs;
+
+    while ((filename = g_dir_read_name(dir)))
+    {
+        if (!g_str_has_suffix(filename, ".sat"))
+            continue;
+
+        catnr = (gint) g_ascii_strtoll(filename, NULL, 10);
+        if (catnr > 0)
+            g_array_append_val(catnrs, catnr);
+    }
+    g_dir_close(dir);
+
+    return catnrs;
+}
+
+/* Read and initialise the satellites. */
+static GPtrArray *load_sats(GArray * catnrs, qth_t * qth)
+{
+    GPtrArray      *sats;
+    sat_t          *sat;
+    guint           i;
+
+    sats = g_ptr_array_new_with_free_func((GDestroyNotify)
+                                          gtk_sat_data_free_sat);
+    for (i = 0; i < catnrs->len; i++)
+    {
+        sat = g_new0(sat_t, 1);
+        if (gtk_sat_data_read_sat(g_array_index(catnrs, gint, i), sat))
+        {
+            g_free(sat);
+            continue;
+        }
+
+        gtk_sat_data_init_sat(sat, qth);
+        g_ptr_array_add(sats, sat);
+    }
+
+    return sats;
+}
+
+/* Time the ticks; returns the total time in microseconds. */
+static gint64 time_ticks(GPtrArray * sats, qth_t * qth, gdouble start,
+                         gint nticks, gdouble err)
+{
+    gint64          t0;
+    gdouble         t;
+    gint            i;
+    guint           j;
+
+    t0 = g_get_monotonic_time();
+    for (i = 0; i < nticks; i++)
+    {
+        t = start + i * step / secday;
+        for (j = 0; j < sats->len; j++)
+        {
+            if (err > 0.0)
+                predict_calc_approx(g_ptr_array_index(sats, j), qth, t, err);
+            else
+                predict_calc(g_ptr_array_index(sats, j), qth, t);
+        }
+    }
+
+    return g_get_monotonic_time() - t0;
+}
+
+int main(int argc, char *argv[])
+{
+    GOptionContext *context;
+    GError         *err = NULL;
+    GArray         *catnrs;
+    GPtrArray      *full, *approx;
+    qth_t           qth;
+    sat_t          *fsat, *asat;
+    const gchar    *worst = "-";
+    gdouble         start, t, dx, dy, dz, d, maxd = 0.0;
+    gint64          tfull, tapprox;
+    gint            nticks, i, catnr;
+    guint           j, resyncs = 0;
+
+    context = g_option_context_new("[CATNUM...] - time predict_calc_approx");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &err))
+    {
+        fprintf(stderr, "%s\n", err->message);
+        g_clear_error(&err);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    if ((step <= 0) || (duration < step) || (maxerr <= 0))
+    {
+        fprintf(stderr, "Invalid duration, step or error bound\n");
+        return EXIT_FAILURE;
+    }
+
+    sat_cfg_load();
+
+    if (argc > 1)
+    {
+        catnrs = g_array_new(FALSE, FALSE, sizeof(gint));
+        for (i = 1; i < argc; i++)
+        {
+            catnr = atoi(argv[i]);
+            g_array_append_val(catnrs, catnr);
+        }
+    }
+    else
+    {
+        catnrs = get_all_sats();
+    }
+
+    memset(&qth, 0, sizeof(qth));
+    qth.lat = 55.7;
+    qth.lon = 12.5;
+    qth.alt = 0;
+
+    full = load_sats(catnrs, &qth);
+    approx = load_sats(catnrs, &qth);
+
+    if (full->len == 0)
+    {
+        fprintf(stderr, "No satellites\n");
+        return EXIT_FAILURE;
+    }
+
+    start = get_current_daynum();
+    nticks = duration / step;
+
+    tfull = time_ticks(full, &qth, start, nticks, 0.0);
+    tapprox = time_ticks(approx, &qth, start, nticks, maxerr / 1000.0);
+
+    printf("%u satellites, %d ticks of %d s, error bound %d m\n",
+           full->len, nticks, step, maxerr);
+    printf("predict_calc        %10.1f us/tick %8.3f us/sat\n",
+           (gdouble) tfull / nticks, (gdouble) tfull / nticks / full->len);
+    printf("predict_calc_approx %10.1f us/tick %8.3f us/sat (%.1fx)\n",
+           (gdouble) tapprox / nticks,
+           (gdouble) tapprox / nticks / approx->len,
+           (gdouble) tfull / MAX(tapprox, 1));
+
+    /* side by side from fresh anchors for the error */
+    g_ptr_array_free(approx, TRUE);
+    approx = load_sats(catnrs, &qth);
+
+    for (i = 0; i < nticks; i++)
+    {
+        t = start + i * step / secday;
+        for (j = 0; j < full->len; j++)
+        {
+            fsat = g_ptr_array_index(full, j);
+            asat = g_ptr_array_index(approx, j);
+
+            predict_calc(fsat, &qth, t);
+            predict_calc_approx(asat, &qth, t, maxerr / 1000.0);
+            if (asat->anchor.jul_utc == t)
+                resyncs++;
+
+            dx = asat->pos.x - fsat->pos.x;
+            dy = asat->pos.y - fsat->pos.y;
+            dz = asat->pos.z - fsat->pos.z;
+            d = sqrt(dx * dx + dy * dy + dz * dz);
+            if (d > maxd)
+            {
+                maxd = d;
+                worst = fsat->nickname;
+            }
+        }
+    }
+
+    printf("max position error  %10.1f m (%s)\n", maxd * 1000.0, worst);
+    printf("resyncs             %10.2f %% of calls\n",
+           100.0 * resyncs / ((gdouble) nticks * full->len));
+
+    g_ptr_array_free(full, TRUE);
+    g_ptr_array_free(approx, TRUE);
+    g_array_free(catnrs, TRUE);
+
+    return EXIT_SUCCESS;
+}
@@ -47,13 +47,16 @@
 static pass_t  *get_pass_engine(sat_t * sat_in, qth_t * qth, gdouble start,
                                 gdouble maxdt, gdouble min_el);
 
-/**
- * \brief SGP4SDP4 driver for doing AOS/LOS calculations.
- * \param sat Pointer to the satellite data.
- * \param qth Pointer to the QTH data.
- * \param t The time for calculation (Julian Date)
+/* Limits and initial value of the resync interval of predict_calc_approx() */
+#define APPROX_STEP_MIN     (5.0 / secday)
+#define APPROX_STEP_MAX     (1800.0 / secday)
+#define APPROX_STEP_INIT    (60.0 / secday)
+
+/*
+ * Calculate the observer dependent and derived data of a satellite from
+ * sat->pos, sat->vel and sat->phase, which must be valid at sat->jul_utc.
  */
-void predict_calc(sat_t * sat, qth_t * qth, gdouble t)
+static void predict_calc_obs(sat_t * sat, qth_t * qth)
 {
     obs_set_t       obs_set;
     geodetic_t      sat_geodetic;
@@ -65,17 +68,6 @@ void predict_calc(sat_t * sat, qth_t * qth, gdouble t)
     obs_geodetic.alt = qth->alt / 1000.0;
     obs_geodetic.theta = 0;
 
-    sat->jul_utc = t;
-    sat->tsince = (sat->jul_utc - sat->jul_epoch) * xmnpda;
-
-    /* call the norad routines according to the deep-space flag */
-    if (sat->flags & DEEP_SPACE_EPHEM_FLAG)
-        SDP4(sat, sat->tsince);
-    else
-        SGP4(sat, sat->tsince);
-
-    Convert_Sat_State(&sat->pos, &sat->vel);
-
     /* get the velocity of the satellite */
     Magnitude(&sat->vel);
     sat->velo = sat->vel.w;
@@ -108,6 +100,251 @@ void predict_calc(sat_t * sat, qth_t * qth, gdouble t)
                              (sat->tle.xmo + sat->tle.omegao) / twopi) + sat->tle.revnum ;
 }
 
+/**
+ * \brief SGP4SDP4 driver for doing AOS/LOS calculations.
+ * \param sat Pointer to the satellite data.
+ * \param qth Pointer to the QTH data.
+ * \param t The time for calculation (Julian Date)
+ */
+void predict_calc(sat_t * sat, qth_t * qth, gdouble t)
+{
+    sat->jul_utc = t;
+    sat->tsince = (sat->jul_utc - sat->jul_epoch) * xmnpda;
+
+    /* RA and Dec are calculated on demand */
+    sat->radec_utc = -1.0;
+
+    /* call the norad routines according to the deep-space flag */
+    if (sat->flags & DEEP_SPACE_EPHEM_FLAG)
+        SDP4(sat, sat->tsince);
+    else
+        SGP4(sat, sat->tsince);
+
+    Convert_Sat_State(&sat->pos, &sat->vel);
+
+    predict_calc_obs(sat, qth);
+}
+
+/*
+ * Two-body propagation of a state vector.
+ *
+ * r0 and v0 are the position [km] and velocity [km/s] at time 0 and dt is the
+ * time in seconds. The Kepler equation is solved for the change in eccentric
+ * anomaly and the result is obtained with the Lagrange f and g coefficients.
+ * Returns FALSE if the orbit is not elliptical.
+ */
+static gboolean kepler_propagate(const vector_t * r0, const vector_t * v0,
+                                 double dt, vector_t * r, vector_t * v)
+{
+    double          r0m, v02, sig0, a, sqa, sqmu, e1, m, de, s, c, d;
+    double          rm, f, g, fd, gd;
+    int             i;
+
+    r0m = sqrt(r0->x * r0->x + r0->y * r0->y + r0->z * r0->z);
+    v02 = v0->x * v0->x + v0->y * v0->y + v0->z * v0->z;
+    a = 1.0 / (2.0 / r0m - v02 / ge);
+    if (a <= 0.0)
+        return FALSE;
+
+    sqmu = sqrt(ge);
+    sqa = sqrt(a);
+    sig0 = (r0->x * v0->x + r0->y * v0->y + r0->z * v0->z) / sqmu;
+    e1 = 1.0 - r0m / a;
+    m = sqmu / (a * sqa) * dt;
+
+    /* Newton iteration; de = m is exact for circular orbits */
+    de = m;
+    for (i = 0; i < 10; i++)
+    {
+        s = sin(de);
+        c = cos(de);
+        d = (de - e1 * s + sig0 / sqa * (1.0 - c) - m) /
+            (1.0 - e1 * c + sig0 / sqa * s);
+        de -= d;
+        if (fabs(d) < 1.0e-12)
+            break;
+    }
+
+    s = sin(de);
+    c = cos(de);
+    rm = a + (r0m - a) * c + sig0 * sqa * s;
+    f = 1.0 - a / r0m * (1.0 - c);
+    g = a * sig0 / sqmu * (1.0 - c) + r0m * sqa / sqmu * s;
+    fd = -sqmu * sqa / (rm * r0m) * s;
+    gd = 1.0 - a / rm * (1.0 - c);
+
+    r->x = f * r0->x + g * v0->x;
+    r->y = f * r0->y + g * v0->y;
+    r->z = f * r0->z + g * v0->z;
+    v->x = fd * r0->x + gd * v0->x;
+    v->y = fd * r0->y + gd * v0->y;
+    v->z = fd * r0->z + gd * v0->z;
+    Magnitude(r);
+    Magnitude(v);
+
+    return TRUE;
+}
+
+/**
+ * \brief Approximate SGP4SDP4 driver for display purposes.
+ * \param sat Pointer to the satellite data.
+ * \param qth Pointer to the QTH data.
+ * \param t The time for calculation (Julian Date)
+ * \param maxerr The maximum position error in km (0 for full precision).
+ *
+ * The position of the satellite is propagated as a two-body orbit from an
+ * anchor state computed with SGP4/SDP4. The anchor is refreshed when t is
+ * more than the resync interval away from it. On each resync the two-body
+ * position is compared with the SGP4/SDP4 position and the interval is
+ * adjusted so that the error stays below maxerr, assuming that the error grows
+ * with the square of the time since the anchor.
+ *
+ * All fields updated by predict_calc() are updated. Use predict_calc() where
+ * the full precision is needed, e.g. for the targets of radio and rotator
+ * control and for event calculations.
+ */
+void predict_calc_approx(sat_t * sat, qth_t * qth, gdouble t, gdouble maxerr)
+{
+    approx_anchor_t *anchor = &sat->anchor;
+    vector_t        pos, vel;
+    gboolean        valid;
+    double          dt, dx, dy, dz, err, step;
+
+    if (maxerr <= 0.0)
+    {
+        predict_calc(sat, qth, t);
+        return;
+    }
+
+    dt = t - anchor->jul_utc;
+    valid = (anchor->jul_utc > 0.0 && anchor->jul_epoch == sat->jul_epoch);
+
+    if (valid && fabs(dt) <= anchor->step &&
+        kepler_propagate(&anchor->pos, &anchor->vel, dt * secday, &pos, &vel))
+    {
+        sat->jul_utc = t;
+        sat->tsince = (sat->jul_utc - sat->jul_epoch) * xmnpda;
+        sat->radec_utc = -1.0;
+        sat->pos = pos;
+        sat->vel = vel;
+        sat->phase = FMod2p(anchor->phase + sat->tle.xno * dt * xmnpda);
+
+        predict_calc_obs(sat, qth);
+        return;
+    }
+
+    /* measure the error of the old anchor unless time has jumped */
+    step = APPROX_STEP_INIT;
+    if (valid && fabs(dt) <= 2.0 * anchor->step &&
+        kepler_propagate(&anchor->pos, &anchor->vel, dt * secday, &pos, &vel))
+        step = anchor->step;
+    else
+        valid = FALSE;
+
+    /* resync */
+    predict_calc(sat, qth, t);
+
+    if (valid)
+    {
+        dx = pos.x - sat->pos.x;
+        dy = pos.y - sat->pos.y;
+        dz = pos.z - sat->pos.z;
+        err = sqrt(dx * dx + dy * dy + dz * dz);
+
+        if (err > maxerr)
+            sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                        _("%s: %s: Position error %.3f km after %.0f s "
+                          "exceeds %.3f km"),
+                        __func__, sat->nickname, err, fabs(dt) * secday,
+                        maxerr);
+
+        /* 0.8 leaves some margin for the error model */
+        if (err > 0.0)
+            step = MIN(0.8 * fabs(dt) * sqrt(maxerr / err), 2.0 * step);
+        else
+            step *= 2.0;
+    }
+
+    anchor->jul_utc = t;
+    anchor->jul_epoch = sat->jul_epoch;
+    anchor->step = CLAMP(step, APPROX_STEP_MIN, APPROX_STEP_MAX);
+    anchor->phase = sat->phase * de2ra;
+    anchor->pos = sat->pos;
+    anchor->vel = sat->vel;
+}
+
+/**
+ * \brief Calculate right ascension and declination of a satellite.
+ * \param sat Pointer to the satellite data.
+ * \param qth Pointer to the QTH data.
+ *
+ * The values are derived from the azimuth and elevation calculated by
+ * predict_calc() and stored in sat->ra and sat->dec. They are calculated at
+ * most once per call to predict_calc(), so all views showing RA or Dec for the
+ * same satellite share the result.
+ */
+void predict_calc_radec(sat_t * sat, qth_t * qth)
+{
+    obs_astro_t     astro;
+
+    if (sat->radec_utc == sat->jul_utc)
+        return;
+
+    calc_radec(sat->jul_utc, sat->az, sat->el, qth, &astro);
+    sat->ra = Degrees(astro.ra);
+    sat->dec = Degrees(astro.dec);
+    sat->radec_utc = sat->jul_utc;
+}
+
+/**
+ * \brief Convert observed azimuth and elevation to RA and Dec.
+ * \param jul_utc The time of the observation (Julian Date)
+ * \param az Azimuth [deg]
+ * \param el Elevation [deg]
+ * \param qth Pointer to the QTH data.
+ * \param obs_set Structure receiving right ascension and declination [rad]
+ *
+ * Reference: Methods of Orbit Determination by Pedro Ramon Escobal,
+ * pp. 401-402
+ */
+void calc_radec(gdouble jul_utc, gdouble az, gdouble el, qth_t * qth,
+                obs_astro_t * obs_set)
+{
+    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
+        sin_az, cos_az, sin_el, cos_el, Lxh, Lyh, Lzh, Lx, Ly, Lz,
+        cos_delta;
+
+    az = az * de2ra;
+    el = el * de2ra;
+    phi = qth->lat * de2ra;
+    theta = FMod2p(ThetaG_JD(jul_utc) + qth->lon * de2ra);
+    sin_theta = sin(theta);
+    cos_theta = cos(theta);
+    sin_phi = sin(phi);
+    cos_phi = cos(phi);
+    sin_az = sin(az);
+    cos_az = cos(az);
+    sin_el = sin(el);
+    cos_el = cos(el);
+
+    /* line of sight in the local horizon system (south, east, zenith) */
+    Lxh = -cos_az * cos_el;
+    Lyh = sin_az * cos_el;
+    Lzh = sin_el;
+
+    /* rotate into the equatorial system */
+    Lx = sin_phi * cos_theta * Lxh - sin_theta * Lyh +
+        cos_theta * cos_phi * Lzh;
+    Ly = sin_phi * sin_theta * Lxh + cos_theta * Lyh +
+        sin_theta * cos_phi * Lzh;
+    Lz = -cos_phi * Lxh + sin_phi * Lzh;
+
+    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
+    cos_delta = sqrt(1 - Sqr(Lz));
+    obs_set->ra = AcTan(Ly / cos_delta, Lx / cos_delta);
+    obs_set->ra = FMod2p(obs_set->ra);  /* Right Ascension (radians) */
+}
+
 /**
  * \brief Find the AOS time of the next pass.
  * \author Alexandru Csete, OZ9AEC
@@ -435,6 +672,22 @@ pass_t         *get_pass_no_min_el(sat_t * sat_in, qth_t * qth, gdouble start,
     return get_pass_engine(sat_in, qth, start, maxdt, 0.0);
 }
 
+/**
+ * \brief Predict first pass after a certain time with a given min elevation.
+ * \param sat Pointer to the satellite data.
+ * \param qth Pointer to the location data.
+ * \param start Starting time.
+ * \param maxdt The maximum number of days to look ahead (0 for no limit).
+ * \param min_el The minimum elevation of the pass.
+ * \return Pointer to a newly allocated pass_t structure or NULL if
+ *         there was an error.
+ */
+pass_t         *get_pass_min_el(sat_t * sat_in, qth_t * qth, gdouble start,
+                                gdouble maxdt, gdouble min_el)
+{
+    return get_pass_engine(sat_in, qth, start, maxdt, min_el);
+}
+
 /**
  * \brief Predict first pass after a certain time.
  * \param sat Pointer to the satellite data.
@@ -557,29 +810,7 @@ static pass_t  *get_pass_engine(sat_t * sat_in, qth_t * qth, gdouble start,
                 }
 
                 /* append details to sat->details */
-                detail = g_new(pass_detail_t, 1);
-                detail->time = t;
-                detail->pos.x = sat->pos.x;
-                detail->pos.y = sat->pos.y;
-                detail->pos.z = sat->pos.z;
-                detail->pos.w = sat->pos.w;
-                detail->vel.x = sat->vel.x;
-                detail->vel.y = sat->vel.y;
-                detail->vel.z = sat->vel.z;
-                detail->vel.w = sat->vel.w;
-                detail->velo = sat->velo;
-                detail->az = sat->az;
-                detail->el = sat->el;
-                detail->range = sat->range;
-                detail->range_rate = sat->range_rate;
-                detail->lat = sat->ssplat;
-                detail->lon = sat->ssplon;
-                detail->alt = sat->alt;
-                detail->ma = sat->ma;
-                detail->phase = sat->phase;
-                detail->footprint = sat->footprint;
-                detail->orbit = sat->orbit;
-                detail->vis = get_sat_vis(sat, qth, t);
+                detail = new_pass_detail(sat, qth);
 
                 /* also store visibility "bit" */
                 switch (detail->vis)
@@ -704,13 +935,250 @@ GSList         *get_passes(sat_t * sat, qth_t * qth, gdouble start,
         passes = g_slist_reverse(passes);
 
     sat_log_log(SAT_LOG_LEVEL_INFO,
-                _("%s: Found %d passes for %s in time window [%f;%f]"),
+                _("%s: Found %u passes for %s in time window [%f;%f]"),
                 __func__, g_slist_length(passes), sat->nickname, start,
                 start + maxdt);
 
     return passes;
 }
 
+/**
+ * \brief Asynchronous pass search.
+ *
+ * The worker operates on private copies of the satellite and the observer
+ * so that the caller is free to update or destroy its own data while the
+ * search is running. Results are handed back to the main loop one pass at
+ * a time using idle callbacks.
+ *
+ * References are held by the caller (until the search completes or is
+ * cancelled), by the worker thread and by every pending idle callback.
+ */
+struct _pass_search {
+    sat_t           sat;        /*!< Private copy of the satellite */
+    qth_t           qth;        /*!< Private copy of the observer position */
+    gdouble         start;      /*!< Start time */
+    gdouble         maxdt;      /*!< Look ahead in days (0 = no limit) */
+    guint           num;        /*!< Max number of passes */
+    pass_found_fn   found;      /*!< Called for each pass */
+    pass_done_fn    done;       /*!< Called when the search has completed */
+    gpointer        data;       /*!< User data for the callbacks */
+    gint            cancelled;  /*!< Set when the caller is no longer interested */
+    gint            refcount;
+};
+
+typedef struct {
+    pass_search_t  *search;
+    pass_t         *pass;       /*!< Pass found or NULL when done */
+    guint           count;      /*!< Number of passes found when done */
+} pass_search_result_t;
+
+static void pass_search_unref(pass_search_t * search)
+{
+    if (!g_atomic_int_dec_and_test(&search->refcount))
+        return;
+
+    g_free(search->sat.name);
+    g_free(search->sat.nickname);
+    g_free(search->sat.website);
+    g_free(search);
+}
+
+static gboolean pass_search_deliver(gpointer data)
+{
+    pass_search_result_t *result = (pass_search_result_t *) data;
+    pass_search_t  *search = result->search;
+
+    if (result->pass != NULL)
+    {
+        if (g_atomic_int_get(&search->cancelled))
+            free_pass(result->pass);
+        else
+            search->found(result->pass, search->data);
+    }
+    else if (!g_atomic_int_get(&search->cancelled))
+    {
+        /* the search is complete and the caller's reference is released */
+        g_atomic_int_set(&search->cancelled, TRUE);
+        if (search->done != NULL)
+            search->done(result->count, search->data);
+        pass_search_unref(search);
+    }
+
+    pass_search_unref(search);
+    g_free(result);
+
+    return FALSE;
+}
+
+static void pass_search_queue(pass_search_t * search, pass_t * pass,
+                              guint count)
+{
+    pass_search_result_t *result = g_new(pass_search_result_t, 1);
+
+    g_atomic_int_inc(&search->refcount);
+    result->search = search;
+    result->pass = pass;
+    result->count = count;
+    g_idle_add(pass_search_deliver, result);
+}
+
+static gpointer pass_search_thread(gpointer data)
+{
+    pass_search_t  *search = (pass_search_t *) data;
+    pass_t         *pass;
+    guint           count = 0;
+    gdouble         t = search->start;
+
+    while (count < search->num && !g_atomic_int_get(&search->cancelled))
+    {
+        pass = get_pass(&search->sat, &search->qth, t, search->maxdt);
+        if (pass == NULL)
+            break;
+
+        t = pass->los + 0.014;  // +20 min
+        count++;
+        pass_search_queue(search, pass, 0);
+
+        if ((search->maxdt > 0.0) && (t >= (search->start + search->maxdt)))
+            break;
+    }
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Found %u passes for %s in time window [%f;%f]"),
+                __func__, count, search->sat.nickname, search->start,
+                search->start + search->maxdt);
+
+    pass_search_queue(search, NULL, count);
+    pass_search_unref(search);
+
+    return NULL;
+}
+
+/**
+ * \brief Predict passes in a worker thread.
+ * \param sat Pointer to the satellite data.
+ * \param qth Pointer to the observer data.
+ * \param start Starting time.
+ * \param maxdt The maximum number of days to look ahead (0 for no limit).
+ * \param num The number of passes to predict (0 for default).
+ * \param found Function called in the main loop for every pass found.
+ * \param done Function called in the main loop when the search completes
+ *             (may be NULL).
+ * \param data User data passed to the callbacks.
+ * \return A handle that can be used to cancel the search.
+ *
+ * This is the non-blocking version of get_passes. Passes are delivered to
+ * the found callback in chronological order as soon as they have been
+ * computed. The handle becomes invalid once the done callback has been
+ * invoked or pass_search_cancel has been called.
+ *
+ * \note Neither sat nor qth are accessed after this function returns.
+ */
+pass_search_t  *get_passes_async(sat_t * sat, qth_t * qth, gdouble start,
+                                 gdouble maxdt, guint num,
+                                 pass_found_fn found, pass_done_fn done,
+                                 gpointer data)
+{
+    pass_search_t  *search;
+    GThread        *thread;
+    GError         *err = NULL;
+
+    g_return_val_if_fail(sat != NULL && qth != NULL && found != NULL, NULL);
+
+    search = g_new0(pass_search_t, 1);
+
+    /* shallow copy is fine for the orbital data; strings are duplicated */
+    search->sat = *sat;
+    search->sat.name = g_strdup(sat->name);
+    search->sat.nickname = g_strdup(sat->nickname);
+    search->sat.website = g_strdup(sat->website);
+
+    /* only the position of the observer is needed for predictions */
+    search->qth.lat = qth->lat;
+    search->qth.lon = qth->lon;
+    search->qth.alt = qth->alt;
+
+    search->start = start;
+    search->maxdt = maxdt;
+    search->num = (num == 0) ? 100 : num;
+    search->found = found;
+    search->done = done;
+    search->data = data;
+    search->cancelled = FALSE;
+    search->refcount = 2;       /* caller + worker */
+
+    thread = g_thread_try_new("gpredict_pass_search", pass_search_thread,
+                              search, &err);
+    if (thread == NULL)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: Failed to create pass search thread (%s)"),
+                    __func__, err != NULL ? err->message : "unknown");
+        g_clear_error(&err);
+
+        /* results are still delivered through the main loop */
+        pass_search_thread(search);
+    }
+    else
+    {
+        g_thread_unref(thread);
+    }
+
+    return search;
+}
+
+/**
+ * \brief Cancel an asynchronous pass search.
+ * \param search The search handle returned by get_passes_async.
+ *
+ * No callbacks will be invoked after this function returns. Must be called
+ * from the main loop and not after the done callback has been invoked.
+ */
+void pass_search_cancel(pass_search_t * search)
+{
+    if (search == NULL)
+        return;
+
+    g_atomic_int_set(&search->cancelled, TRUE);
+    pass_search_unref(search);
+}
+
+/**
+ * \brief Create a pass detail entry from the current satellite data.
+ * \param sat Pointer to the satellite data, calculated for sat->jul_utc.
+ * \param qth Pointer to the observer data used for the calculation.
+ * \return A newly allocated pass_detail_t structure.
+ */
+pass_detail_t  *new_pass_detail(sat_t * sat, qth_t * qth)
+{
+    pass_detail_t  *detail = g_new(pass_detail_t, 1);
+
+    detail->time = sat->jul_utc;
+    detail->pos.x = sat->pos.x;
+    detail->pos.y = sat->pos.y;
+    detail->pos.z = sat->pos.z;
+    detail->pos.w = sat->pos.w;
+    detail->vel.x = sat->vel.x;
+    detail->vel.y = sat->vel.y;
+    detail->vel.z = sat->vel.z;
+    detail->vel.w = sat->vel.w;
+    detail->velo = sat->velo;
+    detail->az = sat->az;
+    detail->el = sat->el;
+    detail->range = sat->range;
+    detail->range_rate = sat->range_rate;
+    detail->lat = sat->ssplat;
+    detail->lon = sat->ssplon;
+    detail->alt = sat->alt;
+    detail->ma = sat->ma;
+    detail->phase = sat->phase;
+    detail->footprint = sat->footprint;
+    detail->orbit = sat->orbit;
+    detail->vis = get_sat_vis(sat, qth, sat->jul_utc);
+
+    return detail;
+}
+
 pass_t         *copy_pass(pass_t * pass)
 {
     pass_t         *new;
@@ -78,12 +78,34 @@ typedef struct {
     gint      orbit;
 } pass_detail_t;
 
+/**
+ * \brief Callback receiving a pass found by an asynchronous search.
+ *
+ * The callback is invoked in the main loop and takes ownership of pass.
+ */
+typedef void    (*pass_found_fn) (pass_t * pass, gpointer data);
+
+/**
+ * \brief Callback invoked in the main loop when an asynchronous search
+ *        has completed.
+ */
+typedef void    (*pass_done_fn) (guint count, gpointer data);
+
+/** \brief Opaque handle for a pass search running in a worker thread. */
+typedef struct _pass_search pass_search_t;
+
 /* type casting macros */
 #define PASS(x) ((pass_t *) x)
 #define PASS_DETAIL(x) ((pass_detail_t *) x)
 
 /* SGP4/SDP4 driver */
-void predict_calc (sat_t *sat, qth_t *qth, gdouble t);
+void predict_calc        (sat_t *sat, qth_t *qth, gdouble t);
+void predict_calc_approx (sat_t *sat, qth_t *qth, gdouble t, gdouble maxerr);
+
+/* derived coordinates */
+void predict_calc_radec (sat_t *sat, qth_t *qth);
+void calc_radec         (gdouble jul_utc, gdouble az, gdouble el,
+                         qth_t *qth, obs_astro_t *obs_set);
 
 /* AOS/LOS time calculators */
 gdouble find_aos           (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt);
@@ -99,6 +121,18 @@ pass_t *get_pass           (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt
 GSList *get_passes         (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt, guint num);
 pass_t *get_current_pass   (sat_t *sat, qth_t *qth, gdouble start);
 pass_t *get_pass_no_min_el (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt);
+pass_t *get_pass_min_el    (sat_t *sat, qth_t *qth, gdouble start, gdouble maxdt,
+                            gdouble min_el);
+
+/* future events predicted in a worker thread */
+pass_search_t *get_passes_async   (sat_t *sat, qth_t *qth, gdouble start,
+                                   gdouble maxdt, guint num,
+                                   pass_found_fn found, pass_done_fn done,
+                                   gpointer data);
+void           pass_search_cancel (pass_search_t *search);
+
+/* pass details */
+pass_detail_t *new_pass_detail   (sat_t *sat, qth_t *qth);
 
 /* copying */
 pass_t        *copy_pass         (pass_t *pass);
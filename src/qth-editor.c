@@ -289,6 +289,14 @@ static void select_location(GtkWidget * widget, gpointer data)
         break;
     }
 
+    /* current coordinates are used to search for nearby locations */
+    qthlat = gtk_spin_button_get_value(GTK_SPIN_BUTTON(lat));
+    if (gtk_combo_box_get_active(GTK_COMBO_BOX(ns)))
+        qthlat = -qthlat;
+    qthlon = gtk_spin_button_get_value(GTK_SPIN_BUTTON(lon));
+    if (gtk_combo_box_get_active(GTK_COMBO_BOX(ew)))
+        qthlon = -qthlon;
+
     selected = loc_tree_create(NULL, flags, &qthloc, &qthlat, &qthlon,
                                &qthalt, &qthwx);
 
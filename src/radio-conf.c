@@ -44,6 +44,9 @@
 #define KEY_VFO_UP      "VFO_UP"
 #define KEY_SIG_AOS     "SIGNAL_AOS"
 #define KEY_SIG_LOS     "SIGNAL_LOS"
+#define KEY_MODEL       "Model"
+#define KEY_DEVICE      "Device"
+#define KEY_SPEED       "Speed"
 
 /**
  * \brief Read radio configuration.
@@ -213,6 +216,11 @@ gboolean radio_conf_read(radio_conf_t * conf)
     conf->signal_aos = g_key_file_get_boolean(cfg, GROUP, KEY_SIG_AOS, NULL);
     conf->signal_los = g_key_file_get_boolean(cfg, GROUP, KEY_SIG_LOS, NULL);
 
+    /* In-process Hamlib control is optional; 0 means use the daemon */
+    conf->model = g_key_file_get_integer(cfg, GROUP, KEY_MODEL, NULL);
+    conf->device = g_key_file_get_string(cfg, GROUP, KEY_DEVICE, NULL);
+    conf->speed = g_key_file_get_integer(cfg, GROUP, KEY_SPEED, NULL);
+
     g_key_file_free(cfg);
     sat_log_log(SAT_LOG_LEVEL_INFO,
                 _("%s: Read radio configuration %s"), __func__, conf->name);
@@ -260,6 +268,14 @@ void radio_conf_save(radio_conf_t * conf)
     g_key_file_set_boolean(cfg, GROUP, KEY_SIG_AOS, conf->signal_aos);
     g_key_file_set_boolean(cfg, GROUP, KEY_SIG_LOS, conf->signal_los);
 
+    if (conf->model > 0)
+    {
+        g_key_file_set_integer(cfg, GROUP, KEY_MODEL, conf->model);
+        if (conf->device != NULL)
+            g_key_file_set_string(cfg, GROUP, KEY_DEVICE, conf->device);
+        g_key_file_set_integer(cfg, GROUP, KEY_SPEED, conf->speed);
+    }
+
     confdir = get_hwconf_dir();
     fname = g_strconcat(confdir, G_DIR_SEPARATOR_S, conf->name, ".rig", NULL);
     g_free(confdir);
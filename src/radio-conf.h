@@ -71,6 +71,11 @@ typedef struct {
 
     gboolean        signal_aos; /*!< Send AOS notification to RIG */
     gboolean        signal_los; /*!< Send LOS notification to RIG */
+
+    gint            model;      /*!< Hamlib rig model for in-process control;
+                                   0 to use rigctld at host:port. */
+    gchar          *device;     /*!< Serial port or device used with model. */
+    gint            speed;      /*!< Serial speed used with model or 0. */
 } radio_conf_t;
 
 
@@ -43,6 +43,10 @@
 #define KEY_MINEL       "MinEl"
 #define KEY_MAXEL       "MaxEl"
 #define KEY_AZSTOPPOS   "AzStopPos"
+#define KEY_MODEL       "Model"
+#define KEY_DEVICE      "Device"
+#define KEY_SPEED       "Speed"
+#define KEY_AOSLEAD     "AosLead"
 
 
 /**
@@ -171,6 +175,16 @@ gboolean rotor_conf_read(rotor_conf_t * conf)
         conf->azstoppos = conf->minaz;
     }
 
+    /* In-process Hamlib control is optional; 0 means use the daemon */
+    conf->model = g_key_file_get_integer(cfg, GROUP, KEY_MODEL, NULL);
+    conf->device = g_key_file_get_string(cfg, GROUP, KEY_DEVICE, NULL);
+    conf->speed = g_key_file_get_integer(cfg, GROUP, KEY_SPEED, NULL);
+
+    if (g_key_file_has_key(cfg, GROUP, KEY_AOSLEAD, NULL))
+        conf->aoslead = g_key_file_get_double(cfg, GROUP, KEY_AOSLEAD, NULL);
+    else
+        conf->aoslead = ROT_DEFAULT_AOS_LEAD;
+
     g_key_file_free(cfg);
 
     return TRUE;
@@ -204,6 +218,15 @@ void rotor_conf_save(rotor_conf_t * conf)
     g_key_file_set_double(cfg, GROUP, KEY_MINEL, conf->minel);
     g_key_file_set_double(cfg, GROUP, KEY_MAXEL, conf->maxel);
     g_key_file_set_double(cfg, GROUP, KEY_AZSTOPPOS, conf->azstoppos);
+    g_key_file_set_double(cfg, GROUP, KEY_AOSLEAD, conf->aoslead);
+
+    if (conf->model > 0)
+    {
+        g_key_file_set_integer(cfg, GROUP, KEY_MODEL, conf->model);
+        if (conf->device != NULL)
+            g_key_file_set_string(cfg, GROUP, KEY_DEVICE, conf->device);
+        g_key_file_set_integer(cfg, GROUP, KEY_SPEED, conf->speed);
+    }
 
     /* build filename */
     confdir = get_hwconf_dir();
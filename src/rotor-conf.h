@@ -33,6 +33,9 @@
 #include <glib.h>
 
 
+/** Default time in sec to reach the AOS position before AOS */
+#define ROT_DEFAULT_AOS_LEAD 60.0
+
 typedef enum {
     ROT_AZ_TYPE_360 = 0,        /*!< Azimuth in range 0..360 */
     ROT_AZ_TYPE_180 = 1         /*!< Azimuth in range -180..+180 */
@@ -50,6 +53,12 @@ typedef struct {
     gdouble         maxel;      /*!< Upper elevation limit */
     gdouble         azstoppos;  /*!< absolute position of rotation stops;
                                  *   will normally be equal to minaz */
+    gint            model;      /*!< Hamlib model for in-process control;
+                                 *   0 to use rotctld at host:port */
+    gchar          *device;     /*!< Serial port or device used with model */
+    gint            speed;      /*!< Serial speed used with model or 0 */
+    gdouble         aoslead;    /*!< Time in sec to be at the AOS position
+                                 *   before AOS */
 } rotor_conf_t;
 
 
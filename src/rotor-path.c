@@ -0,0 +1,378 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Rotator path planning.
+ *
+ * Each point of a pass can be reached in several ways: rotators with more
+ * than 360 degrees of azimuth travel can reach an azimuth on more than one
+ * wrap, and rotators with 180 degrees of elevation can reach it flipped, i.e.
+ * with the azimuth turned by 180 degrees and the elevation mirrored. The
+ * planner walks the pass details once and keeps the cheapest way of reaching
+ * each of these positions (dynamic programming over a handful of states per
+ * point), then picks the cheapest path ending at LOS. The cost of a move is
+ * the time the rotator falls behind the satellite, i.e. the slew time at the
+ * measured slew rates less the time available, plus a small fraction of the
+ * slew time to prefer the path with the least movement when several paths
+ * keep up with the satellite. The first move starts at the current rotator
+ * position and may use the time left before AOS.
+ *
+ * The travel of the rotator runs from its azimuth stop, which is not
+ * necessarily at minaz, so the planner works on the azimuth range shifted
+ * by azstoppos - minaz and maps the result back to minaz..maxaz.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <math.h>
+
+#include "rotor-path.h"
+#include "sat-log.h"
+
+
+/* Maximum number of azimuth wraps considered for each point */
+#define MAX_WRAPS       3
+
+/* Maximum number of states for each point (two elevation modes) */
+#define MAX_STATES      (2 * MAX_WRAPS)
+
+/* Weight of the slew time in the cost of a move */
+#define MOVE_WEIGHT     0.01
+
+/* Lowest slew rate accepted in deg/s */
+#define MIN_SLEW_RATE   0.1
+
+
+typedef struct {
+    gdouble         az;         /*!< Rotator azimuth */
+    gdouble         el;         /*!< Rotator elevation */
+    gboolean        flipped;    /*!< Whether the elevation axis is flipped */
+    gboolean        reachable;  /*!< FALSE if az is outside the travel */
+    gdouble         cost;       /*!< Cost of the cheapest path to here */
+    gint            prev;       /*!< State of the previous point on it */
+} path_state_t;
+
+
+/* Add a state to the list of states of a point. */
+static void add_state(path_state_t * states, gint * n, gdouble az,
+                      gdouble el, gboolean flipped, gboolean reachable)
+{
+    states[*n].az = az;
+    states[*n].el = el;
+    states[*n].flipped = flipped;
+    states[*n].reachable = reachable;
+    states[*n].cost = 0.0;
+    states[*n].prev = -1;
+    (*n)++;
+}
+
+/* Azimuth of a position within the shifted travel window */
+static gdouble travel_az(rotor_path_t * path, gdouble az)
+{
+    gdouble         lo = path->minaz + path->offset;
+    gdouble         hi = path->maxaz + path->offset;
+
+    while (az > hi && az - 360.0 >= lo)
+        az -= 360.0;
+    while (az < lo && az + 360.0 <= hi)
+        az += 360.0;
+
+    return az;
+}
+
+/* Azimuth to command for a position within the shifted travel window */
+static gdouble command_az(rotor_path_t * path, gdouble az)
+{
+    while (az > path->maxaz && az - 360.0 >= path->minaz)
+        az -= 360.0;
+    while (az < path->minaz && az + 360.0 <= path->maxaz)
+        az += 360.0;
+
+    return CLAMP(az, path->minaz, path->maxaz);
+}
+
+/**
+ * Get the rotator positions that point to az/el.
+ *
+ * @param path The path holding the rotator limits.
+ * @param flip Whether flipped positions are possible.
+ * @param az The azimuth in the range 0..360.
+ * @param el The elevation.
+ * @param states Storage for at least MAX_STATES states.
+ * @return The number of states stored.
+ *
+ * The azimuths of the states are within the travel window starting at the
+ * azimuth stop. If az is outside the travel of a rotator with less than 360
+ * degrees of azimuth travel, the ends of the travel are returned as
+ * unreachable states.
+ */
+static gint get_states(rotor_path_t * path, gboolean flip, gdouble az,
+                       gdouble el, path_state_t * states)
+{
+    gdouble         a, e;
+    gdouble         lo = path->minaz + path->offset;
+    gdouble         hi = path->maxaz + path->offset;
+    gint            f, k, kmin, kmax;
+    gint            n = 0;
+
+    for (f = 0; f <= (flip ? 1 : 0); f++)
+    {
+        if (f)
+        {
+            a = fmod(az + 180.0, 360.0);
+            e = 180.0 - el;
+        }
+        else
+        {
+            a = az;
+            e = el;
+        }
+        e = CLAMP(e, path->minel, path->maxel);
+
+        kmin = (gint) ceil((lo - a) / 360.0);
+        kmax = (gint) floor((hi - a) / 360.0);
+        if (kmax - kmin >= MAX_WRAPS)
+            kmax = kmin + MAX_WRAPS - 1;
+
+        if (kmin <= kmax)
+        {
+            for (k = kmin; k <= kmax; k++)
+                add_state(states, &n, a + 360.0 * k, e, f, TRUE);
+        }
+        else
+        {
+            add_state(states, &n, lo, e, f, FALSE);
+            add_state(states, &n, hi, e, f, FALSE);
+        }
+    }
+
+    return n;
+}
+
+/* Cost of moving between two states with dt seconds available. */
+static gdouble move_cost(const path_state_t * from, const path_state_t * to,
+                         gdouble azrate, gdouble elrate, gdouble dt)
+{
+    gdouble         slew;
+
+    slew = MAX(fabs(to->az - from->az) / azrate,
+               fabs(to->el - from->el) / elrate);
+
+    return MAX(slew - dt, 0.0) + MOVE_WEIGHT * slew;
+}
+
+/**
+ * Plan the rotator path for a pass.
+ *
+ * @param pass The pass including its details.
+ * @param conf The rotator configuration.
+ * @param az The current rotator azimuth.
+ * @param el The current rotator elevation.
+ * @param azrate The azimuth slew rate in deg/s.
+ * @param elrate The elevation slew rate in deg/s.
+ * @param t The current time.
+ * @return A newly allocated path or NULL if the pass has no details. Use
+ *         rotor_path_free() to free the path.
+ *
+ * The running time is linear in the number of pass details.
+ */
+rotor_path_t   *rotor_path_new(pass_t * pass, rotor_conf_t * conf,
+                               gdouble az, gdouble el,
+                               gdouble azrate, gdouble elrate, gdouble t)
+{
+    rotor_path_t   *path;
+    rotor_path_point_t *point;
+    pass_detail_t  *detail;
+    path_state_t   *states, *cur, *prev;
+    path_state_t    start;
+    GSList         *node;
+    gint           *nstates;
+    gint            num, i, j, p, best;
+    gdouble         dt, cost;
+    gdouble         prevt = 0.0;
+    gboolean        flip;
+
+    num = g_slist_length(pass->details);
+    if (num == 0)
+        return NULL;
+
+    path = g_new0(rotor_path_t, 1);
+    path->minaz = conf->minaz;
+    path->maxaz = conf->maxaz;
+    path->minel = conf->minel;
+    path->maxel = conf->maxel;
+    path->offset = conf->azstoppos - conf->minaz;
+    path->points = g_array_sized_new(FALSE, FALSE,
+                                     sizeof(rotor_path_point_t), num);
+    g_array_set_size(path->points, num);
+
+    flip = (conf->maxel >= 180.0);
+    azrate = MAX(azrate, MIN_SLEW_RATE);
+    elrate = MAX(elrate, MIN_SLEW_RATE);
+
+    states = g_new(path_state_t, num * MAX_STATES);
+    nstates = g_new(gint, num);
+
+    start.az = travel_az(path, az);
+    start.el = el;
+
+    /* cheapest path to each state of each point */
+    for (node = pass->details, i = 0; node != NULL; node = node->next, i++)
+    {
+        detail = PASS_DETAIL(node->data);
+        g_array_index(path->points, rotor_path_point_t, i).time =
+            detail->time;
+
+        cur = states + i * MAX_STATES;
+        prev = cur - MAX_STATES;
+        nstates[i] = get_states(path, flip, detail->az, detail->el, cur);
+
+        if (i == 0)
+            dt = MAX((detail->time - t) * secday, 0.0);
+        else
+            dt = (detail->time - prevt) * secday;
+
+        for (j = 0; j < nstates[i]; j++)
+        {
+            if (i == 0)
+            {
+                cur[j].cost = move_cost(&start, &cur[j], azrate, elrate, dt);
+            }
+            else
+            {
+                for (p = 0; p < nstates[i - 1]; p++)
+                {
+                    cost = prev[p].cost +
+                        move_cost(&prev[p], &cur[j], azrate, elrate, dt);
+                    if ((cur[j].prev < 0) || (cost < cur[j].cost))
+                    {
+                        cur[j].cost = cost;
+                        cur[j].prev = p;
+                    }
+                }
+
+                /* off target for the whole interval */
+                if (!cur[j].reachable)
+                    cur[j].cost += dt;
+            }
+        }
+
+        prevt = detail->time;
+    }
+
+    /* cheapest path ending at LOS */
+    cur = states + (num - 1) * MAX_STATES;
+    best = 0;
+    for (j = 1; j < nstates[num - 1]; j++)
+        if (cur[j].cost < cur[best].cost)
+            best = j;
+
+    path->cost = cur[best].cost;
+
+    for (i = num - 1; i >= 0; i--)
+    {
+        cur = states + i * MAX_STATES;
+        point = &g_array_index(path->points, rotor_path_point_t, i);
+        point->az = cur[best].az;
+        point->el = cur[best].el;
+        point->flipped = cur[best].flipped;
+        best = cur[best].prev;
+    }
+
+    point = &g_array_index(path->points, rotor_path_point_t, 0);
+    sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                _("%s: Path for %s starts at %.1f/%.1f%s, "
+                  "%.1f sec off target"),
+                __func__, pass->satname, command_az(path, point->az),
+                point->el,
+                point->flipped ? _(" (flipped)") : "", path->cost);
+
+    g_free(nstates);
+    g_free(states);
+
+    return path;
+}
+
+void rotor_path_free(rotor_path_t * path)
+{
+    if (path == NULL)
+        return;
+
+    g_array_free(path->points, TRUE);
+    g_free(path);
+}
+
+/**
+ * Map a satellite position to the rotator position on the path.
+ *
+ * @param path The rotator path.
+ * @param t The time of the position.
+ * @param az The azimuth of the satellite in the range 0..360.
+ * @param el The elevation of the satellite.
+ * @param raz Location where the rotator azimuth is stored.
+ * @param rel Location where the rotator elevation is stored.
+ *
+ * The flip mode and azimuth wrap of the path point closest in time are used.
+ * Times before AOS and after LOS map onto the first and last points.
+ */
+void rotor_path_map(rotor_path_t * path, gdouble t, gdouble az, gdouble el,
+                    gdouble * raz, gdouble * rel)
+{
+    rotor_path_point_t *point;
+    guint           lo, hi, mid;
+    gdouble         a, e;
+
+    /* binary search for the points around t */
+    lo = 0;
+    hi = path->points->len - 1;
+    while (hi - lo > 1)
+    {
+        mid = (lo + hi) / 2;
+        if (g_array_index(path->points, rotor_path_point_t, mid).time <= t)
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    if (fabs(g_array_index(path->points, rotor_path_point_t, hi).time - t) <
+        fabs(g_array_index(path->points, rotor_path_point_t, lo).time - t))
+        lo = hi;
+    point = &g_array_index(path->points, rotor_path_point_t, lo);
+
+    if (point->flipped)
+    {
+        a = fmod(az + 180.0, 360.0);
+        e = 180.0 - el;
+    }
+    else
+    {
+        a = az;
+        e = el;
+    }
+
+    /* use the wrap closest to the planned azimuth */
+    a += 360.0 * floor((point->az - a) / 360.0 + 0.5);
+    a = CLAMP(a, path->minaz + path->offset, path->maxaz + path->offset);
+
+    *raz = command_az(path, a);
+    *rel = CLAMP(e, path->minel, path->maxel);
+}
@@ -0,0 +1,37 @@
+#ifndef ROTOR_PATH_H
+#define ROTOR_PATH_H 1
+
+#include <glib.h>
+
+#include "predict-tools.h"
+#include "rotor-conf.h"
+
+/** Rotator position planned for one pass detail. */
+typedef struct {
+    gdouble         time;       /*!< Time in "jul_utc" */
+    gdouble         az;         /*!< Azimuth within the travel of the rotator */
+    gdouble         el;         /*!< Rotator elevation */
+    gboolean        flipped;    /*!< Whether the elevation axis is flipped */
+} rotor_path_point_t;
+
+/** Rotator path planned for a pass. */
+typedef struct {
+    GArray         *points;     /*!< rotor_path_point_t ordered by time */
+    gdouble         minaz;      /*!< Lower azimuth limit */
+    gdouble         maxaz;      /*!< Upper azimuth limit */
+    gdouble         minel;      /*!< Lower elevation limit */
+    gdouble         maxel;      /*!< Upper elevation limit */
+    gdouble         offset;     /*!< Position of the azimuth stop relative
+                                 *   to minaz */
+    gdouble         cost;       /*!< Expected time off target in seconds */
+} rotor_path_t;
+
+rotor_path_t   *rotor_path_new(pass_t * pass, rotor_conf_t * conf,
+                               gdouble az, gdouble el,
+                               gdouble azrate, gdouble elrate, gdouble t);
+void            rotor_path_free(rotor_path_t * path);
+void            rotor_path_map(rotor_path_t * path, gdouble t,
+                               gdouble az, gdouble el,
+                               gdouble * raz, gdouble * rel);
+
+#endif
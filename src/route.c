@@ -0,0 +1,716 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Pass prediction along the planned route of a moving observer.
+ *
+ * A route is a list of time-stamped waypoints read from a GPX file (track,
+ * route or waypoint points with a <time> element) or from a CSV file with
+ * time, latitude, longitude and optional altitude in meters on each line.
+ * Times are ISO 8601 strings or Unix time in seconds. The observer position
+ * is interpolated linearly between the waypoints and is kept constant before
+ * the first and after the last waypoint.
+ *
+ * Passes are found by stepping through time against the interpolated
+ * observer, using the same elevation dependent coarse steps as find_aos(),
+ * and the AOS, LOS and TCA are refined by bisection. Consecutive positions
+ * are looked up from the route segment of the previous one, so following the
+ * route costs next to nothing compared to the orbit propagation.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <math.h>
+#include <string.h>
+
+#include "orbit-tools.h"
+#include "route.h"
+#include "sat-cfg.h"
+#include "sat-log.h"
+
+
+/* Longest coarse step while the satellite is below the horizon (10 min) */
+#define ROUTE_STEP_MAX      0.007
+
+/* Step when the satellite is just below the horizon (about 17 sec) */
+#define ROUTE_STEP_FINE     0.0002
+
+/* Resolution of AOS, LOS and TCA (1 sec) */
+#define ROUTE_TRES          0.0000116
+
+/* Julian Date of the Unix epoch */
+#define UNIX_EPOCH_JD       2440587.5
+
+
+/* Parse an ISO 8601 time or Unix time in seconds into a Julian Date */
+static gboolean parse_time(const gchar * str, gdouble * t)
+{
+    GTimeVal        tv;
+    gchar          *buff;
+    gchar          *end;
+    gdouble         secs;
+    gboolean        ok = FALSE;
+
+    buff = g_strstrip(g_strdup(str));
+
+    secs = g_ascii_strtod(buff, &end);
+    if (end != buff && *end == '\0')
+    {
+        *t = UNIX_EPOCH_JD + secs / 86400.0;
+        ok = TRUE;
+    }
+    else if (g_time_val_from_iso8601(buff, &tv))
+    {
+        *t = UNIX_EPOCH_JD + (tv.tv_sec + tv.tv_usec / 1.0e6) / 86400.0;
+        ok = TRUE;
+    }
+
+    g_free(buff);
+
+    return ok;
+}
+
+/* Parse a number that must make up the whole string */
+static gboolean parse_number(const gchar * str, gdouble * value)
+{
+    gchar          *end;
+
+    while (g_ascii_isspace(*str))
+        str++;
+
+    *value = g_ascii_strtod(str, &end);
+    while (g_ascii_isspace(*end))
+        end++;
+
+    return (end != str && *end == '\0');
+}
+
+static gboolean point_is_valid(route_point_t * point)
+{
+    if (point->lat < -90.0 || point->lat > 90.0)
+        return FALSE;
+
+    if (point->lon < -180.0 || point->lon > 360.0)
+        return FALSE;
+
+    if (point->lon > 180.0)
+        point->lon -= 360.0;
+
+    return TRUE;
+}
+
+/* GPX parser state */
+typedef struct {
+    GArray         *points;
+    route_point_t   point;
+    gboolean        in_point;   /* inside trkpt, rtept or wpt */
+    gboolean        has_time;
+    gboolean        valid;
+    GString        *text;
+    guint           skipped;
+} gpx_parser_t;
+
+static gboolean is_gpx_point(const gchar * element)
+{
+    return (!g_strcmp0(element, "trkpt") || !g_strcmp0(element, "rtept") ||
+            !g_strcmp0(element, "wpt"));
+}
+
+static void gpx_start_element(GMarkupParseContext * context,
+                              const gchar * element,
+                              const gchar ** names, const gchar ** values,
+                              gpointer data, GError ** error)
+{
+    gpx_parser_t   *parser = (gpx_parser_t *) data;
+    gboolean        has_lat = FALSE;
+    gboolean        has_lon = FALSE;
+    guint           i;
+
+    (void)context;
+    (void)error;
+
+    g_string_truncate(parser->text, 0);
+
+    if (!is_gpx_point(element))
+        return;
+
+    parser->in_point = TRUE;
+    parser->has_time = FALSE;
+    parser->point.alt = 0.0;
+
+    for (i = 0; names[i] != NULL; i++)
+    {
+        if (!g_strcmp0(names[i], "lat"))
+            has_lat = parse_number(values[i], &parser->point.lat);
+        else if (!g_strcmp0(names[i], "lon"))
+            has_lon = parse_number(values[i], &parser->point.lon);
+    }
+
+    parser->valid = has_lat && has_lon;
+}
+
+static void gpx_end_element(GMarkupParseContext * context,
+                            const gchar * element, gpointer data,
+                            GError ** error)
+{
+    gpx_parser_t   *parser = (gpx_parser_t *) data;
+
+    (void)context;
+    (void)error;
+
+    if (!parser->in_point)
+        return;
+
+    if (!g_strcmp0(element, "time"))
+    {
+        parser->has_time = parse_time(parser->text->str, &parser->point.t);
+    }
+    else if (!g_strcmp0(element, "ele"))
+    {
+        if (!parse_number(parser->text->str, &parser->point.alt))
+            parser->point.alt = 0.0;
+    }
+    else if (is_gpx_point(element))
+    {
+        if (parser->valid && parser->has_time &&
+            point_is_valid(&parser->point))
+            g_array_append_val(parser->points, parser->point);
+        else
+            parser->skipped++;
+
+        parser->in_point = FALSE;
+    }
+}
+
+static void gpx_text(GMarkupParseContext * context, const gchar * text,
+                     gsize len, gpointer data, GError ** error)
+{
+    gpx_parser_t   *parser = (gpx_parser_t *) data;
+
+    (void)context;
+    (void)error;
+
+    if (parser->in_point)
+        g_string_append_len(parser->text, text, len);
+}
+
+static gboolean read_gpx(const gchar * fname, const gchar * contents,
+                         gsize length, GArray * points)
+{
+    GMarkupParser   markup = {
+        gpx_start_element, gpx_end_element, gpx_text, NULL, NULL
+    };
+    GMarkupParseContext *context;
+    gpx_parser_t    parser;
+    GError         *err = NULL;
+    gboolean        ok;
+
+    memset(&parser, 0, sizeof(parser));
+    parser.points = points;
+    parser.text = g_string_new(NULL);
+
+    context = g_markup_parse_context_new(&markup, 0, &parser, NULL);
+    ok = g_markup_parse_context_parse(context, contents, length, &err) &&
+        g_markup_parse_context_end_parse(context, &err);
+    g_markup_parse_context_free(context);
+    g_string_free(parser.text, TRUE);
+
+    if (!ok)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Error parsing %s (%s)"),
+                    __func__, fname, err->message);
+        g_clear_error(&err);
+    }
+    else if (parser.skipped > 0)
+    {
+        sat_log_log(SAT_LOG_LEVEL_WARN,
+                    _("%s: Skipped %d points without a valid position "
+                      "and time in %s"), __func__, parser.skipped, fname);
+    }
+
+    return ok;
+}
+
+static gboolean read_csv(const gchar * fname, const gchar * contents,
+                         GArray * points)
+{
+    gchar         **lines;
+    gchar         **fields;
+    route_point_t   point;
+    guint           skipped = 0;
+    guint           i;
+    gboolean        first = TRUE;
+    gboolean        ok;
+
+    lines = g_strsplit(contents, "\n", -1);
+
+    for (i = 0; lines[i] != NULL; i++)
+    {
+        g_strstrip(lines[i]);
+        if (lines[i][0] == '\0' || lines[i][0] == '#')
+            continue;
+
+        fields = g_strsplit_set(lines[i], ",;\t", -1);
+        ok = (g_strv_length(fields) >= 3 &&
+              parse_time(fields[0], &point.t) &&
+              parse_number(fields[1], &point.lat) &&
+              parse_number(fields[2], &point.lon));
+
+        point.alt = 0.0;
+        if (ok && fields[3] != NULL && !parse_number(fields[3], &point.alt))
+            point.alt = 0.0;
+
+        if (ok && point_is_valid(&point))
+            g_array_append_val(points, point);
+        else if (!first)
+            skipped++;          /* the first line may be a header */
+
+        first = FALSE;
+        g_strfreev(fields);
+    }
+
+    g_strfreev(lines);
+
+    if (skipped > 0)
+        sat_log_log(SAT_LOG_LEVEL_WARN,
+                    _("%s: Skipped %d invalid lines in %s"),
+                    __func__, skipped, fname);
+
+    return TRUE;
+}
+
+static gint route_point_compare(gconstpointer a, gconstpointer b)
+{
+    gdouble         ta = ((const route_point_t *)a)->t;
+    gdouble         tb = ((const route_point_t *)b)->t;
+
+    return (ta < tb) ? -1 : ((ta > tb) ? 1 : 0);
+}
+
+/**
+ * Read a route from a GPX or CSV file.
+ *
+ * @param fname The name of the file.
+ * @return A new route with a reference count of one or NULL if the file
+ *         could not be read or contains less than two time-stamped points.
+ *         Errors are logged.
+ */
+route_t        *route_read(const gchar * fname)
+{
+    route_t        *route;
+    GArray         *points;
+    GError         *err = NULL;
+    gchar          *contents;
+    const gchar    *p;
+    gsize           length;
+    gboolean        ok;
+
+    if (!g_file_get_contents(fname, &contents, &length, &err))
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Could not read %s (%s)"),
+                    __func__, fname, err->message);
+        g_clear_error(&err);
+
+        return NULL;
+    }
+
+    points = g_array_new(FALSE, FALSE, sizeof(route_point_t));
+
+    /* GPX files start with an XML declaration or the gpx element */
+    for (p = contents; g_ascii_isspace(*p); p++);
+    if (*p == '<')
+        ok = read_gpx(fname, contents, length, points);
+    else
+        ok = read_csv(fname, contents, points);
+
+    g_free(contents);
+
+    if (ok && points->len < 2)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR,
+                    _("%s: %s contains less than two time-stamped points"),
+                    __func__, fname);
+        ok = FALSE;
+    }
+
+    if (!ok)
+    {
+        g_array_free(points, TRUE);
+        return NULL;
+    }
+
+    g_array_sort(points, route_point_compare);
+
+    route = g_new0(route_t, 1);
+    route->name = g_path_get_basename(fname);
+    route->points = points;
+    route->refcount = 1;
+
+    sat_log_log(SAT_LOG_LEVEL_INFO,
+                _("%s: Read route with %d points from %s"),
+                __func__, points->len, fname);
+
+    return route;
+}
+
+route_t        *route_ref(route_t * route)
+{
+    g_atomic_int_inc(&route->refcount);
+
+    return route;
+}
+
+void route_unref(route_t * route)
+{
+    if (route == NULL || !g_atomic_int_dec_and_test(&route->refcount))
+        return;
+
+    g_free(route->name);
+    g_array_free(route->points, TRUE);
+    g_free(route);
+}
+
+/** Time of the first waypoint. */
+gdouble route_start(route_t * route)
+{
+    return g_array_index(route->points, route_point_t, 0).t;
+}
+
+/** Time of the last waypoint. */
+gdouble route_end(route_t * route)
+{
+    return g_array_index(route->points, route_point_t,
+                         route->points->len - 1).t;
+}
+
+/** Smallest absolute latitude along the route. */
+gdouble route_min_abs_lat(route_t * route)
+{
+    route_point_t  *p = (route_point_t *) route->points->data;
+    gdouble         lat = 90.0;
+    guint           i;
+
+    for (i = 0; i < route->points->len; i++)
+    {
+        lat = MIN(lat, fabs(p[i].lat));
+
+        /* the route crosses the equator */
+        if (i > 0 && p[i].lat * p[i - 1].lat < 0.0)
+            lat = 0.0;
+    }
+
+    return lat;
+}
+
+/**
+ * Get the observer position at a given time.
+ *
+ * @param route The route.
+ * @param t The time (Julian Date).
+ * @param cursor Index of the route segment of the previous call. It is used
+ *               as a starting point and updated, so looking up increasing
+ *               or decreasing times does not search the whole route. Use 0
+ *               for the first call.
+ * @param qth The observer; only lat, lon and alt are set.
+ */
+void route_get_position(route_t * route, gdouble t, guint * cursor,
+                        qth_t * qth)
+{
+    route_point_t  *p = (route_point_t *) route->points->data;
+    guint           n = route->points->len;
+    guint           i = MIN(*cursor, n - 1);
+    gdouble         f, dlon, lon, alt;
+
+    if (t <= p[0].t)
+    {
+        i = 0;
+        qth->lat = p[0].lat;
+        qth->lon = p[0].lon;
+        alt = p[0].alt;
+    }
+    else if (t >= p[n - 1].t)
+    {
+        i = n - 1;
+        qth->lat = p[n - 1].lat;
+        qth->lon = p[n - 1].lon;
+        alt = p[n - 1].alt;
+    }
+    else
+    {
+        /* find the segment p[i].t <= t < p[i+1].t */
+        while (i > 0 && p[i].t > t)
+            i--;
+        while (i + 1 < n && p[i + 1].t <= t)
+            i++;
+
+        f = (t - p[i].t) / (p[i + 1].t - p[i].t);
+
+        /* go the short way across the date line */
+        dlon = p[i + 1].lon - p[i].lon;
+        if (dlon > 180.0)
+            dlon -= 360.0;
+        else if (dlon < -180.0)
+            dlon += 360.0;
+
+        lon = p[i].lon + f * dlon;
+        if (lon > 180.0)
+            lon -= 360.0;
+        else if (lon < -180.0)
+            lon += 360.0;
+
+        qth->lat = p[i].lat + f * (p[i + 1].lat - p[i].lat);
+        qth->lon = lon;
+        alt = p[i].alt + f * (p[i + 1].alt - p[i].alt);
+    }
+
+    qth->alt = (gint) rint(alt);
+    *cursor = i;
+}
+
+/* Satellite seen from the route */
+typedef struct {
+    sat_t           sat;        /* working copy of the satellite */
+    route_t        *route;
+    guint           cursor;     /* route segment of the last calculation */
+    qth_t           qth;        /* observer at the last calculation */
+} route_obs_t;
+
+/* Calculate the satellite data seen from the route at time t */
+static gdouble route_calc(route_obs_t * obs, gdouble t)
+{
+    route_get_position(obs->route, t, &obs->cursor, &obs->qth);
+    predict_calc(&obs->sat, &obs->qth, t);
+
+    return obs->sat.el;
+}
+
+/* Bisect the horizon crossing between t0 and t1 */
+static gdouble route_find_horizon(route_obs_t * obs, gdouble t0, gdouble t1)
+{
+    gboolean        above1 = (route_calc(obs, t1) >= 0.0);
+    gdouble         tm;
+
+    while (t1 - t0 > ROUTE_TRES)
+    {
+        tm = (t0 + t1) / 2.0;
+        if ((route_calc(obs, tm) >= 0.0) == above1)
+            t1 = tm;
+        else
+            t0 = tm;
+    }
+
+    /* the time where the satellite is above the horizon */
+    return above1 ? t1 : t0;
+}
+
+/* Find the time of max elevation between t0 and t1 */
+static gdouble route_find_tca(route_obs_t * obs, gdouble t0, gdouble t1)
+{
+    gdouble         m0, m1;
+
+    while (t1 - t0 > ROUTE_TRES)
+    {
+        m0 = t0 + (t1 - t0) / 3.0;
+        m1 = t1 - (t1 - t0) / 3.0;
+        if (route_calc(obs, m0) < route_calc(obs, m1))
+            t0 = m0;
+        else
+            t1 = m1;
+    }
+
+    return (t0 + t1) / 2.0;
+}
+
+/* Append the current satellite data to the details of a pass */
+static void route_add_detail(route_obs_t * obs, pass_t * pass)
+{
+    pass_detail_t  *detail = new_pass_detail(&obs->sat, &obs->qth);
+
+    switch (detail->vis)
+    {
+    case SAT_VIS_VISIBLE:
+        pass->vis[0] = 'V';
+        break;
+    case SAT_VIS_DAYLIGHT:
+        pass->vis[1] = 'D';
+        break;
+    case SAT_VIS_ECLIPSED:
+        pass->vis[2] = 'E';
+        break;
+    default:
+        break;
+    }
+
+    pass->details = g_slist_prepend(pass->details, detail);
+}
+
+/* Follow a pass from AOS to LOS or the end of the route */
+static pass_t  *route_follow_pass(route_obs_t * obs, gdouble aos, gdouble end,
+                                  gdouble step)
+{
+    pass_t         *pass;
+    gdouble         t, prev;
+    gdouble         tlast = aos;        /* time of the last detail */
+    gdouble         tmax = aos;
+    gdouble         max_el = -90.0;
+
+    pass = g_new0(pass_t, 1);
+    pass->satname = g_strdup(obs->sat.nickname);
+    pass->aos = aos;
+    g_strlcpy(pass->vis, "---", sizeof(pass->vis));
+
+    route_calc(obs, aos);
+    pass->aos_az = obs->sat.az;
+    pass->orbit = obs->sat.orbit;
+
+    for (prev = t = aos; ; prev = t, t = MIN(t + step, end))
+    {
+        if (route_calc(obs, t) < 0.0)
+        {
+            pass->los = route_find_horizon(obs, prev, t);
+            break;
+        }
+
+        route_add_detail(obs, pass);
+        tlast = t;
+
+        if (obs->sat.el > max_el)
+        {
+            max_el = obs->sat.el;
+            tmax = t;
+        }
+
+        if (t >= end)
+        {
+            pass->los = end;
+            break;
+        }
+    }
+
+    /* last point of the pass */
+    route_calc(obs, pass->los);
+    if (pass->los > tlast)
+        route_add_detail(obs, pass);
+    pass->details = g_slist_reverse(pass->details);
+    pass->los_az = obs->sat.az;
+
+    pass->tca = route_find_tca(obs, MAX(aos, tmax - step),
+                               MIN(pass->los, tmax + step));
+    route_calc(obs, pass->tca);
+    pass->max_el = obs->sat.el;
+    pass->maxel_az = obs->sat.az;
+    qth_small_save(&obs->qth, &pass->qth_comp);
+
+    return pass;
+}
+
+/**
+ * Predict the passes of a satellite along a route.
+ *
+ * @param sat The satellite.
+ * @param route The route of the observer.
+ * @param start Start of the search (Julian Date).
+ * @param maxdt Length of the search in days, 0 to search until the end of
+ *              the route.
+ * @param min_el Minimum of the max elevation in degrees.
+ * @param cancelled Flag checked in each step of the search (atomic); the
+ *                  search stops and returns the passes found so far when it
+ *                  is set. May be NULL.
+ * @return A list of passes in chronological order. Passes are cut at the
+ *         start and end of the route. The details and the azimuth and
+ *         elevation values refer to the observer position at the time of
+ *         each point, qth_comp holds the observer position at TCA. Free the
+ *         list with free_passes().
+ */
+GSList         *get_route_passes(sat_t * sat, route_t * route, gdouble start,
+                                 gdouble maxdt, gdouble min_el,
+                                 gint * cancelled)
+{
+    route_obs_t     obs;
+    GSList         *passes = NULL;
+    pass_t         *pass;
+    gdouble         t, end, el, step, prev, pstep;
+
+    t = MAX(start, route_start(route));
+    end = route_end(route);
+    if (maxdt > 0.0)
+        end = MIN(end, start + maxdt);
+
+    memset(&obs, 0, sizeof(obs));
+    memcpy(&obs.sat, sat, sizeof(sat_t));
+    obs.route = route;
+
+    /* also excludes geostationary and decayed satellites */
+    obs.qth.lat = route_min_abs_lat(route);
+    if (t >= end || !has_aos(sat, &obs.qth))
+        return NULL;
+
+    /* same time resolution as the fixed observer passes */
+    pstep = MAX(sat_cfg_get_int(SAT_CFG_INT_PRED_RESOLUTION) / 86400.0,
+                ROUTE_TRES);
+
+    el = route_calc(&obs, t);
+
+    while (t < end)
+    {
+        if (cancelled != NULL && g_atomic_int_get(cancelled))
+            break;
+
+        if (el < 0.0)
+        {
+            /* coarse steps as in find_aos() */
+            if (el < -1.0)
+                step = -0.00035 * (el * ((obs.sat.alt / 8400.0) + 0.46) -
+                                   2.0);
+            else
+                step = ROUTE_STEP_FINE;
+
+            prev = t;
+            t = MIN(t + MIN(step, ROUTE_STEP_MAX), end);
+            el = route_calc(&obs, t);
+
+            if (el < 0.0)
+            {
+                if (t >= end)
+                    break;
+
+                continue;
+            }
+
+            t = route_find_horizon(&obs, prev, t);
+        }
+
+        /* t is the AOS or the start of the route during a pass */
+        pass = route_follow_pass(&obs, t, end, pstep);
+        t = pass->los + 0.014;  // +20 min, same as get_passes()
+
+        if (pass->max_el >= min_el)
+            passes = g_slist_prepend(passes, pass);
+        else
+            free_pass(pass);
+
+        if (t < end)
+            el = route_calc(&obs, t);
+    }
+
+    return g_slist_reverse(passes);
+}
@@ -0,0 +1,42 @@
+#ifndef ROUTE_H
+#define ROUTE_H 1
+
+#include <glib.h>
+
+#include "predict-tools.h"
+#include "qth-data.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/** Time-stamped route waypoint. */
+typedef struct {
+    gdouble         t;          /*!< Time (Julian Date). */
+    gdouble         lat;        /*!< Latitude in dec. deg. North. */
+    gdouble         lon;        /*!< Longitude in dec. deg. East. */
+    gdouble         alt;        /*!< Altitude above sea level in meters. */
+} route_point_t;
+
+/**
+ * Planned route of a moving observer.
+ *
+ * Routes are not modified after they have been read and can be shared
+ * between threads using route_ref() and route_unref().
+ */
+typedef struct {
+    gchar          *name;       /*!< Name of the route file. */
+    GArray         *points;     /*!< route_point_t in chronological order. */
+    gint            refcount;
+} route_t;
+
+route_t        *route_read(const gchar * fname);
+route_t        *route_ref(route_t * route);
+void            route_unref(route_t * route);
+gdouble         route_start(route_t * route);
+gdouble         route_end(route_t * route);
+gdouble         route_min_abs_lat(route_t * route);
+void            route_get_position(route_t * route, gdouble t, guint * cursor,
+                                   qth_t * qth);
+GSList         *get_route_passes(sat_t * sat, route_t * route, gdouble start,
+                                 gdouble maxdt, gdouble min_el,
+                                 gint * cancelled);
+
+#endif
@@ -0,0 +1,166 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Versioned catalog of the element sets written by TLE updates.
+ *
+ * The TLE update runs in a background thread while the modules keep running
+ * in the main loop. Instead of having the modules re-read the .sat files, the
+ * update builds a new catalog version holding the elements it has written
+ * and publishes it by swapping a single pointer. A published catalog is never
+ * modified, so the modules read it without locking; they compare its version
+ * with the version they have adopted at the start of each tick.
+ *
+ * A new version starts as a copy of the current one (copy-on-write), so the
+ * latest catalog holds all elements updated since gpredict was started. Only
+ * one writer can build a version at a time. The replaced version is freed in
+ * the main loop from an idle callback: readers only use a catalog within one
+ * main loop callback, so no reader can hold the old version by then.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include "sat-catalog.h"
+
+
+struct _sat_catalog {
+    guint           version;    /*!< Version number, starting at 1 */
+    GHashTable     *tles;       /*!< tle_t keyed on their catnr field */
+};
+
+
+/* The published catalog or NULL; use atomic access only */
+static sat_catalog_t *current = NULL;
+
+/* Held by the writer from sat_catalog_begin() until publish or discard */
+static GMutex   writer;
+
+
+static void free_catalog(sat_catalog_t * catalog)
+{
+    g_hash_table_destroy(catalog->tles);
+    g_free(catalog);
+}
+
+static gboolean free_catalog_cb(gpointer data)
+{
+    free_catalog((sat_catalog_t *) data);
+
+    return FALSE;
+}
+
+/**
+ * Get the published catalog.
+ *
+ * @return The current catalog version or NULL if no TLE update has been
+ *         published yet.
+ *
+ * Must be called from the main loop. The catalog remains valid until the
+ * caller returns to the main loop and must not be modified.
+ */
+sat_catalog_t  *sat_catalog_get(void)
+{
+    return (sat_catalog_t *) g_atomic_pointer_get(&current);
+}
+
+guint sat_catalog_version(sat_catalog_t * catalog)
+{
+    return catalog->version;
+}
+
+/** Get the elements of a satellite or NULL if it is not in the catalog. */
+const tle_t    *sat_catalog_lookup(sat_catalog_t * catalog, gint catnr)
+{
+    return (const tle_t *) g_hash_table_lookup(catalog->tles, &catnr);
+}
+
+/**
+ * Start a new catalog version.
+ *
+ * @return A private copy of the current catalog. Add elements using
+ *         sat_catalog_set() and finish with sat_catalog_publish() or
+ *         sat_catalog_discard().
+ *
+ * Blocks while another writer is building a version. May be called from
+ * any thread.
+ */
+sat_catalog_t  *sat_catalog_begin(void)
+{
+    sat_catalog_t  *catalog, *old;
+    GHashTableIter  iter;
+    gpointer        value;
+
+    g_mutex_lock(&writer);
+
+    catalog = g_new0(sat_catalog_t, 1);
+    catalog->tles = g_hash_table_new_full(g_int_hash, g_int_equal, NULL,
+                                          g_free);
+    catalog->version = 1;
+
+    /* only writers replace the catalog, so old stays valid here */
+    old = sat_catalog_get();
+    if (old != NULL)
+    {
+        catalog->version = old->version + 1;
+
+        g_hash_table_iter_init(&iter, old->tles);
+        while (g_hash_table_iter_next(&iter, NULL, &value))
+            sat_catalog_set(catalog, (const tle_t *) value);
+    }
+
+    return catalog;
+}
+
+/** Add or replace the elements of a satellite in an unpublished catalog. */
+void sat_catalog_set(sat_catalog_t * catalog, const tle_t * tle)
+{
+    tle_t          *copy;
+
+    copy = g_new(tle_t, 1);
+    *copy = *tle;
+    g_hash_table_replace(catalog->tles, &copy->catnr, copy);
+}
+
+/**
+ * Publish a catalog version.
+ *
+ * @param catalog The catalog returned by sat_catalog_begin().
+ *
+ * The catalog must not be modified after this call.
+ */
+void sat_catalog_publish(sat_catalog_t * catalog)
+{
+    sat_catalog_t  *old;
+
+    old = sat_catalog_get();
+    g_atomic_pointer_set(&current, catalog);
+    g_mutex_unlock(&writer);
+
+    if (old != NULL)
+        g_idle_add(free_catalog_cb, old);
+}
+
+/** Drop an unpublished catalog. */
+void sat_catalog_discard(sat_catalog_t * catalog)
+{
+    free_catalog(catalog);
+    g_mutex_unlock(&writer);
+}
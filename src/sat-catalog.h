@@ -0,0 +1,22 @@
+#ifndef SAT_CATALOG_H
+#define SAT_CATALOG_H 1
+
+#include <glib.h>
+
+#include "sgpsdp/sgp4sdp4.h"
+
+/** Opaque satellite catalog handle. */
+typedef struct _sat_catalog sat_catalog_t;
+
+/* readers, main loop only */
+sat_catalog_t  *sat_catalog_get(void);
+guint           sat_catalog_version(sat_catalog_t * catalog);
+const tle_t    *sat_catalog_lookup(sat_catalog_t * catalog, gint catnr);
+
+/* writers */
+sat_catalog_t  *sat_catalog_begin(void);
+void            sat_catalog_set(sat_catalog_t * catalog, const tle_t * tle);
+void            sat_catalog_publish(sat_catalog_t * catalog);
+void            sat_catalog_discard(sat_catalog_t * catalog);
+
+#endif
@@ -186,6 +186,7 @@ sat_cfg_int_t   sat_cfg_int[SAT_CFG_INT_NUM] = {
     {"PREDICT", "SAVE_FORMAT", 0},
     {"PREDICT", "SAVE_CONTENTS", 0},
     {"PREDICT", "TWILIGHT_THRESHOLD", -6},
+    {"PREDICT", "APPROX_MAX_ERROR", 1000},
     {"SKY_AT_GLANCE", "TIME_SPAN_HOURS", 8},
     {"SKY_AT_GLANCE", "COLOUR_01", 0x3c46c8},
     {"SKY_AT_GLANCE", "COLOUR_02", 0x00500a},
@@ -205,6 +206,7 @@ sat_cfg_int_t   sat_cfg_int[SAT_CFG_INT_NUM] = {
     {"TLE", "AUTO_UPDATE_FREQ", 2},     /* weekly, see tle_auto_upd_freq_t */
     {"TLE", "AUTO_UPDATE_ACTION", 1},   /* notify, see tle_auto_upd_action_t */
     {"TLE", "LAST_UPDATE", 0},
+    {"TLE", "MAX_AGE", 72},     /* 0 = Only check the update frequency */
     {"LOG", "CLEAN_AGE", 0},    /* 0 = Never clean */
     {"LOG", "LEVEL", 2}
 };
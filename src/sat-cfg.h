@@ -107,6 +107,7 @@ typedef enum {
     SAT_CFG_INT_PRED_SAVE_FORMAT,       /*!< Last used save format for predictions */
     SAT_CFG_INT_PRED_SAVE_CONTENTS,     /*!< Last selection for save file contents */
     SAT_CFG_INT_PRED_TWILIGHT_THLD,     /*!< Twilight zone threshold */
+    SAT_CFG_INT_PRED_APPROX_ERR,        /*!< Position error bound of background satellites [m] */
     SAT_CFG_INT_SKYATGL_TIME,   /*!< Time span for sky at a glance predictions */
     SAT_CFG_INT_SKYATGL_COL_01, /*!< Colour 1 in sky at a glance predictions */
     SAT_CFG_INT_SKYATGL_COL_02, /*!< Colour 2 in sky at a glance predictions */
@@ -126,6 +127,7 @@ typedef enum {
     SAT_CFG_INT_TLE_AUTO_UPD_FREQ,      /*!< TLE auto-update frequency. */
     SAT_CFG_INT_TLE_AUTO_UPD_ACTION,    /*!< TLE auto-update action. */
     SAT_CFG_INT_TLE_LAST_UPDATE,        /*!< Date and time of last update, Unix seconds. */
+    SAT_CFG_INT_TLE_MAX_AGE,    /*!< Refresh sources with older elements (hours) */
     SAT_CFG_INT_LOG_CLEAN_AGE,  /*!< Age of log file to delete (seconds) */
     SAT_CFG_INT_LOG_LEVEL,      /*!< Logging level */
     SAT_CFG_INT_NUM             /*!< Number of integer parameters. */
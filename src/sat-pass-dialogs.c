@@ -230,9 +230,6 @@ static gboolean button_press_cb(GtkWidget * treeview,
 static void     view_popup_menu(GtkWidget * treeview,
                                 GdkEventButton * event, gpointer data);
 
-static void     Calc_RADec(gdouble jul_utc, gdouble saz, gdouble sel,
-                           qth_t * qth, obs_astro_t * obs_set);
-
 static void     single_pass_response(GtkWidget * dialog, gint response,
                                      gpointer data);
 static void     multi_pass_response(GtkWidget * dialog, gint response,
@@ -363,7 +360,7 @@ void show_pass(const gchar * satname, qth_t * qth, pass_t * pass,
         /*     SINGLE_PASS_COL_DEC */
         if (flags & (SINGLE_PASS_FLAG_RA | SINGLE_PASS_FLAG_DEC))
         {
-            Calc_RADec(detail->time, detail->az, detail->el, qth, &astro);
+            calc_radec(detail->time, detail->az, detail->el, qth, &astro);
 
             ra = Degrees(astro.ra);
             dec = Degrees(astro.dec);
@@ -518,6 +515,124 @@ void show_pass(const gchar * satname, qth_t * qth, pass_t * pass,
     gtk_widget_show_all(dialog);
 }
 
+/** Show the pass found by the asynchronous search and close progress dialog */
+static void next_pass_found(pass_t * pass, gpointer data)
+{
+    GtkWidget      *dialog = GTK_WIDGET(data);
+    GtkWindow      *toplevel = gtk_window_get_transient_for(GTK_WINDOW(dialog));
+    qth_t          *qth;
+
+    qth = (qth_t *) g_object_get_data(G_OBJECT(dialog), "qth");
+    show_pass(pass->satname, qth, pass, GTK_WIDGET(toplevel));
+
+    /* this will also cancel the search */
+    gtk_widget_destroy(dialog);
+}
+
+/** Tell the user that there are no passes within the look-ahead period */
+static void next_pass_done(guint count, gpointer data)
+{
+    GtkWidget      *dialog = GTK_WIDGET(data);
+    GtkWidget      *spinner;
+    GtkWidget      *label;
+    gchar          *text;
+
+    g_object_set_data(G_OBJECT(dialog), "search", NULL);
+
+    if (count > 0)
+        return;
+
+    spinner = GTK_WIDGET(g_object_get_data(G_OBJECT(dialog), "spinner"));
+    label = GTK_WIDGET(g_object_get_data(G_OBJECT(dialog), "status"));
+
+    gtk_spinner_stop(GTK_SPINNER(spinner));
+    gtk_widget_hide(spinner);
+
+    text = g_strdup_printf(_("Satellite %s has no passes\n"
+                             "within the next %d days"),
+                           (gchar *) g_object_get_data(G_OBJECT(dialog),
+                                                       "satname"),
+                           GPOINTER_TO_INT(g_object_get_data
+                                           (G_OBJECT(dialog), "days")));
+    gtk_label_set_text(GTK_LABEL(label), text);
+    g_free(text);
+}
+
+static void next_pass_progress_destroy(GtkWidget * dialog, gpointer data)
+{
+    pass_search_t  *search =
+        (pass_search_t *) g_object_get_data(G_OBJECT(dialog), "search");
+
+    (void)data;
+
+    if (search != NULL)
+    {
+        pass_search_cancel(search);
+        g_object_set_data(G_OBJECT(dialog), "search", NULL);
+    }
+}
+
+/**
+ * Predict the next pass without blocking and show its details.
+ *
+ * @param sat Pointer to the satellite data.
+ * @param qth Pointer to the QTH data.
+ * @param start The time where the search starts.
+ * @param maxdt The number of days to look ahead.
+ * @param toplevel The toplevel window or NULL.
+ *
+ * A small progress dialog is shown while the pass is predicted in a worker
+ * thread. Once the pass has been found the progress dialog is replaced by
+ * the pass details dialog. Closing the progress dialog cancels the search.
+ */
+void show_next_pass_async(sat_t * sat, qth_t * qth, gdouble start,
+                          gdouble maxdt, GtkWidget * toplevel)
+{
+    GtkWidget      *dialog;
+    GtkWidget      *hbox;
+    GtkWidget      *spinner;
+    GtkWidget      *label;
+    pass_search_t  *search;
+    gchar          *title;
+
+    title = g_strdup_printf(_("Next pass for %s"), sat->nickname);
+    dialog = gtk_dialog_new_with_buttons(title,
+                                         GTK_WINDOW(toplevel),
+                                         GTK_DIALOG_DESTROY_WITH_PARENT,
+                                         "_Close", GTK_RESPONSE_CLOSE,
+                                         NULL);
+    g_free(title);
+    gtk_window_set_modal(GTK_WINDOW(dialog), FALSE);
+
+    spinner = gtk_spinner_new();
+    label = gtk_label_new(_("Predicting next pass..."));
+    hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
+    gtk_container_set_border_width(GTK_CONTAINER(hbox), 10);
+    gtk_box_pack_start(GTK_BOX(hbox), spinner, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(hbox), label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(gtk_dialog_get_content_area(GTK_DIALOG(dialog))),
+                       hbox, TRUE, TRUE, 0);
+
+    g_object_set_data(G_OBJECT(dialog), "qth", qth);
+    g_object_set_data(G_OBJECT(dialog), "spinner", spinner);
+    g_object_set_data(G_OBJECT(dialog), "status", label);
+    g_object_set_data(G_OBJECT(dialog), "days", GINT_TO_POINTER((gint) maxdt));
+    g_object_set_data_full(G_OBJECT(dialog), "satname",
+                           g_strdup(sat->nickname), g_free);
+
+    g_signal_connect_swapped(dialog, "response",
+                             G_CALLBACK(gtk_widget_destroy), dialog);
+    g_signal_connect(dialog, "destroy", G_CALLBACK(next_pass_progress_destroy),
+                     NULL);
+
+    gtk_widget_show_all(dialog);
+    gtk_spinner_start(GTK_SPINNER(spinner));
+
+    search = get_passes_async(sat, qth, start, maxdt, 1,
+                              next_pass_found, next_pass_done, dialog);
+    g_object_set_data(G_OBJECT(dialog), "search", search);
+}
+
 /**
  * Manage button responses for single-pass dialogues.
  *
@@ -865,80 +980,31 @@ static void single_pass_dialog_destroy(GtkWidget * dialog, gpointer data)
     gtk_widget_destroy(dialog);
 }
 
-/*** FIXME: other copies */
-static void Calc_RADec(gdouble jul_utc, gdouble saz, gdouble sel,
-                       qth_t * qth, obs_astro_t * obs_set)
-{
-
-    double          phi, theta, sin_theta, cos_theta, sin_phi, cos_phi,
-        az, el, Lxh, Lyh, Lzh, Sx, Ex, Zx, Sy, Ey, Zy, Sz, Ez, Zz,
-        Lx, Ly, Lz, cos_delta, sin_alpha, cos_alpha;
-    geodetic_t      geodetic;
-
-    geodetic.lon = qth->lon * de2ra;
-    geodetic.lat = qth->lat * de2ra;
-    geodetic.alt = qth->alt / 1000.0;
-    geodetic.theta = 0;
-
-    az = saz * de2ra;
-    el = sel * de2ra;
-    phi = geodetic.lat;
-    theta = FMod2p(ThetaG_JD(jul_utc) + geodetic.lon);
-    sin_theta = sin(theta);
-    cos_theta = cos(theta);
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
-    Lxh = -cos(az) * cos(el);
-    Lyh = sin(az) * cos(el);
-    Lzh = sin(el);
-    Sx = sin_phi * cos_theta;
-    Ex = -sin_theta;
-    Zx = cos_theta * cos_phi;
-    Sy = sin_phi * sin_theta;
-    Ey = cos_theta;
-    Zy = sin_theta * cos_phi;
-    Sz = -cos_phi;
-    Ez = 0;
-    Zz = sin_phi;
-    Lx = Sx * Lxh + Ex * Lyh + Zx * Lzh;
-    Ly = Sy * Lxh + Ey * Lyh + Zy * Lzh;
-    Lz = Sz * Lxh + Ez * Lyh + Zz * Lzh;
-    obs_set->dec = ArcSin(Lz);  /* Declination (radians) */
-    cos_delta = sqrt(1 - Sqr(Lz));
-    sin_alpha = Ly / cos_delta;
-    cos_alpha = Lx / cos_delta;
-    obs_set->ra = AcTan(sin_alpha, cos_alpha);  /* Right Ascension (radians) */
-    obs_set->ra = FMod2p(obs_set->ra);
-}
-
 /***   MULTI PASS  ***/
 
 /**
- * Show details about a satellite pass.
+ * Create a multi-pass dialog with an empty pass list.
  *
  * @param satname The name of the satellite.
  * @param qth Pointer to the QTH data.
- * @param passes List of passes to show.
  * @param toplevel The toplevel window or NULL.
+ * @return The dialog widget; it has not been shown yet.
  *
- * This function creates a dialog window with a list showing the
- * details of a pass.
- *
+ * Passes are added to the dialog using multi_pass_dialog_add_pass. The list
+ * of passes is owned by the dialog and freed when the dialog is destroyed.
  */
-void show_passes(const gchar * satname, qth_t * qth, GSList * passes,
-                 GtkWidget * toplevel)
+static GtkWidget *create_multi_pass_dialog(const gchar * satname,
+                                           qth_t * qth, GtkWidget * toplevel)
 {
     GtkWidget      *dialog;
     GtkWidget      *list;
     GtkListStore   *liststore;
     GtkCellRenderer *renderer;
     GtkTreeViewColumn *column;
-    GtkTreeIter     item;
     GtkWidget      *swin;
     gchar          *title;
     guint           flags;
-    guint           i, num;
-    pass_t         *pass = NULL;
+    guint           i;
     gchar          *buff;
 
     /* get columns flags */
@@ -972,7 +1038,7 @@ void show_passes(const gchar * satname, qth_t * qth, GSList * passes,
         }
     }
 
-    /* create and fill model */
+    /* create model; rows are added by multi_pass_dialog_add_pass */
     liststore = gtk_list_store_new(MULTI_PASS_COL_NUMBER + 1, G_TYPE_DOUBLE,    // aos time
                                    G_TYPE_DOUBLE,       // tca time
                                    G_TYPE_DOUBLE,       // los time
@@ -985,33 +1051,12 @@ void show_passes(const gchar * satname, qth_t * qth, GSList * passes,
                                    G_TYPE_STRING,       // visibility
                                    G_TYPE_INT); // row number
 
-    /* add rows to list store */
-    num = g_slist_length(passes);
-
-    for (i = 0; i < num; i++)
-    {
-        pass = PASS(g_slist_nth_data(passes, i));
-        gtk_list_store_append(liststore, &item);
-        gtk_list_store_set(liststore, &item,
-                           MULTI_PASS_COL_AOS_TIME, pass->aos,
-                           MULTI_PASS_COL_TCA, pass->tca,
-                           MULTI_PASS_COL_LOS_TIME, pass->los,
-                           MULTI_PASS_COL_DURATION, (pass->los - pass->aos),
-                           MULTI_PASS_COL_AOS_AZ, pass->aos_az,
-                           MULTI_PASS_COL_MAX_EL, pass->max_el,
-                           MULTI_PASS_COL_MAX_EL_AZ, pass->maxel_az,
-                           MULTI_PASS_COL_LOS_AZ, pass->los_az,
-                           MULTI_PASS_COL_ORBIT, pass->orbit,
-                           MULTI_PASS_COL_VIS, pass->vis,
-                           MULTI_PASS_COL_NUMBER, i, -1);
-    }
-
     /* connect model to tree view */
     gtk_tree_view_set_model(GTK_TREE_VIEW(list), GTK_TREE_MODEL(liststore));
     g_object_unref(liststore);
 
     /* store reference to passes and QTH */
-    g_object_set_data(G_OBJECT(list), "passes", passes);
+    g_object_set_data(G_OBJECT(list), "passes", NULL);
     g_object_set_data(G_OBJECT(list), "qth", qth);
 
     /* mouse events => popup menu */
@@ -1058,7 +1103,10 @@ void show_passes(const gchar * satname, qth_t * qth, GSList * passes,
 
     g_object_set_data(G_OBJECT(dialog), "sat", (gpointer) satname);
     g_object_set_data(G_OBJECT(dialog), "qth", qth);
-    g_object_set_data(G_OBJECT(dialog), "passes", passes);
+    g_object_set_data(G_OBJECT(dialog), "passes", NULL);
+    g_object_set_data(G_OBJECT(dialog), "passes_tail", NULL);
+    g_object_set_data(G_OBJECT(dialog), "npasses", GUINT_TO_POINTER(0));
+    g_object_set_data(G_OBJECT(dialog), "list", list);
 
     g_signal_connect(dialog, "response", G_CALLBACK(multi_pass_response),
                      NULL);
@@ -1071,9 +1119,177 @@ void show_passes(const gchar * satname, qth_t * qth, GSList * passes,
                        swin, TRUE, TRUE, 0);
 
     gtk_window_set_default_size(GTK_WINDOW(dialog), -1, 300);
+
+    return dialog;
+}
+
+/**
+ * Append a pass to a multi-pass dialog.
+ *
+ * @param dialog The dialog created by create_multi_pass_dialog.
+ * @param pass The pass to add. The dialog takes ownership of the pass.
+ */
+static void multi_pass_dialog_add_pass(GtkWidget * dialog, pass_t * pass)
+{
+    GtkWidget      *list;
+    GtkListStore   *liststore;
+    GtkTreeIter     item;
+    GSList         *passes;
+    GSList         *tail;
+    GSList         *node;
+    guint           i;
+
+    list = GTK_WIDGET(g_object_get_data(G_OBJECT(dialog), "list"));
+    liststore =
+        GTK_LIST_STORE(gtk_tree_view_get_model(GTK_TREE_VIEW(list)));
+    passes = (GSList *) g_object_get_data(G_OBJECT(dialog), "passes");
+    tail = (GSList *) g_object_get_data(G_OBJECT(dialog), "passes_tail");
+
+    /* row number is the index of the pass in the list; the tail is kept
+       so that streaming a long search does not walk the list every time */
+    i = GPOINTER_TO_UINT(g_object_get_data(G_OBJECT(dialog), "npasses"));
+    node = g_slist_prepend(NULL, pass);
+    if (tail == NULL)
+        passes = node;
+    else
+        tail->next = node;
+
+    gtk_list_store_append(liststore, &item);
+    gtk_list_store_set(liststore, &item,
+                       MULTI_PASS_COL_AOS_TIME, pass->aos,
+                       MULTI_PASS_COL_TCA, pass->tca,
+                       MULTI_PASS_COL_LOS_TIME, pass->los,
+                       MULTI_PASS_COL_DURATION, (pass->los - pass->aos),
+                       MULTI_PASS_COL_AOS_AZ, pass->aos_az,
+                       MULTI_PASS_COL_MAX_EL, pass->max_el,
+                       MULTI_PASS_COL_MAX_EL_AZ, pass->maxel_az,
+                       MULTI_PASS_COL_LOS_AZ, pass->los_az,
+                       MULTI_PASS_COL_ORBIT, pass->orbit,
+                       MULTI_PASS_COL_VIS, pass->vis,
+                       MULTI_PASS_COL_NUMBER, i, -1);
+
+    g_object_set_data(G_OBJECT(list), "passes", passes);
+    g_object_set_data(G_OBJECT(dialog), "passes", passes);
+    g_object_set_data(G_OBJECT(dialog), "passes_tail", node);
+    g_object_set_data(G_OBJECT(dialog), "npasses", GUINT_TO_POINTER(i + 1));
+}
+
+/**
+ * Show details about a satellite pass.
+ *
+ * @param satname The name of the satellite.
+ * @param qth Pointer to the QTH data.
+ * @param passes List of passes to show.
+ * @param toplevel The toplevel window or NULL.
+ *
+ * This function creates a dialog window with a list showing the
+ * details of a pass.
+ *
+ */
+void show_passes(const gchar * satname, qth_t * qth, GSList * passes,
+                 GtkWidget * toplevel)
+{
+    GtkWidget      *dialog;
+    GSList         *iter;
+
+    dialog = create_multi_pass_dialog(satname, qth, toplevel);
+
+    for (iter = passes; iter != NULL; iter = iter->next)
+        multi_pass_dialog_add_pass(dialog, PASS(iter->data));
+
+    /* the passes are now owned by the dialog */
+    g_slist_free(passes);
+
     gtk_widget_show_all(dialog);
 }
 
+/** Add a pass found by the asynchronous search to the multi-pass dialog. */
+static void multi_pass_found(pass_t * pass, gpointer data)
+{
+    multi_pass_dialog_add_pass(GTK_WIDGET(data), pass);
+}
+
+/** Update status of the multi-pass dialog when the search is complete. */
+static void multi_pass_done(guint count, gpointer data)
+{
+    GtkWidget      *dialog = GTK_WIDGET(data);
+    GtkWidget      *spinner;
+    GtkWidget      *label;
+    gchar          *text;
+    gint            days;
+
+    g_object_set_data(G_OBJECT(dialog), "search", NULL);
+
+    spinner = GTK_WIDGET(g_object_get_data(G_OBJECT(dialog), "spinner"));
+    label = GTK_WIDGET(g_object_get_data(G_OBJECT(dialog), "status"));
+    days = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(dialog), "days"));
+
+    gtk_spinner_stop(GTK_SPINNER(spinner));
+    gtk_widget_hide(spinner);
+
+    if (count == 0)
+    {
+        text = g_strdup_printf(_("Satellite has no passes "
+                                 "within the next %d days"), days);
+        gtk_label_set_text(GTK_LABEL(label), text);
+        g_free(text);
+    }
+    else
+    {
+        gtk_widget_hide(label);
+    }
+}
+
+/**
+ * Show upcoming passes while they are being predicted.
+ *
+ * @param sat Pointer to the satellite data.
+ * @param qth Pointer to the QTH data.
+ * @param start The time where the search starts.
+ * @param maxdt The number of days to look ahead.
+ * @param num The number of passes to predict.
+ * @param toplevel The toplevel window or NULL.
+ *
+ * The dialog is shown immediately and the passes are predicted in a worker
+ * thread. Each pass is appended to the list as soon as it has been found.
+ * Closing the dialog cancels the prediction.
+ */
+void show_passes_async(sat_t * sat, qth_t * qth, gdouble start,
+                       gdouble maxdt, guint num, GtkWidget * toplevel)
+{
+    GtkWidget      *dialog;
+    GtkWidget      *hbox;
+    GtkWidget      *spinner;
+    GtkWidget      *label;
+    pass_search_t  *search;
+    gchar          *satname;
+
+    /* the dialog may outlive the satellite */
+    satname = g_strdup(sat->nickname);
+    dialog = create_multi_pass_dialog(satname, qth, toplevel);
+    g_object_set_data_full(G_OBJECT(dialog), "satname", satname, g_free);
+
+    /* progress indicator */
+    spinner = gtk_spinner_new();
+    label = gtk_label_new(_("Predicting passes..."));
+    hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+    gtk_box_pack_start(GTK_BOX(hbox), spinner, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(hbox), label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(gtk_dialog_get_content_area(GTK_DIALOG(dialog))),
+                       hbox, FALSE, FALSE, 5);
+
+    g_object_set_data(G_OBJECT(dialog), "spinner", spinner);
+    g_object_set_data(G_OBJECT(dialog), "status", label);
+    g_object_set_data(G_OBJECT(dialog), "days", GINT_TO_POINTER((gint) maxdt));
+
+    gtk_widget_show_all(dialog);
+    gtk_spinner_start(GTK_SPINNER(spinner));
+
+    search = get_passes_async(sat, qth, start, maxdt, num,
+                              multi_pass_found, multi_pass_done, dialog);
+    g_object_set_data(G_OBJECT(dialog), "search", search);
+}
+
 /**
  * Manage button responses for multi-pass dialogues.
  *
@@ -1120,10 +1336,21 @@ static void multi_pass_dialog_destroy(GtkWidget * dialog, gpointer data)
 {
     GSList         *passes =
         (GSList *) g_object_get_data(G_OBJECT(dialog), "passes");
+    pass_search_t  *search =
+        (pass_search_t *) g_object_get_data(G_OBJECT(dialog), "search");
 
     (void)data;
 
+    /* stop prediction if still running */
+    if (search != NULL)
+    {
+        pass_search_cancel(search);
+        g_object_set_data(G_OBJECT(dialog), "search", NULL);
+    }
+
     free_passes(passes);
+    g_object_set_data(G_OBJECT(dialog), "passes", NULL);
+    g_object_set_data(G_OBJECT(dialog), "passes_tail", NULL);
     gtk_widget_destroy(dialog);
 }
 
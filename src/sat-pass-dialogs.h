@@ -113,5 +113,10 @@ void            show_pass(const gchar * satname, qth_t * qth, pass_t * pass,
                           GtkWidget * toplevel);
 void            show_passes(const gchar * satname, qth_t * qth,
                             GSList * passes, GtkWidget * toplevel);
+void            show_next_pass_async(sat_t * sat, qth_t * qth, gdouble start,
+                                     gdouble maxdt, GtkWidget * toplevel);
+void            show_passes_async(sat_t * sat, qth_t * qth, gdouble start,
+                                  gdouble maxdt, guint num,
+                                  GtkWidget * toplevel);
 
 #endif
@@ -33,6 +33,7 @@ static GtkWidget *lookahead;
 static GtkWidget *res;
 static GtkWidget *nument;
 static GtkWidget *twspin;
+static GtkWidget *apperr;
 
 static gboolean dirty = FALSE;  /* used to check whether any changes have occurred */
 static gboolean reset = FALSE;
@@ -66,6 +67,9 @@ void sat_pref_conditions_ok()
         sat_cfg_set_int(SAT_CFG_INT_PRED_TWILIGHT_THLD,
                         gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON
                                                          (twspin)));
+        sat_cfg_set_int(SAT_CFG_INT_PRED_APPROX_ERR,
+                        gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON
+                                                         (apperr)));
         sat_cfg_set_bool(SAT_CFG_BOOL_PRED_USE_REAL_T0,
                          gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON
                                                       (tzero)));
@@ -80,6 +84,7 @@ void sat_pref_conditions_ok()
         sat_cfg_reset_int(SAT_CFG_INT_PRED_RESOLUTION);
         sat_cfg_reset_int(SAT_CFG_INT_PRED_NUM_ENTRIES);
         sat_cfg_reset_int(SAT_CFG_INT_PRED_TWILIGHT_THLD);
+        sat_cfg_reset_int(SAT_CFG_INT_PRED_APPROX_ERR);
         sat_cfg_reset_bool(SAT_CFG_BOOL_PRED_USE_REAL_T0);
 
         reset = FALSE;
@@ -116,6 +121,9 @@ static void reset_cb(GtkWidget * button, gpointer data)
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(twspin),
                               sat_cfg_get_int_def
                               (SAT_CFG_INT_PRED_TWILIGHT_THLD));
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(apperr),
+                              sat_cfg_get_int_def
+                              (SAT_CFG_INT_PRED_APPROX_ERR));
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(tzero),
                                  sat_cfg_get_bool_def
                                  (SAT_CFG_BOOL_PRED_USE_REAL_T0));
@@ -329,6 +337,32 @@ GtkWidget      *sat_pref_conditions_create()
 
     gtk_grid_attach(GTK_GRID(table), tzero, 0, 13, 3, 1);
 
+    /* position error of background satellites */
+    label = gtk_label_new(_("Background position accuracy"));
+    g_object_set(label, "xalign", 0.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 0, 14, 1, 1);
+    apperr = gtk_spin_button_new_with_range(0, 100000, 100);
+    gtk_widget_set_tooltip_text(apperr,
+                                _("Satellites that are not selected and not "
+                                  "tracked by the radio or rotator "
+                                  "controller are calculated with a faster "
+                                  "approximation. Their position stays "
+                                  "within the specified distance of the "
+                                  "exact position.\n\n"
+                                  "Set to 0 to calculate all satellites "
+                                  "with full precision."));
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(apperr), 0);
+    gtk_spin_button_set_numeric(GTK_SPIN_BUTTON(apperr), TRUE);
+    gtk_spin_button_set_wrap(GTK_SPIN_BUTTON(apperr), FALSE);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(apperr),
+                              sat_cfg_get_int(SAT_CFG_INT_PRED_APPROX_ERR));
+    g_signal_connect(G_OBJECT(apperr), "value-changed",
+                     G_CALLBACK(spin_changed_cb), NULL);
+    gtk_grid_attach(GTK_GRID(table), apperr, 1, 14, 1, 1);
+    label = gtk_label_new(_("[m]"));
+    g_object_set(label, "xalign", 0.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 2, 14, 1, 1);
+
     vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
     gtk_box_set_homogeneous(GTK_BOX(vbox), FALSE);
     gtk_container_set_border_width(GTK_CONTAINER(vbox), 20);
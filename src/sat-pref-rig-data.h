@@ -40,6 +40,9 @@ typedef enum {
     RIG_LIST_COL_LOUP,          /*!< Local oscillato freq (uplink) */
     RIG_LIST_COL_SIGAOS,        /*!< Signal AOS */
     RIG_LIST_COL_SIGLOS,        /*!< Signal LOS */
+    RIG_LIST_COL_MODEL,         /*!< Hamlib model, 0 for rigctld */
+    RIG_LIST_COL_DEVICE,        /*!< Device path for Hamlib model */
+    RIG_LIST_COL_SPEED,         /*!< Serial speed for Hamlib model */
     RIG_LIST_COL_NUM            /*!< The number of fields in the list. */
 } rig_list_col_t;
 
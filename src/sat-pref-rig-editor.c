@@ -25,6 +25,7 @@
 #include <math.h>
 
 #include "gpredict-utils.h"
+#include "hamlib-backend.h"
 #include "radio-conf.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
@@ -43,6 +44,9 @@ static GtkWidget *lo;           /* local oscillator of downconverter */
 static GtkWidget *loup;         /* local oscillator of upconverter */
 static GtkWidget *sigaos;       /* AOS signalling */
 static GtkWidget *siglos;       /* LOS signalling */
+static GtkWidget *model;        /* Hamlib model for in-process control */
+static GtkWidget *device;       /* device used with the Hamlib model */
+static GtkWidget *speed;        /* serial speed used with the Hamlib model */
 
 
 static void clear_widgets()
@@ -58,6 +62,9 @@ static void clear_widgets()
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(ptt), FALSE);
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(sigaos), FALSE);
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(siglos), FALSE);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(model), 0);
+    gtk_entry_set_text(GTK_ENTRY(device), "");
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(speed), 0);
 }
 
 static void update_widgets(radio_conf_t * conf)
@@ -103,6 +110,31 @@ static void update_widgets(radio_conf_t * conf)
     /* AOS / LOS signalling */
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(sigaos), conf->signal_aos);
     gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(siglos), conf->signal_los);
+
+    /* in-process Hamlib control */
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(model), conf->model);
+    if (conf->device)
+        gtk_entry_set_text(GTK_ENTRY(device), conf->device);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(speed), conf->speed);
+}
+
+/*
+ * Manage Hamlib model changed signals.
+ *
+ * Host and port are only used with rigctld, device and speed only when the
+ * radio is controlled in-process through Hamlib.
+ */
+static void model_changed(GtkWidget * widget, gpointer data)
+{
+    gboolean        inproc;
+
+    (void)data;
+
+    inproc = (gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(widget)) > 0);
+    gtk_widget_set_sensitive(host, !inproc);
+    gtk_widget_set_sensitive(port, !inproc);
+    gtk_widget_set_sensitive(device, inproc);
+    gtk_widget_set_sensitive(speed, inproc);
 }
 
 /*
@@ -436,9 +468,69 @@ static GtkWidget *create_editor_widgets(radio_conf_t * conf)
     gtk_widget_set_tooltip_text(siglos,
                                 _("Enable LOS signalling for this radio."));
 
+    /* In-process Hamlib control */
+    gtk_grid_attach(GTK_GRID(table),
+                    gtk_separator_new(GTK_ORIENTATION_HORIZONTAL),
+                    0, 9, 4, 1);
+
+    label = gtk_label_new(_("Hamlib model"));
+    g_object_set(label, "xalign", 1.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 0, 10, 1, 1);
+
+    model = gtk_spin_button_new_with_range(0, 99999, 1);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(model), 0);
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(model), 0);
+    if (hamlib_backend_available())
+        gtk_widget_set_tooltip_text(model,
+                                    _("Enter the Hamlib model number to "
+                                      "control the radio directly from "
+                                      "gpredict instead of through rigctld, "
+                                      "e.g. 1 for the Hamlib dummy rig. "
+                                      "The model numbers are listed by "
+                                      "rigctl -l\n\n"
+                                      "Use 0 to control the radio through "
+                                      "rigctld at the host and port above."));
+    else
+    {
+        gtk_widget_set_sensitive(model, FALSE);
+        gtk_widget_set_tooltip_text(model,
+                                    _("Gpredict has been built without "
+                                      "Hamlib and can only control the "
+                                      "radio through rigctld."));
+    }
+    gtk_grid_attach(GTK_GRID(table), model, 1, 10, 1, 1);
+
+    label = gtk_label_new(_("Device"));
+    g_object_set(label, "xalign", 1.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 0, 11, 1, 1);
+
+    device = gtk_entry_new();
+    gtk_entry_set_max_length(GTK_ENTRY(device), 100);
+    gtk_widget_set_tooltip_text(device,
+                                _("Enter the serial port or device the "
+                                  "radio is connected to, e.g. /dev/ttyUSB0. "
+                                  "Leave empty to use the Hamlib default."));
+    gtk_grid_attach(GTK_GRID(table), device, 1, 11, 3, 1);
+
+    label = gtk_label_new(_("Speed"));
+    g_object_set(label, "xalign", 1.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 0, 12, 1, 1);
+
+    speed = gtk_spin_button_new_with_range(0, 921600, 1);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(speed), 0);
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(speed), 0);
+    gtk_widget_set_tooltip_text(speed,
+                                _("Enter the serial speed in baud. Use 0 "
+                                  "for the default of the Hamlib model."));
+    gtk_grid_attach(GTK_GRID(table), speed, 1, 12, 1, 1);
+
+    g_signal_connect(model, "value-changed", G_CALLBACK(model_changed), NULL);
+
     if (conf->name != NULL)
         update_widgets(conf);
 
+    model_changed(model, NULL);
+
     gtk_widget_show_all(table);
 
     return table;
@@ -462,6 +554,15 @@ static gboolean apply_changes(radio_conf_t * conf)
     /* port */
     conf->port = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(port));
 
+    /* in-process Hamlib control */
+    conf->model = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(model));
+
+    if (conf->device)
+        g_free(conf->device);
+
+    conf->device = g_strdup(gtk_entry_get_text(GTK_ENTRY(device)));
+    conf->speed = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(speed));
+
     /* lo down freq */
     conf->lo = 1000000.0 * gtk_spin_button_get_value(GTK_SPIN_BUTTON(lo));
 
@@ -61,7 +61,10 @@ static GtkTreeModel *create_and_fill_model()
                                    G_TYPE_DOUBLE,       // LO DOWN
                                    G_TYPE_DOUBLE,       // LO UO
                                    G_TYPE_BOOLEAN,      // AOS signalling
-                                   G_TYPE_BOOLEAN       // LOS signalling
+                                   G_TYPE_BOOLEAN,      // LOS signalling
+                                   G_TYPE_INT,  // Hamlib model
+                                   G_TYPE_STRING,       // device
+                                   G_TYPE_INT   // serial speed
         );
 
     gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(liststore),
@@ -97,6 +100,9 @@ static GtkTreeModel *create_and_fill_model()
                                        RIG_LIST_COL_LO, conf.lo,
                                        RIG_LIST_COL_LOUP, conf.loup,
                                        RIG_LIST_COL_SIGAOS, conf.signal_aos,
+                                       RIG_LIST_COL_MODEL, conf.model,
+                                       RIG_LIST_COL_DEVICE, conf.device,
+                                       RIG_LIST_COL_SPEED, conf.speed,
                                        RIG_LIST_COL_SIGLOS, conf.signal_los,
                                        -1);
 
@@ -109,6 +115,8 @@ static GtkTreeModel *create_and_fill_model()
 
                     if (conf.host)
                         g_free(conf.host);
+
+                    g_free(conf.device);
                 }
                 else
                 {
@@ -394,7 +402,10 @@ static void edit_cb(GtkWidget * button, gpointer data)
         .lo = 0.0,
         .loup = 0.0,
         .signal_aos = FALSE,
-        .signal_los = FALSE
+        .signal_los = FALSE,
+        .model = 0,
+        .device = NULL,
+        .speed = 0,
     };
 
     /* If there are no entries, we have a bug since the button should 
@@ -426,6 +437,9 @@ static void edit_cb(GtkWidget * button, gpointer data)
                            RIG_LIST_COL_LO, &conf.lo,
                            RIG_LIST_COL_LOUP, &conf.loup,
                            RIG_LIST_COL_SIGAOS, &conf.signal_aos,
+                           RIG_LIST_COL_MODEL, &conf.model,
+                           RIG_LIST_COL_DEVICE, &conf.device,
+                           RIG_LIST_COL_SPEED, &conf.speed,
                            RIG_LIST_COL_SIGLOS, &conf.signal_los, -1);
     }
     else
@@ -462,6 +476,9 @@ static void edit_cb(GtkWidget * button, gpointer data)
                            RIG_LIST_COL_LO, conf.lo,
                            RIG_LIST_COL_LOUP, conf.loup,
                            RIG_LIST_COL_SIGAOS, conf.signal_aos,
+                           RIG_LIST_COL_MODEL, conf.model,
+                           RIG_LIST_COL_DEVICE, conf.device,
+                           RIG_LIST_COL_SPEED, conf.speed,
                            RIG_LIST_COL_SIGLOS, conf.signal_los, -1);
     }
 
@@ -471,6 +488,8 @@ static void edit_cb(GtkWidget * button, gpointer data)
 
     if (conf.host != NULL)
         g_free(conf.host);
+
+    g_free(conf.device);
 }
 
 static void row_activated_cb(GtkTreeView * tree_view,
@@ -690,6 +709,9 @@ static void add_cb(GtkWidget * button, gpointer data)
         .loup = 0.0,
         .signal_aos = FALSE,
         .signal_los = FALSE,
+        .model = 0,
+        .device = NULL,
+        .speed = 0,
     };
 
     /* run rig conf editor */
@@ -712,12 +734,17 @@ static void add_cb(GtkWidget * button, gpointer data)
                            RIG_LIST_COL_LO, conf.lo,
                            RIG_LIST_COL_LOUP, conf.loup,
                            RIG_LIST_COL_SIGAOS, conf.signal_aos,
+                           RIG_LIST_COL_MODEL, conf.model,
+                           RIG_LIST_COL_DEVICE, conf.device,
+                           RIG_LIST_COL_SPEED, conf.speed,
                            RIG_LIST_COL_SIGLOS, conf.signal_los, -1);
 
         g_free(conf.name);
 
         if (conf.host != NULL)
             g_free(conf.host);
+
+        g_free(conf.device);
     }
 }
 
@@ -813,7 +840,10 @@ void sat_pref_rig_ok()
         .lo = 0.0,
         .loup = 0.0,
         .signal_aos = FALSE,
-        .signal_los = FALSE
+        .signal_los = FALSE,
+        .model = 0,
+        .device = NULL,
+        .speed = 0,
     };
 
     /* delete all .rig files */
@@ -859,6 +889,9 @@ void sat_pref_rig_ok()
                                RIG_LIST_COL_LO, &conf.lo,
                                RIG_LIST_COL_LOUP, &conf.loup,
                                RIG_LIST_COL_SIGAOS, &conf.signal_aos,
+                               RIG_LIST_COL_MODEL, &conf.model,
+                               RIG_LIST_COL_DEVICE, &conf.device,
+                               RIG_LIST_COL_SPEED, &conf.speed,
                                RIG_LIST_COL_SIGLOS, &conf.signal_los, -1);
             radio_conf_save(&conf);
 
@@ -868,6 +901,8 @@ void sat_pref_rig_ok()
 
             if (conf.host)
                 g_free(conf.host);
+
+            g_free(conf.device);
         }
         else
         {
@@ -40,6 +40,10 @@ typedef enum {
     ROT_LIST_COL_AZSTOPPOS,     /*!< Position of the azimuth rotation stops.
                                    Should default to MINAZ, unless specified
                                    otherwise */
+    ROT_LIST_COL_MODEL,         /*!< Hamlib model, 0 for rotctld */
+    ROT_LIST_COL_DEVICE,        /*!< Device path for Hamlib model */
+    ROT_LIST_COL_SPEED,         /*!< Serial speed for Hamlib model */
+    ROT_LIST_COL_AOSLEAD,       /*!< Time to be at the AOS position early */
     ROT_LIST_COL_NUM            /*!< The number of fields in the list. */
 } rotor_list_col_t;
 
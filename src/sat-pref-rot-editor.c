@@ -26,6 +26,7 @@
 #include <math.h>
 
 #include "gpredict-utils.h"
+#include "hamlib-backend.h"
 #include "rotor-conf.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
@@ -43,6 +44,10 @@ static GtkWidget *maxaz;
 static GtkWidget *minel;
 static GtkWidget *maxel;
 static GtkWidget *azstoppos;
+static GtkWidget *aoslead;
+static GtkWidget *model;        /* Hamlib model for in-process control */
+static GtkWidget *device;       /* device used with the Hamlib model */
+static GtkWidget *speed;        /* serial speed used with the Hamlib model */
 
 /* Update widgets from the currently selected row in the treeview */
 static void update_widgets(rotor_conf_t * conf)
@@ -68,6 +73,13 @@ static void update_widgets(rotor_conf_t * conf)
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(minel), conf->minel);
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(maxel), conf->maxel);
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(azstoppos), conf->azstoppos);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(aoslead), conf->aoslead);
+
+    /* in-process Hamlib control */
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(model), conf->model);
+    if (conf->device)
+        gtk_entry_set_text(GTK_ENTRY(device), conf->device);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(speed), conf->speed);
 }
 
 /* called when the user clicks on the CLEAR button */
@@ -82,6 +94,10 @@ static void clear_widgets()
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(minel), 0);
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(maxel), 90);
     gtk_spin_button_set_value(GTK_SPIN_BUTTON(azstoppos), 0);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(aoslead), ROT_DEFAULT_AOS_LEAD);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(model), 0);
+    gtk_entry_set_text(GTK_ENTRY(device), "");
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(speed), 0);
 }
 
 /*
@@ -130,6 +146,25 @@ static void name_changed(GtkWidget * widget, gpointer data)
     }
 }
 
+/*
+ * Manage Hamlib model changed signals.
+ *
+ * Host and port are only used with rotctld, device and speed only when the
+ * rotator is controlled in-process through Hamlib.
+ */
+static void model_changed(GtkWidget * widget, gpointer data)
+{
+    gboolean        inproc;
+
+    (void)data;
+
+    inproc = (gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(widget)) > 0);
+    gtk_widget_set_sensitive(host, !inproc);
+    gtk_widget_set_sensitive(port, !inproc);
+    gtk_widget_set_sensitive(device, inproc);
+    gtk_widget_set_sensitive(speed, inproc);
+}
+
 static void aztype_changed_cb(GtkComboBox * box, gpointer data)
 {
     gint            type = gtk_combo_box_get_active(box);
@@ -292,9 +327,85 @@ static GtkWidget *create_editor_widgets(rotor_conf_t * conf)
                                   "\342\206\222 +180\302\260 rotor is -180\302\260."));
     gtk_grid_attach(GTK_GRID(table), azstoppos, 3, 7, 1, 1);
 
+    label = gtk_label_new(_(" AOS lead time [sec]"));
+    g_object_set(label, "xalign", 1.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 1, 8, 2, 1);
+    aoslead = gtk_spin_button_new_with_range(0, 3600, 10);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(aoslead), ROT_DEFAULT_AOS_LEAD);
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(aoslead), 0);
+    gtk_widget_set_tooltip_text(aoslead,
+                                _("Time the rotator should be at the AOS "
+                                  "position of the next pass before AOS, "
+                                  "in addition to the time it needs to slew "
+                                  "there. Until the slew rate of the rotator "
+                                  "has been measured, the rotator moves to "
+                                  "the AOS position as soon as the previous "
+                                  "pass has ended."));
+    gtk_grid_attach(GTK_GRID(table), aoslead, 3, 8, 1, 1);
+
+    /* In-process Hamlib control */
+    gtk_grid_attach(GTK_GRID(table),
+                    gtk_separator_new(GTK_ORIENTATION_HORIZONTAL),
+                    0, 9, 4, 1);
+
+    label = gtk_label_new(_("Hamlib model"));
+    g_object_set(label, "xalign", 1.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 0, 10, 1, 1);
+
+    model = gtk_spin_button_new_with_range(0, 99999, 1);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(model), 0);
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(model), 0);
+    if (hamlib_backend_available())
+        gtk_widget_set_tooltip_text(model,
+                                    _("Enter the Hamlib model number to "
+                                      "control the rotator directly from "
+                                      "gpredict instead of through rotctld, "
+                                      "e.g. 1 for the Hamlib dummy rotator. "
+                                      "The model numbers are listed by "
+                                      "rotctl -l\n\n"
+                                      "Use 0 to control the rotator through "
+                                      "rotctld at the host and port above."));
+    else
+    {
+        gtk_widget_set_sensitive(model, FALSE);
+        gtk_widget_set_tooltip_text(model,
+                                    _("Gpredict has been built without "
+                                      "Hamlib and can only control the "
+                                      "rotator through rotctld."));
+    }
+    gtk_grid_attach(GTK_GRID(table), model, 1, 10, 1, 1);
+
+    label = gtk_label_new(_("Device"));
+    g_object_set(label, "xalign", 1.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 0, 11, 1, 1);
+
+    device = gtk_entry_new();
+    gtk_entry_set_max_length(GTK_ENTRY(device), 100);
+    gtk_widget_set_tooltip_text(device,
+                                _("Enter the serial port or device the "
+                                  "rotator is connected to, e.g. /dev/ttyUSB0. "
+                                  "Leave empty to use the Hamlib default."));
+    gtk_grid_attach(GTK_GRID(table), device, 1, 11, 3, 1);
+
+    label = gtk_label_new(_("Speed"));
+    g_object_set(label, "xalign", 1.0, "yalign", 0.5, NULL);
+    gtk_grid_attach(GTK_GRID(table), label, 0, 12, 1, 1);
+
+    speed = gtk_spin_button_new_with_range(0, 921600, 1);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(speed), 0);
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(speed), 0);
+    gtk_widget_set_tooltip_text(speed,
+                                _("Enter the serial speed in baud. Use 0 "
+                                  "for the default of the Hamlib model."));
+    gtk_grid_attach(GTK_GRID(table), speed, 1, 12, 1, 1);
+
+    g_signal_connect(model, "value-changed", G_CALLBACK(model_changed), NULL);
+
     if (conf->name != NULL)
         update_widgets(conf);
 
+    model_changed(model, NULL);
+
     gtk_widget_show_all(table);
 
     return table;
@@ -318,6 +429,15 @@ static gboolean apply_changes(rotor_conf_t * conf)
     /* port */
     conf->port = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(port));
 
+    /* in-process Hamlib control */
+    conf->model = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(model));
+
+    if (conf->device)
+        g_free(conf->device);
+
+    conf->device = g_strdup(gtk_entry_get_text(GTK_ENTRY(device)));
+    conf->speed = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(speed));
+
     /* az type */
     conf->aztype = gtk_combo_box_get_active(GTK_COMBO_BOX(aztype));
 
@@ -330,6 +450,9 @@ static gboolean apply_changes(rotor_conf_t * conf)
     /* az stop position */
     conf->azstoppos = gtk_spin_button_get_value(GTK_SPIN_BUTTON(azstoppos));
 
+    /* AOS lead time */
+    conf->aoslead = gtk_spin_button_get_value(GTK_SPIN_BUTTON(aoslead));
+
     return TRUE;
 }
 
@@ -58,6 +58,10 @@ static void add_cb(GtkWidget * button, gpointer data)
         .maxel = 90,
         .aztype = ROT_AZ_TYPE_360,
         .azstoppos = 0,
+        .model = 0,
+        .device = NULL,
+        .speed = 0,
+        .aoslead = ROT_DEFAULT_AOS_LEAD,
     };
 
     /* run rot conf editor */
@@ -78,12 +82,18 @@ static void add_cb(GtkWidget * button, gpointer data)
                            ROT_LIST_COL_MINEL, conf.minel,
                            ROT_LIST_COL_MAXEL, conf.maxel,
                            ROT_LIST_COL_AZTYPE, conf.aztype,
-                           ROT_LIST_COL_AZSTOPPOS, conf.azstoppos, -1);
+                           ROT_LIST_COL_MODEL, conf.model,
+                           ROT_LIST_COL_DEVICE, conf.device,
+                           ROT_LIST_COL_SPEED, conf.speed,
+                           ROT_LIST_COL_AZSTOPPOS, conf.azstoppos,
+                           ROT_LIST_COL_AOSLEAD, conf.aoslead, -1);
 
         g_free(conf.name);
 
         if (conf.host != NULL)
             g_free(conf.host);
+
+        g_free(conf.device);
     }
 }
 
@@ -107,6 +117,7 @@ static void edit_cb(GtkWidget * button, gpointer data)
         .maxel = 90,
         .aztype = ROT_AZ_TYPE_360,
         .azstoppos = 0,         //used in the "new rotator" dialog
+        .aoslead = ROT_DEFAULT_AOS_LEAD,
     };
 
     /* If there are no entries, we have a bug since the button should 
@@ -137,7 +148,11 @@ static void edit_cb(GtkWidget * button, gpointer data)
                            ROT_LIST_COL_MINEL, &conf.minel,
                            ROT_LIST_COL_MAXEL, &conf.maxel,
                            ROT_LIST_COL_AZTYPE, &conf.aztype,
-                           ROT_LIST_COL_AZSTOPPOS, &conf.azstoppos, -1);
+                           ROT_LIST_COL_MODEL, &conf.model,
+                           ROT_LIST_COL_DEVICE, &conf.device,
+                           ROT_LIST_COL_SPEED, &conf.speed,
+                           ROT_LIST_COL_AZSTOPPOS, &conf.azstoppos,
+                           ROT_LIST_COL_AOSLEAD, &conf.aoslead, -1);
     }
     else
     {
@@ -172,7 +187,11 @@ static void edit_cb(GtkWidget * button, gpointer data)
                            ROT_LIST_COL_MINEL, conf.minel,
                            ROT_LIST_COL_MAXEL, conf.maxel,
                            ROT_LIST_COL_AZTYPE, conf.aztype,
-                           ROT_LIST_COL_AZSTOPPOS, conf.azstoppos, -1);
+                           ROT_LIST_COL_MODEL, conf.model,
+                           ROT_LIST_COL_DEVICE, conf.device,
+                           ROT_LIST_COL_SPEED, conf.speed,
+                           ROT_LIST_COL_AZSTOPPOS, conf.azstoppos,
+                           ROT_LIST_COL_AOSLEAD, conf.aoslead, -1);
     }
 
     /* clean up memory */
@@ -181,6 +200,8 @@ static void edit_cb(GtkWidget * button, gpointer data)
 
     if (conf.host != NULL)
         g_free(conf.host);
+
+    g_free(conf.device);
 }
 
 static void delete_cb(GtkWidget * button, gpointer data)
@@ -258,7 +279,11 @@ static GtkTreeModel *create_and_fill_model()
                                    G_TYPE_DOUBLE,       // Min El
                                    G_TYPE_DOUBLE,       // Max El
                                    G_TYPE_INT,  // Az type
-                                   G_TYPE_DOUBLE        // Az Stop Position
+                                   G_TYPE_DOUBLE,       // Az Stop Position
+                                   G_TYPE_INT,  // Hamlib model
+                                   G_TYPE_STRING,       // device
+                                   G_TYPE_INT,  // serial speed
+                                   G_TYPE_DOUBLE        // AOS lead
         );
     gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(liststore),
                                          ROT_LIST_COL_NAME,
@@ -290,7 +315,11 @@ static GtkTreeModel *create_and_fill_model()
                                        ROT_LIST_COL_MINEL, conf.minel,
                                        ROT_LIST_COL_MAXEL, conf.maxel,
                                        ROT_LIST_COL_AZTYPE, conf.aztype,
+                                       ROT_LIST_COL_MODEL, conf.model,
+                                       ROT_LIST_COL_DEVICE, conf.device,
+                                       ROT_LIST_COL_SPEED, conf.speed,
                                        ROT_LIST_COL_AZSTOPPOS, conf.azstoppos,
+                                       ROT_LIST_COL_AOSLEAD, conf.aoslead,
                                        -1);
 
                     sat_log_log(SAT_LOG_LEVEL_DEBUG,
@@ -302,6 +331,8 @@ static GtkTreeModel *create_and_fill_model()
 
                     if (conf.host)
                         g_free(conf.host);
+
+                    g_free(conf.device);
                 }
                 else
                 {
@@ -575,6 +606,10 @@ void sat_pref_rot_ok()
         .maxel = 90,
         .aztype = ROT_AZ_TYPE_360,
         .azstoppos = 0,
+        .model = 0,
+        .device = NULL,
+        .speed = 0,
+        .aoslead = ROT_DEFAULT_AOS_LEAD,
     };
 
 
@@ -621,7 +656,11 @@ void sat_pref_rot_ok()
                                ROT_LIST_COL_MINEL, &conf.minel,
                                ROT_LIST_COL_MAXEL, &conf.maxel,
                                ROT_LIST_COL_AZTYPE, &conf.aztype,
-                               ROT_LIST_COL_AZSTOPPOS, &conf.azstoppos, -1);
+                               ROT_LIST_COL_MODEL, &conf.model,
+                               ROT_LIST_COL_DEVICE, &conf.device,
+                               ROT_LIST_COL_SPEED, &conf.speed,
+                               ROT_LIST_COL_AZSTOPPOS, &conf.azstoppos,
+                               ROT_LIST_COL_AOSLEAD, &conf.aoslead, -1);
             rotor_conf_save(&conf);
 
             /* free conf buffer */
@@ -631,6 +670,8 @@ void sat_pref_rot_ok()
             if (conf.host)
                 g_free(conf.host);
 
+            g_free(conf.device);
+
         }
         else
         {
@@ -33,6 +33,9 @@ extern GtkWidget *window;       /* dialog window defined in sat-pref.c */
 /* Update frequency widget */
 static GtkWidget *freq;
 
+/* Maximum element age widget */
+static GtkWidget *maxage;
+
 /* auto update radio buttons */
 static GtkWidget *warn, *autom;
 
@@ -94,6 +97,29 @@ static void create_auto_update(GtkWidget * vbox)
 
     gtk_box_pack_start(GTK_BOX(vbox), box, FALSE, TRUE, 0);
 
+    /* maximum element age */
+    maxage = gtk_spin_button_new_with_range(0, 720, 1);
+    gtk_spin_button_set_digits(GTK_SPIN_BUTTON(maxage), 0);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(maxage),
+                              sat_cfg_get_int(SAT_CFG_INT_TLE_MAX_AGE));
+    gtk_widget_set_tooltip_text(maxage,
+                                _("Refresh a TLE source before the next "
+                                  "scheduled check when it has satellites "
+                                  "with elements older than this. "
+                                  "Set to 0 to disable."));
+    g_signal_connect(maxage, "value-changed", G_CALLBACK(value_changed_cb),
+                     NULL);
+
+    box = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+    gtk_box_set_homogeneous(GTK_BOX(box), FALSE);
+    label = gtk_label_new(_("Refresh sources with elements older than:"));
+    gtk_box_pack_start(GTK_BOX(box), label, FALSE, FALSE, 0);
+    gtk_box_pack_start(GTK_BOX(box), maxage, FALSE, FALSE, 0);
+    label = gtk_label_new(_("hours"));
+    gtk_box_pack_start(GTK_BOX(box), label, FALSE, FALSE, 0);
+
+    gtk_box_pack_start(GTK_BOX(vbox), box, FALSE, TRUE, 0);
+
     /* radio buttons selecting action */
     label = gtk_label_new(_("If TLEs are too old:"));
     g_object_set(label, "xalign", 0.0, "yalign", 0.5, NULL);
@@ -360,6 +386,10 @@ static void reset_cb(GtkWidget * button, gpointer data)
                              sat_cfg_get_int_def
                              (SAT_CFG_INT_TLE_AUTO_UPD_FREQ));
 
+    /* maximum element age */
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(maxage),
+                              sat_cfg_get_int_def(SAT_CFG_INT_TLE_MAX_AGE));
+
     /* action */
     if (sat_cfg_get_int_def(SAT_CFG_INT_TLE_AUTO_UPD_ACTION) ==
         TLE_AUTO_UPDATE_GOAHEAD)
@@ -435,6 +465,11 @@ void sat_pref_tle_ok()
         sat_cfg_set_int(SAT_CFG_INT_TLE_AUTO_UPD_FREQ,
                         gtk_combo_box_get_active(GTK_COMBO_BOX(freq)));
 
+        /* maximum element age */
+        sat_cfg_set_int(SAT_CFG_INT_TLE_MAX_AGE,
+                        gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON
+                                                         (maxage)));
+
         /* action to take */
         if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(autom)))
             sat_cfg_set_int(SAT_CFG_INT_TLE_AUTO_UPD_ACTION,
@@ -494,6 +529,7 @@ void sat_pref_tle_ok()
     {
         /* use sat_cfg_reset */
         sat_cfg_reset_int(SAT_CFG_INT_TLE_AUTO_UPD_FREQ);
+        sat_cfg_reset_int(SAT_CFG_INT_TLE_MAX_AGE);
         sat_cfg_reset_int(SAT_CFG_INT_TLE_AUTO_UPD_ACTION);
         sat_cfg_reset_str(SAT_CFG_STR_TLE_PROXY);
         sat_cfg_reset_str(SAT_CFG_STR_TLE_URLS);
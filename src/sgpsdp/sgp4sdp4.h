@@ -149,6 +149,21 @@ typedef struct {
     double          zsinhl, zcoshl, zsinil, zcosil;
 } deep_static_t;
 
+/**
+ * \brief Anchor of the approximate propagation
+ * \ingroup sgpsdpif
+ *
+ * See predict_calc_approx() in predict-tools.c.
+ */
+typedef struct {
+    double          jul_utc;    /*!< Time of the anchor, 0 if not set */
+    double          jul_epoch;  /*!< TLE epoch the anchor belongs to */
+    double          step;       /*!< Resync interval [days] */
+    double          phase;      /*!< Orbit phase at the anchor [rad] */
+    vector_t        pos;        /*!< Position at the anchor [km] */
+    vector_t        vel;        /*!< Velocity at the anchor [km/s] */
+} approx_anchor_t;
+
 /**
  * \brief Satellite data structure
  * \ingroup sgpsdpif
@@ -179,6 +194,7 @@ typedef struct {
     double          range_rate; /*!< Range Rate [km/sec] */
     double          ra;         /*!< Right Ascension [deg] */
     double          dec;        /*!< Declination [deg] */
+    double          radec_utc;  /*!< Time of ra and dec (Julian Date) */
     double          ssplat;     /*!< SSP latitude [deg] */
     double          ssplon;     /*!< SSP longitude [deg] */
     double          alt;        /*!< altitude [km] */
@@ -189,6 +205,7 @@ typedef struct {
     double          meanmo;     /*!< mean motion kept in rev/day */
     long            orbit;      /*!< orbit number */
     orbit_type_t    otype;      /*!< orbit type. */
+    approx_anchor_t anchor;     /*!< Anchor of the approximate propagation */
 } sat_t;
 
 
@@ -295,6 +312,7 @@ void            ClearFlag(int flag);
 /* sgp_in.c */
 int             Checksum_Good(char *tle_set);
 int             Good_Elements(char *tle_set);
+int             Decode_Catnr(const char *field);
 void            Convert_Satellite_Data(char *tle_set, tle_t * tle);
 int             Get_Next_Tle_Set(char lines[3][80], tle_t * tle);
 void            select_ephemeris(sat_t * sat);
@@ -103,6 +103,31 @@ int Good_Elements(char *tle_set)
     return (1);
 }
 
+/* Decodes the 5 character catalogue number field of a TLE.  */
+/* Numbers from 100000 to 339999 use the Alpha-5 scheme where */
+/* the first character is a letter (I and O are skipped), so  */
+/* A0000 is 100000 and Z9999 is 339999.                       */
+int Decode_Catnr(const char *field)
+{
+    static const char letters[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+    const char     *p;
+    char            buff[6];
+
+    strncpy(buff, field, 5);
+    buff[5] = '\0';
+
+    if ((buff[0] >= 'A') && (buff[0] <= 'Z'))
+    {
+        p = strchr(letters, buff[0]);
+        if (p == NULL)
+            return 0;
+
+        return (10 + (int)(p - letters)) * 10000 + atoi(&buff[1]);
+    }
+
+    return atoi(buff);
+}
+
 /* Converts the strings in a raw two-line element set  */
 /* to their intended numerical values. No processing   */
 /* of these values is done, e.g. from deg to rads etc. */
@@ -112,9 +137,7 @@ void Convert_Satellite_Data(char *tle_set, tle_t * tle)
     char            buff[15];
 
     /* Satellite's catalogue number */
-    strncpy(buff, &tle_set[2], 5);
-    buff[5] = '\0';
-    tle->catnr = atoi(buff);
+    tle->catnr = Decode_Catnr(&tle_set[2]);
 
     /* International Designator for satellite */
     strncpy(tle->idesg, &tle_set[9], 8);
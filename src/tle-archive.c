@@ -0,0 +1,472 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Historical TLE archive.
+ *
+ * The .sat file of a satellite only holds the newest element set. Every
+ * distinct element set seen by the TLE update is also appended to the
+ * archive of the satellite, USER_CONF_DIR/satdata/archive/<catnum>.tle, which
+ * holds the two TLE lines of each set in the order they were added.
+ *
+ * Adding a set only appends to the file. Duplicates are detected among the
+ * last few sets of the file, which is where a repeated download ends up.
+ * The archive keeps at most ARCHIVE_MAX_SETS sets: once the file has grown
+ * to twice that size it is rewritten with the newest ARCHIVE_MAX_SETS sets.
+ *
+ * A loaded archive is an array of element sets sorted by epoch together with
+ * an index of the Julian epochs. tle_archive_select() switches a satellite to
+ * the set with the epoch closest to the requested time. It remembers the
+ * last selected set, so the usual case where the time is still closest to
+ * that set is a constant time check; otherwise the set is found by binary
+ * search in the epoch index.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "compat.h"
+#include "gtk-sat-data.h"
+#include "sat-log.h"
+#include "tle-archive.h"
+
+
+/* Offset and length of the epoch field in TLE line 1 */
+#define EPOCH_OFFSET    18
+#define EPOCH_LENGTH    14
+
+/* Size of an element set in the archive file: two lines of 69 characters */
+#define SET_SIZE        140
+
+/* Number of sets at the end of the archive checked for duplicates */
+#define DEDUP_SETS      16
+
+/* Number of sets kept when the archive is trimmed */
+#define ARCHIVE_MAX_SETS 1000
+
+
+struct _tle_archive {
+    GArray         *epochs;     /*!< Julian epochs in ascending order */
+    GArray         *sets;       /*!< tle_t in the order of epochs */
+    guint           current;    /*!< Index of the last selected set */
+};
+
+
+/* Get the archive file name of a satellite. */
+static gchar   *archive_file_name(guint catnr)
+{
+    gchar          *dir;
+    gchar          *fname;
+
+    dir = get_satdata_dir();
+    fname = g_strdup_printf("%s%sarchive%s%u.tle", dir, G_DIR_SEPARATOR_S,
+                            G_DIR_SEPARATOR_S, catnr);
+    g_free(dir);
+
+    return fname;
+}
+
+/* Check whether a TLE line pair is valid. */
+static gboolean is_good_tle(const gchar * line1, const gchar * line2,
+                            tle_t * tle)
+{
+    gchar          *rawtle;
+    gboolean        good;
+
+    if ((line1 == NULL) || (line2 == NULL) ||
+        (strlen(line1) < EPOCH_OFFSET + EPOCH_LENGTH))
+        return FALSE;
+
+    rawtle = g_strconcat(line1, line2, NULL);
+    good = Good_Elements(rawtle);
+    if (good && (tle != NULL))
+        Convert_Satellite_Data(rawtle, tle);
+    g_free(rawtle);
+
+    return good;
+}
+
+/*
+ * Read the complete sets within the last maxlen bytes of a file.
+ *
+ * Returns NULL if the file could not be read. The size of the file is
+ * stored in size.
+ */
+static gchar   *read_tail(const gchar * fname, glong maxlen, glong * size)
+{
+    FILE           *file;
+    gchar          *buf, *start;
+    gsize           len;
+
+    file = g_fopen(fname, "rb");
+    if (file == NULL)
+        return NULL;
+
+    if (fseek(file, 0, SEEK_END) != 0 || (*size = ftell(file)) < 0 ||
+        fseek(file, MAX(*size - maxlen, 0), SEEK_SET) != 0)
+    {
+        fclose(file);
+        return NULL;
+    }
+
+    buf = g_malloc(MIN(*size, maxlen) + 1);
+    len = fread(buf, 1, MIN(*size, maxlen), file);
+    buf[len] = '\0';
+    fclose(file);
+
+    if (*size <= maxlen)
+        return buf;
+
+    /* skip the partial line and a second line cut off from its first line */
+    start = strchr(buf, '\n');
+    start = (start == NULL) ? buf + len : start + 1;
+    if (*start == '2')
+    {
+        start = strchr(start, '\n');
+        start = (start == NULL) ? buf + len : start + 1;
+    }
+    memmove(buf, start, strlen(start) + 1);
+
+    return buf;
+}
+
+/* Rewrite an archive with its newest ARCHIVE_MAX_SETS sets. */
+static void trim_archive(const gchar * fname)
+{
+    gchar          *tail;
+    gchar          *tmpname;
+    glong           size;
+
+    tail = read_tail(fname, ARCHIVE_MAX_SETS * SET_SIZE, &size);
+    if (tail == NULL)
+        return;
+
+    tmpname = g_strconcat(fname, ".tmp", NULL);
+    if (!g_file_set_contents(tmpname, tail, -1, NULL) ||
+        g_rename(tmpname, fname) != 0)
+    {
+        sat_log_log(SAT_LOG_LEVEL_ERROR, _("%s: Could not trim %s"),
+                    __func__, fname);
+        g_remove(tmpname);
+    }
+    else
+    {
+        sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                    _("%s: Trimmed %s from %ld bytes"), __func__, fname,
+                    size);
+    }
+
+    g_free(tmpname);
+    g_free(tail);
+}
+
+/**
+ * Add an element set to the archive of a satellite.
+ *
+ * @param catnr The catalog number of the satellite.
+ * @param line1 The first line of the TLE.
+ * @param line2 The second line of the TLE.
+ * @return TRUE if the set was added, FALSE if it is already in the archive,
+ *         is not valid or an error occurred.
+ *
+ * Sets are identified by the epoch field of the first TLE line, so the
+ * existing sets are not converted to check for duplicates. Only the last
+ * DEDUP_SETS sets of the archive are checked.
+ */
+gboolean tle_archive_add(guint catnr, const gchar * line1,
+                         const gchar * line2)
+{
+    gchar          *fname, *dir;
+    gchar          *contents;
+    gchar         **lines;
+    FILE           *file;
+    glong           size = 0;
+    guint           i;
+    gboolean        found = FALSE;
+    gboolean        added = FALSE;
+
+    if (!is_good_tle(line1, line2, NULL))
+        return FALSE;
+
+    fname = archive_file_name(catnr);
+
+    contents = read_tail(fname, DEDUP_SETS * SET_SIZE, &size);
+    if (contents != NULL)
+    {
+        lines = g_strsplit(contents, "\n", -1);
+        for (i = 0; lines[i] != NULL && !found; i++)
+        {
+            if ((lines[i][0] == '1') &&
+                (strlen(lines[i]) >= EPOCH_OFFSET + EPOCH_LENGTH) &&
+                !strncmp(lines[i] + EPOCH_OFFSET, line1 + EPOCH_OFFSET,
+                         EPOCH_LENGTH))
+                found = TRUE;
+        }
+        g_strfreev(lines);
+        g_free(contents);
+    }
+
+    if (!found)
+    {
+        dir = g_path_get_dirname(fname);
+        g_mkdir_with_parents(dir, 0755);
+        g_free(dir);
+
+        file = g_fopen(fname, "a");
+        if (file == NULL)
+        {
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Could not open %s for appending"),
+                        __func__, fname);
+        }
+        else
+        {
+            fprintf(file, "%s\n%s\n", line1, line2);
+            added = (fclose(file) == 0);
+        }
+
+        if (added && size + SET_SIZE > 2 * ARCHIVE_MAX_SETS * SET_SIZE)
+            trim_archive(fname);
+    }
+
+    g_free(fname);
+
+    return added;
+}
+
+static gint compare_sets(gconstpointer a, gconstpointer b)
+{
+    gdouble         ea = ((const tle_t *)a)->epoch;
+    gdouble         eb = ((const tle_t *)b)->epoch;
+
+    return (ea > eb) - (ea < eb);
+}
+
+/**
+ * Load the archive of a satellite.
+ *
+ * @param sat The satellite with the element set read from its .sat file.
+ * @return The archive or NULL if there are no other element sets for the
+ *         satellite. Use tle_archive_free() to free the archive.
+ *
+ * The current element set of the satellite is part of the archive even if
+ * it has not been archived, and it is the initially selected set.
+ */
+tle_archive_t  *tle_archive_load(sat_t * sat)
+{
+    tle_archive_t  *archive;
+    tle_t           tle;
+    gchar          *fname;
+    gchar          *contents = NULL;
+    gchar         **lines;
+    gdouble         epoch;
+    guint           i, n;
+
+    fname = archive_file_name(sat->tle.catnr);
+    if (!g_file_get_contents(fname, &contents, NULL, NULL))
+    {
+        g_free(fname);
+        return NULL;
+    }
+
+    archive = tle_archive_new();
+    g_array_append_val(archive->sets, sat->tle);
+
+    lines = g_strsplit(contents, "\n", -1);
+    for (i = 0; lines[i] != NULL && lines[i + 1] != NULL; i++)
+    {
+        if ((lines[i][0] == '1') && (lines[i + 1][0] == '2') &&
+            is_good_tle(g_strchomp(lines[i]), g_strchomp(lines[i + 1]),
+                        &tle) && (tle.catnr == sat->tle.catnr))
+        {
+            tle.status = sat->tle.status;
+            g_array_append_val(archive->sets, tle);
+            i++;
+        }
+    }
+    g_strfreev(lines);
+    g_free(contents);
+    g_free(fname);
+
+    /* sort by epoch and drop duplicates */
+    g_array_sort(archive->sets, compare_sets);
+    for (i = 0, n = 0; i < archive->sets->len; i++)
+    {
+        if ((n > 0) &&
+            (g_array_index(archive->sets, tle_t, i).epoch ==
+             g_array_index(archive->sets, tle_t, n - 1).epoch))
+            continue;
+
+        g_array_index(archive->sets, tle_t, n) =
+            g_array_index(archive->sets, tle_t, i);
+        epoch = Julian_Date_of_Epoch(g_array_index(archive->sets, tle_t,
+                                                   n).epoch);
+        g_array_append_val(archive->epochs, epoch);
+        if (g_array_index(archive->sets, tle_t, n).epoch == sat->tle.epoch)
+            archive->current = n;
+        n++;
+    }
+    g_array_set_size(archive->sets, n);
+
+    if (n < 2)
+    {
+        tle_archive_free(archive);
+        return NULL;
+    }
+
+    return archive;
+}
+
+/** Create an empty archive. */
+tle_archive_t  *tle_archive_new(void)
+{
+    tle_archive_t  *archive;
+
+    archive = g_new0(tle_archive_t, 1);
+    archive->sets = g_array_new(FALSE, FALSE, sizeof(tle_t));
+    archive->epochs = g_array_new(FALSE, FALSE, sizeof(gdouble));
+
+    return archive;
+}
+
+/**
+ * Insert the current element set of a satellite into a loaded archive.
+ *
+ * @param archive The archive of the satellite.
+ * @param sat The satellite.
+ *
+ * The set becomes the selected set of the archive. Nothing is written to the
+ * archive file.
+ */
+void tle_archive_insert(tle_archive_t * archive, sat_t * sat)
+{
+    gdouble         epoch;
+    guint           i;
+
+    epoch = Julian_Date_of_Epoch(sat->tle.epoch);
+    for (i = 0; i < archive->epochs->len; i++)
+        if (g_array_index(archive->epochs, gdouble, i) >= epoch)
+            break;
+
+    if ((i == archive->epochs->len) ||
+        (g_array_index(archive->sets, tle_t, i).epoch != sat->tle.epoch))
+    {
+        g_array_insert_val(archive->sets, i, sat->tle);
+        g_array_insert_val(archive->epochs, i, epoch);
+    }
+
+    archive->current = i;
+}
+
+void tle_archive_free(tle_archive_t * archive)
+{
+    if (archive == NULL)
+        return;
+
+    g_array_free(archive->sets, TRUE);
+    g_array_free(archive->epochs, TRUE);
+    g_free(archive);
+}
+
+/** Get the number of element sets in the archive. */
+guint tle_archive_size(tle_archive_t * archive)
+{
+    return archive->sets->len;
+}
+
+/* Check whether t is closer to the epoch of set i than to its neighbours. */
+static gboolean is_closest(tle_archive_t * archive, guint i, gdouble t)
+{
+    gdouble        *epochs = (gdouble *) archive->epochs->data;
+
+    if ((i > 0) && (t < (epochs[i - 1] + epochs[i]) / 2.0))
+        return FALSE;
+
+    if ((i + 1 < archive->epochs->len) &&
+        (t >= (epochs[i] + epochs[i + 1]) / 2.0))
+        return FALSE;
+
+    return TRUE;
+}
+
+/**
+ * Select the element set closest to a given time.
+ *
+ * @param archive The archive of the satellite.
+ * @param sat The satellite.
+ * @param qth The observer, used to initialise the satellite.
+ * @param t The time in "jul_utc".
+ * @return TRUE if the satellite has been switched to another element set.
+ *
+ * The satellite must have been initialised with the set that was selected
+ * last, i.e. the current set when the archive was loaded.
+ */
+gboolean tle_archive_select(tle_archive_t * archive, sat_t * sat,
+                            qth_t * qth, gdouble t)
+{
+    gdouble        *epochs = (gdouble *) archive->epochs->data;
+    guint           lo, hi, mid;
+    gint            status;
+
+    if (is_closest(archive, archive->current, t))
+        return FALSE;
+
+    /* first epoch after t */
+    lo = 0;
+    hi = archive->epochs->len;
+    while (lo < hi)
+    {
+        mid = (lo + hi) / 2;
+        if (epochs[mid] <= t)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo == archive->epochs->len)
+        lo--;
+    else if ((lo > 0) && (t - epochs[lo - 1] < epochs[lo] - t))
+        lo--;
+
+    if (lo == archive->current)
+        return FALSE;
+
+    archive->current = lo;
+
+    /* the operational status is not part of the elements */
+    status = sat->tle.status;
+    sat->tle = g_array_index(archive->sets, tle_t, lo);
+    sat->tle.status = status;
+
+    sat->flags = 0;
+    select_ephemeris(sat);
+    gtk_sat_data_init_sat(sat, qth);
+
+    sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                _("%s: Using elements of %d with epoch %.8f"),
+                __func__, sat->tle.catnr, sat->tle.epoch);
+
+    return TRUE;
+}
@@ -0,0 +1,22 @@
+#ifndef TLE_ARCHIVE_H
+#define TLE_ARCHIVE_H 1
+
+#include <glib.h>
+
+#include "qth-data.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/** Opaque TLE archive handle. */
+typedef struct _tle_archive tle_archive_t;
+
+gboolean        tle_archive_add(guint catnr, const gchar * line1,
+                                const gchar * line2);
+tle_archive_t  *tle_archive_new(void);
+tle_archive_t  *tle_archive_load(sat_t * sat);
+void            tle_archive_insert(tle_archive_t * archive, sat_t * sat);
+void            tle_archive_free(tle_archive_t * archive);
+guint           tle_archive_size(tle_archive_t * archive);
+gboolean        tle_archive_select(tle_archive_t * archive, sat_t * sat,
+                                   qth_t * qth, gdouble t);
+
+#endif
@@ -0,0 +1,532 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Per source TLE refresh schedule.
+ *
+ * Every time a TLE source is fetched, the time of the fetch is stored in
+ * USER_CONF_DIR/satdata/sources.cfg, one group per source URL, together with
+ * the catalog numbers of the tracked satellites found in the fetched file.
+ * Tracked satellites are those used by the modules of the user; the age of
+ * their elements is taken from their .sat files.
+ *
+ * A source is due for a refresh when it has never been fetched, when the
+ * auto-update interval has passed since it was last fetched, or when one of
+ * its tracked satellites has no elements younger than the configured maximum
+ * age. Satellites that were already too old when the source was last fetched
+ * do not count, otherwise a source carrying a decayed or dormant object
+ * would be fetched over and over. To limit the load on the servers a source
+ * is not refreshed because of the element age more often than every quarter
+ * of the maximum age.
+ *
+ * When there is no sources.cfg yet, e.g. after upgrading from a version
+ * without it, the configured sources are taken to have been fetched at the
+ * time of the last TLE update.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <glib/gstdio.h>
+#include <string.h>
+
+#include "compat.h"
+#include "config-keys.h"
+#include "gpredict-utils.h"
+#include "omm-import.h"
+#include "sat-cfg.h"
+#include "sat-log.h"
+#include "sgpsdp/sgp4sdp4.h"
+#include "tle-schedule.h"
+#include "tle-update.h"
+
+
+/* Offset and length of the epoch field in TLE line 1 */
+#define EPOCH_OFFSET    18
+#define EPOCH_LENGTH    14
+
+#define KEY_FETCHED     "FETCHED"
+#define KEY_SATS        "SATS"
+
+/* Written by earlier versions for every satellite of a source */
+#define KEY_EPOCHS      "EPOCHS"
+
+
+struct _tle_schedule {
+    GKeyFile       *data;       /*!< The contents of sources.cfg */
+    GHashTable     *tracked;    /*!< Julian epoch in satdata keyed on the
+                                 *   catnr of the tracked satellites */
+    gint64          mtime;      /*!< Modification time of sources.cfg */
+    gint64          size;       /*!< Size of sources.cfg */
+};
+
+/* Tracked satellites of a fetched file */
+typedef struct {
+    tle_schedule_t *sched;
+    GArray         *sats;       /*!< Catalog numbers */
+    guint           found;      /*!< Number of sets in the file */
+} fetched_sets_t;
+
+
+/* Get the key file group of a source; [ and ] are not allowed in groups. */
+static gchar   *group_name(const gchar * url)
+{
+    return g_strdelimit(g_strdup(url), "[]", '_');
+}
+
+/* Get the modification time and size of sources.cfg; both are -1 if the
+ * file does not exist. */
+static void stat_sources(const gchar * fname, gint64 * mtime, gint64 * size)
+{
+    GStatBuf        buf;
+
+    if (g_stat(fname, &buf) == 0)
+    {
+        *mtime = buf.st_mtime;
+        *size = buf.st_size;
+    }
+    else
+    {
+        *mtime = -1;
+        *size = -1;
+    }
+}
+
+/* Take the configured sources to have been fetched at the last update. */
+static void seed_fetched(tle_schedule_t * sched)
+{
+    gchar          *urls_str;
+    gchar         **urls;
+    gchar          *group;
+    gdouble         fetched;
+    gint            last;
+    guint           i;
+
+    last = sat_cfg_get_int(SAT_CFG_INT_TLE_LAST_UPDATE);
+    if (last <= 0)
+        return;
+
+    /* Unix seconds to Julian date */
+    fetched = last / 86400.0 + 2440587.5;
+
+    urls_str = sat_cfg_get_str(SAT_CFG_STR_TLE_URLS);
+    urls = g_strsplit(urls_str, ";", 0);
+    g_free(urls_str);
+
+    for (i = 0; urls[i] != NULL; i++)
+    {
+        if (urls[i][0] == '\0')
+            continue;
+
+        group = group_name(urls[i]);
+        g_key_file_set_double(sched->data, group, KEY_FETCHED, fetched);
+        g_free(group);
+    }
+    g_strfreev(urls);
+}
+
+/* Get the Julian epoch of the elements in the .sat file of a satellite. */
+static gdouble sat_epoch(gint catnr)
+{
+    GKeyFile       *data;
+    gchar          *fname;
+    gchar          *tle1;
+    gchar           field[EPOCH_LENGTH + 1];
+    gdouble         epoch = 0.0;
+
+    data = g_key_file_new();
+    fname = sat_file_name_from_catnum(catnr);
+    if (g_key_file_load_from_file(data, fname, G_KEY_FILE_NONE, NULL))
+    {
+        tle1 = g_key_file_get_string(data, "Satellite", "TLE1", NULL);
+        if ((tle1 != NULL) && (strlen(tle1) >= EPOCH_OFFSET + EPOCH_LENGTH))
+        {
+            g_strlcpy(field, tle1 + EPOCH_OFFSET, sizeof(field));
+            epoch = Julian_Date_of_Epoch(g_ascii_strtod(field, NULL));
+        }
+        g_free(tle1);
+    }
+    g_free(fname);
+    g_key_file_free(data);
+
+    return epoch;
+}
+
+/*
+ * Collect the satellites of all modules with the epochs of their elements.
+ *
+ * All module files are read rather than the open modules only, because the
+ * list of open modules is only stored on exit and the TLE update does not
+ * run on the main thread. There are few modules with few satellites each.
+ */
+static void load_tracked(tle_schedule_t * sched)
+{
+    GKeyFile       *data;
+    GDir           *dir;
+    const gchar    *filename;
+    gchar          *dirname;
+    gchar          *fname;
+    gint           *sats;
+    gint           *key;
+    gdouble        *epoch;
+    gsize           nsats, i;
+
+    g_hash_table_remove_all(sched->tracked);
+
+    dirname = get_modules_dir();
+    dir = g_dir_open(dirname, 0, NULL);
+    if (dir == NULL)
+    {
+        g_free(dirname);
+        return;
+    }
+
+    while ((filename = g_dir_read_name(dir)))
+    {
+        if (!g_str_has_suffix(filename, ".mod"))
+            continue;
+
+        data = g_key_file_new();
+        fname = g_strconcat(dirname, G_DIR_SEPARATOR_S, filename, NULL);
+        nsats = 0;
+        sats = NULL;
+        if (g_key_file_load_from_file(data, fname, G_KEY_FILE_NONE, NULL))
+            sats = g_key_file_get_integer_list(data, MOD_CFG_GLOBAL_SECTION,
+                                               MOD_CFG_SATS_KEY, &nsats,
+                                               NULL);
+
+        for (i = 0; i < nsats; i++)
+        {
+            if (g_hash_table_contains(sched->tracked, &sats[i]))
+                continue;
+
+            key = g_new(gint, 1);
+            *key = sats[i];
+            epoch = g_new(gdouble, 1);
+            *epoch = sat_epoch(sats[i]);
+            g_hash_table_insert(sched->tracked, key, epoch);
+        }
+
+        g_free(sats);
+        g_free(fname);
+        g_key_file_free(data);
+    }
+    g_dir_close(dir);
+    g_free(dirname);
+}
+
+/* Read sources.cfg into a schedule. */
+static void read_sources(tle_schedule_t * sched)
+{
+    gchar          *fname;
+    GError         *err = NULL;
+
+    fname = sat_file_name("sources.cfg");
+    stat_sources(fname, &sched->mtime, &sched->size);
+    if (!g_key_file_load_from_file(sched->data, fname, G_KEY_FILE_NONE, &err))
+    {
+        if (g_error_matches(err, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+            seed_fetched(sched);
+        else
+            sat_log_log(SAT_LOG_LEVEL_ERROR,
+                        _("%s: Error reading %s (%s)"),
+                        __func__, fname, err->message);
+        g_clear_error(&err);
+    }
+    g_free(fname);
+}
+
+/**
+ * Load the TLE source schedule.
+ *
+ * @return The schedule. Use tle_schedule_free() to free it.
+ *
+ * A broken sources.cfg gives an empty schedule where every source is due.
+ */
+tle_schedule_t *tle_schedule_load(void)
+{
+    tle_schedule_t *sched;
+
+    sched = g_new0(tle_schedule_t, 1);
+    sched->data = g_key_file_new();
+    sched->tracked = g_hash_table_new_full(g_int_hash, g_int_equal,
+                                           g_free, g_free);
+    read_sources(sched);
+    load_tracked(sched);
+
+    return sched;
+}
+
+/**
+ * Reload the schedule if sources.cfg has changed since it was read.
+ *
+ * @param sched The schedule.
+ * @return TRUE if the schedule has been reloaded.
+ *
+ * The file is considered changed when its modification time or size differ
+ * from when it was read.
+ */
+gboolean tle_schedule_reload(tle_schedule_t * sched)
+{
+    gchar          *fname;
+    gint64          mtime, size;
+
+    fname = sat_file_name("sources.cfg");
+    stat_sources(fname, &mtime, &size);
+    g_free(fname);
+
+    if ((mtime == sched->mtime) && (size == sched->size))
+        return FALSE;
+
+    g_key_file_free(sched->data);
+    sched->data = g_key_file_new();
+    read_sources(sched);
+
+    return TRUE;
+}
+
+/** Write the schedule to sources.cfg. */
+gboolean tle_schedule_save(tle_schedule_t * sched)
+{
+    gchar          *fname;
+    gboolean        saved;
+
+    fname = sat_file_name("sources.cfg");
+    saved = gpredict_save_key_file(sched->data, fname);
+    g_free(fname);
+
+    return saved;
+}
+
+void tle_schedule_free(tle_schedule_t * sched)
+{
+    if (sched == NULL)
+        return;
+
+    g_key_file_free(sched->data);
+    g_hash_table_destroy(sched->tracked);
+    g_free(sched);
+}
+
+/* Get the auto-update interval in days or 0 if auto-update is disabled. */
+static gdouble update_interval(void)
+{
+    switch (sat_cfg_get_int(SAT_CFG_INT_TLE_AUTO_UPD_FREQ))
+    {
+    case TLE_AUTO_UPDATE_MONTHLY:
+        return 30.0;
+
+    case TLE_AUTO_UPDATE_WEEKLY:
+        return 7.0;
+
+    case TLE_AUTO_UPDATE_DAILY:
+        return 1.0;
+
+    default:
+        return 0.0;
+    }
+}
+
+/**
+ * Check whether a TLE source is due for a refresh.
+ *
+ * @param sched The schedule.
+ * @param url The URL of the source.
+ * @param now The current time in "jul_utc".
+ * @return TRUE if the source should be fetched.
+ *
+ * Automatic updates are disabled when the auto-update frequency is set to
+ * never; the source is never due then.
+ */
+gboolean tle_schedule_is_due(tle_schedule_t * sched, const gchar * url,
+                             gdouble now)
+{
+    gchar          *group;
+    gint           *sats;
+    gdouble        *epoch;
+    gdouble         interval, maxage, fetched;
+    gsize           nsats = 0;
+    gsize           i;
+    gboolean        due = FALSE;
+
+    interval = update_interval();
+    if (interval == 0.0)
+        return FALSE;
+
+    group = group_name(url);
+
+    if (!g_key_file_has_key(sched->data, group, KEY_FETCHED, NULL))
+    {
+        g_free(group);
+        return TRUE;
+    }
+
+    fetched = g_key_file_get_double(sched->data, group, KEY_FETCHED, NULL);
+    maxage = sat_cfg_get_int(SAT_CFG_INT_TLE_MAX_AGE) / 24.0;
+
+    if (now - fetched >= interval)
+    {
+        due = TRUE;
+    }
+    else if ((maxage > 0.0) && (now - fetched >= maxage / 4.0))
+    {
+        sats = g_key_file_get_integer_list(sched->data, group, KEY_SATS,
+                                           &nsats, NULL);
+
+        for (i = 0; i < nsats && !due; i++)
+        {
+            /* not tracked any more, no .sat file or already too old */
+            epoch = g_hash_table_lookup(sched->tracked, &sats[i]);
+            if ((epoch == NULL) || (*epoch == 0.0) ||
+                (*epoch + maxage <= fetched))
+                continue;
+
+            if (*epoch + maxage <= now)
+            {
+                sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                            _("%s: Elements of %d are %.1f days old"),
+                            __func__, sats[i], now - *epoch);
+                due = TRUE;
+            }
+        }
+
+        g_free(sats);
+    }
+
+    g_free(group);
+
+    return due;
+}
+
+/**
+ * Get the configured TLE sources which are due for a refresh.
+ *
+ * @param sched The schedule.
+ * @param now The current time in "jul_utc".
+ * @return A newly allocated NULL terminated list of URLs, which is empty if
+ *         no source is due. Use g_strfreev() to free it.
+ *
+ * The tracked satellites and the epochs of their elements are read again,
+ * since modules may have been edited or elements updated since the last call.
+ */
+gchar         **tle_schedule_get_due(tle_schedule_t * sched, gdouble now)
+{
+    GPtrArray      *due;
+    gchar          *urls_str;
+    gchar         **urls;
+    guint           i;
+
+    load_tracked(sched);
+
+    urls_str = sat_cfg_get_str(SAT_CFG_STR_TLE_URLS);
+    urls = g_strsplit(urls_str, ";", 0);
+    g_free(urls_str);
+
+    due = g_ptr_array_new();
+    for (i = 0; urls[i] != NULL; i++)
+    {
+        if ((urls[i][0] != '\0') && tle_schedule_is_due(sched, urls[i], now))
+            g_ptr_array_add(due, g_strdup(urls[i]));
+    }
+    g_ptr_array_add(due, NULL);
+    g_strfreev(urls);
+
+    return (gchar **) g_ptr_array_free(due, FALSE);
+}
+
+/* Add a satellite of a fetched file to the list if it is tracked. */
+static void add_fetched(fetched_sets_t * sets, gint catnr)
+{
+    sets->found++;
+    if (g_hash_table_contains(sets->sched->tracked, &catnr))
+        g_array_append_val(sets->sats, catnr);
+}
+
+static void fetched_omm_cb(tle_t * tle, gchar lines[3][80], gpointer data)
+{
+    (void)lines;
+
+    add_fetched((fetched_sets_t *) data, tle->catnr);
+}
+
+/* Read the catalog numbers of a TLE file. */
+static void read_fetched_tle(const gchar * fname, fetched_sets_t * sets)
+{
+    gchar          *contents = NULL;
+    gchar         **lines;
+    guint           i;
+
+    if (!g_file_get_contents(fname, &contents, NULL, NULL))
+        return;
+
+    lines = g_strsplit(contents, "\n", -1);
+    for (i = 0; lines[i] != NULL && lines[i + 1] != NULL; i++)
+    {
+        if ((lines[i][0] != '1') || (lines[i + 1][0] != '2') ||
+            (strlen(lines[i]) < 7))
+            continue;
+
+        add_fetched(sets, Decode_Catnr(lines[i] + 2));
+        i++;
+    }
+    g_strfreev(lines);
+    g_free(contents);
+}
+
+/**
+ * Record a successful fetch of a TLE source.
+ *
+ * @param sched The schedule.
+ * @param url The URL of the source.
+ * @param fname The local copy of the fetched file.
+ * @param now The time of the fetch in "jul_utc".
+ *
+ * Only the catalog numbers of the tracked satellites in the file are stored.
+ * For TLE files only the catalog number field of the first line of each TLE
+ * is parsed, without verifying the checksum; broken sets are rejected later
+ * by the update itself. OMM files are read using omm_import_file().
+ */
+void tle_schedule_record(tle_schedule_t * sched, const gchar * url,
+                         const gchar * fname, gdouble now)
+{
+    fetched_sets_t  sets;
+    gchar          *group;
+
+    sets.sched = sched;
+    sets.sats = g_array_new(FALSE, FALSE, sizeof(gint));
+    sets.found = 0;
+
+    if (omm_import_file(fname, fetched_omm_cb, &sets) < 0)
+        read_fetched_tle(fname, &sets);
+
+    if (sets.found == 0)
+        sat_log_log(SAT_LOG_LEVEL_WARN,
+                    _("%s: No TLE data found in %s"), __func__, url);
+
+    group = group_name(url);
+    g_key_file_set_double(sched->data, group, KEY_FETCHED, now);
+    g_key_file_set_integer_list(sched->data, group, KEY_SATS,
+                                (gint *) sets.sats->data, sets.sats->len);
+    g_key_file_remove_key(sched->data, group, KEY_EPOCHS, NULL);
+    g_free(group);
+
+    g_array_free(sets.sats, TRUE);
+}
@@ -0,0 +1,20 @@
+#ifndef TLE_SCHEDULE_H
+#define TLE_SCHEDULE_H 1
+
+#include <glib.h>
+
+/** Opaque TLE source schedule handle. */
+typedef struct _tle_schedule tle_schedule_t;
+
+tle_schedule_t *tle_schedule_load(void);
+gboolean        tle_schedule_reload(tle_schedule_t * sched);
+gboolean        tle_schedule_save(tle_schedule_t * sched);
+void            tle_schedule_free(tle_schedule_t * sched);
+gboolean        tle_schedule_is_due(tle_schedule_t * sched,
+                                    const gchar * url, gdouble now);
+gchar         **tle_schedule_get_due(tle_schedule_t * sched, gdouble now);
+void            tle_schedule_record(tle_schedule_t * sched,
+                                    const gchar * url, const gchar * fname,
+                                    gdouble now);
+
+#endif
@@ -40,9 +40,14 @@
 
 #include "compat.h"
 #include "gpredict-utils.h"
+#include "omm-import.h"
+#include "sat-catalog.h"
 #include "sat-cfg.h"
 #include "sat-log.h"
 #include "sgpsdp/sgp4sdp4.h"
+#include "time-tools.h"
+#include "tle-archive.h"
+#include "tle-schedule.h"
 #include "tle-update.h"
 
 
@@ -53,18 +58,25 @@ static size_t   my_write_func(void *ptr, size_t size, size_t nmemb,
 #endif
 static gint     read_fresh_tle(const gchar * dir, const gchar * fnam,
                                GHashTable * data);
+static gint     read_fresh_omm(const gchar * dir, const gchar * fnam,
+                               GHashTable * data);
 static gboolean is_tle_file(const gchar * dir, const gchar * fnam);
+static gboolean is_omm_file(const gchar * dir, const gchar * fnam);
 
 
 static void     update_tle_in_file(const gchar * ldname,
                                    const gchar * fname,
                                    GHashTable * data,
+                                   sat_catalog_t * catalog,
                                    guint * sat_upd,
                                    guint * sat_ski,
                                    guint * sat_nod, guint * sat_tot);
 
 static guint    add_new_sats(GHashTable * data);
 static gboolean is_computer_generated_name(gchar * satname);
+static void     update_from_network(gboolean due_only, gboolean silent,
+                                    GtkWidget * progress,
+                                    GtkWidget * label1, GtkWidget * label2);
 
 
 /** Free a new_tle_t structure. */
@@ -103,6 +115,7 @@ void tle_update_from_files(const gchar * dir, const gchar * filter,
     static GMutex   tle_file_in_progress;
 
     GHashTable     *data;       /* hash table with fresh TLE data */
+    sat_catalog_t  *catalog;    /* new catalog version */
     GDir           *cache_dir;  /* directory to scan fresh TLE */
     GDir           *loc_dir;    /* directory for gpredict TLE files */
     GError         *err = NULL;
@@ -183,7 +196,10 @@ void tle_update_from_files(const gchar * dir, const gchar * filter,
                 }
 
                 /* now, do read the fresh data */
-                num = read_fresh_tle(dir, fnam, data);
+                if (is_omm_file(dir, fnam))
+                    num = read_fresh_omm(dir, fnam, data);
+                else
+                    num = read_fresh_tle(dir, fnam, data);
             }
             else
             {
@@ -262,6 +278,9 @@ void tle_update_from_files(const gchar * dir, const gchar * filter,
 
             g_dir_rewind(loc_dir);
 
+            /* the modules pick up the new elements from the catalog */
+            catalog = sat_catalog_begin();
+
             /* update TLE files one by one */
             while ((fnam = g_dir_read_name(loc_dir)) != NULL)
             {
@@ -275,7 +294,7 @@ void tle_update_from_files(const gchar * dir, const gchar * filter,
                     total_tmp = 0;
 
                     /* update TLE data in this file */
-                    update_tle_in_file(ldname, fnam, data,
+                    update_tle_in_file(ldname, fnam, data, catalog,
                                        &updated_tmp,
                                        &skipped_tmp, &nodata_tmp, &total_tmp);
 
@@ -393,6 +412,11 @@ void tle_update_from_files(const gchar * dir, const gchar * filter,
                             __func__, newsats);
             }
 
+            if (updated > 0)
+                sat_catalog_publish(catalog);
+            else
+                sat_catalog_discard(catalog);
+
             /* store time of update if we have updated something */
             if ((updated > 0) || (newsats > 0))
             {
@@ -444,6 +468,8 @@ static void check_and_add_sat(gpointer key, gpointer value, gpointer user_data)
     if (!gpredict_save_key_file(satdata, cfgfile))
         *num += 1;
 
+    tle_archive_add(ntle->catnum, ntle->line1, ntle->line2);
+
     /* clean up memory */
     g_free(cfgfile);
     g_key_file_free(satdata);
@@ -466,13 +492,46 @@ static guint add_new_sats(GHashTable * data)
  * @param progress Pointer to a GtkProgressBar progress indicator (can be NULL)
  * @param label1 GtkLabel for activity string.
  * @param label2 GtkLabel for statistics string.
+ *
+ * All configured TLE sources are fetched.
  */
 void tle_update_from_network(gboolean silent,
                              GtkWidget * progress,
                              GtkWidget * label1, GtkWidget * label2)
+{
+    update_from_network(FALSE, silent, progress, label1, label2);
+}
+
+/**
+ * Update TLE files from the sources that are due for a refresh.
+ *
+ * This is the unattended auto-update; it only fetches the sources that
+ * tle_schedule_get_due() returns and runs without status indicators.
+ */
+void tle_update_due_from_network(void)
+{
+    update_from_network(TRUE, TRUE, NULL, NULL, NULL);
+}
+
+/**
+ * Fetch TLE sources and update the TLE files from them.
+ *
+ * @param due_only TRUE to fetch only the sources that are due for a refresh,
+ *                 FALSE to fetch all configured sources.
+ * @param silent TRUE if function should execute without graphical status indicator.
+ * @param progress Pointer to a GtkProgressBar progress indicator (can be NULL)
+ * @param label1 GtkLabel for activity string.
+ * @param label2 GtkLabel for statistics string.
+ *
+ * Each successful fetch is recorded in the TLE source schedule.
+ */
+static void update_from_network(gboolean due_only, gboolean silent,
+                                GtkWidget * progress,
+                                GtkWidget * label1, GtkWidget * label2)
 {
     static GMutex   tle_in_progress;
 
+    tle_schedule_t *sched;
     gchar          *proxy = NULL;
     gchar          *files_tmp;
     gchar         **files;
@@ -494,6 +553,7 @@ void tle_update_from_network(gboolean silent,
     gchar          *text;
     GError         *err = NULL;
     guint           success = 0;        /* no. of successfull downloads */
+    gboolean        fetched;
 
     /* bail out if we are already in an update process */
     if (g_mutex_trylock(&tle_in_progress) == FALSE)
@@ -516,11 +576,25 @@ void tle_update_from_network(gboolean silent,
         proxy = NULL;
     }
 
-    files_tmp = sat_cfg_get_str(SAT_CFG_STR_TLE_URLS);
-    files = g_strsplit(files_tmp, ";", 0);
+    sched = tle_schedule_load();
+    if (due_only)
+    {
+        files = tle_schedule_get_due(sched, get_current_daynum());
+    }
+    else
+    {
+        files_tmp = sat_cfg_get_str(SAT_CFG_STR_TLE_URLS);
+        files = g_strsplit(files_tmp, ";", 0);
+        g_free(files_tmp);
+    }
     numfiles = g_strv_length(files);
 
-    if (numfiles < 1)
+    if (due_only && (numfiles < 1))
+    {
+        sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                    _("%s: No TLE sources are due for a refresh."), __func__);
+    }
+    else if (numfiles < 1)
     {
         sat_log_log(SAT_LOG_LEVEL_ERROR,
                     _("%s: No files to fetch from network."), __func__);
@@ -578,6 +652,7 @@ void tle_update_from_network(gboolean silent,
                                       userconfdir, G_DIR_SEPARATOR_S,
                                       G_DIR_SEPARATOR_S, G_DIR_SEPARATOR_S, i);
             outfile = g_fopen(locfile, "wb");
+            fetched = FALSE;
             if (outfile != NULL)
             {
 #ifdef WIN32
@@ -594,6 +669,7 @@ void tle_update_from_network(gboolean silent,
                                 _("%s: Successfully fetched %s"),
                                 __func__, curfile);
                     success++;
+                    fetched = TRUE;
                 }
 #else
                 curl_easy_setopt(curl, CURLOPT_WRITEDATA, outfile);
@@ -614,9 +690,14 @@ void tle_update_from_network(gboolean silent,
                                 _("%s: Successfully fetched %s"),
                                 __func__, curfile);
                     success++;
+                    fetched = TRUE;
                 }
 #endif
                 fclose(outfile);
+
+                if (fetched)
+                    tle_schedule_record(sched, curfile, locfile,
+                                        get_current_daynum());
             }
             else
             {
@@ -655,6 +736,8 @@ void tle_update_from_network(gboolean silent,
             sat_log_log(SAT_LOG_LEVEL_INFO,
                         _("%s: Fetched %d files from network; updating..."),
                         __func__, success);
+            tle_schedule_save(sched);
+
             /* call update_from_files */
             cache = sat_file_name("cache");
             tle_update_from_files(cache, NULL, silent, progress, label1,
@@ -673,7 +756,7 @@ void tle_update_from_network(gboolean silent,
 
     /* clear cache and memory */
     g_strfreev(files);
-    g_free(files_tmp);
+    tle_schedule_free(sched);
     if (proxy != NULL)
         g_free(proxy);
 
@@ -738,7 +821,7 @@ static size_t my_write_func(void *ptr, size_t size, size_t nmemb,
  * This function checks whether the file with path dir/fnam is a potential
  * TLE file. Checks performed:
  *   - It is a real file
- *   - suffix is .txt or .tle
+ *   - suffix is .txt or .tle, or .json, .csv, .xml or .kvn for OMM data
  */
 static gboolean is_tle_file(const gchar * dir, const gchar * fnam)
 {
@@ -751,7 +834,11 @@ static gboolean is_tle_file(const gchar * dir, const gchar * fnam)
 
     if (g_file_test(path, G_FILE_TEST_IS_REGULAR) &&
         (g_str_has_suffix(fname_lower, ".tle") ||
-         g_str_has_suffix(fname_lower, ".txt")))
+         g_str_has_suffix(fname_lower, ".txt") ||
+         g_str_has_suffix(fname_lower, ".json") ||
+         g_str_has_suffix(fname_lower, ".csv") ||
+         g_str_has_suffix(fname_lower, ".xml") ||
+         g_str_has_suffix(fname_lower, ".kvn")))
     {
         fileIsOk = TRUE;
     }
@@ -761,6 +848,163 @@ static gboolean is_tle_file(const gchar * dir, const gchar * fnam)
     return fileIsOk;
 }
 
+/**
+ * Check whether a TLE file holds OMM data.
+ *
+ * The content is checked rather than the suffix because the files fetched
+ * from the network are all stored as .tle in the cache.
+ */
+static gboolean is_omm_file(const gchar * dir, const gchar * fnam)
+{
+    gchar          *path;
+    gboolean        isomm;
+
+    path = g_strconcat(dir, G_DIR_SEPARATOR_S, fnam, NULL);
+    isomm = (omm_import_sniff(path) != OMM_FORMAT_NONE);
+    g_free(path);
+
+    return isomm;
+}
+
+/**
+ * Add a fresh element set to the hash table.
+ *
+ * @param data Hash table with the fresh TLE data.
+ * @param fnam The name of the file the element set was read from.
+ * @param tle_str The satellite name and the two TLE lines.
+ * @param tle The converted element set.
+ * @return TRUE if the satellite was not in the hash table yet.
+ *
+ * If the satellite is already in the hash table, the newer element set is
+ * kept and the operational status and name are merged.
+ */
+static gboolean add_fresh_tle(GHashTable * data, const gchar * fnam,
+                              gchar tle_str[3][80], tle_t * tle)
+{
+    new_tle_t      *ntle;
+    guint          *key;
+    gboolean        isnew = FALSE;
+
+    /* add data to hash table */
+    key = g_try_new0(guint, 1);
+    *key = tle->catnr;
+
+    ntle = g_hash_table_lookup(data, key);
+
+    /* check if satellite already in hash table */
+    if (ntle == NULL)
+    {
+
+        /* create new_tle structure */
+        ntle = g_try_new(new_tle_t, 1);
+        ntle->catnum = tle->catnr;
+        ntle->epoch = tle->epoch;
+        ntle->status = tle->status;
+        ntle->satname = g_strdup(tle->sat_name);
+        ntle->line1 = g_strdup(tle_str[1]);
+        ntle->line2 = g_strdup(tle_str[2]);
+        ntle->srcfile = g_strdup(fnam);
+        ntle->isnew = TRUE; /* flag will be reset when using data */
+
+        g_hash_table_insert(data, key, ntle);
+        isnew = TRUE;
+    }
+    else
+    {
+        /* satellite is already in hash */
+        /* apply various merge routines */
+
+        /* time merge */
+        if (ntle->epoch == tle->epoch)
+        {
+            /* if satellite epoch has the same time,  merge status as appropriate */
+            if (ntle->status != tle->status)
+            {
+                /* log if there is something funny about the data coming in */
+                sat_log_log(SAT_LOG_LEVEL_WARN,
+                            _
+                            ("%s:%s: Two different statuses for %d (%s) at the same time."),
+                            __FILE__, __func__, ntle->catnum,
+                            ntle->satname);
+                if (tle->status != OP_STAT_UNKNOWN)
+                    ntle->status = tle->status;
+            }
+        }
+        else if (ntle->epoch < tle->epoch)
+        {
+            /* if the satellite in the hash is older than 
+               the one just loaded, copy the values over. */
+
+            ntle->catnum = tle->catnr;
+            ntle->epoch = tle->epoch;
+            ntle->status = tle->status;
+            g_free(ntle->line1);
+            ntle->line1 = g_strdup(tle_str[1]);
+            g_free(ntle->line2);
+            ntle->line2 = g_strdup(tle_str[2]);
+            g_free(ntle->srcfile);
+            ntle->srcfile = g_strdup(fnam);
+            ntle->isnew = TRUE;     /* flag will be reset when using data */
+        }
+
+        /* merge based on name */
+        if (is_computer_generated_name(ntle->satname) &&
+            !is_computer_generated_name(tle_str[0]))
+        {
+            g_free(ntle->satname);
+            ntle->satname = g_strdup(tle->sat_name);
+        }
+
+        /* free the key since we do not commit it to the cache */
+        g_free(key);
+    }
+
+    return isnew;
+}
+
+typedef struct {
+    GHashTable     *data;       /*!< Hash table with the fresh TLE data */
+    const gchar    *fnam;       /*!< The file being read */
+    gint            count;      /*!< Number of new satellites */
+} fresh_omm_t;
+
+static void fresh_omm_cb(tle_t * tle, gchar lines[3][80], gpointer data)
+{
+    fresh_omm_t    *fresh = (fresh_omm_t *) data;
+
+    if (add_fresh_tle(fresh->data, fresh->fnam, lines, tle))
+        fresh->count++;
+}
+
+/**
+ * Read fresh OMM data into hash table.
+ *
+ * @param dir The directory to read from.
+ * @param fnam The name of the file to read from.
+ * @param data Hash table where the data should be stored.
+ * @return The number of satellites successfully read.
+ *
+ * The OMM messages are converted to TLE by omm_import_file() and merged like
+ * the element sets of TLE files. Satellite categories are not synchronised
+ * with OMM files.
+ */
+static gint read_fresh_omm(const gchar * dir, const gchar * fnam,
+                           GHashTable * data)
+{
+    fresh_omm_t     fresh;
+    gchar          *path;
+
+    fresh.data = data;
+    fresh.fnam = fnam;
+    fresh.count = 0;
+
+    path = g_strconcat(dir, G_DIR_SEPARATOR_S, fnam, NULL);
+    omm_import_file(path, fresh_omm_cb, &fresh);
+    g_free(path);
+
+    return fresh.count;
+}
+
 /**
  * Read fresh TLE data into hash table.
  *
@@ -776,20 +1020,17 @@ static gboolean is_tle_file(const gchar * dir, const gchar * fnam)
 static gint read_fresh_tle(const gchar * dir, const gchar * fnam,
                            GHashTable * data)
 {
-    new_tle_t      *ntle;
     tle_t           tle;
     gchar          *path;
     gchar           tle_str[3][80];
     gchar           tle_working[3][80];
     gchar           linetmp[80];
     guint           linesneeded = 3;
-    gchar           catstr[6];
     gchar           idstr[7] = "\0\0\0\0\0\0\0", idyearstr[3];
     gchar          *b;
     FILE           *fp;
     gint            retcode = 0;
-    guint           catnr, i, idyear;
-    guint          *key = NULL;
+    guint           catnr, idyear;
 
     /* category sync related */
     gchar          *catname, *catpath, *buff, **buffv;
@@ -997,13 +1238,8 @@ static gint read_fresh_tle(const gchar * dir, const gchar * fnam,
             tle_str[1][69] = '\0';
             tle_str[2][69] = '\0';
 
-            /* copy catnum and convert to integer */
-            for (i = 2; i < 7; i++)
-            {
-                catstr[i - 2] = tle_str[1][i];
-            }
-            catstr[5] = '\0';
-            catnr = (guint) g_ascii_strtod(catstr, NULL);
+            /* convert catnum to integer */
+            catnr = (guint) Decode_Catnr(&tle_str[1][2]);
 
 
             if (Get_Next_Tle_Set(tle_str, &tle) != 1)
@@ -1023,79 +1259,8 @@ static gint read_fresh_tle(const gchar * dir, const gchar * fnam,
                     g_free(buff);
                 }
 
-                /* add data to hash table */
-                key = g_try_new0(guint, 1);
-                *key = catnr;
-
-                ntle = g_hash_table_lookup(data, key);
-
-                /* check if satellite already in hash table */
-                if (ntle == NULL)
-                {
-
-                    /* create new_tle structure */
-                    ntle = g_try_new(new_tle_t, 1);
-                    ntle->catnum = catnr;
-                    ntle->epoch = tle.epoch;
-                    ntle->status = tle.status;
-                    ntle->satname = g_strdup(tle.sat_name);
-                    ntle->line1 = g_strdup(tle_str[1]);
-                    ntle->line2 = g_strdup(tle_str[2]);
-                    ntle->srcfile = g_strdup(fnam);
-                    ntle->isnew = TRUE; /* flag will be reset when using data */
-
-                    g_hash_table_insert(data, key, ntle);
+                if (add_fresh_tle(data, fnam, tle_str, &tle))
                     retcode++;
-                }
-                else
-                {
-                    /* satellite is already in hash */
-                    /* apply various merge routines */
-
-                    /* time merge */
-                    if (ntle->epoch == tle.epoch)
-                    {
-                        /* if satellite epoch has the same time,  merge status as appropriate */
-                        if (ntle->status != tle.status)
-                        {
-                            /* log if there is something funny about the data coming in */
-                            sat_log_log(SAT_LOG_LEVEL_WARN,
-                                        _
-                                        ("%s:%s: Two different statuses for %d (%s) at the same time."),
-                                        __FILE__, __func__, ntle->catnum,
-                                        ntle->satname);
-                            if (tle.status != OP_STAT_UNKNOWN)
-                                ntle->status = tle.status;
-                        }
-                    }
-                    else if (ntle->epoch < tle.epoch)
-                    {
-                        /* if the satellite in the hash is older than 
-                           the one just loaded, copy the values over. */
-
-                        ntle->catnum = catnr;
-                        ntle->epoch = tle.epoch;
-                        ntle->status = tle.status;
-                        g_free(ntle->line1);
-                        ntle->line1 = g_strdup(tle_str[1]);
-                        g_free(ntle->line2);
-                        ntle->line2 = g_strdup(tle_str[2]);
-                        g_free(ntle->srcfile);
-                        ntle->srcfile = g_strdup(fnam);
-                        ntle->isnew = TRUE;     /* flag will be reset when using data */
-                    }
-
-                    /* merge based on name */
-                    if (is_computer_generated_name(ntle->satname) &&
-                        !is_computer_generated_name(tle_str[0]))
-                    {
-                        g_free(ntle->satname);
-                        ntle->satname = g_strdup(tle.sat_name);
-                    }
-
-                    /* free the key since we do not commit it to the cache */
-                    g_free(key);
-                }
             }
 
         }
@@ -1128,6 +1293,7 @@ static gint read_fresh_tle(const gchar * dir, const gchar * fnam,
  * @param ldname Directory name for gpredict tle files.
  * @param fname The name of the TLE file.
  * @param data The hash table containing the fresh data.
+ * @param catalog The new catalog version receiving the updated elements.
  * @param sat_upd OUT: number of sats updated.
  * @param sat_ski OUT: number of sats skipped.
  * @param sat_nod OUT: number of sats for which no data found
@@ -1143,6 +1309,7 @@ static gint read_fresh_tle(const gchar * dir, const gchar * fnam,
 static void update_tle_in_file(const gchar * ldname,
                                const gchar * fname,
                                GHashTable * data,
+                               sat_catalog_t * catalog,
                                guint * sat_upd,
                                guint * sat_ski,
                                guint * sat_nod, guint * sat_tot)
@@ -1162,6 +1329,7 @@ static void update_tle_in_file(const gchar * ldname,
     GKeyFile       *satdata;
     gchar          *tlestr1, *tlestr2, *rawtle, *satname, *satnickname;
     gboolean        updateddata;
+    gboolean        updatedtle;
 
     /* get catalog number for this satellite */
     catstr = g_strsplit(fname, ".sat", 0);
@@ -1257,12 +1425,21 @@ static void update_tle_in_file(const gchar * ldname,
             {
                 Convert_Satellite_Data(rawtle, &tle);
             }
+            g_free(rawtle);
+
+            /* keep every distinct element set in the archive */
+            if (tle.epoch != ntle->epoch)
+            {
+                if (tle.epoch != 0)
+                    tle_archive_add(catnr, tlestr1, tlestr2);
+                tle_archive_add(catnr, ntle->line1, ntle->line2);
+            }
             g_free(tlestr1);
             g_free(tlestr2);
-            g_free(rawtle);
 
-            /* Initialize flag for update */
+            /* Initialize flags for update */
             updateddata = FALSE;
+            updatedtle = FALSE;
 
             if (ntle->satname != NULL)
             {
@@ -1314,7 +1491,7 @@ static void update_tle_in_file(const gchar * ldname,
                 g_key_file_set_integer(satdata, "Satellite", "STATUS",
                                        ntle->status);
                 updateddata = TRUE;
-
+                updatedtle = TRUE;
             }
             else if (tle.epoch == ntle->epoch)
             {
@@ -1328,15 +1505,28 @@ static void update_tle_in_file(const gchar * ldname,
                     g_key_file_set_integer(satdata, "Satellite", "STATUS",
                                            ntle->status);
                     updateddata = TRUE;
+                    updatedtle = TRUE;
                 }
             }
 
             if (updateddata == TRUE)
             {
                 if (gpredict_save_key_file(satdata, path))
+                {
                     skipped++;
+                }
                 else
+                {
                     updated++;
+                    if (updatedtle)
+                    {
+                        rawtle = g_strconcat(ntle->line1, ntle->line2, NULL);
+                        Convert_Satellite_Data(rawtle, &tle);
+                        tle.status = ntle->status;
+                        sat_catalog_set(catalog, &tle);
+                        g_free(rawtle);
+                    }
+                }
             }
             else
             {
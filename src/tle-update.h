@@ -83,6 +83,7 @@ void            tle_update_from_network(gboolean silent,
                                         GtkWidget * progress,
                                         GtkWidget * label1,
                                         GtkWidget * label2);
+void            tle_update_due_from_network(void);
 
 const gchar    *tle_update_freq_to_str(tle_auto_upd_freq_t freq);
 
@@ -0,0 +1,375 @@
+/*
+  Gpredict: Real-time satellite tracking and orbit prediction program
+
+  Copyright (C)  2001-2017  Alexandru Csete, OZ9AEC.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, visit http://www.fsf.org/
+*/
+
+/*
+ * Visible pass search.
+ *
+ * A pass is visible when the satellite is above the horizon and in sunlight
+ * while the sun is below the twilight threshold at the observer. Instead of
+ * predicting every pass and checking the visibility afterwards, the search
+ * first computes the windows where the solar elevation at the observer allows
+ * visible passes and then only looks for passes within these windows. The
+ * lower bound of the solar elevation depends on the orbit: a satellite is in
+ * the shadow of the Earth whenever the sun is too far below the horizon of
+ * every point it can be seen from.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <build-config.h>
+#endif
+
+#include <glib/gi18n.h>
+#include <math.h>
+#include <string.h>
+
+#include "orbit-tools.h"
+#include "sat-cfg.h"
+#include "sat-log.h"
+#include "vis-pass.h"
+
+
+/* Sampling step of the solar elevation (10 min) */
+#define SUN_STEP        0.007
+
+/* Resolution of the dark window boundaries (10 sec) */
+#define SUN_TRES        0.000116
+
+/* Sampling step of the satellite visibility during a pass (30 sec) */
+#define VIS_STEP        0.00035
+
+/* Resolution of the visibility boundaries (1 sec) */
+#define VIS_TRES        0.0000116
+
+/* Margin of the solar elevation bound for penumbra and refraction [deg] */
+#define SUN_EL_MARGIN   1.0
+
+
+/* Solar elevation at the observer in degrees */
+static gdouble sun_el(qth_t * qth, gdouble t, vector_t * solar_vector)
+{
+    vector_t        zero_vector = { 0, 0, 0, 0 };
+    geodetic_t      obs_geodetic;
+    obs_set_t       solar_set;
+
+    obs_geodetic.lon = qth->lon * de2ra;
+    obs_geodetic.lat = qth->lat * de2ra;
+    obs_geodetic.alt = qth->alt / 1000.0;
+    obs_geodetic.theta = 0;
+
+    Calculate_Solar_Position(t, solar_vector);
+    Calculate_Obs(t, solar_vector, &zero_vector, &obs_geodetic, &solar_set);
+
+    return Degrees(solar_set.el);
+}
+
+static gboolean sun_in_range(qth_t * qth, gdouble t, gdouble min_sun_el,
+                             gdouble max_sun_el)
+{
+    vector_t        solar_vector;
+    gdouble         el = sun_el(qth, t, &solar_vector);
+
+    return (el >= min_sun_el && el <= max_sun_el);
+}
+
+/**
+ * Find the dark windows within a time range.
+ *
+ * @param qth The observer.
+ * @param start Start of the time range (Julian Date).
+ * @param maxdt Length of the time range in days.
+ * @param min_sun_el Minimum solar elevation in degrees.
+ * @param max_sun_el Maximum solar elevation in degrees.
+ * @return An array of dark_window_t in chronological order. Free it with
+ *         g_array_free().
+ *
+ * The solar elevation is sampled every 10 minutes, so windows shorter than
+ * that may be missed when the sun barely crosses one of the limits.
+ */
+GArray         *get_dark_windows(qth_t * qth, gdouble start, gdouble maxdt,
+                                 gdouble min_sun_el, gdouble max_sun_el)
+{
+    GArray         *windows;
+    dark_window_t   window;
+    gdouble         end = start + maxdt;
+    gdouble         t, t0, t1, tm;
+    gboolean        dark, prev;
+
+    windows = g_array_new(FALSE, FALSE, sizeof(dark_window_t));
+
+    prev = sun_in_range(qth, start, min_sun_el, max_sun_el);
+    window.start = start;
+
+    for (t = start; t < end; t += SUN_STEP)
+    {
+        t1 = MIN(t + SUN_STEP, end);
+        dark = sun_in_range(qth, t1, min_sun_el, max_sun_el);
+        if (dark == prev)
+            continue;
+
+        /* bisect the boundary */
+        t0 = t;
+        while (t1 - t0 > SUN_TRES)
+        {
+            tm = (t0 + t1) / 2.0;
+            if (sun_in_range(qth, tm, min_sun_el, max_sun_el) == prev)
+                t0 = tm;
+            else
+                t1 = tm;
+        }
+
+        if (dark)
+        {
+            window.start = t1;
+        }
+        else
+        {
+            window.end = t0;
+            g_array_append_val(windows, window);
+        }
+
+        prev = dark;
+    }
+
+    if (prev)
+    {
+        window.end = end;
+        g_array_append_val(windows, window);
+    }
+
+    return windows;
+}
+
+/* Whether the satellite can be seen by eye at time t */
+static gboolean sat_visible(sat_t * sat, qth_t * qth, gdouble t,
+                            gdouble max_sun_el)
+{
+    vector_t        solar_vector;
+    gdouble         el;
+    gdouble         depth;
+
+    predict_calc(sat, qth, t);
+    if (sat->el < 0.0)
+        return FALSE;
+
+    el = sun_el(qth, t, &solar_vector);
+    if (el > max_sun_el)
+        return FALSE;
+
+    return !Sat_Eclipsed(&sat->pos, &solar_vector, &depth);
+}
+
+/* Bisect the time where sat_visible() changes from state between t0 and t1 */
+static gdouble find_vis_change(sat_t * sat, qth_t * qth, gdouble t0,
+                               gdouble t1, gboolean state,
+                               gdouble max_sun_el)
+{
+    gdouble         tm;
+
+    while (t1 - t0 > VIS_TRES)
+    {
+        tm = (t0 + t1) / 2.0;
+        if (sat_visible(sat, qth, tm, max_sun_el) == state)
+            t0 = tm;
+        else
+            t1 = tm;
+    }
+
+    return (t0 + t1) / 2.0;
+}
+
+/**
+ * Find the visible part of a pass.
+ *
+ * @param sat The satellite; its data is modified.
+ * @param qth The observer.
+ * @param pass The pass.
+ * @param vis_start Location where the start of the visible part is stored.
+ *                  May be NULL.
+ * @param vis_end Location where the end of the visible part is stored.
+ *                May be NULL.
+ * @return TRUE if the satellite is visible during the pass.
+ *
+ * The pass is sampled every 30 seconds and the times where the satellite
+ * enters or leaves the shadow of the Earth or the sky gets too bright are
+ * refined to one second. If the satellite is visible more than once during
+ * the pass, the visible part spans from the first to the last visible time.
+ * If both vis_start and vis_end are NULL, the search stops at the first
+ * visible sample.
+ */
+gboolean get_pass_visibility(sat_t * sat, qth_t * qth, pass_t * pass,
+                             gdouble * vis_start, gdouble * vis_end)
+{
+    gdouble         max_sun_el;
+    gdouble         t, t1;
+    gdouble         dummy_start, dummy_end;
+    gboolean        vis, prev;
+    gboolean        found = FALSE;
+    gboolean        check_only = (vis_start == NULL && vis_end == NULL);
+
+    if (vis_start == NULL)
+        vis_start = &dummy_start;
+    if (vis_end == NULL)
+        vis_end = &dummy_end;
+
+    max_sun_el = sat_cfg_get_int(SAT_CFG_INT_PRED_TWILIGHT_THLD);
+
+    prev = sat_visible(sat, qth, pass->aos, max_sun_el);
+    if (prev && check_only)
+        return TRUE;
+
+    if (prev)
+    {
+        *vis_start = pass->aos;
+        *vis_end = pass->aos;
+        found = TRUE;
+    }
+
+    for (t = pass->aos; t < pass->los; t += VIS_STEP)
+    {
+        t1 = MIN(t + VIS_STEP, pass->los);
+        vis = sat_visible(sat, qth, t1, max_sun_el);
+        if (vis && check_only)
+            return TRUE;
+
+        if (vis != prev)
+        {
+            if (vis && !found)
+            {
+                *vis_start = find_vis_change(sat, qth, t, t1, prev,
+                                             max_sun_el);
+                found = TRUE;
+            }
+            else if (!vis)
+            {
+                *vis_end = find_vis_change(sat, qth, t, t1, prev,
+                                           max_sun_el);
+            }
+        }
+
+        if (vis)
+            *vis_end = t1;
+
+        prev = vis;
+    }
+
+    return found;
+}
+
+/*
+ * Lowest solar elevation at the observer that still allows the satellite to
+ * be in sunlight while above the horizon. The satellite at distance r is in
+ * sunlight when the sun is less than acos(R/r) below the horizon of the
+ * sub-satellite point, which is at most acos(R/r) away from the observer.
+ */
+static gdouble min_sun_el_for_sat(sat_t * sat)
+{
+    gdouble         sma, apogee, angle;
+
+    /* same as in has_aos() */
+    sma = 331.25 * exp(log(1440.0 / sat->meanmo) * (2.0 / 3.0));
+    apogee = sma * (1.0 + sat->tle.eo) - xkmper;
+    if (apogee <= 0.0)
+        return 90.0;
+
+    angle = 2.0 * Degrees(acos(xkmper / (xkmper + apogee))) + SUN_EL_MARGIN;
+
+    return MAX(-angle, -90.0);
+}
+
+/**
+ * Predict the visible passes of a satellite.
+ *
+ * @param sat The satellite.
+ * @param qth The observer.
+ * @param start Start of the search (Julian Date).
+ * @param maxdt Length of the search in days.
+ * @param min_el Minimum of the max elevation in degrees.
+ * @param num The max number of passes, 0 for no limit.
+ * @param cancelled Flag checked before each pass (atomic); the search stops
+ *                  and returns the passes found so far when it is set.
+ *                  May be NULL.
+ * @return A list of passes in chronological order. The visibility string of
+ *         every pass starts with 'V'. Free the list with free_passes().
+ *
+ * Only passes overlapping the dark windows of the observer are predicted.
+ * Unlike get_passes(), the time window must be finite.
+ */
+GSList         *get_visible_passes(sat_t * sat, qth_t * qth, gdouble start,
+                                   gdouble maxdt, gdouble min_el, guint num,
+                                   gint * cancelled)
+{
+    GSList         *passes = NULL;
+    GArray         *windows;
+    dark_window_t  *window;
+    pass_t         *pass;
+    sat_t           sat_working;
+    gdouble         t = start;
+    guint           count = 0;
+    guint           i;
+
+    g_return_val_if_fail(maxdt > 0.0, NULL);
+
+    if (!has_aos(sat, qth))
+        return NULL;
+
+    windows = get_dark_windows(qth, start, maxdt, min_sun_el_for_sat(sat),
+                               sat_cfg_get_int
+                               (SAT_CFG_INT_PRED_TWILIGHT_THLD));
+
+    /* get_pass_visibility() corrupts the satellite data */
+    memcpy(&sat_working, sat, sizeof(sat_t));
+
+    for (i = 0; i < windows->len && (num == 0 || count < num); i++)
+    {
+        window = &g_array_index(windows, dark_window_t, i);
+        t = MAX(t, window->start);
+
+        while (t < window->end && (num == 0 || count < num))
+        {
+            if (cancelled != NULL && g_atomic_int_get(cancelled))
+                break;
+
+            pass = get_pass_min_el(sat, qth, t, window->end - t, min_el);
+            if (pass == NULL)
+                break;
+
+            t = pass->los + 0.014;      // +20 min, same as get_passes()
+
+            /* only whether the pass is visible matters here */
+            if (get_pass_visibility(&sat_working, qth, pass, NULL, NULL))
+            {
+                pass->vis[0] = 'V';
+                passes = g_slist_prepend(passes, pass);
+                count++;
+            }
+            else
+            {
+                free_pass(pass);
+            }
+        }
+    }
+
+    sat_log_log(SAT_LOG_LEVEL_DEBUG,
+                _("%s: Found %d visible passes for %s in %d dark windows"),
+                __func__, count, sat->nickname, windows->len);
+
+    g_array_free(windows, TRUE);
+
+    return g_slist_reverse(passes);
+}
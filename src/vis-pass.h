@@ -0,0 +1,24 @@
+#ifndef VIS_PASS_H
+#define VIS_PASS_H 1
+
+#include <glib.h>
+
+#include "predict-tools.h"
+#include "qth-data.h"
+#include "sgpsdp/sgp4sdp4.h"
+
+/** Time window in which the sky is dark enough to see satellites. */
+typedef struct {
+    gdouble         start;      /*!< Start of the window (Julian Date). */
+    gdouble         end;        /*!< End of the window (Julian Date). */
+} dark_window_t;
+
+GArray         *get_dark_windows(qth_t * qth, gdouble start, gdouble maxdt,
+                                 gdouble min_sun_el, gdouble max_sun_el);
+gboolean        get_pass_visibility(sat_t * sat, qth_t * qth, pass_t * pass,
+                                    gdouble * vis_start, gdouble * vis_end);
+GSList         *get_visible_passes(sat_t * sat, qth_t * qth, gdouble start,
+                                   gdouble maxdt, gdouble min_el, guint num,
+                                   gint * cancelled);
+
+#endif